@@ -88,7 +88,7 @@ inline static void BindPoolLoadParams(NLastGetopt::TOpts* parser, NCatboostOptio
       loadParamsPtr->CvParams.Shuffle = false;
         });
 
-    parser->AddLongOption('f', "learn-set", "learn set path")
+    parser->AddLongOption('f', "learn-set", "learn set path, dsv shards can be specified by wildcards in file name (e.g. part-*.tsv.gz)")
         .RequiredArgument("[SCHEME://]PATH")
         .Handler1T<TStringBuf>([loadParamsPtr](const TStringBuf& str) {
             loadParamsPtr->LearnSetPath = TPathWithScheme(str, "dsv");
@@ -294,6 +294,12 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("trace-file", "file to write Chrome trace (chrome://tracing) of data loading and training stages")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["trace_file"] = name;
+        });
+
     parser.AddLongOption("trace-log", "path for trace log")
         .RequiredArgument("file")
         .Handler1T<TString>([](const TString& name) {
@@ -667,6 +673,15 @@ static void BindTreeParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* pla
                 (*plainJsonPtr)["dev_efb_max_buckets"] = maxBuckets;
             });
 
+    parser.AddLongOption("dev-efb-conflicts-sample-size",
+                         "CPU only. Number of objects used to calculate conflicts between features "
+                         "for exclusive features bundles, 0 means all objects. "
+                         "Used only for learning speed tuning.")
+            .RequiredArgument("INT")
+            .Handler1T<ui32>([plainJsonPtr](ui32 sampleSize) {
+                (*plainJsonPtr)["dev_efb_conflicts_sample_size"] = sampleSize;
+            });
+
     parser.AddLongOption("sparse-features-conflict-fraction",
                          "CPU only. Maximum allowed fraction of conflicting non-default values for features in exclusive features bundle."
                          "Should be a real value in [0, 1) interval.")
@@ -1039,6 +1054,15 @@ static void BindSystemParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
                 (*plainJsonPtr)["used_ram_limit"] = param;
             });
 
+    parser
+        .AddLongOption("numa-local-placement")
+        .NoArgument()
+        .Help("CPU only. Pin worker threads to NUMA nodes and place approxes and derivatives of each part of"
+              " the dataset on the node that processes it (feature columns too if folds are not permuted, e.g. has_time)")
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["numa_local_placement"] = true;
+        });
+
     parser
             .AddLongOption("gpu-ram-part")
             .RequiredArgument("double")
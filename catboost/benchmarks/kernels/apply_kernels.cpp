@@ -0,0 +1,284 @@
+#include "data_generators.h"
+
+#include <catboost/libs/model/cpu/quantization.h>
+#include <catboost/libs/model/evaluation_interface.h>
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/online_ctr.h>
+#include <catboost/libs/model/static_ctr_provider.h>
+#include <catboost/libs/model/ut/lib/random_model.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+#include <util/string/builder.h>
+
+using namespace NCB::NBenchmarks;
+using namespace NCB::NModelEvaluation;
+using NCB::NModelUT::BuildRandomModel;
+
+/* Model application kernels, an iteration is one document.
+ * Documents are processed in FORMULA_EVALUATION_BLOCK_SIZE blocks as the CPU evaluator does,
+ *  the last block of a run is partial if the number of iterations is not a multiple of the block size.
+ */
+
+namespace {
+    const size_t FeatureCount = 50;
+    const size_t BorderCount = 64;
+    const size_t DocCount = 16 * 1024;
+
+    class TApplyData {
+    public:
+        TApplyData(size_t treeCount, size_t treeDepth)
+            : Model(BuildRandomModel(FeatureCount, BorderCount, treeCount, treeDepth))
+            , Evaluator(CreateCpuEvaluator(Model))
+            , Features(GenerateFloatFeatures(DocCount, FeatureCount))
+            , BucketCount(Model.ObliviousTrees->GetEffectiveBinaryFeaturesBucketsCount())
+            , ApproxDimension(Model.ObliviousTrees->ApproxDimension)
+            , BlockQuantizedData(
+                NCB::TMaybeOwningArrayHolder<ui8>::CreateOwning(TVector<ui8>(BucketCount * FORMULA_EVALUATION_BLOCK_SIZE))
+            )
+        {
+            // the whole dataset is quantized once for the tree calculation benchmark
+            TCPUEvaluatorQuantizedData quantizedData(
+                NCB::TMaybeOwningArrayHolder<ui8>::CreateOwning(TVector<ui8>(BucketCount * DocCount))
+            );
+            Binarize(0, DocCount, &quantizedData);
+            QuantizedBlocks.reserve(quantizedData.BlocksCount);
+            for (auto blockId : xrange(quantizedData.BlocksCount)) {
+                QuantizedBlocks.push_back(quantizedData.ExtractBlock(blockId));
+            }
+            // quantized layout depends on the number of documents in a block, so partial blocks are separate
+            PartialQuantizedBlocks.reserve(FORMULA_EVALUATION_BLOCK_SIZE);
+            PartialQuantizedBlocks.emplace_back(); // no documents, unused
+            for (auto docCount : xrange<size_t>(1, FORMULA_EVALUATION_BLOCK_SIZE)) {
+                PartialQuantizedBlocks.emplace_back(
+                    NCB::TMaybeOwningArrayHolder<ui8>::CreateOwning(TVector<ui8>(BucketCount * docCount))
+                );
+                Binarize(0, docCount, &PartialQuantizedBlocks.back());
+            }
+            Results.yresize(FORMULA_EVALUATION_BLOCK_SIZE * ApproxDimension);
+        }
+
+        size_t GetTreeCount() const {
+            return Model.GetTreeCount();
+        }
+
+        size_t GetQuantizedBytesPerDoc() const {
+            return BucketCount;
+        }
+
+        void Binarize(size_t start, size_t end, TCPUEvaluatorQuantizedData* quantizedData) const {
+            BinarizeFeatures(
+                *Model.ObliviousTrees,
+                Model.CtrProvider,
+                [this] (TFeaturePosition position, size_t index) -> float {
+                    return Features[position.Index][index];
+                },
+                [] (TFeaturePosition, size_t) -> int {
+                    return 0;
+                },
+                start,
+                end,
+                quantizedData,
+                /*transposedHash*/ {},
+                /*ctrs*/ {}
+            );
+        }
+
+        // BinarizeFeatures
+        void RunBinarization(size_t iterations) {
+            size_t blockStart = 0;
+            for (size_t doc = 0; doc < iterations; doc += FORMULA_EVALUATION_BLOCK_SIZE) {
+                const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, iterations - doc);
+                Binarize(blockStart, blockStart + blockSize, &BlockQuantizedData);
+                Y_DO_NOT_OPTIMIZE_AWAY(BlockQuantizedData.QuantizedData.data());
+                blockStart = (blockStart + FORMULA_EVALUATION_BLOCK_SIZE) % DocCount;
+            }
+        }
+
+        // CalcIndexesSse and leaf value accumulation on quantized data
+        void RunTreeCalculation(size_t iterations) {
+            size_t blockId = 0;
+            for (size_t doc = 0; doc < iterations; doc += FORMULA_EVALUATION_BLOCK_SIZE) {
+                const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, iterations - doc);
+                Evaluator->Calc(
+                    blockSize == FORMULA_EVALUATION_BLOCK_SIZE ? &QuantizedBlocks[blockId] : &PartialQuantizedBlocks[blockSize],
+                    0,
+                    GetTreeCount(),
+                    MakeArrayRef(Results.data(), blockSize * ApproxDimension)
+                );
+                Y_DO_NOT_OPTIMIZE_AWAY(Results.data());
+                blockId = (blockId + 1) % QuantizedBlocks.size();
+            }
+        }
+
+    private:
+        TFullModel Model;
+        TModelEvaluatorPtr Evaluator;
+        TVector<TVector<float>> Features; // [featureIdx][docIdx]
+        size_t BucketCount;
+        size_t ApproxDimension;
+
+        TCPUEvaluatorQuantizedData BlockQuantizedData;
+        TVector<TCPUEvaluatorQuantizedData> QuantizedBlocks; // slices share the buffer of the whole dataset
+        TVector<TCPUEvaluatorQuantizedData> PartialQuantizedBlocks; // [docCount], first docCount documents
+        TVector<double> Results;
+    };
+
+    template <size_t TreeCount, size_t TreeDepth>
+    TApplyData& GetApplyData() {
+        static TApplyData data(TreeCount, TreeDepth);
+        static bool reported = [] {
+            const TString suffix = TStringBuilder() << "_" << TreeCount << "_Trees_Depth_" << TreeDepth;
+            ReportIterationUnits("BinarizeFeatures" + suffix, 1, FeatureCount * sizeof(float) + data.GetQuantizedBytesPerDoc());
+            ReportIterationUnits("CalcTrees" + suffix, 1, data.GetQuantizedBytesPerDoc() + sizeof(double));
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+
+    // ECtrType::Buckets values of a single categorical feature by the static CTR provider, as the evaluator calls it
+    class TCtrLookupData {
+    public:
+        TCtrLookupData(size_t uniqueValueCount) {
+            TRandomCtrTable ctrTable = BuildRandomCtrTable(uniqueValueCount, TargetClassesCount);
+            TFastRng64 rng(5);
+            CatValues.yresize(DocCount);
+            for (auto& catValue : CatValues) {
+                // one of ten values is unseen in the table
+                catValue = rng.Uniform(10)
+                    ? ctrTable.CatValues[rng.Uniform(uniqueValueCount)]
+                    : static_cast<ui32>(rng.GenRand());
+            }
+
+            TModelCtr ctr;
+            ctr.Base.Projection.CatFeatures = {0};
+            ctr.Base.CtrType = ECtrType::Buckets;
+            ctr.TargetBorderIdx = 1;
+            ctr.PriorNum = 0.5f;
+            NeededCtrs = {ctr};
+
+            ctrTable.Table.ModelCtrBase = ctr.Base;
+            CtrProvider.AddCtrCalcerData(std::move(ctrTable.Table));
+            CtrProvider.SetupBinFeatureIndexes({}, {}, {TCatFeature(true, 0, 0, "")});
+            Results.yresize(FORMULA_EVALUATION_BLOCK_SIZE);
+        }
+
+        void Run(size_t iterations) {
+            size_t blockStart = 0;
+            for (size_t doc = 0; doc < iterations; doc += FORMULA_EVALUATION_BLOCK_SIZE) {
+                const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, iterations - doc);
+                CtrProvider.CalcCtrs(
+                    NeededCtrs,
+                    TConstArrayRef<ui8>(),
+                    MakeArrayRef(CatValues.data() + blockStart, blockSize),
+                    blockSize,
+                    MakeArrayRef(Results.data(), blockSize));
+                Y_DO_NOT_OPTIMIZE_AWAY(Results.data());
+                blockStart = (blockStart + FORMULA_EVALUATION_BLOCK_SIZE) % DocCount;
+            }
+        }
+
+    private:
+        static constexpr int TargetClassesCount = 2;
+
+        TStaticCtrProvider CtrProvider;
+        TVector<TModelCtr> NeededCtrs;
+        TVector<ui32> CatValues;
+        TVector<float> Results;
+    };
+
+    template <size_t UniqueValueCount>
+    TCtrLookupData& GetCtrLookupData() {
+        static TCtrLookupData data(UniqueValueCount);
+        static bool reported = [] {
+            ReportIterationUnits(
+                TStringBuilder() << "CtrLookup_" << UniqueValueCount << "_Values",
+                1,
+                sizeof(ui32) + sizeof(NCatboost::TBucket) + 2 * sizeof(int) + sizeof(float));
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+
+    // model deserialization from memory, an iteration is one model
+    class TModelLoadData {
+    public:
+        TModelLoadData(size_t treeCount, size_t treeDepth)
+            : SerializedModel(SerializeModel(BuildRandomModel(FeatureCount, BorderCount, treeCount, treeDepth)))
+        {
+        }
+
+        size_t GetModelSize() const {
+            return SerializedModel.size();
+        }
+
+        void Run(size_t iterations) const {
+            for (auto iteration : xrange(iterations)) {
+                Y_UNUSED(iteration);
+                auto model = ReadModel(SerializedModel.data(), SerializedModel.size());
+                Y_DO_NOT_OPTIMIZE_AWAY(model.GetTreeCount());
+            }
+        }
+
+    private:
+        TString SerializedModel;
+    };
+
+    template <size_t TreeCount, size_t TreeDepth>
+    const TModelLoadData& GetModelLoadData() {
+        static TModelLoadData data(TreeCount, TreeDepth);
+        static bool reported = [] {
+            ReportIterationUnits(
+                TStringBuilder() << "ModelLoad_" << TreeCount << "_Trees_Depth_" << TreeDepth,
+                0,
+                data.GetModelSize());
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+}
+
+#define DEFINE_APPLY_BENCHMARKS(treeCount, treeDepth)                                                         \
+    Y_CPU_BENCHMARK(BinarizeFeatures_##treeCount##_Trees_Depth_##treeDepth, iface) {                          \
+        auto& data = GetApplyData<treeCount, treeDepth>();                                                    \
+        RunTimed(                                                                                             \
+            "BinarizeFeatures_" #treeCount "_Trees_Depth_" #treeDepth,                                        \
+            iface.Iterations(),                                                                               \
+            [&] (size_t iterations) { data.RunBinarization(iterations); });                                   \
+    }                                                                                                         \
+    Y_CPU_BENCHMARK(CalcTrees_##treeCount##_Trees_Depth_##treeDepth, iface) {                                 \
+        auto& data = GetApplyData<treeCount, treeDepth>();                                                    \
+        RunTimed(                                                                                             \
+            "CalcTrees_" #treeCount "_Trees_Depth_" #treeDepth,                                               \
+            iface.Iterations(),                                                                               \
+            [&] (size_t iterations) { data.RunTreeCalculation(iterations); });                                \
+    }                                                                                                         \
+    Y_CPU_BENCHMARK(ModelLoad_##treeCount##_Trees_Depth_##treeDepth, iface) {                                 \
+        const auto& data = GetModelLoadData<treeCount, treeDepth>();                                          \
+        RunTimed(                                                                                             \
+            "ModelLoad_" #treeCount "_Trees_Depth_" #treeDepth,                                               \
+            iface.Iterations(),                                                                               \
+            [&] (size_t iterations) { data.Run(iterations); });                                               \
+    }
+
+DEFINE_APPLY_BENCHMARKS(100, 6)
+DEFINE_APPLY_BENCHMARKS(1000, 6)
+DEFINE_APPLY_BENCHMARKS(1000, 8)
+
+Y_CPU_BENCHMARK(CtrLookup_1000_Values, iface) {
+    auto& data = GetCtrLookupData<1000>();
+    RunTimed("CtrLookup_1000_Values", iface.Iterations(), [&] (size_t iterations) { data.Run(iterations); });
+}
+
+Y_CPU_BENCHMARK(CtrLookup_1000000_Values, iface) {
+    auto& data = GetCtrLookupData<1000000>();
+    RunTimed("CtrLookup_1000000_Values", iface.Iterations(), [&] (size_t iterations) { data.Run(iterations); });
+}
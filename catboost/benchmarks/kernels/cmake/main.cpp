@@ -0,0 +1,115 @@
+#include "../../../libs/model_interface/c_api.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Model load and apply benchmark built against the prebuilt libcatboostmodel.
+ *
+ * Usage: catboost_kernels_benchmark model.bin [doc_count] [repeat_count]
+ *
+ * Features are synthetic, uniform in [0, 1) for float features and random hashes for categorical ones.
+ * Apply is measured in blocks of BlockSize documents, as it is called by services.
+ */
+
+namespace {
+    const size_t BlockSize = 128;
+
+    using TClock = std::chrono::steady_clock;
+
+    double SecondsSince(TClock::time_point start) {
+        return std::chrono::duration<double>(TClock::now() - start).count();
+    }
+
+    void Report(const std::string& name, double seconds, size_t docCount, size_t byteCount) {
+        std::cout << name << ": " << seconds * 1e9 / docCount << " ns/doc, "
+                  << byteCount / seconds / 1e9 << " GB/s" << std::endl;
+    }
+
+    void Check(bool success) {
+        if (!success) {
+            throw std::runtime_error(GetErrorString());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " model.bin [doc_count] [repeat_count]" << std::endl;
+        return 1;
+    }
+    const size_t docCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+    const size_t repeatCount = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10;
+
+    std::ifstream modelFile(argv[1], std::ios::binary);
+    const std::vector<char> modelBuffer((std::istreambuf_iterator<char>(modelFile)), std::istreambuf_iterator<char>());
+    if (modelBuffer.empty()) {
+        std::cerr << "Can't read model from " << argv[1] << std::endl;
+        return 1;
+    }
+
+    ModelCalcerHandle* calcer = ModelCalcerCreate();
+    try {
+        // model load, from memory so that disk reads are not measured
+        auto start = TClock::now();
+        for (size_t repeat = 0; repeat < repeatCount; ++repeat) {
+            Check(LoadFullModelFromBuffer(calcer, modelBuffer.data(), modelBuffer.size()));
+        }
+        const double loadSeconds = SecondsSince(start) / repeatCount;
+        std::cout << "ModelLoad: " << loadSeconds * 1e3 << " ms/model, "
+                  << modelBuffer.size() / loadSeconds / 1e9 << " GB/s" << std::endl;
+
+        const size_t floatFeatureCount = GetFloatFeaturesCount(calcer);
+        const size_t catFeatureCount = GetCatFeaturesCount(calcer);
+        const size_t dimension = GetDimensionsCount(calcer);
+
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<float> floatDistribution;
+        std::vector<std::vector<float>> floatFeatures(docCount, std::vector<float>(floatFeatureCount));
+        std::vector<std::vector<int>> catFeatures(docCount, std::vector<int>(catFeatureCount));
+        for (size_t doc = 0; doc < docCount; ++doc) {
+            for (auto& value : floatFeatures[doc]) {
+                value = floatDistribution(rng);
+            }
+            for (auto& value : catFeatures[doc]) {
+                value = GetIntegerCatFeatureHash(rng() % 1000);
+            }
+        }
+        std::vector<const float*> floatPtrs;
+        std::vector<const int*> catPtrs;
+        for (size_t doc = 0; doc < docCount; ++doc) {
+            floatPtrs.push_back(floatFeatures[doc].data());
+            catPtrs.push_back(catFeatures[doc].data());
+        }
+        std::vector<double> results(BlockSize * dimension);
+
+        // binarization, tree calculation and, for models with categorical features, CTR calculation
+        start = TClock::now();
+        for (size_t repeat = 0; repeat < repeatCount; ++repeat) {
+            for (size_t blockStart = 0; blockStart < docCount; blockStart += BlockSize) {
+                const size_t blockSize = std::min(BlockSize, docCount - blockStart);
+                Check(CalcModelPredictionWithHashedCatFeatures(
+                    calcer,
+                    blockSize,
+                    floatPtrs.data() + blockStart, floatFeatureCount,
+                    catPtrs.data() + blockStart, catFeatureCount,
+                    results.data(), blockSize * dimension));
+            }
+        }
+        const size_t bytesPerDoc = floatFeatureCount * sizeof(float) + catFeatureCount * sizeof(int) + dimension * sizeof(double);
+        Report("Apply", SecondsSince(start), docCount * repeatCount, bytesPerDoc * docCount * repeatCount);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        ModelCalcerDelete(calcer);
+        return 1;
+    }
+    ModelCalcerDelete(calcer);
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "data_generators.h"
+
+#include <catboost/libs/data_new/data_provider_builders.h>
+#include <catboost/libs/model/hash.h>
+
+#include <util/generic/map.h>
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/output.h>
+#include <util/string/builder.h>
+
+
+namespace {
+    struct TKernelTotals {
+        size_t DocsPerIteration = 0;
+        size_t BytesPerIteration = 0;
+        ui64 Iterations = 0;
+        TDuration Time;
+    };
+
+    /* Totals of all benchmark runs (including the warm-up ones) for each kernel.
+     * Singletons are destroyed before the standard streams, so it is safe to print in the destructor.
+     */
+    class TKernelThroughputReport {
+    public:
+        ~TKernelThroughputReport() {
+            for (const auto& [kernelName, totals] : Kernels) {
+                if (!totals.Iterations || !totals.Time.NanoSeconds()) {
+                    continue;
+                }
+                const double nsPerIteration = double(totals.Time.NanoSeconds()) / totals.Iterations;
+                Cerr << kernelName << ":";
+                if (totals.DocsPerIteration) {
+                    Cerr << " " << nsPerIteration / totals.DocsPerIteration << " ns/doc,";
+                } else {
+                    Cerr << " " << nsPerIteration << " ns/call,";
+                }
+                // bytes per ns is GB/s
+                Cerr << " " << totals.BytesPerIteration / nsPerIteration << " GB/s" << Endl;
+            }
+        }
+
+        TKernelTotals& operator[](TStringBuf kernelName) {
+            return Kernels[TString(kernelName)];
+        }
+
+    private:
+        TMap<TString, TKernelTotals> Kernels;
+    };
+}
+
+
+namespace NCB::NBenchmarks {
+    TVector<TVector<float>> GenerateFloatFeatures(size_t docCount, size_t featureCount, ui64 seed) {
+        TFastRng64 rng(seed);
+        TVector<TVector<float>> features(featureCount);
+        for (auto& feature : features) {
+            feature.yresize(docCount);
+            for (auto& value : feature) {
+                value = rng.GenRandReal1();
+            }
+        }
+        return features;
+    }
+
+    TVector<float> GenerateTarget(size_t docCount, ui32 classCount, ui64 seed) {
+        TFastRng64 rng(seed);
+        TVector<float> target;
+        target.yresize(docCount);
+        for (auto& value : target) {
+            value = classCount ? rng.Uniform(classCount) : rng.GenRandReal1();
+        }
+        return target;
+    }
+
+    TVector<double> GenerateApproxes(size_t docCount, ui64 seed) {
+        TFastRng64 rng(seed);
+        TVector<double> approxes;
+        approxes.yresize(docCount);
+        for (auto& value : approxes) {
+            value = 4.0 * (rng.GenRandReal1() - 0.5);
+        }
+        return approxes;
+    }
+
+    TRandomCtrTable BuildRandomCtrTable(size_t uniqueValueCount, int targetClassesCount) {
+        TFastRng64 rng(4);
+        TRandomCtrTable result;
+        result.Table.TargetClassesCount = targetClassesCount;
+
+        auto hashBuilder = result.Table.GetIndexHashBuilder(uniqueValueCount);
+        result.CatValues.reserve(uniqueValueCount);
+        for (auto valueIdx : xrange(uniqueValueCount)) {
+            Y_UNUSED(valueIdx);
+            const ui32 catValue = static_cast<ui32>(rng.GenRand());
+            // hash of the single feature projection, see CalcHashes
+            hashBuilder.AddIndex(CalcHash(0, (ui64)(int)catValue));
+            result.CatValues.push_back(catValue);
+        }
+        auto counts = result.Table.AllocateBlobAndGetArrayRef<int>(uniqueValueCount * targetClassesCount);
+        for (auto& count : counts) {
+            count = rng.Uniform(100);
+        }
+        return result;
+    }
+
+    TDataProviderPtr CreateRawDataProvider(
+        const TVector<TVector<float>>& features,
+        const TVector<float>& target) {
+
+        const ui32 featureCount = features.size();
+        return CreateDataProvider(
+            [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                TDataMetaInfo metaInfo;
+                metaInfo.HasTarget = true;
+                metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                    featureCount,
+                    TVector<ui32>{},
+                    TVector<ui32>{},
+                    TVector<TString>{});
+
+                visitor->Start(metaInfo, target.size(), EObjectsOrder::Undefined, {});
+
+                for (auto featureIdx : xrange(featureCount)) {
+                    visitor->AddFloatFeature(
+                        featureIdx,
+                        TMaybeOwningConstArrayHolder<float>::CreateOwning(TVector<float>(features[featureIdx]))
+                    );
+                }
+                visitor->AddTarget(target);
+
+                visitor->Finish();
+            }
+        );
+    }
+
+    TVector<TString> GenerateDsvLines(size_t docCount, size_t featureCount, ui64 seed) {
+        TFastRng64 rng(seed);
+        TVector<TString> lines;
+        lines.reserve(docCount);
+        for (auto docIdx : xrange(docCount)) {
+            Y_UNUSED(docIdx);
+            TStringBuilder line;
+            line << rng.Uniform(2);
+            for (auto featureIdx : xrange(featureCount)) {
+                Y_UNUSED(featureIdx);
+                line << '\t' << rng.GenRandReal1();
+            }
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }
+
+    void ReportIterationUnits(TStringBuf kernelName, size_t docsPerIteration, size_t bytesPerIteration) {
+        Cerr << kernelName << ": iteration = ";
+        if (docsPerIteration) {
+            Cerr << docsPerIteration << " doc(s)";
+        } else {
+            Cerr << "1 call";
+        }
+        Cerr << ", " << bytesPerIteration << " bytes" << Endl;
+
+        auto& totals = (*Singleton<TKernelThroughputReport>())[kernelName];
+        totals.DocsPerIteration = docsPerIteration;
+        totals.BytesPerIteration = bytesPerIteration;
+    }
+
+    void AddKernelRunTime(TStringBuf kernelName, size_t iterations, TDuration time) {
+        auto& totals = (*Singleton<TKernelThroughputReport>())[kernelName];
+        totals.Iterations += iterations;
+        totals.Time += time;
+    }
+}
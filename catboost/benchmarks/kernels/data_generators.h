@@ -0,0 +1,63 @@
+#pragma once
+
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/model/ctr_value_table.h>
+#include <catboost/libs/model/model.h>
+
+#include <util/datetime/base.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+/* Synthetic data for the kernel benchmarks.
+ *
+ * All generators are deterministic for the same arguments, so results of different builds are comparable.
+ */
+
+namespace NCB::NBenchmarks {
+    // [featureIdx][docIdx], uniform in [0, 1)
+    TVector<TVector<float>> GenerateFloatFeatures(size_t docCount, size_t featureCount, ui64 seed = 0);
+
+    // regression target if classCount == 0, class indices otherwise
+    TVector<float> GenerateTarget(size_t docCount, ui32 classCount = 0, ui64 seed = 1);
+
+    // approxes distributed around zero as they are in the middle of training
+    TVector<double> GenerateApproxes(size_t docCount, ui64 seed = 2);
+
+    /* CTR table of ECtrType::Buckets layout for uniqueValueCount values of a single categorical feature,
+     * keyed by the projection hashes as the static CTR provider calculates them
+     */
+    struct TRandomCtrTable {
+        TCtrValueTable Table;
+        TVector<ui32> CatValues; // hashed categorical feature values present in the table
+    };
+
+    TRandomCtrTable BuildRandomCtrTable(size_t uniqueValueCount, int targetClassesCount);
+
+    // raw data provider with float features and target, as it is after loading
+    TDataProviderPtr CreateRawDataProvider(
+        const TVector<TVector<float>>& features,
+        const TVector<float>& target);
+
+    // lines of a catboost dsv pool with the target in the first column, followed by float features
+    TVector<TString> GenerateDsvLines(size_t docCount, size_t featureCount, ui64 seed = 3);
+
+    /* Benchmark iteration counts are in units of documents or passes depending on the kernel,
+     * print once per kernel what an iteration is.
+     * The units are also used to print ns/doc and GB/s of the kernel at exit (see RunTimed).
+     */
+    void ReportIterationUnits(TStringBuf kernelName, size_t docsPerIteration, size_t bytesPerIteration);
+
+    // adds a run of the kernel to its totals, printed at exit
+    void AddKernelRunTime(TStringBuf kernelName, size_t iterations, TDuration time);
+
+    // kernelName should be the one passed to ReportIterationUnits
+    template <class TKernel>
+    void RunTimed(TStringBuf kernelName, size_t iterations, TKernel&& kernel) {
+        const TInstant start = TInstant::Now();
+        kernel(iterations);
+        AddKernelRunTime(kernelName, iterations, TInstant::Now() - start);
+    }
+}
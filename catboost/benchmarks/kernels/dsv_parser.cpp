@@ -0,0 +1,124 @@
+#include "data_generators.h"
+
+#include <catboost/libs/column_description/column.h>
+#include <catboost/libs/data_new/load_data.h>
+#include <catboost/libs/data_util/line_data_reader.h>
+
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/string/builder.h>
+
+using namespace NCB;
+using namespace NCB::NBenchmarks;
+
+/* Dsv pool parsing from memory, so that disk reads are not measured, an iteration is one line.
+ * Lines are parsed by ReadDataset in blocks of LinesPerBlock, in a single thread.
+ */
+
+namespace {
+    const size_t LinesPerBlock = 10000;
+
+    class TMemoryLineDataReader final : public ILineDataReader {
+    public:
+        explicit TMemoryLineDataReader(TConstArrayRef<TString> lines)
+            : Lines(lines)
+        {
+        }
+
+        ui64 GetDataLineCount() override {
+            return Lines.size();
+        }
+
+        TMaybe<TString> GetHeader() override {
+            return Nothing();
+        }
+
+        bool ReadLine(TString* line) override {
+            if (NextLineIdx == Lines.size()) {
+                return false;
+            }
+            *line = Lines[NextLineIdx++];
+            return true;
+        }
+
+    private:
+        TConstArrayRef<TString> Lines;
+        size_t NextLineIdx = 0;
+    };
+
+    class TDsvData {
+    public:
+        explicit TDsvData(size_t featureCount)
+            : Lines(GenerateDsvLines(LinesPerBlock, featureCount))
+        {
+            Columns.push_back(TColumn{EColumn::Label, TString()});
+            for (auto featureIdx : xrange(featureCount)) {
+                Y_UNUSED(featureIdx);
+                Columns.push_back(TColumn{EColumn::Num, TString()});
+            }
+        }
+
+        size_t GetAverageLineSize() const {
+            size_t totalSize = 0;
+            for (const auto& line : Lines) {
+                totalSize += line.size() + 1;
+            }
+            return totalSize / Lines.size();
+        }
+
+        void Run(size_t iterations) {
+            for (size_t line = 0; line < iterations; line += LinesPerBlock) {
+                const size_t lineCount = Min(LinesPerBlock, iterations - line);
+                auto dataProvider = ReadDataset(
+                    MakeHolder<TMemoryLineDataReader>(MakeArrayRef(Lines.data(), lineCount)),
+                    /*pairsFilePath*/ TPathWithScheme(),
+                    /*groupWeightsFilePath*/ TPathWithScheme(),
+                    /*baselineFilePath*/ TPathWithScheme(),
+                    TDsvFormatOptions(),
+                    Columns,
+                    /*ignoredFeatures*/ {},
+                    EObjectsOrder::Undefined,
+                    /*classNames*/ Nothing(),
+                    &Executor
+                );
+                Y_DO_NOT_OPTIMIZE_AWAY(dataProvider.Get());
+            }
+        }
+
+    private:
+        TVector<TString> Lines;
+        TVector<TColumn> Columns;
+        NPar::TLocalExecutor Executor;
+    };
+
+    template <size_t FeatureCount>
+    TDsvData& GetDsvData() {
+        static TDsvData data(FeatureCount);
+        static bool reported = [] {
+            ReportIterationUnits(
+                TStringBuilder() << "DsvParser_" << FeatureCount << "_Features",
+                1,
+                data.GetAverageLineSize());
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+}
+
+Y_CPU_BENCHMARK(DsvParser_10_Features, iface) {
+    auto& data = GetDsvData<10>();
+    RunTimed("DsvParser_10_Features", iface.Iterations(), [&] (size_t iterations) { data.Run(iterations); });
+}
+
+Y_CPU_BENCHMARK(DsvParser_100_Features, iface) {
+    auto& data = GetDsvData<100>();
+    RunTimed("DsvParser_100_Features", iface.Iterations(), [&] (size_t iterations) { data.Run(iterations); });
+}
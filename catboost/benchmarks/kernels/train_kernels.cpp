@@ -0,0 +1,282 @@
+#include "data_generators.h"
+
+#include <catboost/libs/algo/calc_score_cache.h>
+#include <catboost/libs/algo/data.h>
+#include <catboost/libs/algo/error_functions.h>
+#include <catboost/libs/algo/fold.h>
+#include <catboost/libs/algo/score_calcer.h>
+#include <catboost/libs/algo/tensor_search_helpers.h>
+#include <catboost/libs/labels/label_converter.h>
+#include <catboost/libs/metrics/auc.h>
+#include <catboost/libs/options/catboost_options.h>
+#include <catboost/libs/options/plain_options_helper.h>
+
+#include <library/json/json_value.h>
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+#include <util/string/builder.h>
+
+using namespace NCB;
+using namespace NCB::NBenchmarks;
+
+/* Training kernels, all of them run in a single thread.
+ * Derivatives are calculated per document, an iteration is one document.
+ * Histograms and AUC are calculated over the whole dataset, an iteration is one pass,
+ *  the document count is in the benchmark name.
+ */
+
+namespace {
+    const size_t FeatureCount = 10;
+    const size_t DerBlockSize = 1024;
+
+    // statistics of float feature buckets for all leaves, as in distributed and plain mode training
+    class TStatsData {
+    public:
+        TStatsData(size_t docCount, int depth)
+            : Params(ETaskType::CPU)
+            , Depth(depth)
+            , Rand(0)
+        {
+            NJson::TJsonValue plainParams;
+            plainParams["loss_function"] = "RMSE";
+            plainParams["boosting_type"] = "Plain";
+            plainParams["bootstrap_type"] = "No";
+            plainParams["depth"] = Max(depth, 1);
+            plainParams["thread_count"] = 1;
+            NJson::TJsonValue jsonParams;
+            NJson::TJsonValue outputJsonParams;
+            NCatboostOptions::PlainJsonToOptions(plainParams, &jsonParams, &outputJsonParams);
+            Params.Load(jsonParams);
+
+            TDataProviders pools;
+            pools.Learn = CreateRawDataProvider(GenerateFloatFeatures(docCount, FeatureCount), GenerateTarget(docCount));
+            TLabelConverter labelConverter;
+            Data = GetTrainingData(
+                std::move(pools),
+                /*bordersFile*/ Nothing(),
+                /*ensureConsecutiveLearnFeaturesDataForCpu*/ true,
+                /*allowWriteFiles*/ false,
+                /*quantizedFeaturesInfo*/ nullptr,
+                &Params,
+                &labelConverter,
+                &Executor,
+                &Rand
+            ).Cast<TQuantizedForCPUObjectsDataProvider>().Learn;
+
+            Folds.push_back(
+                TFold::BuildPlainFold(
+                    *Data,
+                    /*targetClassifiers*/ {},
+                    /*shuffle*/ false,
+                    /*permuteBlockSize*/ 1,
+                    /*approxDimension*/ 1,
+                    /*storeExpApproxes*/ false,
+                    /*hasPairwiseWeights*/ false,
+                    &Rand,
+                    &Executor
+                )
+            );
+            auto& fold = Folds[0];
+            const auto error = BuildError(Params, /*objectiveDescriptor*/ Nothing());
+            CalcWeightedDerivatives(*error, /*bodyTailIdx*/ 0, Params, /*randomSeed*/ 0, &fold, &Executor);
+
+            // documents are spread over the leaves of the tree built so far
+            TFastRng64 rng(6);
+            TVector<TIndexType> indices;
+            indices.yresize(docCount);
+            for (auto& index : indices) {
+                index = rng.Uniform(1 << depth);
+            }
+            SampledDocs.Create(
+                Folds,
+                /*isPairwiseScoring*/ false,
+                static_cast<int>(Params.ObliviousTreeOptions->DevScoreCalcObjBlockSize)
+            );
+            Bootstrap(Params, indices, &fold, &SampledDocs, &Executor, &Rand);
+
+            TSplitCandidate splitCandidate;
+            splitCandidate.FeatureIdx = 0;
+            splitCandidate.Type = ESplitType::FloatFeature;
+            Candidate.SplitEnsemble = TSplitEnsemble(std::move(splitCandidate));
+        }
+
+        void Run(size_t iterations) {
+            for (auto iteration : xrange(iterations)) {
+                Y_UNUSED(iteration);
+                CalcStatsAndScores(
+                    *Data->ObjectsData,
+                    Folds[0].GetAllCtrs(),
+                    SampledDocs,
+                    SampledDocs,
+                    /*initialFold*/ nullptr,
+                    /*pairs*/ {},
+                    Params,
+                    Candidate,
+                    Depth,
+                    /*useTreeLevelCaching*/ false,
+                    /*currTreeMonotonicConstraints*/ {},
+                    /*monotonicConstraints*/ {},
+                    &Executor,
+                    &PrevTreeLevelStats,
+                    &Stats,
+                    /*pairwiseStats*/ nullptr,
+                    /*scoreBins*/ nullptr
+                );
+                Y_DO_NOT_OPTIMIZE_AWAY(Stats.Stats.data());
+            }
+        }
+
+    private:
+        NCatboostOptions::TCatBoostOptions Params;
+        int Depth;
+        TRestorableFastRng64 Rand;
+        NPar::TLocalExecutor Executor;
+
+        TTrainingForCPUDataProviderPtr Data;
+        TVector<TFold> Folds;
+        TCalcScoreFold SampledDocs;
+        TBucketStatsCache PrevTreeLevelStats; // unused without tree level caching
+        TCandidateInfo Candidate;
+        TStats3D Stats;
+    };
+
+    template <size_t DocCount, int Depth>
+    TStatsData& GetStatsData() {
+        static TStatsData data(DocCount, Depth);
+        static bool reported = [] {
+            // bucket, leaf index, weighted derivative and weight of each document
+            ReportIterationUnits(
+                TStringBuilder() << "CalcStats_" << DocCount << "_Docs_Depth_" << Depth,
+                DocCount,
+                DocCount * (sizeof(ui8) + sizeof(TIndexType) + sizeof(double) + sizeof(float)));
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+
+    // IDerCalcer::CalcDersRange for the first three derivatives
+    class TDersData {
+    public:
+        explicit TDersData(size_t docCount)
+            : Approxes(GenerateApproxes(docCount))
+            , Targets(GenerateTarget(docCount, /*classCount*/ 2))
+        {
+            Ders.yresize(DerBlockSize);
+        }
+
+        void Run(const IDerCalcer& error, size_t iterations) {
+            int blockStart = 0;
+            for (size_t doc = 0; doc < iterations; doc += DerBlockSize) {
+                const int blockSize = Min(DerBlockSize, iterations - doc);
+                error.CalcDersRange(
+                    /*start*/ 0,
+                    blockSize,
+                    /*calcThirdDer*/ false,
+                    Approxes.data() + blockStart,
+                    /*approxDeltas*/ nullptr,
+                    Targets.data() + blockStart,
+                    /*weights*/ nullptr,
+                    Ders.data()
+                );
+                Y_DO_NOT_OPTIMIZE_AWAY(Ders.data());
+                blockStart = (blockStart + DerBlockSize) % Approxes.size();
+            }
+        }
+
+    private:
+        TVector<double> Approxes;
+        TVector<float> Targets;
+        TVector<TDers> Ders;
+    };
+
+    TDersData& GetDersData() {
+        static TDersData data(64 * DerBlockSize);
+        static bool reported = [] {
+            for (TStringBuf kernelName : {"CalcDers_RMSE", "CalcDers_Logloss"}) {
+                ReportIterationUnits(kernelName, 1, sizeof(double) + sizeof(float) + sizeof(TDers));
+            }
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+
+    // the samples are sorted inside, so each pass starts with a copy of the unsorted ones
+    class TAucData {
+    public:
+        explicit TAucData(size_t docCount) {
+            const auto targets = GenerateTarget(docCount, /*classCount*/ 2);
+            const auto approxes = GenerateApproxes(docCount);
+            Samples.reserve(docCount);
+            for (auto docIdx : xrange(docCount)) {
+                Samples.emplace_back(targets[docIdx], approxes[docIdx]);
+            }
+        }
+
+        void Run(size_t iterations) const {
+            for (auto iteration : xrange(iterations)) {
+                Y_UNUSED(iteration);
+                auto samples = Samples;
+                Y_DO_NOT_OPTIMIZE_AWAY(CalcAUC(&samples));
+            }
+        }
+
+    private:
+        TVector<NMetrics::TSample> Samples;
+    };
+
+    template <size_t DocCount>
+    const TAucData& GetAucData() {
+        static TAucData data(DocCount);
+        static bool reported = [] {
+            ReportIterationUnits(
+                TStringBuilder() << "CalcAUC_" << DocCount << "_Docs",
+                DocCount,
+                DocCount * sizeof(NMetrics::TSample));
+            return true;
+        }();
+        Y_UNUSED(reported);
+        return data;
+    }
+}
+
+#define DEFINE_STATS_BENCHMARK(docCount, depth)                                                \
+    Y_CPU_BENCHMARK(CalcStats_##docCount##_Docs_Depth_##depth, iface) {                        \
+        auto& data = GetStatsData<docCount, depth>();                                          \
+        RunTimed(                                                                              \
+            "CalcStats_" #docCount "_Docs_Depth_" #depth,                                      \
+            iface.Iterations(),                                                                \
+            [&] (size_t iterations) { data.Run(iterations); });                                \
+    }
+
+DEFINE_STATS_BENCHMARK(100000, 0)
+DEFINE_STATS_BENCHMARK(100000, 5)
+DEFINE_STATS_BENCHMARK(1000000, 5)
+
+Y_CPU_BENCHMARK(CalcDers_RMSE, iface) {
+    auto& data = GetDersData();
+    const TRMSEError error(/*isExpApprox*/ false);
+    RunTimed("CalcDers_RMSE", iface.Iterations(), [&] (size_t iterations) { data.Run(error, iterations); });
+}
+
+Y_CPU_BENCHMARK(CalcDers_Logloss, iface) {
+    auto& data = GetDersData();
+    const TCrossEntropyError error(/*isExpApprox*/ false);
+    RunTimed("CalcDers_Logloss", iface.Iterations(), [&] (size_t iterations) { data.Run(error, iterations); });
+}
+
+Y_CPU_BENCHMARK(CalcAUC_100000_Docs, iface) {
+    const auto& data = GetAucData<100000>();
+    RunTimed("CalcAUC_100000_Docs", iface.Iterations(), [&] (size_t iterations) { data.Run(iterations); });
+}
+
+Y_CPU_BENCHMARK(CalcAUC_1000000_Docs, iface) {
+    const auto& data = GetAucData<1000000>();
+    RunTimed("CalcAUC_1000000_Docs", iface.Iterations(), [&] (size_t iterations) { data.Run(iterations); });
+}
@@ -93,6 +93,8 @@ namespace NCatboostCuda {
             MetricDescriptions,
             History.LearnMetricsHistory,
             History.TestMetricsHistory,
+            History.LearnErrorBounds,
+            History.TestErrorBounds,
             !IsSkipOnTestFlags[evalMetricIdx] ? TMaybe<double>(ErrorTracker.GetBestError()) : Nothing(),
             !IsSkipOnTestFlags[evalMetricIdx] ? TMaybe<int>(ErrorTracker.GetBestIteration()) : Nothing(),
             profileResults,
@@ -203,6 +205,8 @@ namespace NCatboostCuda {
                 MetricDescriptions,
                 History.LearnMetricsHistory,
                 History.TestMetricsHistory,
+                History.LearnErrorBounds,
+                History.TestErrorBounds,
                 !IsSkipOnTestFlags[testIdxToLog] ? TMaybe<double>(ErrorTracker.GetBestError()) : Nothing(),
                 !IsSkipOnTestFlags[testIdxToLog] ? TMaybe<int>(ErrorTracker.GetBestIteration()) : Nothing(),
                 TProfileResults(History.TimeHistory[iteration].PassedTime, History.TimeHistory[iteration].RemainingTime),
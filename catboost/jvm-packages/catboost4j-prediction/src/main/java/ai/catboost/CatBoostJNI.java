@@ -2,6 +2,7 @@ package ai.catboost;
 
 import javax.annotation.Nullable;
 import javax.validation.constraints.NotNull;
+import java.nio.ByteBuffer;
 
 class CatBoostJNI {
     final void catBoostHashCatFeature(
@@ -93,4 +94,15 @@ class CatBoostJNI {
             final @NotNull double[] predictions) throws CatBoostError {
         CatBoostJNIImpl.checkCall(CatBoostJNIImpl.catBoostModelPredict(handle, numericFeatures, catFeatureHashes, predictions));
     }
+
+    final void catBoostModelPredict(
+            final long handle,
+            final @Nullable ByteBuffer numericFeatures,
+            final @Nullable ByteBuffer catFeatureHashes,
+            final int objectCount,
+            final boolean columnMajor,
+            final @NotNull ByteBuffer predictions) throws CatBoostError {
+        CatBoostJNIImpl.checkCall(CatBoostJNIImpl.catBoostModelPredict(
+                handle, numericFeatures, catFeatureHashes, objectCount, columnMajor, predictions));
+    }
 }
@@ -2,6 +2,7 @@ package ai.catboost;
 
 import javax.annotation.Nullable;
 import javax.validation.constraints.NotNull;
+import java.nio.ByteBuffer;
 
 class CatBoostJNIImpl {
     final static void checkCall(@Nullable String message) throws CatBoostError {
@@ -85,4 +86,13 @@ class CatBoostJNIImpl {
             @Nullable float[][] numericFeatures,
             @Nullable int[][] catFeatureHashes,
             @NotNull double[] predictions);
+
+    @Nullable
+    final static native String catBoostModelPredict(
+            long handle,
+            @Nullable ByteBuffer numericFeatures,
+            @Nullable ByteBuffer catFeatureHashes,
+            int objectCount,
+            boolean columnMajor,
+            @NotNull ByteBuffer predictions);
 }
\ No newline at end of file
@@ -5,6 +5,8 @@ import javax.validation.constraints.NotNull;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 
 /**
  * CatBoost model, supports basic model application.
@@ -363,6 +365,56 @@ public class CatBoostModel implements AutoCloseable {
         return prediction;
     }
 
+    /**
+     * Apply model to a batch of objects stored in direct buffers. Buffers are used by the native library in place,
+     * so neither features nor predictions are copied. All buffers must be direct, use native byte order and are
+     * used from their beginning regardless of their positions.
+     *
+     * @param numericFeatures  Numeric features matrix of floats, feature count is inferred from buffer capacity.
+     * @param catFeatureHashes Categoric feature hashes matrix of ints computed by
+     *                         {@link #hashCategoricalFeature(String)}, feature count is inferred from buffer capacity.
+     * @param objectCount      Number of objects.
+     * @param columnMajor      If false matrices are row-major (features of an object are contiguous), otherwise
+     *                         matrices are column-major (values of a feature are contiguous).
+     * @param predictions      Buffer of doubles for model predictions, must have space for at least
+     *                         objectCount * {@link #getPredictionDimension()} values.
+     * @throws CatBoostError In case of error within native library.
+     */
+    public void predict(
+            final @Nullable ByteBuffer numericFeatures,
+            final @Nullable ByteBuffer catFeatureHashes,
+            final int objectCount,
+            final boolean columnMajor,
+            final @NotNull ByteBuffer predictions) throws CatBoostError {
+        if (numericFeatures == null && catFeatureHashes == null) {
+            throw new CatBoostError("both feature buffers are null");
+        }
+        checkDirectBuffer(numericFeatures, "numericFeatures");
+        checkDirectBuffer(catFeatureHashes, "catFeatureHashes");
+        checkDirectBuffer(predictions, "predictions");
+
+        NativeLib.handle().catBoostModelPredict(
+                handle,
+                numericFeatures,
+                catFeatureHashes,
+                objectCount,
+                columnMajor,
+                predictions);
+    }
+
+    private static void checkDirectBuffer(final @Nullable ByteBuffer buffer, final @NotNull String name)
+            throws CatBoostError {
+        if (buffer == null) {
+            return;
+        }
+        if (!buffer.isDirect()) {
+            throw new CatBoostError("`" + name + "` must be a direct buffer");
+        }
+        if (buffer.order() != ByteOrder.nativeOrder()) {
+            throw new CatBoostError("`" + name + "` must use native byte order");
+        }
+    }
+
     @Override
     protected void finalize() throws Throwable {
         try {
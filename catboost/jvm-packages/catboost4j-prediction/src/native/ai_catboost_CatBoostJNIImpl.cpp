@@ -635,5 +635,121 @@ JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict_
     Y_END_JNI_API_CALL();
 }
 
+template <typename T>
+static TArrayRef<T> GetDirectBufferArray(
+    JNIEnv* const jenv,
+    const jobject buffer,
+    const TStringBuf bufferName) {
+
+    if (jenv->IsSameObject(buffer, NULL) == JNI_TRUE) {
+        return {};
+    }
+
+    auto* const data = static_cast<T*>(jenv->GetDirectBufferAddress(buffer));
+    CB_ENSURE(data, "`" << bufferName << "` must be a direct buffer");
+    const auto capacity = jenv->GetDirectBufferCapacity(buffer);
+    CB_ENSURE(capacity >= 0, "failed to get `" << bufferName << "` capacity");
+    CB_ENSURE(
+        reinterpret_cast<size_t>(data) % alignof(T) == 0,
+        "`" << bufferName << "` is not aligned to " << alignof(T) << " bytes");
+
+    return MakeArrayRef(data, static_cast<size_t>(capacity) / sizeof(T));
+}
+
+static size_t GetDirectBufferMatrixColumnCount(
+    const size_t bufferSize,
+    const size_t documentCount,
+    const TStringBuf bufferName) {
+
+    CB_ENSURE(
+        bufferSize % documentCount == 0,
+        "`" << bufferName << "` size must be a multiple of document count: "
+        LabeledOutput(bufferSize, documentCount));
+    return bufferSize / documentCount;
+}
+
+JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict__JLjava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2IZLjava_nio_ByteBuffer_2
+  (JNIEnv* jenv, jclass, jlong jhandle, jobject jnumericFeatures, jobject jcatFeatures, jint jdocumentCount, jboolean jcolumnMajor, jobject jpredictions) {
+    Y_BEGIN_JNI_API_CALL();
+
+    const auto* const model = ToConstFullModelPtr(jhandle);
+    CB_ENSURE(model, "got nullptr model pointer");
+    CB_ENSURE(jdocumentCount >= 0, LabeledOutput(jdocumentCount));
+
+    const size_t documentCount = jdocumentCount;
+    if (documentCount == 0) {
+        return nullptr;
+    }
+
+    // buffers are used in place, features are not copied and predictions are written directly to the
+    // caller's buffer
+    const auto numericFeatures = GetDirectBufferArray<const float>(jenv, jnumericFeatures, "numericFeatures");
+    const auto catFeatures = GetDirectBufferArray<const int>(jenv, jcatFeatures, "catFeatureHashes");
+    const auto predictions = GetDirectBufferArray<double>(jenv, jpredictions, "predictions");
+
+    const size_t modelPredictionSize = model->GetDimensionsCount();
+    const size_t minNumericFeatureCount = model->GetNumFloatFeatures();
+    const size_t minCatFeatureCount = model->GetNumCatFeatures();
+    const size_t numericFeatureCount = GetDirectBufferMatrixColumnCount(
+        numericFeatures.size(),
+        documentCount,
+        "numericFeatures");
+    const size_t catFeatureCount = GetDirectBufferMatrixColumnCount(
+        catFeatures.size(),
+        documentCount,
+        "catFeatureHashes");
+
+    CB_ENSURE(
+        numericFeatureCount >= minNumericFeatureCount,
+        LabeledOutput(numericFeatureCount, minNumericFeatureCount));
+
+    CB_ENSURE(
+        catFeatureCount >= minCatFeatureCount,
+        LabeledOutput(catFeatureCount, minCatFeatureCount));
+
+    CB_ENSURE(
+        predictions.size() >= documentCount * modelPredictionSize,
+        "`predictions` size is insufficient, must be at least document count * model prediction dimension: "
+        LabeledOutput(predictions.size(), documentCount * modelPredictionSize));
+
+    const auto results = predictions.first(documentCount * modelPredictionSize);
+
+    if (jcolumnMajor == JNI_TRUE) {
+        // features are passed to the model as flat feature columns, cat feature hashes are reinterpreted
+        // as floats as `CalcFlatTransposed` expects
+        const auto& trees = *model->ObliviousTrees;
+        TVector<TConstArrayRef<float>> flatFeatureColumns(trees.GetFlatFeatureVectorExpectedSize());
+        for (const auto& floatFeature : trees.FloatFeatures) {
+            flatFeatureColumns[floatFeature.Position.FlatIndex] = numericFeatures.Slice(
+                floatFeature.Position.Index * documentCount,
+                documentCount);
+        }
+        for (const auto& catFeature : trees.CatFeatures) {
+            flatFeatureColumns[catFeature.Position.FlatIndex] = MakeArrayRef(
+                reinterpret_cast<const float*>(catFeatures.data() + catFeature.Position.Index * documentCount),
+                documentCount);
+        }
+        model->CalcFlatTransposed(flatFeatureColumns, 0, model->GetTreeCount(), results);
+    } else {
+        TVector<TConstArrayRef<float>> numericFeatureMatrixRows;
+        TVector<TConstArrayRef<int>> catFeatureMatrixRows;
+        if (numericFeatureCount) {
+            numericFeatureMatrixRows.reserve(documentCount);
+            for (size_t i = 0; i < documentCount; ++i) {
+                numericFeatureMatrixRows.push_back(numericFeatures.Slice(i * numericFeatureCount, numericFeatureCount));
+            }
+        }
+        if (catFeatureCount) {
+            catFeatureMatrixRows.reserve(documentCount);
+            for (size_t i = 0; i < documentCount; ++i) {
+                catFeatureMatrixRows.push_back(catFeatures.Slice(i * catFeatureCount, catFeatureCount));
+            }
+        }
+        model->Calc(numericFeatureMatrixRows, catFeatureMatrixRows, results);
+    }
+
+    Y_END_JNI_API_CALL();
+}
+
 #undef Y_BEGIN_JNI_API_CALL
 #undef Y_END_JNI_API_CALL
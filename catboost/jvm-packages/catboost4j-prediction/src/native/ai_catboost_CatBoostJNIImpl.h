@@ -121,6 +121,14 @@ JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict_
 JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict__J_3_3F_3_3I_3D
   (JNIEnv *, jclass, jlong, jobjectArray, jobjectArray, jdoubleArray);
 
+/*
+ * Class:     ai_catboost_CatBoostJNIImpl
+ * Method:    catBoostModelPredict
+ * Signature: (JLjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;IZLjava/nio/ByteBuffer;)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_ai_catboost_CatBoostJNIImpl_catBoostModelPredict__JLjava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2IZLjava_nio_ByteBuffer_2
+  (JNIEnv *, jclass, jlong, jobject, jobject, jint, jboolean, jobject);
+
 #ifdef __cplusplus
 }
 #endif
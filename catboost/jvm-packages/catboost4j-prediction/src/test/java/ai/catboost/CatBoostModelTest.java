@@ -6,6 +6,9 @@ import org.junit.Test;
 
 import javax.validation.constraints.NotNull;
 import java.io.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
 
 import static org.junit.Assert.fail;
 
@@ -844,4 +847,78 @@ public class CatBoostModelTest {
             }
         }
     }
+
+    static ByteBuffer allocateDirectBuffer(final int size) {
+        return ByteBuffer.allocateDirect(size).order(ByteOrder.nativeOrder());
+    }
+
+    @Test
+    public void testSuccessfulPredictMultipleHashesFromDirectBuffers() throws CatBoostError {
+        try(final CatBoostModel model = loadTestModel()) {
+            final float[][] numericFeatures = new float[][]{
+                    {0.5f, 1.5f},
+                    {0.7f, 6.4f},
+                    {-2.0f, -1.0f}};
+            final int[][] catFeatures = new int[][]{
+                    {-805065478, 2136526169, 785836961},
+                    {1982436109, 1400211492, 1076941191},
+                    {-1883343840, -1452597217, 2122455585}};
+            final double[] expected = new double[]{
+                    0.04666924366060905,
+                    0.026244613740247648,
+                    0.03094452158737013};
+
+            for (final boolean columnMajor : new boolean[]{false, true}) {
+                final ByteBuffer numericBuffer = allocateDirectBuffer(3 * 2 * Float.BYTES);
+                final ByteBuffer catBuffer = allocateDirectBuffer(3 * 3 * Integer.BYTES);
+                for (int objectIndex = 0; objectIndex < 3; ++objectIndex) {
+                    for (int featureIndex = 0; featureIndex < 2; ++featureIndex) {
+                        final int index = columnMajor ? featureIndex * 3 + objectIndex : objectIndex * 2 + featureIndex;
+                        numericBuffer.putFloat(index * Float.BYTES, numericFeatures[objectIndex][featureIndex]);
+                    }
+                    for (int featureIndex = 0; featureIndex < 3; ++featureIndex) {
+                        final int index = columnMajor ? featureIndex * 3 + objectIndex : objectIndex * 3 + featureIndex;
+                        catBuffer.putInt(index * Integer.BYTES, catFeatures[objectIndex][featureIndex]);
+                    }
+                }
+
+                final ByteBuffer predictionBuffer = allocateDirectBuffer(3 * Double.BYTES);
+                model.predict(numericBuffer, catBuffer, 3, columnMajor, predictionBuffer);
+
+                final DoubleBuffer predictions = predictionBuffer.asDoubleBuffer();
+                for (int objectIndex = 0; objectIndex < 3; ++objectIndex) {
+                    TestCase.assertEquals(
+                            "at objectIndex=" + String.valueOf(objectIndex) + " columnMajor=" + String.valueOf(columnMajor),
+                            expected[objectIndex],
+                            predictions.get(objectIndex));
+                }
+            }
+        }
+    }
+
+    @Test
+    public void testFailPredictMultipleFromNonDirectBuffer() throws CatBoostError {
+        try(final CatBoostModel model = loadTestModel()) {
+            try {
+                final ByteBuffer numericBuffer = ByteBuffer.allocate(3 * 2 * Float.BYTES).order(ByteOrder.nativeOrder());
+                final ByteBuffer catBuffer = allocateDirectBuffer(3 * 3 * Integer.BYTES);
+                model.predict(numericBuffer, catBuffer, 3, false, allocateDirectBuffer(3 * Double.BYTES));
+                fail();
+            } catch (CatBoostError e) {
+            }
+        }
+    }
+
+    @Test
+    public void testFailPredictMultipleFromDirectBuffersInsufficientPredictionSize() throws CatBoostError {
+        try(final CatBoostModel model = loadTestModel()) {
+            try {
+                final ByteBuffer numericBuffer = allocateDirectBuffer(3 * 2 * Float.BYTES);
+                final ByteBuffer catBuffer = allocateDirectBuffer(3 * 3 * Integer.BYTES);
+                model.predict(numericBuffer, catBuffer, 3, false, allocateDirectBuffer(2 * Double.BYTES));
+                fail();
+            } catch (CatBoostError e) {
+            }
+        }
+    }
 }
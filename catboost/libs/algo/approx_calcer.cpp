@@ -19,6 +19,7 @@
 #include <catboost/libs/options/catboost_options.h>
 #include <catboost/libs/options/enum_helpers.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/ymath.h>
@@ -1025,6 +1026,8 @@ void CalcLeafValues(
     TVector<TVector<double>>* leafDeltas,
     TVector<TIndexType>* indices
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcLeafValues");
+
     *indices = BuildIndices(fold, tree, data.Learn, data.Test, ctx->LocalExecutor);
     const int approxDimension = ctx->LearnProgress->AveragingFold.GetApproxDimension();
     Y_VERIFY(fold.GetLearnSampleCount() == data.Learn->GetObjectCount());
@@ -1052,6 +1055,8 @@ void CalcApproxForLeafStruct(
     TLearnContext* ctx,
     TVector<TVector<TVector<double>>>* approxesDelta // [bodyTailId][approxDim][docIdxInPermuted]
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcApproxForLeafStruct");
+
     const TVector<TIndexType> indices = BuildIndices(fold, tree, data.Learn, data.Test, ctx->LocalExecutor);
     const int approxDimension = ctx->LearnProgress->ApproxDimension;
     const int leafCount = tree.GetLeafCount();
@@ -108,6 +108,8 @@ namespace NCB {
 
                 quantizationOptions.ExclusiveFeaturesBundlingOptions.MaxBuckets
                     = params->ObliviousTreeOptions->DevExclusiveFeaturesBundleMaxBuckets.Get();
+                quantizationOptions.ExclusiveFeaturesBundlingOptions.ConflictsSampleSize
+                    = params->ObliviousTreeOptions->DevExclusiveFeaturesBundleConflictsSampleSize.Get();
                 quantizationOptions.ExclusiveFeaturesBundlingOptions.MaxConflictFraction
                     = params->ObliviousTreeOptions->SparseFeaturesConflictFraction.Get();
             } else {
@@ -8,6 +8,7 @@
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/restorable_rng.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/cast.h>
@@ -106,6 +107,8 @@ TFold TFold::BuildDynamicFold(
     TRestorableFastRng64* rand,
     NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("TFold::BuildDynamicFold");
+
     const ui32 learnSampleCount = learnData.GetObjectCount();
 
     TFold ff;
@@ -214,6 +217,8 @@ TFold TFold::BuildPlainFold(
     TRestorableFastRng64* rand,
     NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("TFold::BuildPlainFold");
+
     const ui32 learnSampleCount = learnData.GetObjectCount();
 
     TFold ff;
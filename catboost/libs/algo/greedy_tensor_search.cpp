@@ -18,6 +18,7 @@
 #include <catboost/libs/helpers/parallel_tasks.h>
 #include <catboost/libs/logging/profile_info.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/fast_log/fast_log.h>
 
 #include <util/generic/cast.h>
@@ -539,6 +540,8 @@ static void CalcBestScore(
     TFold* fold,
     TLearnContext* ctx) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcBestScore");
+
     const TFlatPairsInfo pairs = UnpackPairsFromQueries(fold->LearnQueriesInfo);
     TCandidateList& candList = candidatesContext->CandidateList;
     const auto& monotonicConstraints = ctx->Params.ObliviousTreeOptions->MonotoneConstraints.Get();
@@ -622,6 +625,8 @@ void GreedyTensorSearch(
     TLearnContext* ctx,
     TSplitTree* resSplitTree) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("GreedyTensorSearch");
+
     TSplitTree currentSplitTree;
     TrimOnlineCTRcache({fold});
 
@@ -648,6 +653,10 @@ void GreedyTensorSearch(
     const bool isPairwiseScoring = IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction());
 
     for (ui32 curDepth = 0; curDepth < ctx->Params.ObliviousTreeOptions->MaxDepth; ++curDepth) {
+        NChromiumTrace::TEventArgs depthTraceArgs;
+        depthTraceArgs.Add(AsStringBuf("depth"), i64(curDepth));
+        CHROMIUM_TRACE_COMPLETE_W_ARGS(AsStringBuf("Depth"), AsStringBuf("train"), &depthTraceArgs);
+
         TCandidatesContext candidatesContext;
         candidatesContext.OneHotMaxSize = ctx->Params.CatFeatureParams->OneHotMaxSize;
         candidatesContext.BundlesMetaData = data.Learn->ObjectsData->GetExclusiveFeatureBundlesMetaData();
@@ -6,8 +6,11 @@
 #include <catboost/libs/distributed/master.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/malloc/api/malloc.h>
 
+#include <util/generic/xrange.h>
+
 #include <functional>
 
 
@@ -121,6 +124,8 @@ void CalcErrors(
     bool calcErrorTrackerMetric,
     TLearnContext* ctx
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcErrors");
+
     if (trainingDataProviders.Learn->GetObjectCount() > 0) {
         ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
         if (calcAllMetrics) {
@@ -134,24 +139,32 @@ void CalcErrors(
                 auto queryInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
 
                 TVector<bool> skipMetricOnTrain = GetSkipMetricOnTrain(errors);
+                TVector<const IMetric*> learnMetrics;
+                TVector<TConstArrayRef<float>> learnMetricsTargets;
                 for (int i = 0; i < errors.ysize(); ++i) {
                     if (!skipMetricOnTrain[i]) {
+                        learnMetrics.push_back(errors[i].Get());
                         //TODO(isaf27): will be removed after MLTOOLS-3572
-                        const auto& currentTarget = IsTargetBinarizationNeeded(errors[i]->GetDescription()) ? targetForLoss : target;
-                        const auto& additiveStats = EvalErrors(
-                            ctx->LearnProgress->AvrgApprox,
-                            currentTarget,
-                            weights,
-                            queryInfo,
-                            *errors[i],
-                            ctx->LocalExecutor
-                        );
-                        ctx->LearnProgress->MetricsAndTimeHistory.AddLearnError(
-                            *errors[i].Get(),
-                            errors[i]->GetFinalError(additiveStats)
+                        learnMetricsTargets.push_back(
+                            IsTargetBinarizationNeeded(errors[i]->GetDescription()) ? targetForLoss : target
                         );
                     }
                 }
+                const auto additiveStats = EvalErrors(
+                    ctx->LearnProgress->AvrgApprox,
+                    learnMetricsTargets,
+                    weights,
+                    queryInfo,
+                    learnMetrics,
+                    ctx->LocalExecutor
+                );
+                for (auto i : xrange(learnMetrics.size())) {
+                    ctx->LearnProgress->MetricsAndTimeHistory.AddLearnError(
+                        *learnMetrics[i],
+                        learnMetrics[i]->GetFinalError(additiveStats[i]),
+                        GetMetricErrorBound(*learnMetrics[i], additiveStats[i])
+                    );
+                }
             } else {
                 MapCalcErrors(ctx);
             }
@@ -180,7 +193,9 @@ void CalcErrors(
             auto weights = GetWeights(*targetData);
             auto queryInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());;
 
-            const auto& testApprox = ctx->LearnProgress->TestApprox[testIdx];
+            TVector<int> testMetricIndices;
+            TVector<const IMetric*> testMetrics;
+            TVector<TConstArrayRef<float>> testMetricsTargets;
             for (int i = 0; i < errors.ysize(); ++i) {
                 if (!calcAllMetrics && (i != errorTrackerMetricIdx)) {
                     continue;
@@ -188,24 +203,30 @@ void CalcErrors(
                 if (!maybeTarget && errors[i]->NeedTarget()) {
                     continue;
                 }
-
+                testMetricIndices.push_back(i);
+                testMetrics.push_back(errors[i].Get());
                 //TODO(isaf27): will be removed after MLTOOLS-3572
-                const auto& currentTarget = IsTargetBinarizationNeeded(errors[i]->GetDescription()) ? targetForLoss : target;
-
-                const auto& additiveStats = EvalErrors(
-                    testApprox,
-                    currentTarget,
-                    weights,
-                    queryInfo,
-                    *errors[i],
-                    ctx->LocalExecutor
+                testMetricsTargets.push_back(
+                    IsTargetBinarizationNeeded(errors[i]->GetDescription()) ? targetForLoss : target
                 );
-                bool updateBestIteration = (i == 0) && (testIdx == trainingDataProviders.Test.size() - 1);
+            }
+
+            const auto additiveStats = EvalErrors(
+                ctx->LearnProgress->TestApprox[testIdx],
+                testMetricsTargets,
+                weights,
+                queryInfo,
+                testMetrics,
+                ctx->LocalExecutor
+            );
+            for (auto j : xrange(testMetrics.size())) {
+                bool updateBestIteration = (testMetricIndices[j] == 0) && (testIdx == trainingDataProviders.Test.size() - 1);
                 ctx->LearnProgress->MetricsAndTimeHistory.AddTestError(
                     testIdx,
-                    *errors[i].Get(),
-                    errors[i]->GetFinalError(additiveStats),
-                    updateBestIteration
+                    *testMetrics[j],
+                    testMetrics[j]->GetFinalError(additiveStats[j]),
+                    updateBestIteration,
+                    GetMetricErrorBound(*testMetrics[j], additiveStats[j])
                 );
             }
         }
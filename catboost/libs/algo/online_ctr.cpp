@@ -13,6 +13,7 @@
 #include <catboost/libs/model/ctr_value_table.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/bitops.h>
@@ -372,6 +373,8 @@ void ComputeOnlineCTRs(
     const TLearnContext* ctx,
     TOnlineCTR* dst) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("ComputeOnlineCTRs");
+
     const TCtrHelper& ctrHelper = ctx->CtrsHelper;
     const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
     dst->Feature.resize(ctrInfo.size());
@@ -775,6 +778,8 @@ void CalcFinalCtrsAndSaveToModel(
     std::function<void(TCtrValueTable&& table)>&& asyncCtrValueTableCallback,
     NPar::TLocalExecutor* localExecutor) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcFinalCtrsAndSaveToModel");
+
     CATBOOST_DEBUG_LOG << "Started parallel calculation of " << usedCtrBases.size() << " unique ctrs" << Endl;
 
     TMaybe<TFeaturesArraySubsetIndexing> permutedLearnFeaturesSubsetIndexing;
@@ -17,6 +17,7 @@
 #include <catboost/libs/options/catboost_options.h>
 #include <catboost/libs/options/defaults_helper.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 #include <library/dot_product/dot_product.h>
 
@@ -1161,6 +1162,8 @@ void CalcStatsAndScores(
     TPairwiseStats* pairwiseStats,
     TVector<TScoreBin>* scoreBins
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcStatsAndScores");
+
     CB_ENSURE(
         stats3d || pairwiseStats || scoreBins,
         "stats3d, pairwiseStats, and scoreBins are empty - nothing to calculate"
@@ -7,6 +7,7 @@
 #include <catboost/libs/helpers/restorable_rng.h>
 #include <catboost/libs/options/catboost_options.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/maybe.h>
@@ -354,6 +355,8 @@ void Bootstrap(
     NPar::TLocalExecutor* localExecutor,
     TRestorableFastRng64* rand
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("Bootstrap");
+
     const int learnSampleCount = indices.ysize();
     const EBootstrapType bootstrapType = params.ObliviousTreeOptions->BootstrapConfig->GetBootstrapType();
     const EBoostingType boostingType = params.BoostingOptions->BoostingType;
@@ -413,6 +416,8 @@ void CalcWeightedDerivatives(
     TFold* takenFold,
     NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcWeightedDerivatives");
+
     TFold::TBodyTail& bt = takenFold->BodyTailArr[bodyTailIdx];
     const TVector<TVector<double>>& approx = bt.Approx;
     const TVector<float>& target = takenFold->LearnTarget;
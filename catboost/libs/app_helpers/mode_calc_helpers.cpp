@@ -5,15 +5,23 @@
 #include <catboost/libs/algo/apply.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/eval_result/binary_eval_result.h>
 #include <catboost/libs/eval_result/eval_result.h>
 #include <catboost/libs/labels/label_helper_builder.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/chromium_trace/interface.h>
+#include <library/threading/future/async.h>
+
 #include <util/string/cast.h>
 #include <util/string/split.h>
 
+#include <util/generic/deque.h>
+#include <util/generic/maybe.h>
 #include <util/generic/utility.h>
 #include <util/generic/xrange.h>
+#include <util/system/hp_timer.h>
+#include <util/thread/pool.h>
 
 
 void NCB::PrepareCalcModeParamsParser(
@@ -52,6 +60,14 @@ void NCB::PrepareCalcModeParamsParser(
         });
     parser.AddLongOption("eval-period", "predictions are evaluated every <eval-period> trees")
         .StoreResult(&evalPeriod);
+    parser.AddLongOption("output-float-type", "[for binary and columnar output] Float32 or Float64 (default)")
+        .RequiredArgument("TYPE")
+        .Handler1T<TString>([&](const TString& floatType) {
+            params.OutputFloatType = FromString<EEvalOutputFloatType>(floatType);
+        });
+    parser.AddLongOption("trace-file", "file to write Chrome trace (chrome://tracing) of read, apply and write stages")
+        .RequiredArgument("file")
+        .StoreResult(&params.TraceFilePath);
     parser.SetFreeArgsNum(0);
 }
 
@@ -88,6 +104,28 @@ void NCB::ReadModelAndUpdateParams(
     }
 }
 
+namespace {
+    // per-stage throughput of block processing in CalcModelSingleHost
+    struct TStageStatistics {
+        ui64 ObjectCount = 0;
+        double Time = 0.0;
+
+        void Add(ui64 objectCount, double time) {
+            ObjectCount += objectCount;
+            Time += time;
+        }
+
+        void Log(TStringBuf stageName) const {
+            CATBOOST_INFO_LOG << stageName << ": " << ObjectCount << " objects in "
+                << FloatToString(Time, PREC_NDIGITS, 3) << " sec";
+            if (Time > 0.0) {
+                CATBOOST_INFO_LOG << " (" << FloatToString(ObjectCount / Time, PREC_NDIGITS, 6) << " objects/sec)";
+            }
+            CATBOOST_INFO_LOG << Endl;
+        }
+    };
+}
+
 static NCB::TEvalResult Apply(
     const TFullModel& model,
     const NCB::TDataProvider& dataset,
@@ -134,12 +172,27 @@ void NCB::CalcModelSingleHost(
     size_t evalPeriod,
     TFullModel&& model) {
 
-    CB_ENSURE(params.OutputPath.Scheme == "dsv" || params.OutputPath.Scheme == "stream", "Local model evaluation supports only \"dsv\"  and \"stream\" output file schemas.");
+    CB_ENSURE(
+        params.OutputPath.Scheme == "dsv" || params.OutputPath.Scheme == "stream" || IsBinaryEvalResultScheme(params.OutputPath.Scheme),
+        "Local model evaluation supports only \"dsv\", \"stream\", \"binary\" and \"columnar\" output file schemas."
+    );
     NCatboostOptions::ValidatePoolParams(params.InputPath, params.DsvPoolFormatParams);
 
-    TSetLogging logging(params.OutputPath.Scheme == "dsv" ? ELoggingLevel::Info : ELoggingLevel::Silent);
+    THolder<NChromiumTrace::TGlobalJsonFileSink> traceSink;
+    if (params.TraceFilePath) {
+        traceSink = MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(params.TraceFilePath);
+    }
+
+    TSetLogging logging(params.OutputPath.Scheme != "stream" ? ELoggingLevel::Info : ELoggingLevel::Silent);
     THolder<IOutputStream> outputStream;
-    if (params.OutputPath.Scheme == "dsv") {
+    THolder<TBinaryEvalResultWriter> binaryOutput;
+    if (IsBinaryEvalResultScheme(params.OutputPath.Scheme)) {
+        binaryOutput = MakeHolder<TBinaryEvalResultWriter>(
+            params.OutputPath,
+            params.OutputFloatType,
+            params.OutputColumnsIds
+        );
+    } else if (params.OutputPath.Scheme == "dsv") {
          outputStream = MakeHolder<TOFStream>(params.OutputPath.Path);
     } else {
         CB_ENSURE(params.OutputPath.Path == "stdout" || params.OutputPath.Path == "stderr", "Local model evaluation supports only stderr and stdout paths.");
@@ -161,32 +214,111 @@ void NCB::CalcModelSingleHost(
         32,
         static_cast<int>(10000. / (static_cast<double>(iterationsLimit) / evalPeriod) / model.GetDimensionsCount())
     );
+    const auto visibleLabelsHelper = BuildLabelsHelper<TExternalLabelsHelper>(model);
+
+    /* Blocks go through a pipeline of three stages: the pool is read in this thread,
+     *  the model is applied in applyQueue and results are written in writeQueue,
+     *  so block k + 1 is read while block k is applied and block k - 1 is written.
+     * Each queue has a single thread, so blocks are applied and written in the reading order.
+     * At most maxBlocksInFlight read blocks are waiting to be written, which bounds memory usage.
+     */
+    const size_t maxBlocksInFlight = 2;
+
+    TStageStatistics readStatistics;
+    TStageStatistics applyStatistics;
+    TStageStatistics writeStatistics;
+    THPTimer totalTimer;
+
+    // logging level is process-wide, so it is set once for all the stages instead of inside the stage threads
+    TMaybe<TSetLoggingSilent> silentPipeline;
+    silentPipeline.ConstructInPlace();
+
+    // declared after all the data used by the stages so that the queues are stopped first
+    TDeque<NThreading::TFuture<void>> blocksInFlight;
+    TThreadPool applyQueue;
+    applyQueue.Start(1);
+    TThreadPool writeQueue;
+    writeQueue.Start(1);
+
+    THPTimer readTimer;
     ReadAndProceedPoolInBlocks(params, blockSize, [&](const NCB::TDataProviderPtr datasetPart) {
+        const ui64 blockObjectCount = datasetPart->ObjectsGrouping->GetObjectCount();
+        readStatistics.Add(blockObjectCount, readTimer.Passed());
+
         if (IsFirstBlock) {
             ValidateColumnOutput(params.OutputColumnsIds, *datasetPart);
         }
-        auto approx = Apply(model, *datasetPart, 0, iterationsLimit, evalPeriod, &executor);
-        auto visibleLabelsHelper = BuildLabelsHelper<TExternalLabelsHelper>(model);
-
-        poolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
-
-        TSetLoggingSilent inThisScope;
-        OutputEvalResultToFile(
-            approx,
-            &executor,
-            params.OutputColumnsIds,
-            visibleLabelsHelper,
-            *datasetPart,
-            outputStream.Get(),
-            // TODO: src file columns output is incompatible with block processing
-            poolColumnsPrinter,
-            /*testFileWhichOf*/ {0, 0},
-            IsFirstBlock,
-            docIdOffset,
-            std::make_pair(evalPeriod, iterationsLimit)
+
+        auto approxFuture = NThreading::Async(
+            [&, datasetPart, blockObjectCount] () {
+                CHROMIUM_TRACE_SCOPE("Apply block");
+                THPTimer applyTimer;
+                auto approx = Apply(model, *datasetPart, 0, iterationsLimit, evalPeriod, &executor);
+                applyStatistics.Add(blockObjectCount, applyTimer.Passed());
+                return approx;
+            },
+            applyQueue
+        );
+        blocksInFlight.push_back(
+            NThreading::Async(
+                [&, datasetPart, blockObjectCount, approxFuture, isFirstBlock = IsFirstBlock, docIdOffset] () {
+                    const auto& approx = approxFuture.GetValueSync();
+
+                    CHROMIUM_TRACE_SCOPE("Write block");
+                    THPTimer writeTimer;
+                    if (binaryOutput) {
+                        binaryOutput->Append(
+                            approx,
+                            visibleLabelsHelper,
+                            std::make_pair(evalPeriod, iterationsLimit),
+                            &executor
+                        );
+                        writeStatistics.Add(blockObjectCount, writeTimer.Passed());
+                        return;
+                    }
+                    poolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
+
+                    OutputEvalResultToFile(
+                        approx,
+                        &executor,
+                        params.OutputColumnsIds,
+                        visibleLabelsHelper,
+                        *datasetPart,
+                        outputStream.Get(),
+                        // TODO: src file columns output is incompatible with block processing
+                        poolColumnsPrinter,
+                        /*testFileWhichOf*/ {0, 0},
+                        isFirstBlock,
+                        docIdOffset,
+                        std::make_pair(evalPeriod, iterationsLimit)
+                    );
+                    writeStatistics.Add(blockObjectCount, writeTimer.Passed());
+                },
+                writeQueue
+            )
         );
-        docIdOffset += datasetPart->ObjectsGrouping->GetObjectCount();
+        docIdOffset += blockObjectCount;
         IsFirstBlock = false;
+
+        while (blocksInFlight.size() > maxBlocksInFlight) {
+            blocksInFlight.front().GetValueSync(); // rethrows exceptions from the apply and write stages
+            blocksInFlight.pop_front();
+        }
+        readTimer.Reset();
     }, &executor);
-}
 
+    for (; !blocksInFlight.empty(); blocksInFlight.pop_front()) {
+        blocksInFlight.front().GetValueSync();
+    }
+    if (binaryOutput) {
+        binaryOutput->Finish(params.ClassNames);
+    }
+    silentPipeline.Clear();
+
+    const double totalTime = totalTimer.Passed();
+    CATBOOST_INFO_LOG << "Processed " << docIdOffset << " objects in " << FloatToString(totalTime, PREC_NDIGITS, 3)
+        << " sec" << Endl;
+    readStatistics.Log("Read");
+    applyStatistics.Log("Apply");
+    writeStatistics.Log("Write");
+}
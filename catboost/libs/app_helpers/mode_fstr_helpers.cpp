@@ -2,6 +2,7 @@
 
 #include <catboost/libs/data_new/load_data.h>
 #include <catboost/libs/fstr/output_fstr.h>
+#include <catboost/libs/fstr/shap_interaction_values.h>
 #include <catboost/libs/fstr/shap_values.h>
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/helpers/exception.h>
@@ -142,6 +143,13 @@ void NCB::ModeFstrSingleHost(const NCB::TAnalyticalModeCommonParams& params) {
                                     EPreCalcShapValues::Auto,
                                     localExecutor.Get());
             break;
+        case EFstrType::ShapInteractionValues:
+            CalcAndOutputShapInteractionValues(model,
+                                               *poolLoader(),
+                                               params.OutputPath.Path,
+                                               params.Verbose,
+                                               localExecutor.Get());
+            break;
         default:
             Y_ASSERT(false);
     }
@@ -1,8 +1,14 @@
 #include "cat_feature.h"
+#include "cat_feature_hash_cache.h"
 
 #include <util/digest/city.h>
 #include <util/generic/strbuf.h>
+#include <util/thread/singleton.h>
 
 ui32 CalcCatFeatureHash(const TStringBuf feature) noexcept {
     return CityHash64(feature) & 0xffffffff;
 }
+
+ui32 CalcCatFeatureHashCached(const TStringBuf feature) {
+    return FastTlsSingleton<TCatFeatureHashCache>()->Calc(feature);
+}
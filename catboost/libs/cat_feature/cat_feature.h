@@ -5,6 +5,11 @@
 
 ui32 CalcCatFeatureHash(const TStringBuf feature) noexcept;
 
+/* Same as CalcCatFeatureHash but uses a thread-local cache of hashes of short strings,
+ * useful when values come one by one (like in prediction and C API calls)
+ */
+ui32 CalcCatFeatureHashCached(const TStringBuf feature);
+
 // deprecated, for compatibility, prefer CalcCatFeatureHash in new code
 inline int CalcCatFeatureHashInt(const TStringBuf feature) noexcept {
     ui32 hashVal = CalcCatFeatureHash(feature);
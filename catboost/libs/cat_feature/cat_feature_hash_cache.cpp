@@ -0,0 +1,44 @@
+#include "cat_feature_hash_cache.h"
+
+#include <util/digest/numeric.h>
+
+#include <cstring>
+
+TCatFeatureHashCache::TCatFeatureHashCache(ui32 sizeLog2)
+    : Entries(size_t(1) << sizeLog2)
+    , Mask((ui64(1) << sizeLog2) - 1)
+{
+}
+
+// Much cheaper than CalcCatFeatureHash, used only to choose entry in the cache
+static inline ui64 CalcCacheSlotHash(const TStringBuf feature) noexcept {
+    ui64 head = 0;
+    ui64 tail = 0;
+    const size_t size = feature.size();
+    if (size >= sizeof(ui64)) {
+        std::memcpy(&head, feature.data(), sizeof(ui64));
+        std::memcpy(&tail, feature.data() + size - sizeof(ui64), sizeof(ui64));
+    } else {
+        std::memcpy(&head, feature.data(), size);
+    }
+    return IntHash(head ^ (tail * 0x9E3779B97F4A7C15ULL) ^ size);
+}
+
+ui32 TCatFeatureHashCache::Calc(const TStringBuf feature, bool* isCached) noexcept {
+    if (feature.size() > MaxCachedSize) {
+        *isCached = false;
+        return CalcCatFeatureHash(feature);
+    }
+
+    TEntry& entry = Entries[CalcCacheSlotHash(feature) & Mask];
+    if ((entry.Size == feature.size()) && !std::memcmp(entry.Data, feature.data(), feature.size())) {
+        *isCached = true;
+        return entry.Hash;
+    }
+
+    *isCached = false;
+    entry.Hash = CalcCatFeatureHash(feature);
+    entry.Size = (ui8)feature.size();
+    std::memcpy(entry.Data, feature.data(), feature.size());
+    return entry.Hash;
+}
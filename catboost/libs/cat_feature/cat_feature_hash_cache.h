@@ -0,0 +1,67 @@
+#pragma once
+
+#include "cat_feature.h"
+
+#include <util/generic/array_ref.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ylimits.h>
+#include <util/system/types.h>
+#include <util/system/yassert.h>
+
+// not a part of cat_feature.h interface, used internally by data loading and CalcCatFeatureHashCached
+
+/* Direct-mapped cache of CalcCatFeatureHash results for short strings.
+ *
+ * Categorical values usually have heavily skewed distribution, so keeping one cache per column (and
+ * per thread, cache is not thread-safe) allows to skip hashing of most of the values. Strings longer
+ * than MaxCachedSize are not cached.
+ */
+class TCatFeatureHashCache {
+public:
+    static constexpr size_t MaxCachedSize = 27;
+    static constexpr size_t EntrySize = 32; // memory used by the cache is EntrySize << sizeLog2
+
+public:
+    explicit TCatFeatureHashCache(ui32 sizeLog2 = 10);
+
+    // isCached is set to true if value has been found in the cache
+    ui32 Calc(TStringBuf feature, bool* isCached) noexcept;
+
+    ui32 Calc(TStringBuf feature) noexcept {
+        bool isCached;
+        return Calc(feature, &isCached);
+    }
+
+private:
+    struct TEntry {
+        char Data[MaxCachedSize];
+        ui8 Size = Max<ui8>(); // Max<ui8>() for empty entry
+        ui32 Hash = 0;
+    };
+    static_assert(sizeof(TEntry) == EntrySize, "");
+
+private:
+    TVector<TEntry> Entries;
+    ui64 Mask;
+};
+
+// hashes[i] = CalcCatFeatureHash(features[i]), cache can be nullptr
+template <class TStringLike>
+void CalcCatFeatureHashes(
+    TConstArrayRef<TStringLike> features,
+    TCatFeatureHashCache* cache,
+    TArrayRef<ui32> hashes) noexcept {
+
+    Y_ASSERT(features.size() == hashes.size());
+    if (cache) {
+        for (auto i : xrange(features.size())) {
+            hashes[i] = cache->Calc(features[i]);
+        }
+    } else {
+        for (auto i : xrange(features.size())) {
+            hashes[i] = CalcCatFeatureHash(features[i]);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/cat_feature/cat_feature_hash_cache.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(TCatFeatureHashCache) {
+    Y_UNIT_TEST(TestSameAsCalcCatFeatureHash) {
+        const TVector<TString> values = {
+            "",
+            "a",
+            "bb",
+            "a",
+            "abcdefgh",
+            "abcdefghi",
+            "bb",
+            "012345678901234567890123456",
+            "0123456789012345678901234567", // longer than MaxCachedSize
+            "abcdefgh"
+        };
+
+        // small cache to check collisions too
+        TCatFeatureHashCache cache(/*sizeLog2*/ 1);
+        for (auto iteration : xrange(3)) {
+            Y_UNUSED(iteration);
+            for (const auto& value : values) {
+                UNIT_ASSERT_VALUES_EQUAL(cache.Calc(value), CalcCatFeatureHash(value));
+                UNIT_ASSERT_VALUES_EQUAL(CalcCatFeatureHashCached(value), CalcCatFeatureHash(value));
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestIsCached) {
+        TCatFeatureHashCache cache;
+        bool isCached;
+
+        cache.Calc("value", &isCached);
+        UNIT_ASSERT(!isCached);
+        cache.Calc("value", &isCached);
+        UNIT_ASSERT(isCached);
+
+        const TString longValue(TCatFeatureHashCache::MaxCachedSize + 1, 'a');
+        cache.Calc(longValue, &isCached);
+        UNIT_ASSERT(!isCached);
+        cache.Calc(longValue, &isCached);
+        UNIT_ASSERT(!isCached);
+    }
+
+    Y_UNIT_TEST(TestBatch) {
+        const TVector<TStringBuf> values = {"x", "y", "x", "zz", "y"};
+        TVector<ui32> hashes(values.size());
+        TVector<ui32> hashesWithCache(values.size());
+
+        CalcCatFeatureHashes<TStringBuf>(values, nullptr, hashes);
+        TCatFeatureHashCache cache;
+        CalcCatFeatureHashes<TStringBuf>(values, &cache, hashesWithCache);
+
+        for (auto i : xrange(values.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(hashes[i], CalcCatFeatureHash(values[i]));
+            UNIT_ASSERT_VALUES_EQUAL(hashesWithCache[i], hashes[i]);
+        }
+    }
+}
@@ -0,0 +1,600 @@
+#include "append.h"
+
+#include "cat_feature_perfect_hash_helper.h"
+#include "columns.h"
+#include "packed_binary_features.h"
+
+#include <catboost/libs/helpers/compression.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/resource_holder.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/utility.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+
+#include <climits>
+#include <functional>
+#include <utility>
+
+
+namespace NCB {
+
+    template <class T>
+    static TVector<T> Concatenate(TConstArrayRef<T> lhs, TConstArrayRef<T> rhs) {
+        TVector<T> result;
+        result.reserve(lhs.size() + rhs.size());
+        result.insert(result.end(), lhs.begin(), lhs.end());
+        result.insert(result.end(), rhs.begin(), rhs.end());
+        return result;
+    }
+
+    template <class T>
+    static TMaybeData<TVector<T>> ConcatenateIfDefined(
+        TMaybeData<TConstArrayRef<T>> lhs,
+        TMaybeData<TConstArrayRef<T>> rhs
+    ) {
+        if (!lhs) {
+            return Nothing();
+        }
+        return Concatenate(*lhs, *rhs);
+    }
+
+    static TWeights<float> ConcatenateWeights(
+        const TWeights<float>& lhs,
+        const TWeights<float>& rhs,
+        TStringBuf weightTypeName
+    ) {
+        const ui32 objectCount = lhs.GetSize() + rhs.GetSize();
+        if (lhs.IsTrivial() && rhs.IsTrivial()) {
+            return TWeights<float>(objectCount);
+        }
+        TVector<float> weights;
+        weights.yresize(objectCount);
+        for (auto i : xrange(lhs.GetSize())) {
+            weights[i] = lhs[i];
+        }
+        for (auto i : xrange(rhs.GetSize())) {
+            weights[lhs.GetSize() + i] = rhs[i];
+        }
+        return TWeights<float>(std::move(weights), weightTypeName, /*allWeightsCanBeZero*/ true);
+    }
+
+    static void CheckMetaInfoCompatibleForAppend(const TDataMetaInfo& dst, const TDataMetaInfo& appended) {
+        auto checkSameAvailability = [] (bool dstHasData, bool appendedHasData, TStringBuf dataName) {
+            CB_ENSURE(
+                dstHasData == appendedHasData,
+                "Appended data " << (appendedHasData ? "has " : "does not have ") << dataName
+                << " unlike existing data"
+            );
+        };
+        checkSameAvailability(dst.HasTarget, appended.HasTarget, "target");
+        checkSameAvailability(dst.HasGroupId, appended.HasGroupId, "group ids");
+        checkSameAvailability(dst.HasGroupWeight, appended.HasGroupWeight, "group weights");
+        checkSameAvailability(dst.HasSubgroupIds, appended.HasSubgroupIds, "subgroup ids");
+        checkSameAvailability(dst.HasWeights, appended.HasWeights, "weights");
+        checkSameAvailability(dst.HasTimestamp, appended.HasTimestamp, "timestamps");
+        checkSameAvailability(dst.HasPairs, appended.HasPairs, "pairs");
+        CB_ENSURE(
+            dst.BaselineCount == appended.BaselineCount,
+            "Appended data baseline count (" << appended.BaselineCount
+            << ") is not equal to existing data baseline count (" << dst.BaselineCount << ')'
+        );
+        CB_ENSURE(
+            dst.ClassNames.empty() || appended.ClassNames.empty() || (dst.ClassNames == appended.ClassNames),
+            "Appended data class names are different from existing data class names"
+        );
+    }
+
+    static TDataMetaInfo MergeMetaInfo(const TDataMetaInfo& dst, const TDataMetaInfo& appended) {
+        TDataMetaInfo result = dst;
+        result.ObjectCount = dst.ObjectCount + appended.ObjectCount;
+        result.MaxCatFeaturesUniqValuesOnLearn = Max(
+            dst.MaxCatFeaturesUniqValuesOnLearn,
+            appended.MaxCatFeaturesUniqValuesOnLearn
+        );
+        if (dst.TargetStats && appended.TargetStats) {
+            result.TargetStats->MinValue = Min(dst.TargetStats->MinValue, appended.TargetStats->MinValue);
+            result.TargetStats->MaxValue = Max(dst.TargetStats->MaxValue, appended.TargetStats->MaxValue);
+        } else {
+            result.TargetStats = Nothing();
+        }
+        if (result.ClassNames.empty()) {
+            result.ClassNames = appended.ClassNames;
+        }
+        return result;
+    }
+
+    static TRawTargetData ConcatenateRawTargetData(
+        const TRawTargetDataProvider& dst,
+        const TRawTargetDataProvider& appended
+    ) {
+        TRawTargetData result;
+        result.Target = ConcatenateIfDefined(dst.GetTarget(), appended.GetTarget());
+        if (const auto dstBaseline = dst.GetBaseline()) {
+            const auto appendedBaseline = *appended.GetBaseline();
+            for (auto approxIdx : xrange(dstBaseline->size())) {
+                result.Baseline.push_back(Concatenate((*dstBaseline)[approxIdx], appendedBaseline[approxIdx]));
+            }
+        }
+        result.Weights = ConcatenateWeights(dst.GetWeights(), appended.GetWeights(), "Weight");
+        result.GroupWeights = ConcatenateWeights(dst.GetGroupWeights(), appended.GetGroupWeights(), "GroupWeight");
+
+        const ui32 objectOffset = dst.GetObjectCount();
+        result.Pairs.assign(dst.GetPairs().begin(), dst.GetPairs().end());
+        for (const auto& pair : appended.GetPairs()) {
+            result.Pairs.emplace_back(pair.WinnerId + objectOffset, pair.LoserId + objectOffset, pair.Weight);
+        }
+        return result;
+    }
+
+    // appended values are converted to the same bitsPerKey as used in ExtractValues
+    template <class IColumnType>
+    static TCompressedArray ConcatenateColumnValues(
+        const IColumnType& dst,
+        const IColumnType& appended,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        using TValue = typename IColumnType::TValueType;
+
+        const auto dstValues = dst.ExtractValues(localExecutor);
+        const auto appendedValues = appended.ExtractValues(localExecutor);
+
+        TCompressedArray result = TCompressedArray::CreateWithUninitializedData(
+            (*dstValues).size() + (*appendedValues).size(),
+            sizeof(TValue) * CHAR_BIT
+        );
+        TArrayRef<TValue> resultValues = result.GetRawArray<TValue>();
+        Copy((*dstValues).begin(), (*dstValues).end(), resultValues.begin());
+        Copy((*appendedValues).begin(), (*appendedValues).end(), resultValues.begin() + (*dstValues).size());
+        return result;
+    }
+
+    // bundled categorical features must still fit in their bundle parts after perfect hashes' extension
+    static bool AreExclusiveFeatureBundlesValid(
+        TConstArrayRef<TExclusiveFeaturesBundle> bundles,
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo
+    ) {
+        for (const auto& bundle : bundles) {
+            for (const auto& part : bundle.Parts) {
+                if (part.FeatureType == EFeatureType::Categorical) {
+                    const ui32 binCount
+                        = quantizedFeaturesInfo.GetUniqueValuesCounts(TCatFeatureIdx(part.FeatureIdx)).OnAll;
+                    if (binCount > part.Bounds.GetSize() + 1) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+
+    class TAppendToQuantizedDataImpl {
+    public:
+        static TQuantizedDataProviderPtr Do(
+            const TQuantizationOptions& options,
+            TQuantizedDataProviderPtr quantizedDataProvider,
+            TRawDataProviderPtr rawDataProvider,
+            TRestorableFastRng64* rand,
+            NPar::TLocalExecutor* localExecutor
+        ) {
+            TQuantizedFeaturesInfoPtr quantizedFeaturesInfo
+                = quantizedDataProvider->ObjectsData->GetQuantizedFeaturesInfo();
+            const auto& featuresLayout = *quantizedFeaturesInfo->GetFeaturesLayout();
+
+            CB_ENSURE(
+                !featuresLayout.GetTextFeatureCount(),
+                "Appending to data with text features is not supported yet"
+            );
+            CheckMetaInfoCompatibleForAppend(quantizedDataProvider->MetaInfo, rawDataProvider->MetaInfo);
+
+            const auto* dstForCpuObjectsData = dynamic_cast<const TQuantizedForCPUObjectsDataProvider*>(
+                quantizedDataProvider->ObjectsData.Get()
+            );
+
+            TCatFeaturesPerfectHashHelper catFeaturesPerfectHashHelper(quantizedFeaturesInfo);
+
+            TVector<ui32> prevUniqueValuesCountsOnAll(featuresLayout.GetCatFeatureCount());
+            featuresLayout.IterateOverAvailableFeatures<EFeatureType::Categorical>(
+                [&] (TCatFeatureIdx catFeatureIdx) {
+                    prevUniqueValuesCountsOnAll[*catFeatureIdx]
+                        = catFeaturesPerfectHashHelper.GetUniqueValuesCountOnAll(catFeatureIdx);
+                }
+            );
+
+            // appended part is quantized to plain columns, bundles and packs are created for the result
+            TQuantizationOptions appendedPartOptions = options;
+            appendedPartOptions.CpuCompatibleFormat = true;
+            appendedPartOptions.GpuCompatibleFormat = false;
+            appendedPartOptions.BundleExclusiveFeaturesForCpu = false;
+            appendedPartOptions.PackBinaryFeaturesForCpu = false;
+
+            TQuantizedDataProviderPtr appendedPart = Quantize(
+                appendedPartOptions,
+                std::move(rawDataProvider),
+                quantizedFeaturesInfo,
+                rand,
+                localExecutor
+            );
+
+            // appended objects are learn data as well
+            featuresLayout.IterateOverAvailableFeatures<EFeatureType::Categorical>(
+                [&] (TCatFeatureIdx catFeatureIdx) {
+                    catFeaturesPerfectHashHelper.AddUniqueValuesOnLearn(
+                        catFeatureIdx,
+                        catFeaturesPerfectHashHelper.GetUniqueValuesCountOnAll(catFeatureIdx)
+                            - prevUniqueValuesCountsOnAll[*catFeatureIdx]
+                    );
+                }
+            );
+
+            const auto& dstObjectsData = *quantizedDataProvider->ObjectsData;
+            const auto& appendedObjectsData = *appendedPart->ObjectsData;
+
+            const ui32 objectCount = dstObjectsData.GetObjectCount() + appendedObjectsData.GetObjectCount();
+
+            TQuantizedForCPUBuilderData data;
+            data.MetaInfo = MergeMetaInfo(quantizedDataProvider->MetaInfo, appendedPart->MetaInfo);
+            data.MetaInfo.FeaturesLayout = quantizedDataProvider->MetaInfo.FeaturesLayout;
+            data.TargetData = ConcatenateRawTargetData(
+                quantizedDataProvider->RawTargetData,
+                appendedPart->RawTargetData
+            );
+            data.CommonObjectsData = ConcatenateCommonObjectsData(dstObjectsData, appendedObjectsData);
+
+            TVector<TMaybe<TCompressedArray>> floatFeaturesValues(featuresLayout.GetFloatFeatureCount());
+            TVector<TMaybe<TCompressedArray>> catFeaturesValues(featuresLayout.GetCatFeatureCount());
+            ConcatenateFeaturesValues<EFeatureType::Float>(
+                featuresLayout,
+                [&] (ui32 floatFeatureIdx) {
+                    return std::make_pair(
+                        *dstObjectsData.GetFloatFeature(floatFeatureIdx),
+                        *appendedObjectsData.GetFloatFeature(floatFeatureIdx)
+                    );
+                },
+                localExecutor,
+                &floatFeaturesValues
+            );
+            ConcatenateFeaturesValues<EFeatureType::Categorical>(
+                featuresLayout,
+                [&] (ui32 catFeatureIdx) {
+                    return std::make_pair(
+                        *dstObjectsData.GetCatFeature(catFeatureIdx),
+                        *appendedObjectsData.GetCatFeature(catFeatureIdx)
+                    );
+                },
+                localExecutor,
+                &catFeaturesValues
+            );
+
+            auto& objectsData = data.ObjectsData;
+            objectsData.Data.QuantizedFeaturesInfo = quantizedFeaturesInfo;
+            objectsData.Data.TextFeatures.resize(featuresLayout.GetTextFeatureCount());
+
+            TVector<TExclusiveFeaturesBundle> bundlesMetaData;
+            if (dstForCpuObjectsData) {
+                const auto dstBundlesMetaData = dstForCpuObjectsData->GetExclusiveFeatureBundlesMetaData();
+                if (AreExclusiveFeatureBundlesValid(dstBundlesMetaData, *quantizedFeaturesInfo)) {
+                    bundlesMetaData.assign(dstBundlesMetaData.begin(), dstBundlesMetaData.end());
+                }
+            }
+            objectsData.ExclusiveFeatureBundlesData = TExclusiveFeatureBundlesData(
+                *quantizedFeaturesInfo,
+                std::move(bundlesMetaData)
+            );
+            objectsData.PackedBinaryFeaturesData = TPackedBinaryFeaturesData(
+                *quantizedFeaturesInfo,
+                objectsData.ExclusiveFeatureBundlesData,
+                /*dontPack*/ !dstForCpuObjectsData || !options.PackBinaryFeaturesForCpu
+            );
+
+            auto getBinFunction = [&] (EFeatureType featureType, ui32 perTypeFeatureIdx) {
+                if (featureType == EFeatureType::Float) {
+                    const ui8* values = floatFeaturesValues[perTypeFeatureIdx]->GetRawArray<ui8>().data();
+                    return std::function<ui32(ui32)>([values] (ui32 idx) -> ui32 { return values[idx]; });
+                }
+                const ui32* values = catFeaturesValues[perTypeFeatureIdx]->GetRawArray<ui32>().data();
+                return std::function<ui32(ui32)>([values] (ui32 idx) -> ui32 { return values[idx]; });
+            };
+
+            MakeBundlesData(objectCount, getBinFunction, localExecutor, &objectsData.ExclusiveFeatureBundlesData);
+            MakePackedBinaryFeaturesData(
+                objectCount,
+                getBinFunction,
+                localExecutor,
+                &objectsData.PackedBinaryFeaturesData
+            );
+
+            const auto* subsetIndexing = data.CommonObjectsData.SubsetIndexing.Get();
+            MakeColumns<EFeatureType::Float>(
+                featuresLayout,
+                objectsData.ExclusiveFeatureBundlesData,
+                objectsData.PackedBinaryFeaturesData,
+                subsetIndexing,
+                &floatFeaturesValues,
+                &objectsData.Data.FloatFeatures
+            );
+            MakeColumns<EFeatureType::Categorical>(
+                featuresLayout,
+                objectsData.ExclusiveFeatureBundlesData,
+                objectsData.PackedBinaryFeaturesData,
+                subsetIndexing,
+                &catFeaturesValues,
+                &objectsData.Data.CatFeatures
+            );
+
+            // if there are no group ids grouping is trivial, otherwise create it from group ids
+            TMaybe<TObjectsGroupingPtr> objectsGrouping;
+            if (!data.CommonObjectsData.GroupIds) {
+                objectsGrouping = MakeIntrusive<TObjectsGrouping>(objectCount);
+            }
+
+            if (dstForCpuObjectsData) {
+                return MakeDataProvider<TQuantizedForCPUObjectsDataProvider>(
+                    objectsGrouping,
+                    std::move(data),
+                    false,
+                    localExecutor
+                )->CastMoveTo<TQuantizedObjectsDataProvider>();
+            } else {
+                return MakeDataProvider<TQuantizedObjectsDataProvider>(
+                    objectsGrouping,
+                    CastToBase(std::move(data)),
+                    false,
+                    localExecutor
+                );
+            }
+        }
+
+    private:
+        static TCommonObjectsData ConcatenateCommonObjectsData(
+            const TObjectsDataProvider& dst,
+            const TObjectsDataProvider& appended
+        ) {
+            const ui32 objectCount = dst.GetObjectCount() + appended.GetObjectCount();
+
+            TCommonObjectsData result;
+            result.FeaturesLayout = dst.GetFeaturesLayout();
+            result.SubsetIndexing = MakeAtomicShared<TArraySubsetIndexing<ui32>>(TFullSubset<ui32>(objectCount));
+            result.Order = (dst.GetOrder() == appended.GetOrder()) ? dst.GetOrder() : EObjectsOrder::Undefined;
+            result.GroupIds = ConcatenateIfDefined(dst.GetGroupIds(), appended.GetGroupIds());
+            result.SubgroupIds = ConcatenateIfDefined(dst.GetSubgroupIds(), appended.GetSubgroupIds());
+            result.Timestamp = ConcatenateIfDefined(dst.GetTimestamp(), appended.GetTimestamp());
+
+            const auto& dstHashToString = dst.CommonData.CatFeaturesHashToString;
+            const auto& appendedHashToString = appended.CommonData.CatFeaturesHashToString;
+            if (dstHashToString || appendedHashToString) {
+                result.CatFeaturesHashToString = MakeAtomicShared<TVector<THashMap<ui32, TString>>>(
+                    dstHashToString ?
+                        *dstHashToString
+                        : TVector<THashMap<ui32, TString>>(result.FeaturesLayout->GetCatFeatureCount())
+                );
+                if (appendedHashToString) {
+                    auto& resultHashToString = *result.CatFeaturesHashToString;
+                    for (auto catFeatureIdx : xrange(appendedHashToString->size())) {
+                        for (const auto& [hashedValue, value] : (*appendedHashToString)[catFeatureIdx]) {
+                            resultHashToString[catFeatureIdx].emplace(hashedValue, value);
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        // getColumns returns (dst column, appended column) pair for per type feature index
+        template <EFeatureType FeatureType, class TGetColumns>
+        static void ConcatenateFeaturesValues(
+            const TFeaturesLayout& featuresLayout,
+            TGetColumns&& getColumns,
+            NPar::TLocalExecutor* localExecutor,
+            TVector<TMaybe<TCompressedArray>>* result
+        ) {
+            TVector<ui32> featureIndices;
+            featuresLayout.IterateOverAvailableFeatures<FeatureType>(
+                [&] (TFeatureIdx<FeatureType> featureIdx) {
+                    featureIndices.push_back(*featureIdx);
+                }
+            );
+            localExecutor->ExecRangeWithThrow(
+                [&] (int i) {
+                    const ui32 featureIdx = featureIndices[i];
+                    const auto columns = getColumns(featureIdx);
+                    (*result)[featureIdx] = ConcatenateColumnValues(*columns.first, *columns.second, localExecutor);
+                },
+                0,
+                SafeIntegerCast<int>(featureIndices.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+        }
+
+        template <class TBundle>
+        static TMaybeOwningArrayHolder<ui8> MakeBundleData(
+            const TExclusiveFeaturesBundle& bundle,
+            ui32 objectCount,
+            const std::function<std::function<ui32(ui32)>(EFeatureType, ui32)>& getBinFunction,
+            NPar::TLocalExecutor* localExecutor
+        ) {
+            TVector<TBundle> dstStorage;
+            dstStorage.yresize(objectCount);
+
+            TConstArrayRef<TExclusiveBundlePart> parts = bundle.Parts;
+            const TBundle defaultValue = parts.back().Bounds.End;
+
+            TVector<std::function<ui32(ui32)>> getBinFunctions;
+            for (const auto& part : parts) {
+                getBinFunctions.push_back(getBinFunction(part.FeatureType, part.FeatureIdx));
+            }
+
+            TBundle* dstData = dstStorage.data();
+            NPar::ParallelFor(
+                *localExecutor,
+                0,
+                objectCount,
+                [dstData, parts, defaultValue, &getBinFunctions] (ui32 objectIdx) {
+                    for (auto partIdx : xrange(parts.size())) {
+                        const ui32 partBin = getBinFunctions[partIdx](objectIdx);
+                        if (partBin) {
+                            dstData[objectIdx] = (TBundle)(parts[partIdx].Bounds.Begin + partBin - 1);
+                            return;
+                        }
+                    }
+                    dstData[objectIdx] = defaultValue;
+                }
+            );
+
+            auto vectorHolder = MakeIntrusive<TVectorHolder<TBundle>>(std::move(dstStorage));
+            return TMaybeOwningArrayHolder<ui8>::CreateOwning(
+                TArrayRef<ui8>((ui8*)vectorHolder->Data.data(), objectCount * sizeof(TBundle)),
+                vectorHolder
+            );
+        }
+
+        static void MakeBundlesData(
+            ui32 objectCount,
+            const std::function<std::function<ui32(ui32)>(EFeatureType, ui32)>& getBinFunction,
+            NPar::TLocalExecutor* localExecutor,
+            TExclusiveFeatureBundlesData* exclusiveFeatureBundlesData
+        ) {
+            const auto& metaData = exclusiveFeatureBundlesData->MetaData;
+            auto& srcData = exclusiveFeatureBundlesData->SrcData;
+            srcData.resize(metaData.size());
+            for (auto bundleIdx : xrange(metaData.size())) {
+                switch (metaData[bundleIdx].SizeInBytes) {
+                    case 1:
+                        srcData[bundleIdx] = MakeBundleData<ui8>(
+                            metaData[bundleIdx],
+                            objectCount,
+                            getBinFunction,
+                            localExecutor
+                        );
+                        break;
+                    case 2:
+                        srcData[bundleIdx] = MakeBundleData<ui16>(
+                            metaData[bundleIdx],
+                            objectCount,
+                            getBinFunction,
+                            localExecutor
+                        );
+                        break;
+                    default:
+                        CB_ENSURE_INTERNAL(
+                            false,
+                            "unsupported Bundle SizeInBytes = " << metaData[bundleIdx].SizeInBytes
+                        );
+                }
+            }
+        }
+
+        static void MakePackedBinaryFeaturesData(
+            ui32 objectCount,
+            const std::function<std::function<ui32(ui32)>(EFeatureType, ui32)>& getBinFunction,
+            NPar::TLocalExecutor* localExecutor,
+            TPackedBinaryFeaturesData* packedBinaryFeaturesData
+        ) {
+            const auto& packedBinaryToSrcIndex = packedBinaryFeaturesData->PackedBinaryToSrcIndex;
+            constexpr size_t BITS_PER_PACK = sizeof(TBinaryFeaturesPack) * CHAR_BIT;
+
+            for (auto packIdx : xrange(packedBinaryFeaturesData->SrcData.size())) {
+                TVector<std::function<ui32(ui32)>> getBitFunctions;
+                for (auto linearIdx : xrange(
+                        packIdx * BITS_PER_PACK,
+                        Min((packIdx + 1) * BITS_PER_PACK, packedBinaryToSrcIndex.size())))
+                {
+                    const auto& srcIndex = packedBinaryToSrcIndex[linearIdx];
+                    getBitFunctions.push_back(getBinFunction(srcIndex.first, srcIndex.second));
+                }
+
+                TVector<TBinaryFeaturesPack> pack;
+                pack.yresize(objectCount);
+                TBinaryFeaturesPack* packData = pack.data();
+
+                NPar::ParallelFor(
+                    *localExecutor,
+                    0,
+                    objectCount,
+                    [packData, &getBitFunctions] (ui32 objectIdx) {
+                        TBinaryFeaturesPack packValue = 0;
+                        for (auto bitIdx : xrange(getBitFunctions.size())) {
+                            packValue |= TBinaryFeaturesPack(getBitFunctions[bitIdx](objectIdx) << bitIdx);
+                        }
+                        packData[objectIdx] = packValue;
+                    }
+                );
+
+                packedBinaryFeaturesData->SrcData[packIdx]
+                    = TMaybeOwningArrayHolder<TBinaryFeaturesPack>::CreateOwning(std::move(pack));
+            }
+        }
+
+        template <EFeatureType FeatureType, class IColumnType>
+        static void MakeColumns(
+            const TFeaturesLayout& featuresLayout,
+            const TExclusiveFeatureBundlesData& exclusiveFeatureBundlesData,
+            const TPackedBinaryFeaturesData& packedBinaryFeaturesData,
+            const TFeaturesArraySubsetIndexing* subsetIndexing,
+            TVector<TMaybe<TCompressedArray>>* featuresValues,
+            TVector<THolder<IColumnType>>* dst
+        ) {
+            dst->clear();
+            dst->resize(featuresLayout.GetFeatureCount(FeatureType));
+
+            featuresLayout.IterateOverAvailableFeatures<FeatureType>(
+                [&] (TFeatureIdx<FeatureType> featureIdx) {
+                    const ui32 flatFeatureIdx = featuresLayout.GetExternalFeatureIdx(*featureIdx, FeatureType);
+
+                    if (auto maybeBundleIndex
+                            = exclusiveFeatureBundlesData.FlatFeatureIndexToBundlePart[flatFeatureIdx])
+                    {
+                        const auto& bundleMetaData = exclusiveFeatureBundlesData.MetaData[maybeBundleIndex->BundleIdx];
+
+                        (*dst)[*featureIdx] = MakeHolder<TBundlePartValuesHolderImpl<IColumnType>>(
+                            flatFeatureIdx,
+                            exclusiveFeatureBundlesData.SrcData[maybeBundleIndex->BundleIdx],
+                            bundleMetaData.SizeInBytes,
+                            bundleMetaData.Parts[maybeBundleIndex->InBundleIdx].Bounds,
+                            subsetIndexing
+                        );
+                    } else if (auto maybePackedBinaryIndex
+                                   = packedBinaryFeaturesData.FlatFeatureIndexToPackedBinaryIndex[flatFeatureIdx])
+                    {
+                        (*dst)[*featureIdx] = MakeHolder<TPackedBinaryValuesHolderImpl<IColumnType>>(
+                            flatFeatureIdx,
+                            packedBinaryFeaturesData.SrcData[maybePackedBinaryIndex->PackIdx],
+                            maybePackedBinaryIndex->BitIdx,
+                            subsetIndexing
+                        );
+                    } else {
+                        (*dst)[*featureIdx] = MakeHolder<TCompressedValuesHolderImpl<IColumnType>>(
+                            flatFeatureIdx,
+                            std::move(*(*featuresValues)[*featureIdx]),
+                            subsetIndexing
+                        );
+                    }
+
+                    // not needed anymore
+                    (*featuresValues)[*featureIdx].Clear();
+                }
+            );
+        }
+    };
+
+
+    TQuantizedDataProviderPtr AppendToQuantizedData(
+        const TQuantizationOptions& options,
+        TQuantizedDataProviderPtr quantizedDataProvider,
+        TRawDataProviderPtr rawDataProvider,
+        TRestorableFastRng64* rand,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        return TAppendToQuantizedDataImpl::Do(
+            options,
+            std::move(quantizedDataProvider),
+            std::move(rawDataProvider),
+            rand,
+            localExecutor
+        );
+    }
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "data_provider.h"
+#include "quantization.h"
+
+#include <catboost/libs/helpers/restorable_rng.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+
+namespace NCB {
+
+    /*
+     * Quantize objects from rawDataProvider with QuantizedFeaturesInfo of quantizedDataProvider
+     *  and return a new data provider with these objects appended after the objects of quantizedDataProvider.
+     *
+     * Existing borders are reused, unseen categorical features values extend perfect hashes
+     *  (note that QuantizedFeaturesInfo is shared with quantizedDataProvider, so it is updated as well).
+     *
+     * Exclusive features bundles of quantizedDataProvider are kept if they are still valid with extended
+     *  perfect hashes, otherwise bundled features are stored as separate columns.
+     *  Binary features packs are recalculated according to options.
+     *
+     * Text features are not supported yet.
+     */
+    TQuantizedDataProviderPtr AppendToQuantizedData(
+        const TQuantizationOptions& options,
+        TQuantizedDataProviderPtr quantizedDataProvider,
+        TRawDataProviderPtr rawDataProvider,
+        TRestorableFastRng64* rand,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+}
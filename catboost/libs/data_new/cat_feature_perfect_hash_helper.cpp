@@ -5,6 +5,7 @@
 #include <util/system/guard.h>
 #include <util/system/yassert.h>
 #include <util/generic/map.h>
+#include <util/generic/utility.h>
 
 #include <util/generic/ylimits.h>
 
@@ -13,6 +14,20 @@
 
 namespace NCB {
 
+    ui32 TCatFeaturesPerfectHashHelper::GetUniqueValuesCountOnAll(const TCatFeatureIdx catFeatureIdx) const {
+        QuantizedFeaturesInfo->CheckCorrectPerTypeFeatureIdx(catFeatureIdx);
+        TReadGuard guard(QuantizedFeaturesInfo->GetRWMutex());
+        return QuantizedFeaturesInfo->CatFeaturesPerfectHash.CatFeatureUniqValuesCountsVector[*catFeatureIdx].OnAll;
+    }
+
+    void TCatFeaturesPerfectHashHelper::AddUniqueValuesOnLearn(const TCatFeatureIdx catFeatureIdx, ui32 count) {
+        QuantizedFeaturesInfo->CheckCorrectPerTypeFeatureIdx(catFeatureIdx);
+        TWriteGuard guard(QuantizedFeaturesInfo->GetRWMutex());
+        auto& uniqValuesCounts
+            = QuantizedFeaturesInfo->CatFeaturesPerfectHash.CatFeatureUniqValuesCountsVector[*catFeatureIdx];
+        uniqValuesCounts.OnLearnOnly = Min(uniqValuesCounts.OnLearnOnly + count, uniqValuesCounts.OnAll);
+    }
+
     void TCatFeaturesPerfectHashHelper::UpdatePerfectHashAndMaybeQuantize(
         const TCatFeatureIdx catFeatureIdx,
         TMaybeOwningConstArraySubset<ui32, ui32> hashedCatArraySubset,
@@ -25,6 +25,14 @@ namespace NCB {
             return QuantizedFeaturesInfo->CatFeaturesPerfectHash.GetUniqueValuesCounts(catFeatureIdx);
         }
 
+        // unlike GetUniqueValuesCounts does not return zero counts for constant features
+        ui32 GetUniqueValuesCountOnAll(const TCatFeatureIdx catFeatureIdx) const;
+
+        /* count values added to the perfect hash as seen on learn as well
+         * (used when objects are appended to already quantized learn data)
+         */
+        void AddUniqueValuesOnLearn(const TCatFeatureIdx catFeatureIdx, ui32 count);
+
         // thread-safe w.r.t. QuantizedFeaturesInfo
         void UpdatePerfectHashAndMaybeQuantize(
             const TCatFeatureIdx catFeatureIdx,
@@ -5,6 +5,7 @@
 #include <catboost/libs/data_util/exists_checker.h>
 #include <catboost/libs/helpers/mem_usage.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/object_factory/object_factory.h>
 
 #include <util/generic/maybe.h>
@@ -20,7 +21,11 @@ namespace NCB {
     TCBDsvDataLoader::TCBDsvDataLoader(TDatasetLoaderPullArgs&& args)
         : TCBDsvDataLoader(
             TLineDataLoaderPushArgs {
-                GetLineDataReader(args.PoolPath, args.CommonArgs.PoolFormat),
+                GetLineDataReader(
+                    args.PoolPath,
+                    args.CommonArgs.PoolFormat,
+                    args.CommonArgs.LocalExecutor
+                ),
                 std::move(args.CommonArgs)
             }
         )
@@ -86,6 +91,8 @@ namespace NCB {
 
 
     void TCBDsvDataLoader::ProcessBlock(IRawObjectsOrderDataVisitor* visitor) {
+        CHROMIUM_TRACE_FUNCTION_NAME("TCBDsvDataLoader::ProcessBlock");
+
         visitor->StartNextBlock(AsyncRowProcessor.GetParseBufferSize());
 
         auto& columnsDescription = DataMetaInfo.ColumnsInfo->Columns;
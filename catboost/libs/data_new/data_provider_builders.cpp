@@ -8,6 +8,7 @@
 #include "visitor.h"
 
 #include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/cat_feature/cat_feature_hash_cache.h>
 #include <catboost/libs/helpers/compression.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/resource_holder.h>
@@ -18,7 +19,9 @@
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/bitops.h>
 #include <util/generic/cast.h>
+#include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
 #include <util/generic/string.h>
 #include <util/generic/xrange.h>
@@ -34,6 +37,23 @@
 
 namespace NCB {
 
+    /* Per-thread caches of categorical feature hashes for all columns use at most this memory:
+     * caches are smaller if there are many columns and are not used if they would be too small to be useful.
+     */
+    static constexpr size_t CAT_FEATURE_HASH_CACHES_MAX_SIZE = size_t(1) << 20;
+    static constexpr ui32 CAT_FEATURE_HASH_CACHE_MIN_SIZE_LOG2 = 6;
+    static constexpr ui32 CAT_FEATURE_HASH_CACHE_MAX_SIZE_LOG2 = 10;
+
+    static TMaybe<ui32> GetCatFeatureHashCacheSizeLog2(ui32 catFeatureCount) {
+        const size_t maxEntryCount
+            = CAT_FEATURE_HASH_CACHES_MAX_SIZE / TCatFeatureHashCache::EntrySize / Max<ui32>(catFeatureCount, 1);
+        if (maxEntryCount < (size_t(1) << CAT_FEATURE_HASH_CACHE_MIN_SIZE_LOG2)) {
+            return Nothing();
+        }
+        return Min<ui32>(MostSignificantBit(maxEntryCount), CAT_FEATURE_HASH_CACHE_MAX_SIZE_LOG2);
+    }
+
+
     class TRawObjectsOrderDataProviderBuilder : public IDataProviderBuilder,
                                                 public IRawObjectsOrderDataVisitor
     {
@@ -79,6 +99,7 @@ namespace NCB {
             }
             ObjectCount = objectCount + prevTailSize;
             CatFeatureCount = metaInfo.FeaturesLayout->GetCatFeatureCount();
+            CatFeatureHashCacheSizeLog2 = GetCatFeatureHashCacheSizeLog2(CatFeatureCount);
 
             Cursor = NotSet;
 
@@ -142,12 +163,33 @@ namespace NCB {
 
         ui32 GetCatFeatureValue(ui32 flatFeatureIdx, TStringBuf feature) override {
             auto catFeatureIdx = GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx);
-            ui32 hashVal = CalcCatFeatureHash(feature);
             int hashPartIdx = LocalExecutor->GetWorkerThreadId();
             CB_ENSURE(hashPartIdx < CB_THREAD_LIMIT, "Internal error: thread ID exceeds CB_THREAD_LIMIT");
-            auto& catFeatureHashes = HashMapParts[hashPartIdx].CatFeatureHashes;
-            catFeatureHashes.resize(CatFeatureCount);
-            auto& catFeatureHash = catFeatureHashes[*catFeatureIdx];
+            auto& hashPart = HashMapParts[hashPartIdx];
+            if (hashPart.CatFeatureHashes.size() != CatFeatureCount) {
+                hashPart.CatFeatureHashes.resize(CatFeatureCount);
+                hashPart.CatFeatureHashCaches.clear();
+                hashPart.CatFeatureHashCaches.resize(CatFeatureCount);
+            }
+
+            ui32 hashVal;
+            if (CatFeatureHashCacheSizeLog2) {
+                // caches are allocated only for columns that this thread processes
+                auto& hashCache = hashPart.CatFeatureHashCaches[*catFeatureIdx];
+                if (!hashCache) {
+                    hashCache = MakeHolder<TCatFeatureHashCache>(*CatFeatureHashCacheSizeLog2);
+                }
+                bool isCached;
+                hashVal = hashCache->Calc(feature, &isCached);
+                if (isCached) {
+                    // cache and hash map are filled together, so value is already in the hash map
+                    return hashVal;
+                }
+            } else {
+                hashVal = CalcCatFeatureHash(feature);
+            }
+
+            auto& catFeatureHash = hashPart.CatFeatureHashes[*catFeatureIdx];
 
             THashMap<ui32, TString>::insert_ctx insertCtx;
             if (!catFeatureHash.contains(hashVal, insertCtx)) {
@@ -410,6 +452,7 @@ namespace NCB {
     private:
         struct THashPart {
             TVector<THashMap<ui32, TString>> CatFeatureHashes;
+            TVector<THolder<TCatFeatureHashCache>> CatFeatureHashCaches; // per-thread caches for CatFeatureHashes
         };
 
 
@@ -519,6 +562,7 @@ namespace NCB {
 
         ui32 ObjectCount;
         ui32 CatFeatureCount;
+        TMaybe<ui32> CatFeatureHashCacheSizeLog2; // Nothing() if caches are not used
 
         TRawBuilderData Data;
 
@@ -635,6 +679,26 @@ namespace NCB {
             );
         }
 
+        void AddCatFeatureHashToString(
+            ui32 flatFeatureIdx,
+            TConstArrayRef<ui32> hashes,
+            TConstArrayRef<TString> values
+        ) override {
+            CB_ENSURE_INTERNAL(
+                hashes.size() == values.size(),
+                "hashes and values sizes differ: " << hashes.size() << " != " << values.size()
+            );
+            auto catFeatureIdx = GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx);
+            auto& catFeatureHash = (*Data.CommonObjectsData.CatFeaturesHashToString)[*catFeatureIdx];
+
+            for (auto i : xrange(hashes.size())) {
+                THashMap<ui32, TString>::insert_ctx insertCtx;
+                if (!catFeatureHash.contains(hashes[i], insertCtx)) {
+                    catFeatureHash.emplace_direct(insertCtx, hashes[i], values[i]);
+                }
+            }
+        }
+
         void AddTextFeature(ui32 flatFeatureIdx, TMaybeOwningConstArrayHolder<TString> features) override {
             auto textFeatureIdx = GetInternalFeatureIdx<EFeatureType::Text>(flatFeatureIdx);
             Data.ObjectsData.TextFeatures[*textFeatureIdx] = MakeHolder<TStringTextValuesHolder>(
@@ -736,11 +800,25 @@ namespace NCB {
             TVector<ui32> hashedCatValues;
             hashedCatValues.yresize(ObjectCount);
 
+            const auto& params = *ObjectCalcParams;
             LocalExecutor->ExecRange(
-                [&](int objectIdx) {
-                    hashedCatValues[objectIdx] = CalcCatFeatureHash(feature[objectIdx]);
+                [&](int blockIdx) {
+                    const int blockBegin = params.FirstId + blockIdx * params.GetBlockSize();
+                    const int blockSize = Min(params.GetBlockSize(), params.LastId - blockBegin);
+                    const int threadIdx = LocalExecutor->GetWorkerThreadId();
+                    CB_ENSURE(threadIdx < CB_THREAD_LIMIT, "Internal error: thread ID exceeds CB_THREAD_LIMIT");
+                    auto& hashCache = CatFeatureHashCaches[threadIdx];
+                    if (!hashCache) {
+                        hashCache = MakeHolder<TCatFeatureHashCache>();
+                    }
+                    CalcCatFeatureHashes(
+                        feature.Slice(blockBegin, blockSize),
+                        hashCache.Get(),
+                        TArrayRef<ui32>(hashedCatValues.data() + blockBegin, blockSize)
+                    );
                 },
-                *ObjectCalcParams,
+                0,
+                params.GetBlockCount(),
                 NPar::TLocalExecutor::WAIT_COMPLETE
             );
 
@@ -774,6 +852,11 @@ namespace NCB {
         // have to make it THolder because NPar::TLocalExecutor::TExecRangeParams is unassignable/unmoveable
         THolder<NPar::TLocalExecutor::TExecRangeParams> ObjectCalcParams;
 
+        /* hashes do not depend on the column, so caches are shared by all categorical features,
+         * allocated only for threads that hash them
+         */
+        std::array<THolder<TCatFeatureHashCache>, CB_THREAD_LIMIT> CatFeatureHashCaches;
+
         bool InProcess;
         bool ResultTaken;
     };
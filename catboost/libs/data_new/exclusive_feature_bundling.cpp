@@ -8,7 +8,6 @@
 #include <catboost/libs/helpers/dbg_output.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/options/restrictions.h>
-#include <catboost/libs/helpers/vec_list.h>
 
 #include <library/dbg_output/dump.h>
 #include <library/pop_count/popcount.h>
@@ -133,143 +132,49 @@ struct TDumper<NCB::TFeatureIntersectionGraph> {
 
 namespace NCB {
 
-    struct TCalcIntersectionCheckList {
-        ui32 FeatureIdx1 = 0;
-        TVecList<ui32> FeatureIndices2;
+    /* Non-default values bitset of a feature on a block of the objects sample.
+     * Sparse features store only non-zero 64-bit words in WordIndices and Words,
+     * dense features store the full bitset in AllWords instead.
+     */
+    struct TNonDefaultValuesBitset {
+        ui32 NonDefaultCount = 0;
+        TVector<ui32> WordIndices; // empty for dense features
+        TVector<ui64> Words; // empty for dense features
+        TVector<ui64> AllWords; // non-empty only for dense features
 
     public:
-        TCalcIntersectionCheckList(ui32 featureIdx1)
-            : FeatureIdx1(featureIdx1)
-        {}
-    };
-
-    struct TToCalcData {
-        ui32 CountersCount = 0;
-    };
-
-    // per-thread data
-    struct TCalcFeatureIntersectionPartData {
-        TFeatureIntersectionGraph FeatureIntersectionGraph;
-        TVector<ui32> FeatureNonDefaultCount; // [flatFeatureIdx]
-
-        TVecList<TCalcIntersectionCheckList> FeatureIntersectionCheckLists;
-        TVecList<ui32> FeatureIndicesToCalc; // contains [flatFeatureIdx]
-        TVector<TToCalcData> ToCalcStats; // [flatFeatureIdx]
-
-        // updated for objects in CalcNonDefaultValuesMasks
-        TVector<ui64> FeatureNonDefaultValuesMasks; // [flatFeatureIdx]
-
-    public:
-        TCalcFeatureIntersectionPartData()
-            : FeatureIntersectionGraph(true)
-        {}
-
-        void Init(
-            ui32 featureCount,
-            const TVecList<TCalcIntersectionCheckList>& featureIntersectionCheckLists,
-            const TVecList<ui32>& featureIndicesToCalc
-        ) {
-            FeatureIntersectionGraph.IntersectionCounts.resize(featureCount);
-            FeatureIntersectionCheckLists = featureIntersectionCheckLists;
-            FeatureIndicesToCalc = featureIndicesToCalc;
-
-            ToCalcStats.resize(featureCount);
-            for (auto featureIndicesToCalcIter = FeatureIndicesToCalc.begin();
-                 featureIndicesToCalcIter != FeatureIndicesToCalc.end();
-                 ++featureIndicesToCalcIter)
-            {
-                ToCalcStats[*featureIndicesToCalcIter].CountersCount = (ui32)FeatureIndicesToCalc.size() - 1;
-            }
-
-            FeatureNonDefaultValuesMasks.yresize(featureCount);
-            FeatureNonDefaultCount.resize(featureCount, 0);
+        bool IsDense() const {
+            return !AllWords.empty();
         }
+    };
 
-        bool Inited() const {
-            return !FeatureNonDefaultCount.empty();
-        }
+    // features with at least 1/DENSE_BITSET_INVERSE_WORDS_FRACTION of non-zero words are treated as dense
+    constexpr ui32 DENSE_BITSET_INVERSE_WORDS_FRACTION = 8;
 
-        void CalcNonDefaultValuesMasks(
-            TConstArrayRef<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions,
-            TConstArrayRef<ui32> srcIndices
-        ) {
-            for (auto featureIndicesToCalcIter = FeatureIndicesToCalc.begin();
-                 featureIndicesToCalcIter != FeatureIndicesToCalc.end();)
-            {
-                auto flatFeatureIdx = *featureIndicesToCalcIter;
-                if (!ToCalcStats[flatFeatureIdx].CountersCount) {
-                    featureIndicesToCalcIter = FeatureIndicesToCalc.erase(featureIndicesToCalcIter);
-                } else {
-                    FeatureNonDefaultValuesMasks[flatFeatureIdx]
-                        = getNonDefaultValuesMaskFunctions[flatFeatureIdx](srcIndices);
-                    ++featureIndicesToCalcIter;
+    // returns intersection count if it is <= maxIntersectionCount, maxIntersectionCount + 1 otherwise
+    static ui32 CalcIntersectionCountWithDense(
+        const TNonDefaultValuesBitset& denseBitset,
+        const TNonDefaultValuesBitset& bitset,
+        ui32 maxIntersectionCount
+    ) {
+        ui32 intersectionCount = 0;
+        if (bitset.IsDense()) {
+            for (auto wordIdx : xrange(bitset.AllWords.size())) {
+                intersectionCount += (ui32)PopCount(bitset.AllWords[wordIdx] & denseBitset.AllWords[wordIdx]);
+                if (intersectionCount > maxIntersectionCount) {
+                    return maxIntersectionCount + 1;
                 }
             }
+            return intersectionCount;
         }
-
-        void UpdateNonDefaultCounts(
-            TConstArrayRef<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions,
-            TConstArrayRef<ui32> srcIndices
-        ) {
-            for (auto featureIndicesToCalcIter = FeatureIndicesToCalc.begin();
-                 featureIndicesToCalcIter != FeatureIndicesToCalc.end();)
-            {
-                auto flatFeatureIdx = *featureIndicesToCalcIter;
-                if (!ToCalcStats[flatFeatureIdx].CountersCount) {
-                    featureIndicesToCalcIter = FeatureIndicesToCalc.erase(featureIndicesToCalcIter);
-                } else {
-                    FeatureNonDefaultCount[flatFeatureIdx]
-                        += PopCount(getNonDefaultValuesMaskFunctions[flatFeatureIdx](srcIndices));
-                    ++featureIndicesToCalcIter;
-                }
+        for (auto i : xrange(bitset.WordIndices.size())) {
+            intersectionCount += (ui32)PopCount(bitset.Words[i] & denseBitset.AllWords[bitset.WordIndices[i]]);
+            if (intersectionCount > maxIntersectionCount) {
+                return maxIntersectionCount + 1;
             }
         }
-
-        /* TCheckAndUpdateForPairFunction must be of type bool (featureIdx1, featureIdx2) and return true if
-         * no more intersection count calculation for the pair is required for this part
-         */
-        template <class TCheckSkipFeatureFunction, class TCheckAndUpdateForPairFunction>
-        void CheckAndUpdate(
-            TCheckSkipFeatureFunction&& checkSkipFeatureFunction,
-            TCheckAndUpdateForPairFunction&& checkAndUpdateForPairFunction
-        ) {
-            auto featureIntersectionCheckListsIter = FeatureIntersectionCheckLists.begin();
-            while (featureIntersectionCheckListsIter != FeatureIntersectionCheckLists.end()) {
-                auto& featureIntersectionCheckList = *featureIntersectionCheckListsIter;
-                auto featureIdx1 = featureIntersectionCheckList.FeatureIdx1;
-
-                if (!checkSkipFeatureFunction(featureIdx1)) {
-                    auto& featureIndices2 = featureIntersectionCheckList.FeatureIndices2;
-                    auto indices2Iter = featureIndices2.begin();
-                    while (indices2Iter != featureIndices2.end()) {
-                        auto featureIdx2 = *indices2Iter;
-                        if (checkAndUpdateForPairFunction(featureIdx1, featureIdx2)) {
-                            auto& toCalcStatsForIdx2 = ToCalcStats[featureIdx2];
-                            Y_ASSERT(toCalcStatsForIdx2.CountersCount > 0);
-                            --toCalcStatsForIdx2.CountersCount;
-                            auto& toCalcStatsForIdx1 = ToCalcStats[featureIdx1];
-                            Y_ASSERT(toCalcStatsForIdx1.CountersCount > 0);
-                           --toCalcStatsForIdx1.CountersCount;
-
-                            indices2Iter = featureIndices2.erase(indices2Iter);
-                            if (featureIndices2.empty()) {
-                                featureIntersectionCheckListsIter
-                                    = FeatureIntersectionCheckLists.erase(
-                                        featureIntersectionCheckListsIter
-                                    );
-                                goto next_outer_loop_iter;
-                            }
-                        } else {
-                            ++indices2Iter;
-                        }
-                    }
-                }
-                ++featureIntersectionCheckListsIter;
-next_outer_loop_iter:
-                ;
-            }
-        }
-    };
+        return intersectionCount;
+    }
 
     struct TFeatureWithDegree {
         ui32 FlatFeatureIdx;
@@ -481,106 +386,245 @@ next_outer_loop_iter:
     }
 
 
-    void MergeParts(
-        ui32 featureCount,
-        TConstArrayRef<ui32> featureIndicesToCalc,
-        bool canMove,
-        TArrayRef<TCalcFeatureIntersectionPartData> partsData,
-        NPar::TLocalExecutor* localExecutor,
-        TFeatureIntersectionGraph* dst
+    // result is indexed by index in featureIndicesToCalc
+    static TVector<TNonDefaultValuesBitset> CalcNonDefaultValuesBitsets(
+        TConstArrayRef<ui32> featureIndicesToCalc, // [flatFeatureIdx]
+        TConstArrayRef<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions, // [flatFeatureIdx]
+        TConstArrayRef<ui32> srcIndices,
+        NPar::TLocalExecutor* localExecutor
     ) {
-        dst->IntersectionCounts.resize(featureCount);
+        TSimpleIndexRangesGenerator<ui32> wordBlocks(
+            TIndexRange<ui32>(0, SafeIntegerCast<ui32>(srcIndices.size())),
+            (ui32)sizeof(ui64) * CHAR_BIT
+        );
+        const ui32 wordCount = wordBlocks.RangesCount();
+
+        TVector<TNonDefaultValuesBitset> bitsets(featureIndicesToCalc.size());
+
         localExecutor->ExecRange(
             [&] (int featureToCalcIdx) {
-                const ui32 featureIdx1 = featureIndicesToCalc[featureToCalcIdx];
+                auto& bitset = bitsets[featureToCalcIdx];
+                const auto& getNonDefaultValuesMask
+                    = getNonDefaultValuesMaskFunctions[featureIndicesToCalc[featureToCalcIdx]];
 
-                auto* intersectionCountsForFeature1 = &(dst->IntersectionCounts[featureIdx1]);
+                for (auto wordIdx : xrange(wordCount)) {
+                    auto blockRange = wordBlocks.GetRange(wordIdx);
 
-                auto& part0Counts = partsData[0].FeatureIntersectionGraph.IntersectionCounts[featureIdx1];
-                if (canMove) {
-                    *intersectionCountsForFeature1 = std::move(part0Counts);
-                } else {
-                    *intersectionCountsForFeature1 = part0Counts;
+                    const ui64 word = getNonDefaultValuesMask(
+                        TConstArrayRef<ui32>(srcIndices.begin() + blockRange.Begin, blockRange.GetSize())
+                    );
+                    if (word) {
+                        bitset.NonDefaultCount += (ui32)PopCount(word);
+                        bitset.WordIndices.push_back(wordIdx);
+                        bitset.Words.push_back(word);
+                    }
                 }
 
-                for (auto partIdx : xrange(size_t(1), partsData.size())) {
-                    TFeatureIntersectionGraph::Add(
-                        partsData[partIdx].FeatureIntersectionGraph.IntersectionCounts[featureIdx1],
-                        intersectionCountsForFeature1
-                    );
+                if ((ui64)bitset.WordIndices.size() * DENSE_BITSET_INVERSE_WORDS_FRACTION >= wordCount) {
+                    bitset.AllWords.resize(wordCount, 0);
+                    for (auto i : xrange(bitset.WordIndices.size())) {
+                        bitset.AllWords[bitset.WordIndices[i]] = bitset.Words[i];
+                    }
+                    bitset.WordIndices = TVector<ui32>();
+                    bitset.Words = TVector<ui64>();
                 }
             },
             0,
             SafeIntegerCast<int>(featureIndicesToCalc.size()),
             NPar::TLocalExecutor::WAIT_COMPLETE
         );
+
+        return bitsets;
     }
 
 
-    TVector<TExclusiveFeaturesBundle> CreateExclusiveFeatureBundles(
-        const TRawObjectsData& rawObjectsData,
-        const TFeaturesArraySubsetIndexing& rawDataSubsetIndexing,
-        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
-        const TExclusiveFeaturesBundlingOptions& options,
-        NPar::TLocalExecutor* localExecutor
+    /* Calc exact intersection counts for pairs of sparse features.
+     * Uses inverted index (word index -> sparse features with non-zero bitset word) so only pairs
+     * of features that have non-default values in the same 64-object block are processed.
+     *
+     * Counts are added to featureIntersectionGraph rows of features with the smaller index.
+     */
+    static void CalcSparseFeaturesIntersections(
+        TConstArrayRef<ui32> featureIndicesToCalc, // [flatFeatureIdx]
+        TConstArrayRef<TNonDefaultValuesBitset> bitsets, // [featureToCalcIdx]
+        ui32 wordCount,
+        NPar::TLocalExecutor* localExecutor,
+        TFeatureIntersectionGraph* featureIntersectionGraph
     ) {
-        const ui32 objectCount = rawDataSubsetIndexing.Size();
+        if (bitsets.empty()) {
+            return;
+        }
 
-        if (objectCount == 0) {
-            return {};
+        TVector<size_t> wordOffsets(wordCount + 1, 0);
+        for (const auto& bitset : bitsets) {
+            if (!bitset.IsDense()) {
+                for (auto wordIdx : bitset.WordIndices) {
+                    ++wordOffsets[wordIdx + 1];
+                }
+            }
+        }
+        for (auto wordIdx : xrange(wordCount)) {
+            wordOffsets[wordIdx + 1] += wordOffsets[wordIdx];
         }
 
-        const auto& featuresLayout = *quantizedFeaturesInfo.GetFeaturesLayout();
+        // featureToCalcIdx values are sorted in ascending order for each word
+        TVector<ui32> wordFeatures;
+        wordFeatures.yresize(wordOffsets.back());
+        TVector<ui64> wordFeatureWords;
+        wordFeatureWords.yresize(wordOffsets.back());
+        {
+            TVector<size_t> wordCursors(wordOffsets.begin(), wordOffsets.end() - 1);
+            for (auto featureToCalcIdx : xrange(bitsets.size())) {
+                const auto& bitset = bitsets[featureToCalcIdx];
+                if (bitset.IsDense()) {
+                    continue;
+                }
+                for (auto i : xrange(bitset.WordIndices.size())) {
+                    auto& cursor = wordCursors[bitset.WordIndices[i]];
+                    wordFeatures[cursor] = featureToCalcIdx;
+                    wordFeatureWords[cursor] = bitset.Words[i];
+                    ++cursor;
+                }
+            }
+        }
 
-        const auto featureCount = featuresLayout.GetExternalFeatureCount();
-        const auto featuresMetaInfo = featuresLayout.GetExternalFeaturesMetaInfo();
+        NPar::TLocalExecutor::TExecRangeParams rangeParams(0, SafeIntegerCast<int>(bitsets.size()));
 
-        TVecList<TCalcIntersectionCheckList> featureIntersectionCheckLists;
-        TVecList<ui32> featureIndicesToCalc;
-        TVector<ui32> featureIndicesToCalcVector; // needed for random-access during parallel execution
-        TVector<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions(featureCount); // [flatFeatureIdx]
+        // features with smaller indices have more pairs to process, so use more blocks than threads
+        rangeParams.SetBlockCount((localExecutor->GetThreadCount() + 1) * 8);
 
-        // to allow to use in random order when calculating in parallel
-        TVector<TCalcIntersectionCheckList*> featureIntersectionCheckListVector;
+        localExecutor->ExecRange(
+            [&] (int featureToCalcIdx1) {
+                const auto& bitset1 = bitsets[featureToCalcIdx1];
+                if (bitset1.IsDense() || !bitset1.NonDefaultCount) {
+                    return;
+                }
 
-        for (auto flatFeatureIdx : xrange(featureCount)) {
-            const auto& featureMetaInfo = featuresMetaInfo[flatFeatureIdx];
-            if (!featureMetaInfo.IsAvailable || featureMetaInfo.Type == EFeatureType::Text) {
-                continue;
-            }
+                // (featureToCalcIdx2, intersectionCount)
+                TVector<std::pair<ui32, ui32>> intersections;
+
+                for (auto i : xrange(bitset1.WordIndices.size())) {
+                    const ui32 wordIdx = bitset1.WordIndices[i];
+                    const ui64 word1 = bitset1.Words[i];
+
+                    // pairs with smaller featureToCalcIdx2 are processed for featureToCalcIdx2
+                    const auto wordBegin = wordFeatures.begin() + wordOffsets[wordIdx];
+                    const auto wordEnd = wordFeatures.begin() + wordOffsets[wordIdx + 1];
+                    for (auto it = std::upper_bound(wordBegin, wordEnd, (ui32)featureToCalcIdx1);
+                         it != wordEnd;
+                         ++it)
+                    {
+                        const ui32 intersectionCount = (ui32)PopCount(
+                            word1 & wordFeatureWords[it - wordFeatures.begin()]
+                        );
+                        if (intersectionCount) {
+                            intersections.emplace_back(*it, intersectionCount);
+                        }
+                    }
+                }
 
-            // add previous element. Algorithm works this way to avoid adding the last available feature.
-            if (!featureIndicesToCalcVector.empty()) {
-                featureIntersectionCheckLists.push_back(
-                    TCalcIntersectionCheckList(featureIndicesToCalcVector.back())
-                );
-                for (auto& featureIntersectionCheckList : featureIntersectionCheckLists) {
-                    featureIntersectionCheckList.FeatureIndices2.push_back(flatFeatureIdx);
+                auto& intersectionCountsForFeature1
+                    = featureIntersectionGraph->IntersectionCounts[featureIndicesToCalc[featureToCalcIdx1]];
+                for (const auto& [featureToCalcIdx2, intersectionCount] : intersections) {
+                    TFeatureIntersectionGraph::IncrementCount(
+                        featureIndicesToCalc[featureToCalcIdx2],
+                        intersectionCount,
+                        &intersectionCountsForFeature1
+                    );
                 }
+            },
+            rangeParams,
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+    }
+
+
+    /* Calc intersection counts for pairs with at least one dense feature.
+     * Counts over maxObjectIntersection are not calculated exactly.
+     */
+    static void CalcDenseFeaturesIntersections(
+        TConstArrayRef<ui32> featureIndicesToCalc, // [flatFeatureIdx]
+        TConstArrayRef<TNonDefaultValuesBitset> bitsets, // [featureToCalcIdx]
+        ui32 objectCount,
+        ui32 maxObjectIntersection,
+        NPar::TLocalExecutor* localExecutor,
+        TFeatureIntersectionGraph* featureIntersectionGraph
+    ) {
+        TVector<ui32> denseFeatures; // [featureToCalcIdx]
+        for (auto featureToCalcIdx : xrange(bitsets.size())) {
+            if (bitsets[featureToCalcIdx].IsDense()) {
+                denseFeatures.push_back(featureToCalcIdx);
             }
+        }
 
-            featureIndicesToCalc.push_back(flatFeatureIdx);
-            featureIndicesToCalcVector.push_back(flatFeatureIdx);
+        // [denseFeatureIdx] -> (featureToCalcIdx, intersectionCount)
+        TVector<TVector<std::pair<ui32, ui32>>> denseFeaturesIntersections(denseFeatures.size());
 
-            if (featureMetaInfo.Type == EFeatureType::Float) {
-                getNonDefaultValuesMaskFunctions[flatFeatureIdx] = GetQuantizedFloatNonDefaultValuesMaskFunction(
-                    rawObjectsData,
-                    quantizedFeaturesInfo,
-                    TFloatFeatureIdx(featuresLayout.GetInternalFeatureIdx(flatFeatureIdx))
-                );
-            } else if (featureMetaInfo.Type == EFeatureType::Categorical) {
-                getNonDefaultValuesMaskFunctions[flatFeatureIdx] = GetQuantizedCatNonDefaultValuesMaskFunction(
-                    rawObjectsData,
-                    quantizedFeaturesInfo,
-                    TCatFeatureIdx(featuresLayout.GetInternalFeatureIdx(flatFeatureIdx))
+        localExecutor->ExecRange(
+            [&] (int denseFeatureIdx) {
+                const ui32 featureToCalcIdx1 = denseFeatures[denseFeatureIdx];
+                const auto& bitset1 = bitsets[featureToCalcIdx1];
+
+                for (auto featureToCalcIdx2 : xrange((ui32)bitsets.size())) {
+                    const auto& bitset2 = bitsets[featureToCalcIdx2];
+
+                    // pairs of dense features are processed for the smaller index
+                    if ((featureToCalcIdx2 == featureToCalcIdx1) ||
+                        (bitset2.IsDense() && (featureToCalcIdx2 < featureToCalcIdx1)) ||
+                        !bitset2.NonDefaultCount)
+                    {
+                        continue;
+                    }
+
+                    ui32 intersectionCount;
+                    if ((ui64)bitset1.NonDefaultCount + bitset2.NonDefaultCount
+                        > (ui64)objectCount + maxObjectIntersection)
+                    {
+                        intersectionCount = maxObjectIntersection + 1; // any value over maxObjectIntersection will do
+                    } else {
+                        intersectionCount = CalcIntersectionCountWithDense(
+                            bitset1,
+                            bitset2,
+                            maxObjectIntersection
+                        );
+                    }
+                    if (intersectionCount) {
+                        denseFeaturesIntersections[denseFeatureIdx].emplace_back(
+                            featureToCalcIdx2,
+                            intersectionCount
+                        );
+                    }
+                }
+            },
+            0,
+            SafeIntegerCast<int>(denseFeatures.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        for (auto denseFeatureIdx : xrange(denseFeatures.size())) {
+            const ui32 featureToCalcIdx1 = denseFeatures[denseFeatureIdx];
+            for (const auto& [featureToCalcIdx2, intersectionCount]
+                 : denseFeaturesIntersections[denseFeatureIdx])
+            {
+                featureIntersectionGraph->IncrementCount(
+                    featureIndicesToCalc[Min(featureToCalcIdx1, featureToCalcIdx2)],
+                    featureIndicesToCalc[Max(featureToCalcIdx1, featureToCalcIdx2)],
+                    intersectionCount
                 );
-            } else {
-                CB_ENSURE(false, featureMetaInfo.Type << " is not supported for feature bundles");
             }
         }
+    }
+
+
+    TVector<ui32> GetConflictsSampleSrcIndices(
+        const TFeaturesArraySubsetIndexing& rawDataSubsetIndexing,
+        ui32 conflictsSampleSize,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const ui32 objectCount = rawDataSubsetIndexing.Size();
 
         TVector<ui32> subsetIndices;
-        subsetIndices.yresize(rawDataSubsetIndexing.Size());
+        subsetIndices.yresize(objectCount);
 
         rawDataSubsetIndexing.ParallelForEach(
             [&] (ui32 objectIdx, ui32 srcObjectIdx) {
@@ -592,170 +636,141 @@ next_outer_loop_iter:
         // to improve locality
         Sort(subsetIndices);
 
-        TSimpleIndexRangesGenerator<ui32> partRanges(
-            TIndexRange<ui32>(0, objectCount),
-            CeilDiv(objectCount, ui32(localExecutor->GetThreadCount() + 1))
-        );
+        if (conflictsSampleSize && (conflictsSampleSize < objectCount)) {
+            TVector<ui32> sampleIndices;
+            sampleIndices.yresize(conflictsSampleSize);
+            for (auto i : xrange(conflictsSampleSize)) {
+                sampleIndices[i] = subsetIndices[(ui64)i * objectCount / conflictsSampleSize];
+            }
+            subsetIndices = std::move(sampleIndices);
+        }
+        return subsetIndices;
+    }
 
-        const int partCount = partRanges.RangesCount();
 
-        TVector<TCalcFeatureIntersectionPartData> partsData(partCount);
+    TVector<THashMap<ui32, ui32>> CalcConflictCounts(
+        TConstArrayRef<ui32> featureIndicesToCalc, // [flatFeatureIdx], ascending
+        TConstArrayRef<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions, // [flatFeatureIdx]
+        TConstArrayRef<ui32> srcIndices,
+        ui32 maxObjectIntersection,
+        NPar::TLocalExecutor* localExecutor,
+        ui64 maxBitsetsSize
+    ) {
+        TFeatureIntersectionGraph featureIntersectionGraph(true);
+        featureIntersectionGraph.IntersectionCounts.resize(getNonDefaultValuesMaskFunctions.size());
 
-        const ui32 maxObjectIntersection = ui32(options.MaxConflictFraction * float(objectCount));
+        if (srcIndices.empty() || featureIndicesToCalc.empty()) {
+            return std::move(featureIntersectionGraph.IntersectionCounts);
+        }
 
+        // counts are additive over blocks, and capped counts over maxObjectIntersection stay over it
+        const ui64 blockWordCount = Max<ui64>(1, maxBitsetsSize / (sizeof(ui64) * featureIndicesToCalc.size()));
+        const ui32 blockSize = (ui32)Min<ui64>(srcIndices.size(), blockWordCount * sizeof(ui64) * CHAR_BIT);
 
-        localExecutor->ExecRange(
-            [&](int partIdx) {
-                auto& part = partsData[partIdx];
-                part.Init(featureCount, featureIntersectionCheckLists, featureIndicesToCalc);
+        TSimpleIndexRangesGenerator<ui32> blocks(
+            TIndexRange<ui32>(0, SafeIntegerCast<ui32>(srcIndices.size())),
+            blockSize
+        );
+        for (auto blockIdx : xrange(blocks.RangesCount())) {
+            const auto blockRange = blocks.GetRange(blockIdx);
+            const TConstArrayRef<ui32> blockSrcIndices(srcIndices.begin() + blockRange.Begin, blockRange.GetSize());
+
+            const auto bitsets = CalcNonDefaultValuesBitsets(
+                featureIndicesToCalc,
+                getNonDefaultValuesMaskFunctions,
+                blockSrcIndices,
+                localExecutor
+            );
 
-                auto partObjectRange = partRanges.GetRange(partIdx);
+            CalcSparseFeaturesIntersections(
+                featureIndicesToCalc,
+                bitsets,
+                CeilDiv(blockRange.GetSize(), (ui32)sizeof(ui64) * CHAR_BIT),
+                localExecutor,
+                &featureIntersectionGraph
+            );
 
-                TSimpleIndexRangesGenerator<ui32> partBlocks(partObjectRange, (ui32)sizeof(ui64) * CHAR_BIT);
+            CalcDenseFeaturesIntersections(
+                featureIndicesToCalc,
+                bitsets,
+                blockRange.GetSize(),
+                maxObjectIntersection,
+                localExecutor,
+                &featureIntersectionGraph
+            );
+        }
 
-                for (auto blockIdx : xrange(partBlocks.RangesCount())) {
-                    auto blockRange = partBlocks.GetRange(blockIdx);
+        return std::move(featureIntersectionGraph.IntersectionCounts);
+    }
 
-                    part.UpdateNonDefaultCounts(
-                        getNonDefaultValuesMaskFunctions,
-                        TConstArrayRef<ui32>(subsetIndices.begin() + blockRange.Begin, blockRange.GetSize())
-                    );
-                }
 
+    TVector<TExclusiveFeaturesBundle> CreateExclusiveFeatureBundles(
+        const TRawObjectsData& rawObjectsData,
+        const TFeaturesArraySubsetIndexing& rawDataSubsetIndexing,
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
+        const TExclusiveFeaturesBundlingOptions& options,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const ui32 objectCount = rawDataSubsetIndexing.Size();
 
-                part.CheckAndUpdate(
-                    /*checkSkipFeatureFunction*/ [&] (ui32 featureIdx1) -> bool {
-                        Y_UNUSED(featureIdx1);
-                        return false;
-                    },
-                    /*checkAndUpdateForPairFunction*/ [&] (ui32 featureIdx1, ui32 featureIdx2) -> bool {
-                        const auto nonDefaultCount1 = part.FeatureNonDefaultCount[featureIdx1];
-                        if (nonDefaultCount1 == 0) {
-                            return true;
-                        }
+        if (objectCount == 0) {
+            return {};
+        }
 
-                        const auto nonDefaultCount2 = part.FeatureNonDefaultCount[featureIdx2];
-
-                        if (nonDefaultCount1 == partObjectRange.GetSize()) {
-                            if (nonDefaultCount2) {
-                                part.FeatureIntersectionGraph.IncrementCount(
-                                    featureIdx1,
-                                    featureIdx2,
-                                    nonDefaultCount2
-                                );
-                            }
-                            return true;
-                        } else if ((nonDefaultCount1 + nonDefaultCount2)
-                                   > (partObjectRange.GetSize() + maxObjectIntersection))
-                        {
-                            part.FeatureIntersectionGraph.IncrementCount(
-                                featureIdx1,
-                                featureIdx2,
-                                maxObjectIntersection + 1 // any value over maxObjectIntersection will do
-                            );
-                            return true;
-                        } else {
-                            return false;
-                        }
-                    }
-                );
+        const auto& featuresLayout = *quantizedFeaturesInfo.GetFeaturesLayout();
 
-            },
-            0,
-            partCount,
-            NPar::TLocalExecutor::WAIT_COMPLETE
-        );
+        const auto featureCount = featuresLayout.GetExternalFeatureCount();
+        const auto featuresMetaInfo = featuresLayout.GetExternalFeaturesMetaInfo();
 
-        TFeatureIntersectionGraph featureIntersectionGraphAfterStage1(true);
+        TVector<ui32> featureIndicesToCalc; // [flatFeatureIdx]
+        TVector<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions(featureCount); // [flatFeatureIdx]
 
-        MergeParts(
-            featureCount,
-            featureIndicesToCalcVector,
-            /*canMove*/ false,
-            partsData,
-            localExecutor,
-            &featureIntersectionGraphAfterStage1
-        );
+        for (auto flatFeatureIdx : xrange(featureCount)) {
+            const auto& featureMetaInfo = featuresMetaInfo[flatFeatureIdx];
+            if (!featureMetaInfo.IsAvailable || featureMetaInfo.Type == EFeatureType::Text) {
+                continue;
+            }
 
-        localExecutor->ExecRange(
-            [&](int partIdx) {
-                auto& part = partsData[partIdx];
-
-                // remove counters not needed after stage1
-
-                part.CheckAndUpdate(
-                    /*checkSkipFeatureFunction*/ [&] (ui32 featureIdx1) -> bool {
-                        Y_UNUSED(featureIdx1);
-                        return false;
-                    },
-                    /*checkAndUpdateForPairFunction*/ [&] (ui32 featureIdx1, ui32 featureIdx2) -> bool {
-                        const auto* intersectionCountPtr = MapFindPtr(
-                            featureIntersectionGraphAfterStage1.IntersectionCounts[featureIdx1],
-                            featureIdx2
-                        );
+            featureIndicesToCalc.push_back(flatFeatureIdx);
 
-                        return intersectionCountPtr && (*intersectionCountPtr > maxObjectIntersection);
-                    }
+            if (featureMetaInfo.Type == EFeatureType::Float) {
+                getNonDefaultValuesMaskFunctions[flatFeatureIdx] = GetQuantizedFloatNonDefaultValuesMaskFunction(
+                    rawObjectsData,
+                    quantizedFeaturesInfo,
+                    TFloatFeatureIdx(featuresLayout.GetInternalFeatureIdx(flatFeatureIdx))
                 );
+            } else if (featureMetaInfo.Type == EFeatureType::Categorical) {
+                getNonDefaultValuesMaskFunctions[flatFeatureIdx] = GetQuantizedCatNonDefaultValuesMaskFunction(
+                    rawObjectsData,
+                    quantizedFeaturesInfo,
+                    TCatFeatureIdx(featuresLayout.GetInternalFeatureIdx(flatFeatureIdx))
+                );
+            } else {
+                CB_ENSURE(false, featureMetaInfo.Type << " is not supported for feature bundles");
+            }
+        }
 
-                if (part.FeatureIndicesToCalc.empty()) {
-                    return;
-                }
-
-                auto partObjectRange = partRanges.GetRange(partIdx);
-
-                TSimpleIndexRangesGenerator<ui32> partBlocks(partObjectRange, (ui32)sizeof(ui64) * CHAR_BIT);
-
-                for (auto blockIdx : xrange(partBlocks.RangesCount())) {
-                    auto blockRange = partBlocks.GetRange(blockIdx);
-
-                    part.CalcNonDefaultValuesMasks(
-                        getNonDefaultValuesMaskFunctions,
-                        TConstArrayRef<ui32>(subsetIndices.begin() + blockRange.Begin, blockRange.GetSize())
-                    );
-
-                    part.CheckAndUpdate(
-                        /*checkSkipFeatureFunction*/ [&] (ui32 featureIdx1) -> bool {
-                            return !part.FeatureNonDefaultValuesMasks[featureIdx1];
-                        },
-                        /*checkAndUpdateForPairFunction*/ [&] (ui32 featureIdx1, ui32 featureIdx2) -> bool {
-                            const ui32 intersectionCount = (ui32)PopCount(
-                                part.FeatureNonDefaultValuesMasks[featureIdx1] &
-                                part.FeatureNonDefaultValuesMasks[featureIdx2]
-                            );
-                            if (!intersectionCount) {
-                                return false;
-                            }
-                            return part.FeatureIntersectionGraph.IncrementCount(
-                                featureIdx1,
-                                featureIdx2
-                            ) > maxObjectIntersection;
-                        }
-                    );
-                }
-            },
-            0,
-            partCount,
-            NPar::TLocalExecutor::WAIT_COMPLETE
+        const TVector<ui32> sampleSrcIndices = GetConflictsSampleSrcIndices(
+            rawDataSubsetIndexing,
+            options.ConflictsSampleSize,
+            localExecutor
         );
-
-        featureIntersectionGraphAfterStage1.IntersectionCounts.clear(); // free memory
-
-        TFeatureIntersectionGraph resultFeatureIntersectionGraph(true);
-
-        MergeParts(
-            featureCount,
-            featureIndicesToCalcVector,
-            /*canMove*/ true,
-            partsData,
-            localExecutor,
-            &resultFeatureIntersectionGraph
+        const ui32 sampleSize = sampleSrcIndices.size();
+        const ui32 maxObjectIntersection = ui32(options.MaxConflictFraction * float(sampleSize));
+
+        TFeatureIntersectionGraph featureIntersectionGraph(true);
+        featureIntersectionGraph.IntersectionCounts = CalcConflictCounts(
+            featureIndicesToCalc,
+            getNonDefaultValuesMaskFunctions,
+            sampleSrcIndices,
+            maxObjectIntersection,
+            localExecutor
         );
 
         return CreateExclusiveFeatureBundlesFromGraph(
             quantizedFeaturesInfo,
-            std::move(resultFeatureIntersectionGraph),
-            rawDataSubsetIndexing.Size(),
+            std::move(featureIntersectionGraph),
+            sampleSize,
             options
         );
     }
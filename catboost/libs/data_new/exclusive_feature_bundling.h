@@ -11,11 +11,13 @@
 
 #include <util/generic/array_ref.h>
 #include <util/generic/bitops.h>
+#include <util/generic/hash.h>
 #include <util/generic/vector.h>
 #include <util/generic/ymath.h>
 #include <util/system/types.h>
 
 #include <climits>
+#include <functional>
 
 
 namespace NPar {
@@ -156,9 +158,45 @@ namespace NCB {
     struct TExclusiveFeaturesBundlingOptions {
         ui32 MaxBuckets = 1 << 10;
         float MaxConflictFraction = 0.0f;
+
+        /* if non-0 and less than object count conflicts between features are calculated
+         * on evenly spaced sample of objects of this size
+         */
+        ui32 ConflictsSampleSize = 0;
     };
 
 
+    /*
+     * argument is src indices for up to 64 documents
+     * the return value is a bit mask whether the corresponding quantized feature value bins are non-default
+     */
+    using TGetNonDefaultValuesMask = std::function<ui64(TConstArrayRef<ui32>)>;
+
+    // conflicts are counted on blocks of objects, so that bitsets of all features for a block fit in this size
+    constexpr ui64 CONFLICTS_BITSETS_MAX_SIZE = ui64(256) << 20;
+
+    /* sorted src indices of objects to count conflicts on: all objects or, if conflictsSampleSize is non-0
+     * and less than object count, conflictsSampleSize of them evenly spaced in the sorted order
+     */
+    TVector<ui32> GetConflictsSampleSrcIndices(
+        const TFeaturesArraySubsetIndexing& rawDataSubsetIndexing,
+        ui32 conflictsSampleSize,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+    /* [flatFeatureIdx1][flatFeatureIdx2] -> number of srcIndices objects with non-default values
+     * of both features, only for flatFeatureIdx1 < flatFeatureIdx2 and non-zero counts.
+     * Counts greater than maxObjectIntersection are not exact, but remain greater than it.
+     */
+    TVector<THashMap<ui32, ui32>> CalcConflictCounts(
+        TConstArrayRef<ui32> featureIndicesToCalc, // [flatFeatureIdx], ascending
+        TConstArrayRef<TGetNonDefaultValuesMask> getNonDefaultValuesMaskFunctions, // [flatFeatureIdx]
+        TConstArrayRef<ui32> srcIndices,
+        ui32 maxObjectIntersection,
+        NPar::TLocalExecutor* localExecutor,
+        ui64 maxBitsetsSize = CONFLICTS_BITSETS_MAX_SIZE
+    );
+
     TVector<TExclusiveFeaturesBundle> CreateExclusiveFeatureBundles(
         const TRawObjectsData& rawObjectsData,
         const TFeaturesArraySubsetIndexing& rawDataSubsetIndexing,
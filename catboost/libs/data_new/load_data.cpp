@@ -9,6 +9,8 @@
 #include <catboost/libs/helpers/int_cast.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/chromium_trace/interface.h>
+
 #include <util/datetime/base.h>
 
 
@@ -26,6 +28,8 @@ namespace NCB {
         TMaybe<TVector<TString>*> classNames,
         NPar::TLocalExecutor* localExecutor
     ) {
+        CHROMIUM_TRACE_FUNCTION_NAME("ReadDataset");
+
         CB_ENSURE_INTERNAL(!baselineFilePath.Inited() || classNames, "ClassNames must be specified if baseline file is specified");
         if (classNames) {
             UpdateClassNamesFromBaselineFile(baselineFilePath, *classNames);
@@ -115,6 +119,8 @@ namespace NCB {
         TMaybe<TVector<TString>*> classNames,
         NPar::TLocalExecutor* localExecutor
     ) {
+        CHROMIUM_TRACE_FUNCTION_NAME("ReadDataset");
+
         const auto loadSubset = TDatasetSubset::MakeColumns();
         THolder<IDataProviderBuilder> dataProviderBuilder = CreateDataProviderBuilder(
             EDatasetVisitorType::RawObjectsOrder,
@@ -171,6 +171,7 @@ namespace NCB {
         }
 
     private:
+        friend class TAppendToQuantizedDataImpl;
         friend class TQuantizationImpl;
         friend class TRawBuilderDataHelper;
 
@@ -15,6 +15,7 @@
 #include <catboost/libs/quantization/utils.h>
 #include <catboost/libs/quantization_schema/quantize.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/grid_creator/binarization.h>
 
 #include <util/generic/cast.h>
@@ -875,6 +876,10 @@ namespace NCB {
         TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
         THolder<IQuantizedFloatValuesHolder>* dstQuantizedFeature // can be nullptr if generateBordersOnly
     ) {
+        NChromiumTrace::TEventArgs traceArgs;
+        traceArgs.Add(AsStringBuf("featureIdx"), i64(*floatFeatureIdx));
+        CHROMIUM_TRACE_COMPLETE_W_ARGS(AsStringBuf("ProcessFloatFeature"), AsStringBuf("func"), &traceArgs);
+
         bool calculateNanMode = true;
         ENanMode nanMode = ENanMode::Forbidden;
 
@@ -992,6 +997,10 @@ namespace NCB {
         TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
         THolder<IQuantizedCatValuesHolder>* dstQuantizedFeature
     ) {
+        NChromiumTrace::TEventArgs traceArgs;
+        traceArgs.Add(AsStringBuf("featureIdx"), i64(*catFeatureIdx));
+        CHROMIUM_TRACE_COMPLETE_W_ARGS(AsStringBuf("ProcessCatFeature"), AsStringBuf("func"), &traceArgs);
+
         TMaybeOwningConstArraySubset<ui32, ui32> srcFeatureData = srcFeature.GetArrayData();
 
         // GPU-only external columns
@@ -1137,6 +1146,8 @@ namespace NCB {
             TRestorableFastRng64* rand,
             NPar::TLocalExecutor* localExecutor
         ) {
+            CHROMIUM_TRACE_FUNCTION_NAME("Quantize");
+
             CB_ENSURE_INTERNAL(
                 options.CpuCompatibleFormat || options.GpuCompatibleFormat,
                 "TQuantizationOptions: at least one of CpuCompatibleFormat or GpuCompatibleFormat"
@@ -13,8 +13,6 @@
 #include <util/generic/ylimits.h>
 #include <util/system/types.h>
 
-#include <functional>
-
 
 namespace NCB {
 
@@ -33,12 +31,6 @@ namespace NCB {
     };
 
 
-    /*
-     * argument is src indices for up to 64 documents
-     * the return value is a bit mask whether the corresponding quantized feature value bins are non-default
-     */
-    using TGetNonDefaultValuesMask = std::function<ui64(TConstArrayRef<ui32>)>;
-
     TGetNonDefaultValuesMask GetQuantizedFloatNonDefaultValuesMaskFunction(
         const TRawObjectsData& rawObjectsData,
         const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
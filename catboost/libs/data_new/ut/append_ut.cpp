@@ -0,0 +1,194 @@
+#include <catboost/libs/data_new/append.h>
+
+#include <catboost/libs/data_new/data_provider.h>
+
+#include <catboost/libs/data_new/ut/lib/for_objects.h>
+
+#include <catboost/libs/helpers/vector_helpers.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+Y_UNIT_TEST_SUITE(AppendToQuantizedData) {
+    TRawDataProviderPtr CreateRawDataProvider(
+        const TDataMetaInfo& metaInfo,
+        TVector<TString>&& target,
+        const TVector<TVector<float>>& floatFeatures,
+        const TVector<TVector<ui32>>& hashedCatFeatures,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        const ui32 objectCount = target.size();
+
+        TRawBuilderData srcData;
+        srcData.MetaInfo = metaInfo;
+        srcData.MetaInfo.ObjectCount = objectCount;
+
+        srcData.TargetData.Target = std::move(target);
+        srcData.TargetData.SetTrivialWeights(objectCount);
+
+        srcData.CommonObjectsData.FeaturesLayout = srcData.MetaInfo.FeaturesLayout;
+        srcData.CommonObjectsData.SubsetIndexing = MakeAtomicShared<TArraySubsetIndexing<ui32>>(
+            TFullSubset<ui32>(objectCount)
+        );
+
+        InitFeatures(
+            floatFeatures,
+            *srcData.CommonObjectsData.SubsetIndexing,
+            TConstArrayRef<ui32>{0},
+            &srcData.ObjectsData.FloatFeatures
+        );
+        InitFeatures(
+            hashedCatFeatures,
+            *srcData.CommonObjectsData.SubsetIndexing,
+            TConstArrayRef<ui32>{1, 2},
+            &srcData.ObjectsData.CatFeatures
+        );
+
+        TVector<THashMap<ui32, TString>> catFeaturesHashToString(hashedCatFeatures.size());
+        for (auto catFeatureIdx : xrange(hashedCatFeatures.size())) {
+            for (auto hashedCatValue : hashedCatFeatures[catFeatureIdx]) {
+                catFeaturesHashToString[catFeatureIdx][hashedCatValue] = ToString(hashedCatValue);
+            }
+        }
+        srcData.CommonObjectsData.CatFeaturesHashToString
+            = MakeAtomicShared<TVector<THashMap<ui32, TString>>>(catFeaturesHashToString);
+
+        return MakeDataProvider<TRawObjectsDataProvider>(
+            Nothing(),
+            std::move(srcData),
+            false,
+            localExecutor
+        );
+    }
+
+    Y_UNIT_TEST(TestFloatAndCatFeatures) {
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Label, ""},
+            {EColumn::Num, ""},
+            {EColumn::Categ, ""},
+            {EColumn::Categ, ""}
+        };
+        TVector<TString> featureId = {"f0", "c0", "c1"};
+        TDataMetaInfo metaInfo(std::move(dataColumnsMetaInfo), false, false, Nothing(), &featureId);
+
+        const TVector<TVector<float>> floatFeatures1 = {{0.1f, 0.5f, 0.2f, 0.9f, 0.7f, 0.3f}};
+        const TVector<TVector<ui32>> hashedCatFeatures1 = {
+            {12, 25, 10, 12, 25, 10},
+            {0, 1, 0, 1, 1, 0} // binary
+        };
+
+        const TVector<TVector<float>> floatFeatures2 = {{0.0f, 1.1f, 0.4f, 0.6f}};
+        const TVector<TVector<ui32>> hashedCatFeatures2 = {
+            {25, 7, 12, 99},
+            {1, 1, 2, 0} // not binary anymore
+        };
+
+        for (auto packBinaryFeatures : {false, true}) {
+            TQuantizationOptions quantizationOptions{true, false};
+            quantizationOptions.PackBinaryFeaturesForCpu = packBinaryFeatures;
+            quantizationOptions.BundleExclusiveFeaturesForCpu = false;
+
+            TRestorableFastRng64 rand(0);
+
+            NPar::TLocalExecutor localExecutor;
+            localExecutor.RunAdditionalThreads(2);
+
+            NCatboostOptions::TBinarizationOptions binarizationOptions(
+                EBorderSelectionType::GreedyLogSum,
+                3,
+                ENanMode::Forbidden
+            );
+            auto quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+                *metaInfo.FeaturesLayout,
+                TConstArrayRef<ui32>(),
+                binarizationOptions
+            );
+
+            TQuantizedDataProviderPtr quantizedDataProvider = Quantize(
+                quantizationOptions,
+                CreateRawDataProvider(
+                    metaInfo,
+                    {"0", "1", "1", "0", "1", "0"},
+                    floatFeatures1,
+                    hashedCatFeatures1,
+                    &localExecutor
+                ),
+                quantizedFeaturesInfo,
+                &rand,
+                &localExecutor
+            );
+
+            const auto floatBins1
+                = quantizedDataProvider->ObjectsData->GetFloatFeature(0).GetRef()->ExtractValues(&localExecutor);
+            const TVector<ui8> expectedFloatBins1((*floatBins1).begin(), (*floatBins1).end());
+
+            TQuantizedDataProviderPtr result = AppendToQuantizedData(
+                quantizationOptions,
+                quantizedDataProvider,
+                CreateRawDataProvider(
+                    metaInfo,
+                    {"1", "0", "0", "1"},
+                    floatFeatures2,
+                    hashedCatFeatures2,
+                    &localExecutor
+                ),
+                &rand,
+                &localExecutor
+            );
+
+            UNIT_ASSERT_VALUES_EQUAL(result->GetObjectCount(), 10);
+            UNIT_ASSERT(
+                Equal<TString>(
+                    *result->RawTargetData.GetTarget(),
+                    TVector<TString>{"0", "1", "1", "0", "1", "0", "1", "0", "0", "1"}
+                )
+            );
+            UNIT_ASSERT(result->ObjectsData->GetQuantizedFeaturesInfo() == quantizedFeaturesInfo);
+            UNIT_ASSERT(dynamic_cast<const TQuantizedForCPUObjectsDataProvider*>(result->ObjectsData.Get()));
+
+            // borders are not changed
+            const auto& borders = quantizedFeaturesInfo->GetBorders(TFloatFeatureIdx(0));
+            TVector<ui8> expectedFloatBins = expectedFloatBins1;
+            for (auto value : floatFeatures2[0]) {
+                expectedFloatBins.push_back(
+                    (ui8)CountIf(borders, [value] (float border) { return value > border; })
+                );
+            }
+            const auto floatBins = result->ObjectsData->GetFloatFeature(0).GetRef()->ExtractValues(&localExecutor);
+            UNIT_ASSERT(Equal<ui8>(*floatBins, expectedFloatBins));
+
+            // perfect hashes are extended
+            const TVector<TVector<ui32>> expectedCatBins = {
+                {0, 1, 2, 0, 1, 2, 1, 3, 0, 4},
+                {0, 1, 0, 1, 1, 0, 1, 1, 2, 0}
+            };
+            const TVector<ui32> expectedUniqueValuesCounts = {5, 3};
+
+            for (auto catFeatureIdx : xrange(2)) {
+                const auto catBins
+                    = result->ObjectsData->GetCatFeature(catFeatureIdx).GetRef()->ExtractValues(&localExecutor);
+                UNIT_ASSERT(Equal<ui32>(*catBins, expectedCatBins[catFeatureIdx]));
+
+                const auto uniqueValuesCounts
+                    = quantizedFeaturesInfo->GetUniqueValuesCounts(TCatFeatureIdx(catFeatureIdx));
+                UNIT_ASSERT_VALUES_EQUAL(uniqueValuesCounts.OnAll, expectedUniqueValuesCounts[catFeatureIdx]);
+                UNIT_ASSERT_VALUES_EQUAL(
+                    uniqueValuesCounts.OnLearnOnly,
+                    expectedUniqueValuesCounts[catFeatureIdx]
+                );
+            }
+
+            const auto& catFeaturesHashToString = result->ObjectsData->GetCatFeaturesHashToString(0);
+            UNIT_ASSERT_VALUES_EQUAL(catFeaturesHashToString.at(99), "99");
+            UNIT_ASSERT_VALUES_EQUAL(catFeaturesHashToString.at(12), "12");
+        }
+    }
+}
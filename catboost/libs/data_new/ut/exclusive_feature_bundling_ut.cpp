@@ -0,0 +1,178 @@
+#include <catboost/libs/data_new/exclusive_feature_bundling.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/random/shuffle.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+
+
+// [flatFeatureIdx][srcObjectIdx], non-zero values are non-default
+static TVector<TVector<ui8>> GenerateFeatures(ui32 objectCount) {
+    TFastRng64 rng(7);
+
+    // both sparse and dense features, so that all kinds of pairs are counted
+    const TVector<double> nonDefaultFractions = {0.001, 0.02, 0.0, 0.1, 0.5, 0.9, 0.03, 0.2, 1.0, 0.005};
+
+    TVector<TVector<ui8>> features;
+    for (auto nonDefaultFraction : nonDefaultFractions) {
+        TVector<ui8> feature(objectCount);
+        for (auto& value : feature) {
+            value = rng.GenRandReal1() < nonDefaultFraction;
+        }
+        features.push_back(std::move(feature));
+    }
+    return features;
+}
+
+static TVector<TGetNonDefaultValuesMask> GetMaskFunctions(const TVector<TVector<ui8>>& features) {
+    TVector<TGetNonDefaultValuesMask> result;
+    for (const auto& feature : features) {
+        result.push_back(
+            [&feature] (TConstArrayRef<ui32> srcIndices) -> ui64 {
+                ui64 mask = 0;
+                for (auto i : xrange(srcIndices.size())) {
+                    if (feature[srcIndices[i]]) {
+                        mask |= (ui64(1) << i);
+                    }
+                }
+                return mask;
+            }
+        );
+    }
+    return result;
+}
+
+static ui32 CalcConflictCountBruteForce(
+    const TVector<ui8>& feature1,
+    const TVector<ui8>& feature2,
+    TConstArrayRef<ui32> srcIndices
+) {
+    ui32 count = 0;
+    for (auto srcIdx : srcIndices) {
+        count += feature1[srcIdx] && feature2[srcIdx];
+    }
+    return count;
+}
+
+static void CheckConflictCounts(
+    const TVector<TVector<ui8>>& features,
+    TConstArrayRef<ui32> featureIndicesToCalc,
+    TConstArrayRef<ui32> srcIndices,
+    ui32 maxObjectIntersection,
+    ui64 maxBitsetsSize
+) {
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(3);
+
+    const auto conflictCounts = CalcConflictCounts(
+        featureIndicesToCalc,
+        GetMaskFunctions(features),
+        srcIndices,
+        maxObjectIntersection,
+        &localExecutor,
+        maxBitsetsSize
+    );
+    UNIT_ASSERT_VALUES_EQUAL(conflictCounts.size(), features.size());
+
+    for (auto flatFeatureIdx1 : xrange(features.size())) {
+        for (auto flatFeatureIdx2 : xrange(features.size())) {
+            const ui32* countPtr = conflictCounts[flatFeatureIdx1].FindPtr(flatFeatureIdx2);
+            const bool isCalculated = (flatFeatureIdx1 < flatFeatureIdx2)
+                && IsIn(featureIndicesToCalc, flatFeatureIdx1)
+                && IsIn(featureIndicesToCalc, flatFeatureIdx2);
+            const ui32 expectedCount = isCalculated ?
+                CalcConflictCountBruteForce(features[flatFeatureIdx1], features[flatFeatureIdx2], srcIndices)
+                : 0;
+
+            const ui32 count = countPtr ? *countPtr : 0;
+            UNIT_ASSERT(!countPtr || count);
+            if (expectedCount <= maxObjectIntersection) {
+                UNIT_ASSERT_VALUES_EQUAL(count, expectedCount);
+            } else {
+                UNIT_ASSERT_GT(count, maxObjectIntersection);
+            }
+        }
+    }
+}
+
+
+Y_UNIT_TEST_SUITE(ExclusiveFeatureBundling) {
+    Y_UNIT_TEST(ConflictCounts) {
+        const ui32 objectCount = 5000;
+        const auto features = GenerateFeatures(objectCount);
+
+        TVector<ui32> allFeatures = xrange<ui32>(features.size());
+        TVector<ui32> someFeatures = {0, 1, 3, 4, 5, 8, 9};
+
+        TVector<ui32> srcIndices = xrange<ui32>(objectCount);
+
+        for (const auto& featureIndicesToCalc : {allFeatures, someFeatures}) {
+            for (ui32 maxObjectIntersection : {objectCount, ui32(10), ui32(0)}) {
+                // whole sample in one block and blocks of one and three words, the last one incomplete
+                for (ui64 blockWordCount : {ui64(1000), ui64(1), ui64(3)}) {
+                    CheckConflictCounts(
+                        features,
+                        featureIndicesToCalc,
+                        srcIndices,
+                        maxObjectIntersection,
+                        blockWordCount * sizeof(ui64) * featureIndicesToCalc.size()
+                    );
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ConflictCountsOnSample) {
+        const ui32 objectCount = 5000;
+        const auto features = GenerateFeatures(objectCount);
+
+        TVector<ui32> subsetIndices = xrange<ui32>(objectCount);
+        TFastRng64 rng(11);
+        Shuffle(subsetIndices.begin(), subsetIndices.end(), rng);
+        subsetIndices.resize(4000);
+
+        TVector<ui32> sortedSubsetIndices = subsetIndices;
+        Sort(sortedSubsetIndices);
+
+        const TFeaturesArraySubsetIndexing subsetIndexing(TIndexedSubset<ui32>{subsetIndices});
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        UNIT_ASSERT_VALUES_EQUAL(
+            GetConflictsSampleSrcIndices(subsetIndexing, /*conflictsSampleSize*/ 0, &localExecutor),
+            sortedSubsetIndices
+        );
+        UNIT_ASSERT_VALUES_EQUAL(
+            GetConflictsSampleSrcIndices(subsetIndexing, /*conflictsSampleSize*/ 5000, &localExecutor),
+            sortedSubsetIndices
+        );
+
+        const ui32 sampleSize = 700;
+        const auto sampleSrcIndices = GetConflictsSampleSrcIndices(subsetIndexing, sampleSize, &localExecutor);
+        UNIT_ASSERT_VALUES_EQUAL(sampleSrcIndices.size(), sampleSize);
+        for (auto i : xrange(sampleSize)) {
+            UNIT_ASSERT_VALUES_EQUAL(sampleSrcIndices[i], sortedSubsetIndices[i * 4000 / sampleSize]);
+        }
+
+        const TVector<ui32> allFeatures = xrange<ui32>(features.size());
+        for (ui32 maxObjectIntersection : {sampleSize, ui32(7)}) {
+            for (ui64 blockWordCount : {ui64(1000), ui64(2)}) {
+                CheckConflictCounts(
+                    features,
+                    allFeatures,
+                    sampleSrcIndices,
+                    maxObjectIntersection,
+                    blockWordCount * sizeof(ui64) * allFeatures.size()
+                );
+            }
+        }
+    }
+}
@@ -11,6 +11,9 @@
 #include <util/generic/fwd.h>
 #include <util/generic/maybe.h>
 #include <util/generic/strbuf.h>
+#include <util/generic/xrange.h>
+#include <util/string/builder.h>
+#include <util/string/cast.h>
 
 #include <library/unittest/registar.h>
 
@@ -829,4 +832,60 @@ Y_UNIT_TEST_SUITE(LoadDataFromDsv) {
             Test(testCase);
         }
     }
+
+    Y_UNIT_TEST(ReadDatasetWithManyCatColumns) {
+        // per-thread hash caches are smaller for many columns and are not used at all for 1000 columns
+        for (ui32 catFeatureCount : {3, 100, 1000}) {
+            const ui32 objectCount = 50;
+
+            TStringBuilder cdFileData;
+            cdFileData << "0\tTarget\n";
+            TStringBuilder dsvFileData;
+            TVector<TString> featureId;
+            TVector<TVector<TString>> catFeatureValues(catFeatureCount, TVector<TString>(objectCount));
+            for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                featureId.push_back(TStringBuilder() << "c" << catFeatureIdx);
+                cdFileData << (catFeatureIdx + 1) << "\tCateg\t" << featureId.back() << '\n';
+            }
+            for (auto objectIdx : xrange(objectCount)) {
+                dsvFileData << objectIdx;
+                for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                    // few repeated values for cache hits, the last ones are longer than cached strings
+                    catFeatureValues[catFeatureIdx][objectIdx] = TStringBuilder()
+                        << "v" << (objectIdx * 7 + catFeatureIdx) % 5
+                        << ((objectIdx % 10 == 9) ? TString(40, 'x') : TString());
+                    dsvFileData << '\t' << catFeatureValues[catFeatureIdx][objectIdx];
+                }
+                dsvFileData << '\n';
+            }
+
+            TTestCase testCase;
+            testCase.SrcData.CdFileData = cdFileData;
+            testCase.SrcData.DsvFileData = dsvFileData;
+            testCase.SrcData.DsvFileHasHeader = false;
+
+            TDataColumnsMetaInfo dataColumnsMetaInfo;
+            dataColumnsMetaInfo.Columns.push_back({EColumn::Label, ""});
+            for (const auto& id : featureId) {
+                dataColumnsMetaInfo.Columns.push_back({EColumn::Categ, id});
+            }
+
+            TExpectedRawData expectedData;
+            expectedData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), false, false, /* additionalBaselineCount */ Nothing(), &featureId);
+            for (const auto& values : catFeatureValues) {
+                expectedData.Objects.CatFeatures.push_back(TVector<TStringBuf>(values.begin(), values.end()));
+            }
+            expectedData.ObjectsGrouping = TObjectsGrouping(objectCount);
+            TVector<TString> target;
+            for (auto objectIdx : xrange(objectCount)) {
+                target.push_back(ToString(objectIdx));
+            }
+            expectedData.Target.Target = std::move(target);
+            expectedData.Target.Weights = TWeights<float>(objectCount);
+            expectedData.Target.GroupWeights = TWeights<float>(objectCount);
+            testCase.ExpectedData = std::move(expectedData);
+
+            Test(testCase);
+        }
+    }
 }
@@ -150,6 +150,13 @@ namespace NCB {
         // shared ownership is passed to IRawFeaturesOrderDataVisitor
         virtual void AddCatFeature(ui32 flatFeatureIdx, TMaybeOwningConstArrayHolder<ui32> features) = 0;
 
+        // original values for hashes passed to AddCatFeature above (optional)
+        virtual void AddCatFeatureHashToString(
+            ui32 flatFeatureIdx,
+            TConstArrayRef<ui32> hashes,
+            TConstArrayRef<TString> values
+        ) = 0;
+
         virtual void AddTextFeature(ui32 flatFeatureIdx, TMaybeOwningConstArrayHolder<TString> feature) = 0;
 
         // TRawTargetData
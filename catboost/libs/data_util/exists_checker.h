@@ -1,5 +1,6 @@
 #pragma once
 
+#include "path_pattern.h"
 #include "path_with_scheme.h"
 
 #include <library/object_factory/object_factory.h>
@@ -27,6 +28,9 @@ namespace NCB {
 
     struct TFSExistsChecker : public IExistsChecker {
         bool Exists(const TPathWithScheme& pathWithScheme) const override {
+            if (IsPathPattern(pathWithScheme.Path)) {
+                return !ExpandPathPattern(pathWithScheme.Path).empty();
+            }
             return NFs::Exists(pathWithScheme.Path);
         }
         bool IsSharedFs() const override {
@@ -1,16 +1,37 @@
 #include "line_data_reader.h"
+#include "path_pattern.h"
 
 #include <catboost/libs/helpers/exception.h>
 
+#include <library/threading/future/future.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 #include <util/stream/file.h>
+#include <util/stream/zlib.h>
 #include <util/system/fs.h>
 
+#include <atomic>
+
 
 namespace NCB {
 
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format)
+                                               const TDsvFormatOptions& format,
+                                               NPar::TLocalExecutor* localExecutor)
     {
+        if (IsPathPattern(pathWithScheme.Path)) {
+            TVector<TPathWithScheme> shards;
+            for (const auto& shardPath : ExpandPathPattern(pathWithScheme.Path)) {
+                shards.push_back(pathWithScheme);
+                shards.back().Path = shardPath;
+            }
+            CB_ENSURE(!shards.empty(), "No files match path pattern '" << pathWithScheme.Path << "'");
+            return GetShardedLineDataReader(shards, format, localExecutor);
+        }
         return GetProcessor<ILineDataReader, TLineDataReaderArgs>(
             pathWithScheme, TLineDataReaderArgs{pathWithScheme, format}
         );
@@ -19,13 +40,38 @@ namespace NCB {
 
     namespace {
 
+    // gzip-compressed files are decompressed transparently
+    class TFileLineInput {
+    public:
+        explicit TFileLineInput(const TString& path)
+            : FileInput(path)
+        {
+            if (TStringBuf(path).EndsWith(AsStringBuf(".gz"))) {
+                Decompressor = MakeHolder<TBufferedZLibDecompress>(&FileInput, ZLib::GZip);
+            }
+        }
+
+        bool IsCompressed() const {
+            return Decompressor.Get() != nullptr;
+        }
+
+        bool ReadLine(TString* line) {
+            return (Decompressor ? Decompressor->ReadLine(*line) : FileInput.ReadLine(*line)) != 0;
+        }
+
+    private:
+        TIFStream FileInput;
+        THolder<TBufferedZLibDecompress> Decompressor;
+    };
+
+
     template <class TStr>
     inline int CountLines(const TStr& poolFile) {
         CB_ENSURE(NFs::Exists(TString(poolFile)), "pool file '" << TString(poolFile) << "' is not found");
-        TIFStream reader(poolFile.c_str());
+        TFileLineInput reader(poolFile);
         size_t count = 0;
         TString buffer;
-        while (reader.ReadLine(buffer)) {
+        while (reader.ReadLine(&buffer)) {
             ++count;
         }
         return count;
@@ -35,12 +81,28 @@ namespace NCB {
     public:
         TFileLineDataReader(const TLineDataReaderArgs& args)
             : Args(args)
-            , IFStream(args.PathWithScheme.Path)
+            , LineInput(args.PathWithScheme.Path)
             , HeaderProcessed(!Args.Format.HasHeader)
         {}
 
         ui64 GetDataLineCount() override {
-            ui64 nLines = (ui64)CountLines(Args.PathWithScheme.Path);
+            ui64 nLines;
+            if (LineInput.IsCompressed()) {
+                /* decompression is expensive, so lines are counted by reading the rest of the data once,
+                 * read lines are kept for ReadLine
+                 */
+                if (!BufferedLines) {
+                    BufferedLinesStart = ReadLineCount;
+                    BufferedLines.ConstructInPlace();
+                    TString line;
+                    while (LineInput.ReadLine(&line)) {
+                        BufferedLines->push_back(std::move(line));
+                    }
+                }
+                nLines = BufferedLinesStart + BufferedLines->size();
+            } else {
+                nLines = (ui64)CountLines(Args.PathWithScheme.Path);
+            }
             if (Args.Format.HasHeader) {
                 --nLines;
             }
@@ -51,7 +113,7 @@ namespace NCB {
             if (Args.Format.HasHeader) {
                 CB_ENSURE(!HeaderProcessed, "TFileLineDataReader: multiple calls to GetHeader");
                 TString header;
-                CB_ENSURE(IFStream.ReadLine(header), "TFileLineDataReader: no header in file");
+                CB_ENSURE(ReadRawLine(&header), "TFileLineDataReader: no header in file");
                 HeaderProcessed = true;
                 return header;
             }
@@ -64,13 +126,33 @@ namespace NCB {
             if (!HeaderProcessed) {
                 GetHeader();
             }
-            return IFStream.ReadLine(*line) != 0;
+            return ReadRawLine(line);
+        }
+
+    private:
+        bool ReadRawLine(TString* line) {
+            if (BufferedLines) {
+                if (ReadLineCount == BufferedLinesStart + BufferedLines->size()) {
+                    return false;
+                }
+                *line = std::move((*BufferedLines)[ReadLineCount++ - BufferedLinesStart]);
+                return true;
+            }
+            if (!LineInput.ReadLine(line)) {
+                return false;
+            }
+            ++ReadLineCount;
+            return true;
         }
 
     private:
         TLineDataReaderArgs Args;
-        TIFStream IFStream;
+        TFileLineInput LineInput;
         bool HeaderProcessed;
+
+        ui64 ReadLineCount = 0; // including header
+        TMaybe<TVector<TString>> BufferedLines; // only for compressed data, filled by GetDataLineCount
+        ui64 BufferedLinesStart = 0; // index of the first buffered line in the file
     };
 
 
@@ -78,5 +160,196 @@ namespace NCB {
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> FileLineDataReaderReg("file");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DsvLineDataReaderReg("dsv");
 
+
+    class TShardedLineDataReader : public ILineDataReader {
+    public:
+        TShardedLineDataReader(
+            TConstArrayRef<TPathWithScheme> shards,
+            const TDsvFormatOptions& format,
+            NPar::TLocalExecutor* localExecutor)
+            : Format(format)
+            , LocalExecutor(localExecutor)
+            , PrefetchShardCount(
+                Min<size_t>(localExecutor ? localExecutor->GetThreadCount() + 1 : 1, shards.size())
+            )
+        {
+            CB_ENSURE(!shards.empty(), "TShardedLineDataReader: no shards");
+            for (const auto& shardPath : shards) {
+                Shards.push_back(MakeAtomicShared<TShard>(shardPath));
+            }
+            for (auto shardIdx : xrange(PrefetchShardCount)) {
+                StartShardReading(shardIdx);
+            }
+        }
+
+        ~TShardedLineDataReader() {
+            // shards that have not been started yet are claimed so that their pending tasks do nothing
+            for (auto& shard : Shards) {
+                if (shard->Started.exchange(true)) {
+                    shard->ReadPromise.GetFuture().Wait();
+                }
+            }
+        }
+
+        ui64 GetDataLineCount() override {
+            if (!DataLineCount) {
+                // shards that are read (or have been read) already are counted by their reading
+                const size_t startedShardCount = Min(CurrentShardIdx + PrefetchShardCount, Shards.size());
+                TVector<ui64> shardDataLineCounts(Shards.size());
+                const auto countShardLines = [&] (int shardIdx) {
+                    auto reader = CreateShardReader(Shards[shardIdx]->Path, Format);
+                    TString line;
+                    ui64 dataLineCount = 0;
+                    while (reader->ReadLine(&line)) {
+                        ++dataLineCount;
+                    }
+                    shardDataLineCounts[shardIdx] = dataLineCount;
+                };
+                if (LocalExecutor) {
+                    LocalExecutor->ExecRangeWithThrow(
+                        countShardLines,
+                        SafeIntegerCast<int>(startedShardCount),
+                        SafeIntegerCast<int>(Shards.size()),
+                        NPar::TLocalExecutor::WAIT_COMPLETE
+                    );
+                } else {
+                    for (auto shardIdx : xrange(startedShardCount, Shards.size())) {
+                        countShardLines(SafeIntegerCast<int>(shardIdx));
+                    }
+                }
+                for (auto shardIdx : xrange(startedShardCount)) {
+                    shardDataLineCounts[shardIdx] = WaitForShard(shardIdx).DataLineCount;
+                }
+                DataLineCount = Accumulate(shardDataLineCounts, ui64(0));
+            }
+            return *DataLineCount;
+        }
+
+        TMaybe<TString> GetHeader() override {
+            CB_ENSURE(
+                CurrentShardIdx == 0 && CurrentLineIdx == 0,
+                "TShardedLineDataReader: GetHeader called after ReadLine"
+            );
+            return WaitForShard(0).Header;
+        }
+
+        bool ReadLine(TString* line) override {
+            while (CurrentShardIdx < Shards.size()) {
+                TShard& shard = WaitForShard(CurrentShardIdx);
+                if (CurrentLineIdx < shard.Lines.size()) {
+                    *line = std::move(shard.Lines[CurrentLineIdx++]);
+                    return true;
+                }
+
+                // release memory used by processed shard
+                TVector<TString>().swap(shard.Lines);
+
+                const size_t shardToReadIdx = CurrentShardIdx + PrefetchShardCount;
+                if (shardToReadIdx < Shards.size()) {
+                    StartShardReading(shardToReadIdx);
+                }
+                ++CurrentShardIdx;
+                CurrentLineIdx = 0;
+            }
+            return false;
+        }
+
+    private:
+        /* Shard reading is claimed either by a background task or by the reading thread when it needs the shard,
+         * so waiting for a shard never depends on free executor threads.
+         * Shards are shared with the background tasks as these can outlive the reader.
+         */
+        struct TShard {
+            TPathWithScheme Path;
+
+            // filled by the reading
+            TMaybe<TString> Header;
+            TVector<TString> Lines;
+            ui64 DataLineCount = 0;
+
+            std::atomic<bool> Started{false};
+            NThreading::TPromise<void> ReadPromise = NThreading::NewPromise();
+
+            bool Checked = false;
+
+        public:
+            explicit TShard(const TPathWithScheme& path)
+                : Path(path)
+            {}
+
+            // returns false if the reading has been claimed already
+            bool TryRead(const TDsvFormatOptions& format) {
+                if (Started.exchange(true)) {
+                    return false;
+                }
+                try {
+                    auto reader = CreateShardReader(Path, format);
+                    Header = reader->GetHeader();
+                    TString line;
+                    while (reader->ReadLine(&line)) {
+                        Lines.push_back(std::move(line));
+                    }
+                    DataLineCount = Lines.size();
+                    ReadPromise.SetValue();
+                } catch (...) {
+                    ReadPromise.SetException(std::current_exception());
+                }
+                return true;
+            }
+        };
+
+    private:
+        static THolder<ILineDataReader> CreateShardReader(const TPathWithScheme& path, const TDsvFormatOptions& format) {
+            return GetProcessor<ILineDataReader, TLineDataReaderArgs>(path, TLineDataReaderArgs{path, format});
+        }
+
+        void StartShardReading(size_t shardIdx) {
+            if (!LocalExecutor || !LocalExecutor->GetThreadCount()) {
+                return; // will be read by WaitForShard
+            }
+            LocalExecutor->Exec(
+                [shard = Shards[shardIdx], format = Format] (int) {
+                    shard->TryRead(format);
+                },
+                0,
+                NPar::TLocalExecutor::HIGH_PRIORITY
+            );
+        }
+
+        TShard& WaitForShard(size_t shardIdx) {
+            TShard& shard = *Shards[shardIdx];
+            if (!shard.Checked) {
+                shard.TryRead(Format);
+                shard.ReadPromise.GetFuture().GetValueSync(); // will rethrow if there was an exception during read
+                CB_ENSURE(
+                    shard.Header == Shards[0]->Header,
+                    "Header of shard '" << shard.Path.Path << "' differs from the header of shard '"
+                    << Shards[0]->Path.Path << "'"
+                );
+                shard.Checked = true;
+            }
+            return shard;
+        }
+
+    private:
+        TDsvFormatOptions Format;
+        NPar::TLocalExecutor* LocalExecutor;
+        TVector<TAtomicSharedPtr<TShard>> Shards;
+        size_t PrefetchShardCount;
+
+        size_t CurrentShardIdx = 0;
+        size_t CurrentLineIdx = 0;
+
+        TMaybe<ui64> DataLineCount; // cached
+    };
+
+    }
+
+
+    THolder<ILineDataReader> GetShardedLineDataReader(TConstArrayRef<TPathWithScheme> shards,
+                                                      const TDsvFormatOptions& format,
+                                                      NPar::TLocalExecutor* localExecutor)
+    {
+        return MakeHolder<TShardedLineDataReader>(shards, format, localExecutor);
     }
 }
@@ -3,9 +3,12 @@
 #include "path_with_scheme.h"
 
 #include <library/object_factory/object_factory.h>
+#include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/maybe.h>
 #include <util/generic/string.h>
+#include <util/system/types.h>
 
 
 
@@ -25,6 +28,7 @@ namespace NCB {
     struct ILineDataReader {
         /* returns number of data lines (w/o header, if present)
            in some cases (e.g. for files, could be expensive)
+           compressed files are decompressed only once: the file reader keeps the lines read for counting
         */
         virtual ui64 GetDataLineCount() = 0;
 
@@ -44,7 +48,25 @@ namespace NCB {
     using TLineDataReaderFactory =
         NObjectFactory::TParametrizedObjectFactory<ILineDataReader, TString, TLineDataReaderArgs>;
 
+    /* if pathWithScheme.Path is a path pattern (see path_pattern.h) data from all matching shards
+     * is read by the reader returned from GetShardedLineDataReader
+     */
     THolder<ILineDataReader> GetLineDataReader(const TPathWithScheme& pathWithScheme,
-                                               const TDsvFormatOptions& format = {});
+                                               const TDsvFormatOptions& format = {},
+                                               NPar::TLocalExecutor* localExecutor = nullptr);
+
+    /* Returns a reader that presents data from several shards as a single data source.
+     * Shards are read (and decompressed if necessary) in advance by localExecutor tasks
+     * (or on demand by the reading thread if localExecutor is nullptr or busy),
+     * but lines are always returned in the order of shards in 'shards' argument,
+     * so the result does not depend on the number of threads.
+     * If format.HasHeader all shards must have the same header.
+     * At most localExecutor->GetThreadCount() + 1 shards are held in memory simultaneously.
+     * GetDataLineCount counts lines of the shards that have not been read yet by a separate pass
+     *  that does not keep them, so such compressed shards are decompressed twice.
+     */
+    THolder<ILineDataReader> GetShardedLineDataReader(TConstArrayRef<TPathWithScheme> shards,
+                                                      const TDsvFormatOptions& format = {},
+                                                      NPar::TLocalExecutor* localExecutor = nullptr);
 
 }
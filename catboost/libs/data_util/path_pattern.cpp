@@ -0,0 +1,78 @@
+#include "path_pattern.h"
+
+#include <util/folder/filelist.h>
+#include <util/generic/algorithm.h>
+#include <util/system/fs.h>
+
+
+namespace NCB {
+
+    static size_t GetFileNameStart(TStringBuf path) {
+        const size_t separatorPos = path.find_last_of(AsStringBuf("/\\"));
+        return (separatorPos == TStringBuf::npos) ? 0 : (separatorPos + 1);
+    }
+
+    bool IsPathPattern(TStringBuf path) {
+        if (path.Tail(GetFileNameStart(path)).find_first_of(AsStringBuf("*?")) == TStringBuf::npos) {
+            return false;
+        }
+        // a file that exists under this exact name is read as is
+        return !NFs::Exists(TString(path));
+    }
+
+    bool MatchesPathPattern(TStringBuf fileName, TStringBuf fileNamePattern) {
+        // greedy matching with backtracking to the last '*'
+        size_t nameIdx = 0;
+        size_t patternIdx = 0;
+        size_t lastStarPatternIdx = TStringBuf::npos;
+        size_t lastStarNameIdx = 0;
+
+        while (nameIdx < fileName.size()) {
+            if ((patternIdx < fileNamePattern.size()) &&
+                ((fileNamePattern[patternIdx] == '?') || (fileNamePattern[patternIdx] == fileName[nameIdx])))
+            {
+                ++nameIdx;
+                ++patternIdx;
+            } else if ((patternIdx < fileNamePattern.size()) && (fileNamePattern[patternIdx] == '*')) {
+                lastStarPatternIdx = patternIdx++;
+                lastStarNameIdx = nameIdx;
+            } else if (lastStarPatternIdx != TStringBuf::npos) {
+                patternIdx = lastStarPatternIdx + 1;
+                nameIdx = ++lastStarNameIdx;
+            } else {
+                return false;
+            }
+        }
+        while ((patternIdx < fileNamePattern.size()) && (fileNamePattern[patternIdx] == '*')) {
+            ++patternIdx;
+        }
+        return patternIdx == fileNamePattern.size();
+    }
+
+    TVector<TString> ExpandPathPattern(TStringBuf pathPattern) {
+        const size_t fileNameStart = GetFileNameStart(pathPattern);
+        const TStringBuf dirPrefix = pathPattern.Head(fileNameStart);
+        const TStringBuf fileNamePattern = pathPattern.Tail(fileNameStart);
+
+        const size_t wildcardPos = fileNamePattern.find_first_of(AsStringBuf("*?"));
+        const size_t lastWildcardPos = fileNamePattern.find_last_of(AsStringBuf("*?"));
+
+        TFileList fileList;
+        fileList.Fill(
+            dirPrefix.empty() ? TString(".") : TString(dirPrefix),
+            fileNamePattern.Head(wildcardPos),
+            fileNamePattern.Tail(lastWildcardPos + 1),
+            /*depth*/ 1
+        );
+
+        TVector<TString> result;
+        while (const char* fileName = fileList.Next()) {
+            if (MatchesPathPattern(fileName, fileNamePattern)) {
+                result.push_back(TString(dirPrefix) + fileName);
+            }
+        }
+        Sort(result);
+        return result;
+    }
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+
+
+namespace NCB {
+
+    /* Path patterns are used to specify datasets split into several shards.
+     * Wildcards ('*' - any sequence of characters, '?' - any single character)
+     * are expanded only in the last (file name) component of the path,
+     * '*' and '?' in directory components are literal (e.g. in "\\?\C:\data\train.tsv").
+     * A path is not a pattern if a file with exactly this name exists.
+     */
+    bool IsPathPattern(TStringBuf path);
+
+    bool MatchesPathPattern(TStringBuf fileName, TStringBuf fileNamePattern);
+
+    // returns matching file paths sorted by name
+    TVector<TString> ExpandPathPattern(TStringBuf pathPattern);
+
+}
@@ -0,0 +1,160 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/libs/data_util/exists_checker.h>
+#include <catboost/libs/data_util/line_data_reader.h>
+#include <catboost/libs/data_util/path_pattern.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/zlib.h>
+#include <util/string/builder.h>
+
+
+using namespace NCB;
+
+
+static void WriteShard(const TString& path, TStringBuf data) {
+    TFileOutput output(path);
+    if (TStringBuf(path).EndsWith(AsStringBuf(".gz"))) {
+        TZLibCompress compressor(&output, ZLib::GZip);
+        compressor.Write(data);
+        compressor.Finish();
+    } else {
+        output.Write(data);
+    }
+}
+
+static TVector<TString> ReadAllLines(ILineDataReader* reader) {
+    TVector<TString> lines;
+    TString line;
+    while (reader->ReadLine(&line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+
+Y_UNIT_TEST_SUITE(LineDataReader) {
+    Y_UNIT_TEST(MatchesPathPattern) {
+        UNIT_ASSERT(MatchesPathPattern("part-00001.tsv.gz", "part-*.tsv.gz"));
+        UNIT_ASSERT(MatchesPathPattern("part-00001.tsv.gz", "part-0000?.tsv.gz"));
+        UNIT_ASSERT(MatchesPathPattern("part.tsv", "*"));
+        UNIT_ASSERT(MatchesPathPattern("part.tsv", "part*"));
+        UNIT_ASSERT(MatchesPathPattern("a.b.c", "*.c"));
+        UNIT_ASSERT(!MatchesPathPattern("part-00001.tsv", "part-*.tsv.gz"));
+        UNIT_ASSERT(!MatchesPathPattern("part-1.tsv", "part-??.tsv"));
+        UNIT_ASSERT(!MatchesPathPattern("train.tsv", "part*"));
+
+        UNIT_ASSERT(IsPathPattern("data/part-*.tsv"));
+        UNIT_ASSERT(!IsPathPattern("data/part-1.tsv"));
+        UNIT_ASSERT(!IsPathPattern("data*/part-1.tsv"));
+        UNIT_ASSERT(!IsPathPattern("\\\\?\\C:\\data\\part-1.tsv"));
+        UNIT_ASSERT(IsPathPattern("\\\\?\\C:\\data\\part-*.tsv"));
+    }
+
+    Y_UNIT_TEST(ExistingFileWithWildcardsInName) {
+        TTempDir tempDir;
+        const TString path = tempDir() + "/part-?.tsv";
+        WriteShard(path, "0\t1\n");
+        WriteShard(tempDir() + "/part-1.tsv", "1\t2\n");
+
+        UNIT_ASSERT(!IsPathPattern(path));
+        UNIT_ASSERT(CheckExists(TPathWithScheme(path)));
+        auto reader = GetLineDataReader(TPathWithScheme(path));
+        UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), TVector<TString>{"0\t1"});
+    }
+
+    Y_UNIT_TEST(CompressedFileReading) {
+        for (bool hasHeader : {false, true}) {
+            for (bool countLines : {false, true}) {
+                TTempDir tempDir;
+                const TString path = tempDir() + "/train.tsv.gz";
+                TStringBuilder data;
+                if (hasHeader) {
+                    data << "Label\tF0\n";
+                }
+                TVector<TString> expectedLines;
+                for (auto lineIdx : xrange(100)) {
+                    expectedLines.push_back(TStringBuilder() << lineIdx << '\t' << lineIdx * 2);
+                    data << expectedLines.back() << '\n';
+                }
+                WriteShard(path, data);
+
+                auto reader = GetLineDataReader(TPathWithScheme(path), TDsvFormatOptions{hasHeader, '\t'});
+                if (hasHeader) {
+                    UNIT_ASSERT_VALUES_EQUAL(reader->GetHeader(), TMaybe<TString>("Label\tF0"));
+                }
+                TString line;
+                UNIT_ASSERT(reader->ReadLine(&line));
+                UNIT_ASSERT_VALUES_EQUAL(line, expectedLines[0]);
+                if (countLines) {
+                    UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), expectedLines.size());
+                }
+                TVector<TString> lines = ReadAllLines(reader.Get());
+                lines.insert(lines.begin(), line);
+                UNIT_ASSERT_VALUES_EQUAL(lines, expectedLines);
+                UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), expectedLines.size());
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ShardedReading) {
+        for (bool hasHeader : {false, true}) {
+            for (ui32 threadCount : {1, 3, 8}) {
+                TTempDir tempDir;
+
+                TVector<TString> expectedLines;
+                for (auto shardIdx : xrange(7)) {
+                    TStringBuilder shardData;
+                    if (hasHeader) {
+                        shardData << "Label\tF0\n";
+                    }
+                    for (auto lineIdx : xrange(shardIdx * 3)) { // shard 0 is empty
+                        TString line = TStringBuilder() << shardIdx << '\t' << lineIdx;
+                        shardData << line << '\n';
+                        expectedLines.push_back(line);
+                    }
+                    WriteShard(
+                        TStringBuilder() << tempDir() << "/part-" << shardIdx << ((shardIdx % 2) ? ".tsv.gz" : ".tsv"),
+                        shardData
+                    );
+                }
+                WriteShard(tempDir() + "/other.tsv", "x\ty\n");
+
+                const TPathWithScheme pathPattern(tempDir() + "/part-*");
+                UNIT_ASSERT(CheckExists(pathPattern));
+
+                NPar::TLocalExecutor localExecutor;
+                localExecutor.RunAdditionalThreads(threadCount - 1);
+                auto reader = GetLineDataReader(
+                    pathPattern,
+                    TDsvFormatOptions{hasHeader, '\t'},
+                    threadCount > 1 ? &localExecutor : nullptr
+                );
+                UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), expectedLines.size());
+                if (hasHeader) {
+                    UNIT_ASSERT_VALUES_EQUAL(reader->GetHeader(), TMaybe<TString>("Label\tF0"));
+                }
+                UNIT_ASSERT_VALUES_EQUAL(ReadAllLines(reader.Get()), expectedLines);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ShardedReadingHeaderMismatch) {
+        TTempDir tempDir;
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(1);
+        WriteShard(tempDir() + "/part-0.tsv", "Label\tF0\n0\t1\n");
+        WriteShard(tempDir() + "/part-1.tsv", "Label\tF1\n0\t1\n");
+
+        auto reader = GetLineDataReader(
+            TPathWithScheme(tempDir() + "/part-*.tsv"),
+            TDsvFormatOptions{true, '\t'},
+            &localExecutor
+        );
+        UNIT_ASSERT_EXCEPTION(ReadAllLines(reader.Get()), TCatBoostException);
+    }
+}
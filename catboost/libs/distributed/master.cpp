@@ -322,7 +322,8 @@ void MapCalcErrors(TLearnContext* ctx) {
             const auto description = metrics[metricIdx]->GetDescription();
             ctx->LearnProgress->MetricsAndTimeHistory.AddLearnError(
                 *metrics[metricIdx].Get(),
-                metrics[metricIdx]->GetFinalError(additiveStats[description]));
+                metrics[metricIdx]->GetFinalError(additiveStats[description]),
+                GetMetricErrorBound(*metrics[metricIdx], additiveStats[description]));
         }
     }
 }
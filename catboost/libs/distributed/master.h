@@ -10,6 +10,8 @@
 #include <catboost/libs/data_new/loader.h>
 #include <catboost/libs/options/load_options.h>
 
+#include <library/chromium_trace/interface.h>
+
 void InitializeMaster(const NCatboostOptions::TSystemOptions& systemOptions);
 void FinalizeMaster(TLearnContext* ctx);
 void SetTrainDataFromQuantizedPool(
@@ -49,6 +51,9 @@ TVector<typename TMapper::TOutput> ApplyMapper(
     TObj<NPar::IEnvironment> environment,
     const typename TMapper::TInput& value = typename TMapper::TInput()) {
 
+    // the signature contains the mapper type, so each map/reduce round trip is a separate trace event
+    CHROMIUM_TRACE_FUNCTION();
+
     NPar::TJobDescription job;
     TVector<typename TMapper::TInput> mapperInput(1);
     mapperInput[0] = value;
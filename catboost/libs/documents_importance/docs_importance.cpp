@@ -8,6 +8,7 @@
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/target/data_providers.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
@@ -40,72 +41,128 @@ static TUpdateMethod ParseUpdateMethod(const TString& updateMethod) {
     return TUpdateMethod(updateType, topSize);
 }
 
-static TDStrResult GetFinalDocumentImportances(
-    const TVector<TVector<double>>& rawImportances,
-    EDocumentStrengthType docImpMethod,
+static std::function<bool(double)> GetImportanceValuesSignPredicate(EImportanceValuesSign importanceValuesSign) {
+    if (importanceValuesSign == EImportanceValuesSign::Positive) {
+        return [](double v){return v > 0;};
+    } else if (importanceValuesSign == EImportanceValuesSign::Negative) {
+        return [](double v){return v < 0;};
+    } else {
+        Y_ASSERT(importanceValuesSign == EImportanceValuesSign::All);
+        return [](double){return true;};
+    }
+}
+
+// (importance, trainDocId) pairs
+using TImportanceCandidates = TVector<std::pair<double, ui32>>;
+
+static bool IsMoreImportant(const std::pair<double, ui32>& first, const std::pair<double, ui32>& second) {
+    const double firstAbs = Abs(first.first);
+    const double secondAbs = Abs(second.first);
+    return firstAbs > secondAbs || (firstAbs == secondAbs && first.second < second.second);
+}
+
+// Keep only topSize most important candidates (in any order).
+static void ShrinkImportanceCandidates(size_t topSize, TImportanceCandidates* candidates) {
+    if (candidates->size() > topSize) {
+        NthElement(candidates->begin(), candidates->begin() + topSize, candidates->end(), IsMoreImportant);
+        candidates->resize(topSize);
+    }
+}
+
+static void AddTopImportancesToResult(
+    TImportanceCandidates* candidates, // sorted by importance if sortByImportance else by trainDocId
+    bool sortByImportance,
     int topSize,
-    EImportanceValuesSign importanceValuesSign
+    const std::function<bool(double)>& predicate,
+    TVector<ui32>* indices,
+    TVector<double>* scores
 ) {
-    const ui32 trainDocCount = rawImportances.size();
-    Y_ASSERT(rawImportances.size() != 0);
-    const ui32 testDocCount = rawImportances[0].size();
-    TVector<TVector<double>> preprocessedImportances;
-    if (docImpMethod == EDocumentStrengthType::Average) {
-        preprocessedImportances = TVector<TVector<double>>(1, TVector<double>(trainDocCount));
-        for (ui32 trainDocId = 0; trainDocId < trainDocCount; ++trainDocId) {
-            for (ui32 testDocId = 0; testDocId < testDocCount; ++testDocId) {
-                preprocessedImportances[0][trainDocId] += rawImportances[trainDocId][testDocId];
-            }
+    if (sortByImportance) {
+        ShrinkImportanceCandidates(topSize, candidates);
+        Sort(candidates->begin(), candidates->end(), IsMoreImportant);
+    }
+    int currentSize = 0;
+    for (const auto& [importance, trainDocId] : *candidates) {
+        if (currentSize == topSize) {
+            break;
         }
-        for (ui32 trainDocId = 0; trainDocId < trainDocCount; ++trainDocId) {
-            preprocessedImportances[0][trainDocId] /= testDocCount;
+        if (predicate(importance)) {
+            scores->push_back(importance);
+            indices->push_back(trainDocId);
         }
+        ++currentSize;
+    }
+}
 
-    } else {
-        Y_ASSERT(docImpMethod == EDocumentStrengthType::PerObject || docImpMethod == EDocumentStrengthType::Raw);
-        preprocessedImportances = TVector<TVector<double>>(testDocCount, TVector<double>(trainDocCount));
+static TDStrResult GetFinalDocumentImportances(
+    TDocumentImportancesEvaluator* leafInfluenceEvaluator,
+    const TProcessedDataProvider& trainProcessedData,
+    const TProcessedDataProvider& testProcessedData,
+    EDocumentStrengthType docImpMethod,
+    int topSize,
+    EImportanceValuesSign importanceValuesSign,
+    NPar::TLocalExecutor* localExecutor,
+    int logPeriod
+) {
+    const ui32 trainDocCount = trainProcessedData.GetObjectCount();
+    const ui32 testDocCount = testProcessedData.GetObjectCount();
+    const std::function<bool(double)> predicate = GetImportanceValuesSignPredicate(importanceValuesSign);
+
+    if (docImpMethod == EDocumentStrengthType::Average) {
+        const TVector<double> averageImportances
+            = leafInfluenceEvaluator->GetAverageDocumentImportances(testProcessedData, logPeriod);
+        TImportanceCandidates candidates(trainDocCount);
         for (ui32 trainDocId = 0; trainDocId < trainDocCount; ++trainDocId) {
-            for (ui32 testDocId = 0; testDocId < testDocCount; ++testDocId) {
-                preprocessedImportances[testDocId][trainDocId] = rawImportances[trainDocId][testDocId];
-            }
+            candidates[trainDocId] = {averageImportances[trainDocId], trainDocId};
         }
+        TDStrResult result(1);
+        AddTopImportancesToResult(
+            &candidates,
+            /*sortByImportance*/ true,
+            topSize,
+            predicate,
+            &result.Indices[0],
+            &result.Scores[0]
+        );
+        return result;
     }
 
-    TDStrResult result(preprocessedImportances.size());
-    for (ui32 testDocId = 0; testDocId < preprocessedImportances.size(); ++testDocId) {
-        TVector<double>& preprocessedImportancesRef = preprocessedImportances[testDocId];
-
-        const ui32 docCount = preprocessedImportancesRef.size();
-        TVector<ui32> indices(docCount);
-        std::iota(indices.begin(), indices.end(), 0);
-        if (docImpMethod != EDocumentStrengthType::Raw) {
-            Sort(indices.begin(), indices.end(), [&](ui32 first, ui32 second) {
-                return Abs(preprocessedImportancesRef[first]) > Abs(preprocessedImportancesRef[second]);
+    Y_ASSERT(docImpMethod == EDocumentStrengthType::PerObject || docImpMethod == EDocumentStrengthType::Raw);
+    // Raw importances are not sorted, so only the first topSize train docs are needed.
+    const bool sortByImportance = docImpMethod != EDocumentStrengthType::Raw;
+    const ui32 trainDocEnd = sortByImportance ? trainDocCount : Min<ui32>(topSize, trainDocCount);
+
+    // Only the top candidates of each test doc are kept between blocks of train docs.
+    TVector<TImportanceCandidates> candidates(testDocCount);
+    leafInfluenceEvaluator->ProcessDocumentImportancesByBlocks(
+        testProcessedData,
+        trainDocEnd,
+        logPeriod,
+        [&] (ui32 start, ui32 end, TVector<TVector<double>>* blockImportances) {
+            NPar::ParallelFor(*localExecutor, 0, testDocCount, [&] (ui32 testDocId) {
+                TImportanceCandidates& candidatesRef = candidates[testDocId];
+                for (ui32 trainDocId = start; trainDocId < end; ++trainDocId) {
+                    candidatesRef.emplace_back((*blockImportances)[trainDocId - start][testDocId], trainDocId);
+                }
+                if (sortByImportance && candidatesRef.size() >= 2 * size_t(topSize)) {
+                    ShrinkImportanceCandidates(topSize, &candidatesRef);
+                }
             });
         }
+    );
 
-        std::function<bool(double)> predicate;
-        if (importanceValuesSign == EImportanceValuesSign::Positive) {
-            predicate = [](double v){return v > 0;};
-        } else if (importanceValuesSign == EImportanceValuesSign::Negative) {
-            predicate = [](double v){return v < 0;};
-        } else {
-            Y_ASSERT(importanceValuesSign == EImportanceValuesSign::All);
-            predicate = [](double){return true;};
-        }
-
-        int currentSize = 0;
-        for (ui32 i = 0; i < docCount; ++i) {
-            if (currentSize == topSize) {
-                break;
-            }
-            if (predicate(preprocessedImportancesRef[indices[i]])) {
-                result.Scores[testDocId].push_back(preprocessedImportancesRef[indices[i]]);
-                result.Indices[testDocId].push_back(indices[i]);
-            }
-            ++currentSize;
-        }
-    }
+    TDStrResult result(testDocCount);
+    NPar::ParallelFor(*localExecutor, 0, testDocCount, [&] (ui32 testDocId) {
+        AddTopImportancesToResult(
+            &candidates[testDocId],
+            sortByImportance,
+            topSize,
+            predicate,
+            &result.Indices[testDocId],
+            &result.Scores[testDocId]
+        );
+        TImportanceCandidates().swap(candidates[testDocId]);
+    });
     return result;
 }
 
@@ -160,8 +217,15 @@ TDStrResult GetDocumentImportances(
     ExecuteTasksInParallel(&tasks, localExecutor.Get());
 
     TDocumentImportancesEvaluator leafInfluenceEvaluator(model, *trainProcessedData, updateMethod, localExecutor, logPeriod);
-    const TVector<TVector<double>> documentImportances
-        = leafInfluenceEvaluator.GetDocumentImportances(*testProcessedData, logPeriod);
-    return GetFinalDocumentImportances(documentImportances, dstrType, topSize, importanceValuesSign);
+    return GetFinalDocumentImportances(
+        &leafInfluenceEvaluator,
+        *trainProcessedData,
+        *testProcessedData,
+        dstrType,
+        topSize,
+        importanceValuesSign,
+        localExecutor.Get(),
+        logPeriod
+    );
 }
 
@@ -18,37 +18,117 @@
 using namespace NCB;
 
 
-TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
-    const TProcessedDataProvider& processedData, int logPeriod
+TTestDocumentsLeavesStatistics TDocumentImportancesEvaluator::GetTestDocumentsLeavesStatistics(
+    const TProcessedDataProvider& processedData
 ) {
-    TVector<TVector<ui32>> leafIndices(TreeCount);
+    TTestDocumentsLeavesStatistics statistics;
+    statistics.DocCount = processedData.GetObjectCount();
+    statistics.LeafIndices.resize(TreeCount);
     auto binarizedFeatures = MakeQuantizedFeaturesForEvaluator(Model, *processedData.ObjectsData.Get());
     LocalExecutor->ExecRange([&] (int treeId) {
-        leafIndices[treeId] = BuildIndicesForBinTree(Model, binarizedFeatures.Get(), treeId);
+        statistics.LeafIndices[treeId] = BuildIndicesForBinTree(Model, binarizedFeatures.Get(), treeId);
+    }, NPar::TLocalExecutor::TExecRangeParams(0, TreeCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    UpdateFinalFirstDerivatives(statistics.LeafIndices, *processedData.TargetData->GetTargetForLoss());
+
+    statistics.LeavesDocId.resize(TreeCount);
+    statistics.LeavesFirstDerivativesSum.resize(TreeCount);
+    LocalExecutor->ExecRange([&] (int treeId) {
+        const ui32 leafCount = 1 << Model.ObliviousTrees->TreeSizes[treeId];
+        const TVector<ui32>& leafIndicesRef = statistics.LeafIndices[treeId];
+        auto& leavesDocIdRef = statistics.LeavesDocId[treeId];
+        auto& leavesFirstDerivativesSumRef = statistics.LeavesFirstDerivativesSum[treeId];
+        leavesDocIdRef.resize(leafCount);
+        leavesFirstDerivativesSumRef.resize(leafCount);
+        for (ui32 docId = 0; docId < statistics.DocCount; ++docId) {
+            leavesDocIdRef[leafIndicesRef[docId]].push_back(docId);
+            leavesFirstDerivativesSumRef[leafIndicesRef[docId]] += FinalFirstDerivatives[docId];
+        }
     }, NPar::TLocalExecutor::TExecRangeParams(0, TreeCount), NPar::TLocalExecutor::WAIT_COMPLETE);
 
+    return statistics;
+}
 
-    UpdateFinalFirstDerivatives(leafIndices, *processedData.TargetData->GetTargetForLoss());
-    TVector<TVector<double>> documentImportances(DocCount, TVector<double>(processedData.GetObjectCount()));
-    const size_t docBlockSize = 1000;
+TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(
+    const TProcessedDataProvider& processedData, int logPeriod
+) {
+    TVector<TVector<double>> documentImportances(DocCount);
+    ProcessDocumentImportancesByBlocks(
+        processedData,
+        DocCount,
+        logPeriod,
+        [&] (ui32 start, ui32 /*end*/, TVector<TVector<double>>* blockImportances) {
+            for (ui32 i = 0; i < blockImportances->size(); ++i) {
+                documentImportances[start + i] = std::move((*blockImportances)[i]);
+            }
+        }
+    );
+    return documentImportances;
+}
+
+void TDocumentImportancesEvaluator::ProcessDocumentImportancesByBlocks(
+    const TProcessedDataProvider& processedData,
+    ui32 trainDocEnd,
+    int logPeriod,
+    const std::function<void(ui32, ui32, TVector<TVector<double>>*)>& processBlock
+) {
+    Y_ASSERT(trainDocEnd <= DocCount);
+    const TTestDocumentsLeavesStatistics testLeavesStatistics = GetTestDocumentsLeavesStatistics(processedData);
+    const ui32 docBlockSize = 1000;
+    TImportanceLogger documentsLogger(trainDocEnd, "documents processed", "Processing documents...", logPeriod);
+    TProfileInfo processDocumentsProfile(trainDocEnd);
+
+    TVector<TVector<double>> blockImportances;
+    for (ui32 start = 0; start < trainDocEnd; start += docBlockSize) {
+        const ui32 end = Min<ui32>(start + docBlockSize, trainDocEnd);
+        processDocumentsProfile.StartIterationBlock();
+
+        blockImportances.resize(end - start);
+        LocalExecutor->ExecRange([&] (int docId) {
+            // The derivative of leaf values with respect to train doc weight.
+            TVector<TVector<double>> treesLeavesDerivatives; // [treeCount][leafCount]
+            GetTreesLeavesDerivatives(docId, &treesLeavesDerivatives);
+            GetDocumentImportancesForOneTrainDoc(
+                treesLeavesDerivatives,
+                testLeavesStatistics,
+                &blockImportances[docId - start]
+            );
+        }, NPar::TLocalExecutor::TExecRangeParams(start, end), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        processBlock(start, end, &blockImportances);
+
+        processDocumentsProfile.FinishIterationBlock(end - start);
+        auto profileResults = processDocumentsProfile.GetProfileResults();
+        documentsLogger.Log(profileResults);
+    }
+}
+
+TVector<double> TDocumentImportancesEvaluator::GetAverageDocumentImportances(
+    const TProcessedDataProvider& processedData, int logPeriod
+) {
+    const TTestDocumentsLeavesStatistics testLeavesStatistics = GetTestDocumentsLeavesStatistics(processedData);
+    TVector<double> documentImportances(DocCount);
+    const ui32 docBlockSize = 1000;
     TImportanceLogger documentsLogger(DocCount, "documents processed", "Processing documents...", logPeriod);
     TProfileInfo processDocumentsProfile(DocCount);
 
-    for (size_t start = 0; start < DocCount; start += docBlockSize) {
-        const size_t end = Min<size_t>(start + docBlockSize, DocCount);
+    for (ui32 start = 0; start < DocCount; start += docBlockSize) {
+        const ui32 end = Min<ui32>(start + docBlockSize, DocCount);
         processDocumentsProfile.StartIterationBlock();
 
         LocalExecutor->ExecRange([&] (int docId) {
-            // The derivative of leaf values with respect to train doc weight.
-            TVector<TVector<TVector<double>>> leafDerivatives(TreeCount, TVector<TVector<double>>(LeavesEstimationIterations)); // [treeCount][LeavesEstimationIterationsCount][leafCount]
-            UpdateLeavesDerivatives(docId, &leafDerivatives);
-            GetDocumentImportancesForOneTrainDoc(leafDerivatives, leafIndices, &documentImportances[docId]);
+            TVector<TVector<double>> treesLeavesDerivatives; // [treeCount][leafCount]
+            GetTreesLeavesDerivatives(docId, &treesLeavesDerivatives);
+            documentImportances[docId] = GetAverageDocumentImportanceForOneTrainDoc(
+                treesLeavesDerivatives,
+                testLeavesStatistics
+            );
         }, NPar::TLocalExecutor::TExecRangeParams(start, end), NPar::TLocalExecutor::WAIT_COMPLETE);
 
         processDocumentsProfile.FinishIterationBlock(end - start);
         auto profileResults = processDocumentsProfile.GetProfileResults();
         documentsLogger.Log(profileResults);
-        }
+    }
     return documentImportances;
 }
 
@@ -56,15 +136,16 @@ void TDocumentImportancesEvaluator::UpdateFinalFirstDerivatives(const TVector<TV
     const ui32 docCount = SafeIntegerCast<ui32>(target.size());
     TVector<double> finalApproxes(docCount);
 
-    for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
-        const TVector<ui32>& leafIndicesRef = leafIndices[treeId];
-        for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
-            const TVector<double>& leafValues = TreesStatistics[treeId].LeafValues[it];
-            for (ui32 docId = 0; docId < docCount; ++docId) {
-                finalApproxes[docId] += leafValues[leafIndicesRef[docId]];
+    NPar::ParallelFor(*LocalExecutor, 0, docCount, [&] (ui32 docId) {
+        double finalApprox = 0;
+        for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
+            const ui32 leafId = leafIndices[treeId][docId];
+            for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
+                finalApprox += TreesStatistics[treeId].LeafValues[it][leafId];
             }
         }
-    }
+        finalApproxes[docId] = finalApprox;
+    });
 
     FinalFirstDerivatives.resize(docCount);
     EvaluateDerivatives(LossFunction, LeafEstimationMethod, finalApproxes, target, &FinalFirstDerivatives, nullptr, nullptr);
@@ -133,29 +214,104 @@ void TDocumentImportancesEvaluator::UpdateLeavesDerivatives(ui32 removedDocId, T
     }
 }
 
+void TDocumentImportancesEvaluator::UpdateLeavesDerivativesSinglePoint(
+    ui32 removedDocId,
+    TVector<TVector<TVector<double>>>* leafDerivatives
+) {
+    // Only the leaf of the removed doc is updated, so the jacobian of other docs stays zero.
+    double removedDocJacobian = 0;
+    for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
+        const auto& treeStatistics = TreesStatistics[treeId];
+        const ui32 removedDocLeafId = treeStatistics.LeafIndices[removedDocId];
+        for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
+            TVector<double>& leafDerivativesRef = (*leafDerivatives)[treeId][it];
+            leafDerivativesRef.assign(treeStatistics.LeafCount, 0);
+            leafDerivativesRef[removedDocLeafId]
+                = (removedDocJacobian * treeStatistics.FormulaNumeratorMultiplier[it][removedDocId]
+                    + treeStatistics.FormulaNumeratorAdding[it][removedDocId])
+                * -LearningRate / treeStatistics.FormulaDenominators[it][removedDocLeafId];
+            removedDocJacobian += leafDerivativesRef[removedDocLeafId];
+        }
+    }
+}
+
+void TDocumentImportancesEvaluator::GetTreesLeavesDerivatives(
+    ui32 removedDocId,
+    TVector<TVector<double>>* treesLeavesDerivatives
+) {
+    TVector<TVector<TVector<double>>> leafDerivatives(TreeCount, TVector<TVector<double>>(LeavesEstimationIterations)); // [treeCount][LeavesEstimationIterationsCount][leafCount]
+    if (UpdateMethod.UpdateType == EUpdateType::SinglePoint) {
+        UpdateLeavesDerivativesSinglePoint(removedDocId, &leafDerivatives);
+    } else {
+        UpdateLeavesDerivatives(removedDocId, &leafDerivatives);
+    }
+
+    treesLeavesDerivatives->resize(TreeCount);
+    for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
+        TVector<double>& treeLeavesDerivatives = (*treesLeavesDerivatives)[treeId];
+        treeLeavesDerivatives = std::move(leafDerivatives[treeId][0]);
+        for (ui32 it = 1; it < LeavesEstimationIterations; ++it) {
+            const TVector<double>& leafDerivativesRef = leafDerivatives[treeId][it];
+            for (ui32 leafId = 0; leafId < treeLeavesDerivatives.size(); ++leafId) {
+                treeLeavesDerivatives[leafId] += leafDerivativesRef[leafId];
+            }
+        }
+    }
+}
+
 void TDocumentImportancesEvaluator::GetDocumentImportancesForOneTrainDoc(
-    const TVector<TVector<TVector<double>>>& leafDerivatives,
-    const TVector<TVector<ui32>>& leafIndices,
+    const TVector<TVector<double>>& treesLeavesDerivatives,
+    const TTestDocumentsLeavesStatistics& testLeavesStatistics,
     TVector<double>* documentImportance
 ) {
-    const ui32 docCount = documentImportance->size();
+    const ui32 docCount = testLeavesStatistics.DocCount;
     TVector<double> predictedDerivatives(docCount);
 
     for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
-        const TVector<ui32>& leafIndicesRef = leafIndices[treeId];
-        for (ui32 it = 0; it < LeavesEstimationIterations; ++it) {
-            const TVector<double>& leafDerivativesRef = leafDerivatives[treeId][it];
+        const TVector<double>& treeLeavesDerivatives = treesLeavesDerivatives[treeId];
+        const ui32 updatedLeafCount = CountIf(treeLeavesDerivatives, [] (double derivative) { return derivative != 0; });
+        if (updatedLeafCount == treeLeavesDerivatives.size()) {
+            const TVector<ui32>& leafIndicesRef = testLeavesStatistics.LeafIndices[treeId];
             for (ui32 docId = 0; docId < docCount; ++docId) {
-                predictedDerivatives[docId] += leafDerivativesRef[leafIndicesRef[docId]];
+                predictedDerivatives[docId] += treeLeavesDerivatives[leafIndicesRef[docId]];
+            }
+        } else {
+            // Only docs from updated leaves are affected (e.g. one leaf for SinglePoint update method).
+            const TVector<TVector<ui32>>& leavesDocIdRef = testLeavesStatistics.LeavesDocId[treeId];
+            for (ui32 leafId = 0; leafId < treeLeavesDerivatives.size(); ++leafId) {
+                const double leafDerivative = treeLeavesDerivatives[leafId];
+                if (leafDerivative == 0) {
+                    continue;
+                }
+                for (ui32 docId : leavesDocIdRef[leafId]) {
+                    predictedDerivatives[docId] += leafDerivative;
+                }
             }
         }
     }
 
+    documentImportance->yresize(docCount);
     for (ui32 docId = 0; docId < docCount; ++docId) {
         (*documentImportance)[docId] = FinalFirstDerivatives[docId] * predictedDerivatives[docId];
     }
 }
 
+double TDocumentImportancesEvaluator::GetAverageDocumentImportanceForOneTrainDoc(
+    const TVector<TVector<double>>& treesLeavesDerivatives,
+    const TTestDocumentsLeavesStatistics& testLeavesStatistics
+) {
+    // Sum over test docs of FinalFirstDerivatives[docId] * predictedDerivatives[docId] grouped by leaves.
+    double importance = 0;
+    for (ui32 treeId = 0; treeId < TreeCount; ++treeId) {
+        const TVector<double>& treeLeavesDerivatives = treesLeavesDerivatives[treeId];
+        const TVector<double>& leavesFirstDerivativesSumRef = testLeavesStatistics.LeavesFirstDerivativesSum[treeId];
+        for (ui32 leafId = 0; leafId < treeLeavesDerivatives.size(); ++leafId) {
+            importance += treeLeavesDerivatives[leafId] * leavesFirstDerivativesSumRef[leafId];
+        }
+    }
+    return importance / testLeavesStatistics.DocCount;
+}
+
 void TDocumentImportancesEvaluator::UpdateLeavesDerivativesForTree(
     const TVector<ui32>& leafIdToUpdate,
     ui32 removedDocId,
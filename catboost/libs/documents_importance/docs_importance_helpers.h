@@ -16,6 +16,8 @@
 #include <util/system/types.h>
 #include <util/system/yassert.h>
 
+#include <functional>
+
 
 /*
  * This is the implementation of the LeafInfluence algorithm from the following paper:
@@ -37,6 +39,14 @@ struct TUpdateMethod {
     int TopSize;
 };
 
+// Per-tree leaf statistics of the pool objects, they are shared by all train objects.
+struct TTestDocumentsLeavesStatistics {
+    ui32 DocCount = 0;
+    TVector<TVector<ui32>> LeafIndices; // [treeCount][docCount] // leafId for every test docId.
+    TVector<TVector<TVector<ui32>>> LeavesDocId; // [treeCount][leafCount] // test docIds for every leafId.
+    TVector<TVector<double>> LeavesFirstDerivativesSum; // [treeCount][leafCount] // Sum of final first derivatives of test docs in leaf.
+};
+
 // The class for document importances evaluation.
 class TDocumentImportancesEvaluator {
 public:
@@ -72,20 +82,44 @@ public:
 
     // Getting the importance of all train objects for all objects from pool.
     TVector<TVector<double>> GetDocumentImportances(const NCB::TProcessedDataProvider& processedData, int logPeriod = 0);
+    // Getting the importance of all train objects averaged over objects from pool.
+    // The importances of train objects for separate objects from pool are not materialized.
+    TVector<double> GetAverageDocumentImportances(const NCB::TProcessedDataProvider& processedData, int logPeriod = 0);
+    /* Getting the importance of train objects [0, trainDocEnd) for all objects from pool by blocks of train objects.
+     * processBlock(start, end, &blockImportances) is called for blocks in order,
+     *  blockImportances is [end - start][pool docCount], so only one block is kept in memory.
+     */
+    void ProcessDocumentImportancesByBlocks(
+        const NCB::TProcessedDataProvider& processedData,
+        ui32 trainDocEnd,
+        int logPeriod,
+        const std::function<void(ui32, ui32, TVector<TVector<double>>*)>& processBlock
+    );
 
 private:
+    // Evaluate leaf indices and final first derivatives for objects from pool.
+    TTestDocumentsLeavesStatistics GetTestDocumentsLeavesStatistics(const NCB::TProcessedDataProvider& processedData);
     // Evaluate first derivatives at the final approxes
     void UpdateFinalFirstDerivatives(const TVector<TVector<ui32>>& leafIndices, TConstArrayRef<float> target);
     // Leaves derivatives will be updated based on objects from these leaves.
     TVector<ui32> GetLeafIdToUpdate(ui32 treeId, const TVector<double>& jacobian);
     // Algorithm 4 from paper.
     void UpdateLeavesDerivatives(ui32 removedDocId, TVector<TVector<TVector<double>>>* leafDerivatives);
+    // Algorithm 4 from paper for SinglePoint update method: only the removed doc jacobian is nonzero.
+    void UpdateLeavesDerivativesSinglePoint(ui32 removedDocId, TVector<TVector<TVector<double>>>* leafDerivatives);
+    // Leaf derivatives summed over leaves estimation iterations.
+    void GetTreesLeavesDerivatives(ui32 removedDocId, TVector<TVector<double>>* treesLeavesDerivatives);
     // Getting the importance of one train object for all objects from pool.
     void GetDocumentImportancesForOneTrainDoc(
-        const TVector<TVector<TVector<double>>>& leafDerivatives,
-        const TVector<TVector<ui32>>& leafIndices,
+        const TVector<TVector<double>>& treesLeavesDerivatives,
+        const TTestDocumentsLeavesStatistics& testLeavesStatistics,
         TVector<double>* documentImportance
     );
+    // Getting the importance of one train object averaged over objects from pool.
+    double GetAverageDocumentImportanceForOneTrainDoc(
+        const TVector<TVector<double>>& treesLeavesDerivatives,
+        const TTestDocumentsLeavesStatistics& testLeavesStatistics
+    );
     // Evaluate leaf derivatives at a given removedDocId weight (Equation (6) from paper).
     void UpdateLeavesDerivativesForTree(
         const TVector<ui32>& leafIdToUpdate,
@@ -99,7 +133,7 @@ private:
 private:
     TFullModel Model;
     TVector<TTreeStatistics> TreesStatistics; // [treeCount]
-    TVector<double> FinalFirstDerivatives; // [docCount]
+    TVector<double> FinalFirstDerivatives; // [test docCount]
     TUpdateMethod UpdateMethod;
     ELossFunction LossFunction;
     ELeavesEstimation LeafEstimationMethod;
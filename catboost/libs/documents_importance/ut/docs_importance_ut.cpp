@@ -0,0 +1,220 @@
+#include <catboost/libs/documents_importance/docs_importance.h>
+
+#include <catboost/libs/data_new/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+#include <library/unittest/registar.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+
+#include <numeric>
+
+
+using namespace NCB;
+
+static const double EPS = 1e-9;
+
+// train objects are processed by blocks of 1000, so the train pool spans several blocks
+static const ui32 TRAIN_OBJECT_COUNT = 2500;
+static const ui32 TEST_OBJECT_COUNT = 200;
+static const ui32 THREAD_COUNT = 4;
+
+static TDataProviderPtr CreateRandomPool(ui32 objectCount, ui32 featureCount, ui64 seed) {
+    TFastRng64 rng(seed);
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(featureCount, TVector<ui32>{}, TVector<TString>{});
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> target(objectCount, 0.0f);
+            for (auto featureIdx : xrange(featureCount)) {
+                TVector<float> feature(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    feature[objectIdx] = rng.GenRandReal1();
+                    target[objectIdx] += feature[objectIdx] * (featureIdx + 1);
+                }
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    TMaybeOwningConstArrayHolder<float>::CreateOwning(std::move(feature))
+                );
+            }
+            for (auto& value : target) {
+                value += rng.GenRandReal1();
+            }
+            visitor->AddTarget(target);
+
+            visitor->Finish();
+        }
+    );
+}
+
+static TFullModel TrainModelOnPool(TDataProviderPtr pool) {
+    TTempDir trainDir;
+
+    TDataProviders dataProviders;
+    dataProviders.Learn = pool;
+
+    NJson::TJsonValue params;
+    params.InsertValue("loss_function", "RMSE");
+    params.InsertValue("iterations", 20);
+    params.InsertValue("depth", 4);
+    params.InsertValue("leaf_estimation_method", "Gradient");
+    params.InsertValue("leaf_estimation_iterations", 2);
+    params.InsertValue("boosting_type", "Plain");
+    params.InsertValue("random_seed", 1);
+    params.InsertValue("train_dir", trainDir.Name());
+
+    TFullModel model;
+    TEvalResult evalResult;
+    TrainModel(
+        params,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        std::move(dataProviders),
+        /*initModel*/ Nothing(),
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {&evalResult}
+    );
+    return model;
+}
+
+namespace {
+    struct TDocsImportanceTestData {
+        TDataProviderPtr Train = CreateRandomPool(TRAIN_OBJECT_COUNT, 5, 0);
+        TDataProviderPtr Test = CreateRandomPool(TEST_OBJECT_COUNT, 5, 1);
+        TFullModel Model = TrainModelOnPool(Train);
+
+        // [testDocId][trainDocId]: Raw importances of all train objects are neither sorted nor shrunk
+        TVector<TVector<double>> GetAllImportances(const TString& updateMethod) const {
+            const TDStrResult raw = GetDocumentImportances(
+                Model, *Train, *Test, "Raw", /*topSize*/ -1, updateMethod, "All", THREAD_COUNT);
+            UNIT_ASSERT_VALUES_EQUAL(raw.Scores.size(), TEST_OBJECT_COUNT);
+            for (auto testDocId : xrange(TEST_OBJECT_COUNT)) {
+                TVector<ui32> expectedIndices(TRAIN_OBJECT_COUNT);
+                std::iota(expectedIndices.begin(), expectedIndices.end(), 0);
+                UNIT_ASSERT_EQUAL(raw.Indices[testDocId], expectedIndices);
+            }
+            return raw.Scores;
+        }
+    };
+}
+
+static const TDocsImportanceTestData& GetTestData() {
+    static const TDocsImportanceTestData data;
+    return data;
+}
+
+// train doc ids in the order of the result: by absolute importance, ties by id
+static TVector<ui32> GetExpectedTop(const TVector<double>& importances, ui32 topSize) {
+    TVector<ui32> order(importances.size());
+    std::iota(order.begin(), order.end(), 0);
+    StableSort(order.begin(), order.end(), [&] (ui32 lhs, ui32 rhs) {
+        return Abs(importances[lhs]) > Abs(importances[rhs]);
+    });
+    order.resize(Min<size_t>(topSize, order.size()));
+    return order;
+}
+
+static void AssertTopImportances(
+    const TVector<double>& importances,
+    ui32 topSize,
+    const TVector<ui32>& indices,
+    const TVector<double>& scores
+) {
+    const TVector<ui32> expectedTop = GetExpectedTop(importances, topSize);
+    UNIT_ASSERT_VALUES_EQUAL(indices.size(), expectedTop.size());
+    UNIT_ASSERT_VALUES_EQUAL(scores.size(), expectedTop.size());
+    for (auto i : xrange(expectedTop.size())) {
+        UNIT_ASSERT_DOUBLES_EQUAL(scores[i], importances[expectedTop[i]], EPS);
+        // equal absolute values may be ordered differently only by floating point noise
+        if (indices[i] != expectedTop[i]) {
+            UNIT_ASSERT_DOUBLES_EQUAL(Abs(importances[indices[i]]), Abs(importances[expectedTop[i]]), EPS);
+        }
+    }
+}
+
+Y_UNIT_TEST_SUITE(TDocumentImportancesTest) {
+    Y_UNIT_TEST(PerObjectTopMatchesAllImportances) {
+        const auto& data = GetTestData();
+        for (const TString updateMethod : {"SinglePoint", "AllPoints", "TopKLeaves:top=3"}) {
+            const TVector<TVector<double>> allImportances = data.GetAllImportances(updateMethod);
+            for (int topSize : {1, 7, 1500, -1}) {
+                const TDStrResult perObject = GetDocumentImportances(
+                    data.Model, *data.Train, *data.Test, "PerObject", topSize, updateMethod, "All", THREAD_COUNT);
+                UNIT_ASSERT_VALUES_EQUAL(perObject.Scores.size(), TEST_OBJECT_COUNT);
+                const ui32 expectedSize = topSize == -1 ? TRAIN_OBJECT_COUNT : topSize;
+                for (auto testDocId : xrange(TEST_OBJECT_COUNT)) {
+                    AssertTopImportances(
+                        allImportances[testDocId],
+                        expectedSize,
+                        perObject.Indices[testDocId],
+                        perObject.Scores[testDocId]
+                    );
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(RawTopIsPrefixOfAllImportances) {
+        const auto& data = GetTestData();
+        const TVector<TVector<double>> allImportances = data.GetAllImportances("SinglePoint");
+        const int topSize = 1200;
+        const TDStrResult raw = GetDocumentImportances(
+            data.Model, *data.Train, *data.Test, "Raw", topSize, "SinglePoint", "All", THREAD_COUNT);
+        for (auto testDocId : xrange(TEST_OBJECT_COUNT)) {
+            UNIT_ASSERT_VALUES_EQUAL(raw.Indices[testDocId].size(), topSize);
+            for (auto i : xrange(topSize)) {
+                UNIT_ASSERT_VALUES_EQUAL(raw.Indices[testDocId][i], i);
+                UNIT_ASSERT_DOUBLES_EQUAL(raw.Scores[testDocId][i], allImportances[testDocId][i], EPS);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(AverageMatchesMeanOfAllImportances) {
+        const auto& data = GetTestData();
+        for (const TString updateMethod : {"SinglePoint", "AllPoints"}) {
+            const TVector<TVector<double>> allImportances = data.GetAllImportances(updateMethod);
+            TVector<double> meanImportances(TRAIN_OBJECT_COUNT);
+            for (const auto& testDocImportances : allImportances) {
+                for (auto trainDocId : xrange(TRAIN_OBJECT_COUNT)) {
+                    meanImportances[trainDocId] += testDocImportances[trainDocId] / TEST_OBJECT_COUNT;
+                }
+            }
+            for (int topSize : {10, -1}) {
+                const TDStrResult average = GetDocumentImportances(
+                    data.Model, *data.Train, *data.Test, "Average", topSize, updateMethod, "All", THREAD_COUNT);
+                UNIT_ASSERT_VALUES_EQUAL(average.Scores.size(), 1);
+                AssertTopImportances(
+                    meanImportances,
+                    topSize == -1 ? TRAIN_OBJECT_COUNT : topSize,
+                    average.Indices[0],
+                    average.Scores[0]
+                );
+            }
+        }
+    }
+
+    Y_UNIT_TEST(SinglePointMatchesGeneralLeavesUpdate) {
+        // TopKLeaves with zero top updates only the leaves of the removed object as SinglePoint does,
+        // but by the general algorithm with the jacobian of all train objects
+        const auto& data = GetTestData();
+        const TVector<TVector<double>> singlePoint = data.GetAllImportances("SinglePoint");
+        const TVector<TVector<double>> general = data.GetAllImportances("TopKLeaves:top=0");
+        for (auto testDocId : xrange(TEST_OBJECT_COUNT)) {
+            for (auto trainDocId : xrange(TRAIN_OBJECT_COUNT)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(singlePoint[testDocId][trainDocId], general[testDocId][trainDocId], EPS);
+            }
+        }
+    }
+}
@@ -0,0 +1,199 @@
+#include "binary_eval_result.h"
+
+#include "column_printer.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/json/json_value.h>
+#include <library/json/json_writer.h>
+
+#include <util/folder/path.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/string/cast.h>
+#include <util/system/byteorder.h>
+
+
+namespace NCB {
+
+    static const TString BinaryScheme = "binary";
+    static const TString ColumnarScheme = "columnar";
+
+    static TString GetColumnFileName(size_t columnIdx) {
+        return ToString(columnIdx) + ".bin";
+    }
+
+    static TString GetSidecarPath(const TPathWithScheme& outputPath) {
+        if (outputPath.Scheme == ColumnarScheme) {
+            return JoinFsPaths(outputPath.Path, "meta.json");
+        }
+        return outputPath.Path + ".json";
+    }
+
+    bool IsBinaryEvalResultScheme(TStringBuf scheme) {
+        return (scheme == BinaryScheme) || (scheme == ColumnarScheme);
+    }
+
+    TBinaryEvalResultWriter::TBinaryEvalResultWriter(
+        const TPathWithScheme& outputPath,
+        EEvalOutputFloatType floatType,
+        const TVector<TString>& outputColumns)
+        : OutputPath(outputPath)
+        , FloatType(floatType)
+    {
+        CB_ENSURE(
+            IsBinaryEvalResultScheme(OutputPath.Scheme),
+            "Unsupported binary eval result output scheme \"" << OutputPath.Scheme << "\""
+        );
+        for (const auto& outputColumn : outputColumns) {
+            EPredictionType predictionType;
+            if (TryFromString<EPredictionType>(outputColumn, predictionType)) {
+                PredictionTypes.push_back(predictionType);
+                continue;
+            }
+            EColumn columnType;
+            CB_ENSURE(
+                TryFromString<EColumn>(ToCanonicalColumnName(outputColumn), columnType)
+                    && (columnType == EColumn::SampleId),
+                "Only prediction columns can be written to " << OutputPath.Scheme << " output, got " << outputColumn
+            );
+        }
+        CB_ENSURE(!PredictionTypes.empty(), "No prediction type chosen for " << OutputPath.Scheme << " output");
+
+        if (OutputPath.Scheme == BinaryScheme) {
+            MatrixOutput = MakeHolder<TOFStream>(OutputPath.Path);
+        } else {
+            TFsPath(OutputPath.Path).MkDirs();
+        }
+    }
+
+    template <class TFloat>
+    void TBinaryEvalResultWriter::AppendColumns(
+        TConstArrayRef<TConstArrayRef<double>> columns,
+        NPar::TLocalExecutor* executor) {
+
+        const size_t columnCount = columns.size();
+        const size_t objectCount = columns.empty() ? 0 : columns[0].size();
+
+        if (MatrixOutput) {
+            TVector<TFloat> matrix;
+            matrix.yresize(objectCount * columnCount);
+            NPar::ParallelFor(
+                *executor,
+                0,
+                SafeIntegerCast<ui32>(objectCount),
+                [&] (ui32 objectIdx) {
+                    TFloat* row = matrix.data() + objectIdx * columnCount;
+                    for (auto columnIdx : xrange(columnCount)) {
+                        row[columnIdx] = HostToLittle(static_cast<TFloat>(columns[columnIdx][objectIdx]));
+                    }
+                }
+            );
+            MatrixOutput->Write(matrix.data(), matrix.size() * sizeof(TFloat));
+        } else {
+            // each column has its own file, so they are written in parallel as well
+            NPar::ParallelFor(
+                *executor,
+                0,
+                SafeIntegerCast<ui32>(columnCount),
+                [&] (ui32 columnIdx) {
+                    TVector<TFloat> column;
+                    column.yresize(objectCount);
+                    for (auto objectIdx : xrange(objectCount)) {
+                        column[objectIdx] = HostToLittle(static_cast<TFloat>(columns[columnIdx][objectIdx]));
+                    }
+                    ColumnOutputs[columnIdx]->Write(column.data(), column.size() * sizeof(TFloat));
+                }
+            );
+        }
+    }
+
+    void TBinaryEvalResultWriter::Append(
+        const TEvalResult& evalResult,
+        const TExternalLabelsHelper& visibleLabelsHelper,
+        TMaybe<std::pair<size_t, size_t>> evalParameters,
+        NPar::TLocalExecutor* executor) {
+
+        TVector<THolder<TEvalPrinter>> evalPrinters;
+        TVector<TString> columnNames;
+        TVector<TConstArrayRef<double>> columns;
+        for (auto predictionType : PredictionTypes) {
+            evalPrinters.push_back(
+                MakeHolder<TEvalPrinter>(
+                    executor,
+                    evalResult.GetRawValuesConstRef(),
+                    predictionType,
+                    visibleLabelsHelper,
+                    evalParameters
+                )
+            );
+            const auto& header = evalPrinters.back()->GetHeader();
+            columnNames.insert(columnNames.end(), header.begin(), header.end());
+            for (const auto& approx : evalPrinters.back()->GetApproxes()) {
+                for (const auto& dimensionApprox : approx) {
+                    columns.push_back(dimensionApprox);
+                }
+            }
+        }
+        Y_ASSERT(columnNames.size() == columns.size());
+
+        if (ColumnNames.empty()) {
+            ColumnNames = std::move(columnNames);
+            if (!MatrixOutput) {
+                for (auto columnIdx : xrange(ColumnNames.size())) {
+                    ColumnOutputs.push_back(
+                        MakeHolder<TOFStream>(JoinFsPaths(OutputPath.Path, GetColumnFileName(columnIdx)))
+                    );
+                }
+            }
+        } else {
+            CB_ENSURE(columnNames == ColumnNames, "Eval result columns differ between blocks");
+        }
+
+        if (FloatType == EEvalOutputFloatType::Float32) {
+            AppendColumns<float>(columns, executor);
+        } else {
+            AppendColumns<double>(columns, executor);
+        }
+        ObjectCount += columns.empty() ? 0 : columns[0].size();
+    }
+
+    void TBinaryEvalResultWriter::Finish(const TVector<TString>& classNames) {
+        if (MatrixOutput) {
+            MatrixOutput->Finish();
+        }
+        for (auto& columnOutput : ColumnOutputs) {
+            columnOutput->Finish();
+        }
+
+        NJson::TJsonValue sidecar;
+        sidecar["format"] = OutputPath.Scheme;
+        sidecar["float_type"] = ToString(FloatType);
+        sidecar["byte_order"] = "little";
+        sidecar["object_count"] = ObjectCount;
+        auto& columnNames = sidecar["column_names"];
+        columnNames.SetType(NJson::JSON_ARRAY);
+        for (const auto& columnName : ColumnNames) {
+            columnNames.AppendValue(columnName);
+        }
+        if (OutputPath.Scheme == ColumnarScheme) {
+            auto& columnFiles = sidecar["column_files"];
+            columnFiles.SetType(NJson::JSON_ARRAY);
+            for (auto columnIdx : xrange(ColumnNames.size())) {
+                columnFiles.AppendValue(GetColumnFileName(columnIdx));
+            }
+        }
+        if (!classNames.empty()) {
+            auto& classNamesJson = sidecar["class_names"];
+            for (const auto& className : classNames) {
+                classNamesJson.AppendValue(className);
+            }
+        }
+
+        TOFStream sidecarOutput(GetSidecarPath(OutputPath));
+        NJson::WriteJson(&sidecarOutput, &sidecar, /*formatOutput*/ true);
+        sidecarOutput.Finish();
+    }
+
+} // namespace NCB
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "eval_result.h"
+
+#include <catboost/libs/data_util/path_with_scheme.h>
+#include <catboost/libs/labels/external_label_helper.h>
+#include <catboost/libs/options/enums.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+#include <util/system/types.h>
+
+#include <utility>
+
+
+namespace NCB {
+
+    /* Binary eval result output for consumers that mmap predictions instead of parsing dsv.
+     *
+     * "binary://PATH" - a row-major [object][column] matrix of little-endian floats in PATH
+     *  described by the JSON sidecar PATH.json
+     * "columnar://PATH" - directory PATH with a file <columnIdx>.bin of little-endian floats
+     *  for each column described by the JSON sidecar PATH/meta.json
+     *
+     * Only prediction columns are written, SampleId is the object index and is skipped.
+     * Class predictions are written as class indices, class names are listed in the sidecar.
+     */
+    bool IsBinaryEvalResultScheme(TStringBuf scheme);
+
+    class TBinaryEvalResultWriter {
+    public:
+        TBinaryEvalResultWriter(
+            const TPathWithScheme& outputPath,
+            EEvalOutputFloatType floatType,
+            const TVector<TString>& outputColumns);
+
+        // appends the next block of objects, evalResult is formatted in parallel in executor
+        void Append(
+            const TEvalResult& evalResult,
+            const TExternalLabelsHelper& visibleLabelsHelper,
+            TMaybe<std::pair<size_t, size_t>> evalParameters,
+            NPar::TLocalExecutor* executor);
+
+        // writes the sidecar, must be called after all blocks have been appended
+        void Finish(const TVector<TString>& classNames = {});
+
+    private:
+        template <class TFloat>
+        void AppendColumns(TConstArrayRef<TConstArrayRef<double>> columns, NPar::TLocalExecutor* executor);
+
+    private:
+        TPathWithScheme OutputPath;
+        EEvalOutputFloatType FloatType;
+        TVector<EPredictionType> PredictionTypes;
+
+        TVector<TString> ColumnNames;
+        ui64 ObjectCount = 0;
+
+        THolder<TOFStream> MatrixOutput; // for "binary"
+        TVector<THolder<TOFStream>> ColumnOutputs; // for "columnar"
+    };
+
+} // namespace NCB
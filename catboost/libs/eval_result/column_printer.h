@@ -183,6 +183,15 @@ namespace NCB {
         void OutputValue(IOutputStream* outStream, size_t docIndex) override;
         void OutputHeader(IOutputStream* outStream) override;
 
+        const TVector<TString>& GetHeader() const {
+            return Header;
+        }
+
+        // [evalIter][dim][docIdx], dim is 1 for class labels
+        const TVector<TVector<TVector<double>>>& GetApproxes() const {
+            return Approxes;
+        }
+
     private:
         TVector<TString> Header;
         TVector<TVector<TVector<double>>> Approxes;
@@ -1,6 +1,7 @@
 #include "calc_fstr.h"
 
 #include "feature_str.h"
+#include "shap_interaction_values.h"
 #include "shap_values.h"
 #include "util.h"
 
@@ -250,6 +251,7 @@ static bool TryGetObjectiveMetric(const TFullModel& model, NCatboostOptions::TLo
 static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
         const TFullModel& model,
         const TDataProvider& dataProvider,
+        const TShapPreparedTreesOptions& preparedTreesOptions,
         NPar::TLocalExecutor* localExecutor)
 {
     NCatboostOptions::TLossDescription metricDescription;
@@ -276,17 +278,25 @@ static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
 
     TRestorableFastRng64 rand(0);
     auto targetData = CreateModelCompatibleProcessedDataProvider(dataset, {metricDescription}, model, &rand, localExecutor).TargetData;
-    TShapPreparedTrees preparedTrees = PrepareTrees(model, &dataset, 0, EPreCalcShapValues::Auto, localExecutor, true);
+    const TShapPreparedTreeRanges preparedTreeRanges(
+        model,
+        &dataset,
+        /*logPeriod*/ 0,
+        EPreCalcShapValues::Auto,
+        localExecutor,
+        /*calcInternalValues*/ true,
+        preparedTreesOptions
+    );
 
     TVector<TMetricHolder> scores(featuresCount + 1);
 
     TConstArrayRef<TQueryInfo> targetQueriesInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
-    TVector<TVector<double>> approx = ApplyModelMulti(model, objectsData, EPredictionType::RawFormulaVal, 0, documentCount,
-                                                      localExecutor);
     TVector<TQueryInfo> queriesInfo(targetQueriesInfo.begin(), targetQueriesInfo.end());
+    TConstArrayRef<float> target = *targetData->GetTarget();
+    TConstArrayRef<float> weights = GetWeights(*targetData);
 
     ui32 blockCount = queriesInfo.empty() ? documentCount : queriesInfo.size();
-    ui32 blockSize = Min(ui32(10000), ui32(1e6) / (featuresCount * approx.ysize())); // shapValues[blockSize][featuresCount][dim] double
+    ui32 blockSize = Min(ui32(10000), ui32(1e6) / (featuresCount * approxDimension)); // shapValues[blockSize][featuresCount][dim] double
 
     NCatboostOptions::TLossDescription lossDescription;
     CB_ENSURE(TryGetLossDescription(model, lossDescription), "No loss_function in model params");
@@ -307,6 +317,12 @@ static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
     THolder<IMetric> metric = std::move(CreateMetricFromDescription(metricDescription, approxDimension)[0]);
     CB_ENSURE(metric->IsAdditiveMetric(), "LossFunctionChange support only additive metric");
 
+    // only YetiRank pairs generation needs approxes of the whole dataset, they are filled by blocks
+    TVector<TVector<double>> approx;
+    if (needYetiRankPairs) {
+        approx.assign(approxDimension, TVector<double>(documentCount));
+    }
+
     TProfileInfo profile(documentCount);
     TImportanceLogger importanceLogger(documentCount, "Process documents", "Started LossFunctionChange calculation", 1);
     for (ui32 queryBegin = 0; queryBegin < blockCount; queryBegin += blockSize) {
@@ -320,7 +336,44 @@ static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
             begin = queriesInfo[queryBegin].Begin;
             end = queriesInfo[queryEnd - 1].End;
         }
+        TVector<TVector<TVector<double>>> shapValues;
+        TVector<TVector<double>> blockApprox; // [dim][docIdx - begin]
+        TVector<TVector<TVector<double>>> rangeShapValues;
+        TVector<TVector<double>> rangeBlockApprox;
+        for (size_t rangeIdx = 0; rangeIdx < preparedTreeRanges.GetRangeCount(); ++rangeIdx) {
+            TMaybe<TShapPreparedTrees> rangePreparedTrees;
+            const bool isFirstRange = rangeIdx == 0;
+            CalcShapValuesInternalForFeature(
+                preparedTreeRanges.GetPreparedTrees(rangeIdx, &rangePreparedTrees),
+                model,
+                0,
+                begin,
+                end,
+                featuresCount,
+                objectsData,
+                isFirstRange ? &shapValues : &rangeShapValues,
+                localExecutor,
+                isFirstRange ? &blockApprox : &rangeBlockApprox);
+            if (isFirstRange) {
+                continue;
+            }
+            for (ui32 docIdx = 0; docIdx < end - begin; ++docIdx) {
+                for (int featureIdx = 0; featureIdx < featuresCount; ++featureIdx) {
+                    for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                        shapValues[docIdx][featureIdx][dimensionIdx] += rangeShapValues[docIdx][featureIdx][dimensionIdx];
+                    }
+                }
+            }
+            for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                for (ui32 docIdx = 0; docIdx < end - begin; ++docIdx) {
+                    blockApprox[dimensionIdx][docIdx] += rangeBlockApprox[dimensionIdx][docIdx];
+                }
+            }
+        }
         if (needYetiRankPairs) {
+            for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                Copy(blockApprox[dimensionIdx].begin(), blockApprox[dimensionIdx].end(), approx[dimensionIdx].begin() + begin);
+            }
             UpdatePairsForYetiRank(
                 approx[0],
                 *targetData->GetTarget(),
@@ -332,45 +385,36 @@ static TVector<std::pair<double, TFeature>> CalcFeatureEffectLossChange(
                 localExecutor
             );
         }
+
+        // metric is evaluated on the block only, so features can be processed in parallel with their own approxes
+        TVector<TQueryInfo> blockQueriesInfo;
+        if (!queriesInfo.empty()) {
+            blockQueriesInfo.reserve(queryEnd - queryBegin);
+            for (ui32 queryIndex = queryBegin; queryIndex < queryEnd; ++queryIndex) {
+                blockQueriesInfo.push_back(std::move(queriesInfo[queryIndex]));
+                blockQueriesInfo.back().Begin -= begin;
+                blockQueriesInfo.back().End -= begin;
+            }
+        }
+        const TConstArrayRef<float> blockTarget = target.Slice(begin, end - begin);
+        const TConstArrayRef<float> blockWeights = weights.empty() ? weights : weights.Slice(begin, end - begin);
+        const int blockEvalEnd = SafeIntegerCast<int>(queriesInfo.empty() ? end - begin : queryEnd - queryBegin);
+
         scores.back().Add(
-            metric->Eval(approx, *targetData->GetTarget(), GetWeights(*targetData), queriesInfo, queryBegin, queryEnd, *localExecutor)
+            metric->Eval(blockApprox, blockTarget, blockWeights, blockQueriesInfo, 0, blockEvalEnd, *localExecutor)
         );
-        TVector<TVector<TVector<double>>> shapValues;
-        CalcShapValuesInternalForFeature(
-            preparedTrees,
-            model,
-            0,
-            begin,
-            end,
-            featuresCount,
-            objectsData,
-            &shapValues,
-            localExecutor);
-
-        for (int featureIdx = 0; featureIdx < featuresCount; ++featureIdx) {
-            NPar::TLocalExecutor::TExecRangeParams blockParams(begin, end);
-            blockParams.SetBlockCountToThreadCount();
-            localExecutor->ExecRange([&](ui32 docIdx) {
-                for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
-                    approx[dimensionIdx][docIdx] -= shapValues[docIdx - begin][featureIdx][dimensionIdx];
+        localExecutor->ExecRangeWithThrow([&](int featureIdx) {
+            TVector<TVector<double>> featureApprox = blockApprox;
+            for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
+                for (ui32 docIdx = 0; docIdx < end - begin; ++docIdx) {
+                    featureApprox[dimensionIdx][docIdx] -= shapValues[docIdx][featureIdx][dimensionIdx];
                 }
-            }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+            }
             scores[featureIdx].Add(
-                    metric->Eval(approx, *targetData->GetTarget(), GetWeights(*targetData), queriesInfo, queryBegin, queryEnd,
-                                 *localExecutor)
+                metric->Eval(featureApprox, blockTarget, blockWeights, blockQueriesInfo, 0, blockEvalEnd, *localExecutor)
             );
-            localExecutor->ExecRange([&](ui32 docIdx) {
-                for (int dimensionIdx = 0; dimensionIdx < approxDimension; ++dimensionIdx) {
-                    approx[dimensionIdx][docIdx] += shapValues[docIdx - begin][featureIdx][dimensionIdx];
-                }
-            }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
-        }
-        if (needYetiRankPairs) {
-            for (ui32 queryIndex = queryBegin; queryIndex < queryEnd; ++queryIndex) {
-                queriesInfo[queryIndex].Competitors.clear();
-                queriesInfo[queryIndex].Competitors.shrink_to_fit();
-            }
-        }
+        }, 0, featuresCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
         profile.FinishIterationBlock(end - begin);
         importanceLogger.Log(profile.GetProfileResults());
     }
@@ -411,14 +455,15 @@ TVector<std::pair<double, TFeature>> CalcFeatureEffect(
         const TFullModel& model,
         const TDataProviderPtr dataset,
         EFstrType type,
-        NPar::TLocalExecutor* localExecutor)
+        NPar::TLocalExecutor* localExecutor,
+        const TShapPreparedTreesOptions& preparedTreesOptions)
 {
     //TODO(eermishkina): support non symmetric trees
     CB_ENSURE(model.IsOblivious(), "Feature importance is supported only for symmetric trees");
     type = GetFeatureImportanceType(model, bool(dataset), type);
     if (type == EFstrType::LossFunctionChange) {
         CB_ENSURE(dataset, "dataset is not provided");
-        return CalcFeatureEffectLossChange(model, *dataset.Get(), localExecutor);
+        return CalcFeatureEffectLossChange(model, *dataset.Get(), preparedTreesOptions, localExecutor);
     } else {
         return CalcFeatureEffectAverageChange(model, dataset, localExecutor);
     }
@@ -718,6 +763,23 @@ TVector<TVector<double>> GetFeatureImportances(
 
             return CalcShapValues(model, *dataset, logPeriod, mode, &localExecutor);
         }
+        case EFstrType::ShapInteractionValues: {
+            CB_ENSURE(dataset, "dataset is not provided");
+            CB_ENSURE(
+                model.GetDimensionsCount() == 1,
+                "Use GetFeatureImportancesMulti for SHAP interaction values of multidimensional models"
+            );
+
+            NPar::TLocalExecutor localExecutor;
+            localExecutor.RunAdditionalThreads(threadCount - 1);
+
+            auto interactionValues = CalcShapInteractionValuesMulti(model, *dataset, logPeriod, &localExecutor);
+            TVector<TVector<double>> result(interactionValues.size());
+            for (auto documentIdx : xrange(interactionValues.size())) {
+                result[documentIdx] = std::move(interactionValues[documentIdx][0]);
+            }
+            return result;
+        }
         default:
             Y_UNREACHABLE();
     }
@@ -734,13 +796,19 @@ TVector<TVector<TVector<double>>> GetFeatureImportancesMulti(
     TSetLoggingVerboseOrSilent inThisScope(logPeriod);
     CB_ENSURE(model.GetTreeCount(), "Model is not trained");
 
-    CB_ENSURE(fstrType == EFstrType::ShapValues, "Only shap values can provide multi approxes.");
+    CB_ENSURE(
+        fstrType == EFstrType::ShapValues || fstrType == EFstrType::ShapInteractionValues,
+        "Only shap values and shap interaction values can provide multi approxes."
+    );
 
     CB_ENSURE(dataset, "dataset is not provided");
 
     NPar::TLocalExecutor localExecutor;
     localExecutor.RunAdditionalThreads(threadCount - 1);
 
+    if (fstrType == EFstrType::ShapInteractionValues) {
+        return CalcShapInteractionValuesMulti(model, *dataset, logPeriod, &localExecutor);
+    }
     return CalcShapValuesMulti(model, *dataset, logPeriod, mode, &localExecutor);
 }
 
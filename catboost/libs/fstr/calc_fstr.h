@@ -1,5 +1,7 @@
 #pragma once
 
+#include "shap_values.h"
+
 #include <catboost/libs/algo/split.h>
 #include <catboost/libs/data_new/data_provider.h>
 #include <catboost/libs/model/model.h>
@@ -110,7 +112,8 @@ TVector<std::pair<double, TFeature>> CalcFeatureEffect(
     const TFullModel& model,
     const NCB::TDataProviderPtr dataset, // can be nullptr
     EFstrType type,
-    NPar::TLocalExecutor* localExecutor);
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions());
 
 TVector<TFeatureEffect> CalcRegularFeatureEffect(
     const TVector<std::pair<double, TFeature>>& effect,
@@ -0,0 +1,535 @@
+#include "shap_interaction_values.h"
+
+#include "util.h"
+
+#include <catboost/libs/algo/model_quantization_adapter.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/loggers/logger.h>
+#include <catboost/libs/logging/profile_info.h>
+#include <catboost/libs/model/cpu/quantization.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/maybe.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/stream/file.h>
+
+
+using namespace NCB;
+
+
+namespace {
+    // interaction values for all leaves of a tree, features are local for the tree
+    struct TShapInteractionValuesForTree {
+        TVector<int> Features; // [localFeatureIdx] -> combination class
+
+        // [((leafIdx * featureCount + firstLocalFeature) * featureCount + secondLocalFeature) * approxDimension + dim]
+        TVector<double> Values;
+    };
+
+    struct TShapInteractionPreparedTrees {
+        size_t TreeRangeBegin = 0;
+        size_t TreeRangeEnd = 0;
+        TVector<TShapInteractionValuesForTree> ValuesByTree; // [treeIdx - TreeRangeBegin]
+    };
+} //anonymous
+
+/* Calculation for a tree takes O(2^(depth + features) * features^2) time, this limits it to minutes for a tree
+ *  (e.g. depth 13 with 13 distinct features or depth 16 with 10 of them).
+ */
+static constexpr int MAX_TREE_DEPTH_AND_FEATURES_SUM = 26;
+
+// bits of value at positions of mask bits, packed to the lowest bits
+static size_t ExtractBits(size_t value, size_t mask) {
+    size_t result = 0;
+    for (size_t resultBit = 1; mask; mask &= mask - 1, resultBit <<= 1) {
+        if (value & mask & ~(mask - 1)) {
+            result |= resultBit;
+        }
+    }
+    return result;
+}
+
+// inverse of ExtractBits, bits of the result out of mask are 0
+static size_t DepositBits(size_t bits, size_t mask) {
+    size_t result = 0;
+    for (size_t bit = 1; mask; mask &= mask - 1, bit <<= 1) {
+        if (bits & bit) {
+            result |= mask & ~(mask - 1);
+        }
+    }
+    return result;
+}
+
+static void CalcShapInteractionValuesForTree(
+    const TObliviousTrees& forest,
+    const TShapPreparedTrees& shapPreparedTrees,
+    size_t treeIdx,
+    TShapInteractionValuesForTree* result
+) {
+    const int treeDepth = forest.TreeSizes[treeIdx];
+    const int approxDimension = forest.ApproxDimension;
+    const size_t leafCount = size_t(1) << treeDepth;
+    const TVector<TVector<double>>& subtreeWeights = shapPreparedTrees.SubtreeWeightsForAllTrees[treeIdx];
+
+    TVector<int>& features = result->Features;
+    features.clear();
+    TVector<int> localFeatureForDepth(treeDepth);
+    for (int depth = 0; depth < treeDepth; ++depth) {
+        const int combinationClass = shapPreparedTrees.BinFeatureCombinationClass[
+            forest.TreeSplits[forest.TreeStartOffsets[treeIdx] + depth]
+        ];
+        const auto featureIt = Find(features.begin(), features.end(), combinationClass);
+        localFeatureForDepth[depth] = featureIt - features.begin();
+        if (featureIt == features.end()) {
+            features.push_back(combinationClass);
+        }
+    }
+    const int featureCount = features.size();
+    CB_ENSURE(
+        treeDepth + featureCount <= MAX_TREE_DEPTH_AND_FEATURES_SUM,
+        "SHAP interaction values are supported only for trees with depth + number of distinct features <= "
+        << MAX_TREE_DEPTH_AND_FEATURES_SUM << ", tree " << treeIdx << " has depth " << treeDepth
+        << " and " << featureCount << " features, use ShapValues for such models"
+    );
+    const size_t subsetCount = size_t(1) << featureCount;
+
+    // [subset] -> leaf index bits of depths with features from subset
+    TVector<size_t> knownDepthsMasks(subsetCount, 0);
+    /* expected value of the tree for a document from a leaf if only features from subset are known
+     *  depends only on the leaf index bits of known depths, so only values for them are stored:
+     *  [subsetOffsets[subset] + ExtractBits(leafIdx, knownDepthsMasks[subset]) * approxDimension + dim]
+     */
+    TVector<size_t> subsetOffsets(subsetCount + 1, 0);
+    for (size_t subset = 0; subset < subsetCount; ++subset) {
+        size_t knownDepthCount = 0;
+        for (int depth = 0; depth < treeDepth; ++depth) {
+            if (subset & (size_t(1) << localFeatureForDepth[depth])) {
+                knownDepthsMasks[subset] |= size_t(1) << depth;
+                ++knownDepthCount;
+            }
+        }
+        subsetOffsets[subset + 1] = subsetOffsets[subset] + (size_t(1) << knownDepthCount) * approxDimension;
+    }
+    TVector<double> conditionalValues;
+    conditionalValues.yresize(subsetOffsets.back());
+
+    const double* leafValues = forest.GetFirstLeafPtrForTree(treeIdx);
+    TVector<double> valuesForSubset;
+    valuesForSubset.yresize(leafCount * approxDimension);
+    for (size_t subset = 0; subset < subsetCount; ++subset) {
+        double* values = valuesForSubset.data();
+        Copy(leafValues, leafValues + leafCount * approxDimension, values);
+
+        // unknown features' splits are replaced by the weighted average of subtrees from the bottom up
+        for (int depth = treeDepth - 1; depth >= 0; --depth) {
+            if (subset & (size_t(1) << localFeatureForDepth[depth])) {
+                continue;
+            }
+            const size_t depthBit = size_t(1) << depth;
+            for (size_t leafIdx = 0; leafIdx < leafCount; ++leafIdx) {
+                if (leafIdx & depthBit) {
+                    continue;
+                }
+                const size_t nodeIdx = leafIdx & (depthBit - 1);
+                const double nodeWeight = subtreeWeights[depth][nodeIdx];
+                const double leftWeight = subtreeWeights[depth + 1][nodeIdx];
+                const double rightWeight = subtreeWeights[depth + 1][nodeIdx | depthBit];
+                const bool isEmptyNode = FuzzyEquals(1 + nodeWeight, 1 + 0.0);
+
+                double* leftValues = values + leafIdx * approxDimension;
+                double* rightValues = values + (leafIdx | depthBit) * approxDimension;
+                for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                    const double value = isEmptyNode ?
+                        0.0
+                        : (leftWeight * leftValues[dimension] + rightWeight * rightValues[dimension]) / nodeWeight;
+                    leftValues[dimension] = value;
+                    rightValues[dimension] = value;
+                }
+            }
+        }
+
+        // values are the same for all leaves with the same known depths' bits
+        const size_t knownDepthsMask = knownDepthsMasks[subset];
+        double* dst = conditionalValues.data() + subsetOffsets[subset];
+        const size_t storedCount = (subsetOffsets[subset + 1] - subsetOffsets[subset]) / approxDimension;
+        for (size_t knownBits = 0; knownBits < storedCount; ++knownBits) {
+            const double* src = values + DepositBits(knownBits, knownDepthsMask) * approxDimension;
+            Copy(src, src + approxDimension, dst + knownBits * approxDimension);
+        }
+    }
+
+    TVector<double> factorials(featureCount + 1, 1.0);
+    for (int i = 1; i <= featureCount; ++i) {
+        factorials[i] = factorials[i - 1] * i;
+    }
+    TVector<int> subsetSizes(subsetCount, 0);
+    for (size_t subset = 1; subset < subsetCount; ++subset) {
+        subsetSizes[subset] = subsetSizes[subset >> 1] + (subset & 1);
+    }
+
+    TVector<const double*> leafConditionalValues(subsetCount); // [subset]
+    auto getConditionalValues = [&] (size_t subset) {
+        return leafConditionalValues[subset];
+    };
+
+    result->Values.assign(leafCount * featureCount * featureCount * approxDimension, 0.0);
+    TVector<double> shapValues(featureCount * approxDimension);
+    for (size_t leafIdx = 0; leafIdx < leafCount; ++leafIdx) {
+        double* leafInteractionValues = result->Values.data() + leafIdx * featureCount * featureCount * approxDimension;
+        auto getInteractionValues = [=] (int firstFeature, int secondFeature) {
+            return leafInteractionValues + (firstFeature * featureCount + secondFeature) * approxDimension;
+        };
+
+        for (size_t subset = 0; subset < subsetCount; ++subset) {
+            leafConditionalValues[subset] = conditionalValues.data() + subsetOffsets[subset]
+                + ExtractBits(leafIdx, knownDepthsMasks[subset]) * approxDimension;
+        }
+
+        Fill(shapValues.begin(), shapValues.end(), 0.0);
+        for (size_t subset = 0; subset < subsetCount; ++subset) {
+            const int subsetSize = subsetSizes[subset];
+            const double* subsetValues = getConditionalValues(subset);
+            for (int firstFeature = 0; firstFeature < featureCount; ++firstFeature) {
+                const size_t firstBit = size_t(1) << firstFeature;
+                if (subset & firstBit) {
+                    continue;
+                }
+                const double* withFirstValues = getConditionalValues(subset | firstBit);
+                const double shapCoefficient
+                    = factorials[subsetSize] * factorials[featureCount - subsetSize - 1] / factorials[featureCount];
+                for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                    shapValues[firstFeature * approxDimension + dimension]
+                        += shapCoefficient * (withFirstValues[dimension] - subsetValues[dimension]);
+                }
+
+                for (int secondFeature = firstFeature + 1; secondFeature < featureCount; ++secondFeature) {
+                    const size_t secondBit = size_t(1) << secondFeature;
+                    if (subset & secondBit) {
+                        continue;
+                    }
+                    const double* withSecondValues = getConditionalValues(subset | secondBit);
+                    const double* withBothValues = getConditionalValues(subset | firstBit | secondBit);
+                    const double interactionCoefficient
+                        = factorials[subsetSize] * factorials[featureCount - subsetSize - 2]
+                            / (2 * factorials[featureCount - 1]);
+                    double* firstSecondValues = getInteractionValues(firstFeature, secondFeature);
+                    for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                        firstSecondValues[dimension] += interactionCoefficient * (
+                            withBothValues[dimension] - withFirstValues[dimension]
+                            - withSecondValues[dimension] + subsetValues[dimension]
+                        );
+                    }
+                }
+            }
+        }
+
+        // main effects: shap value minus interactions with all other features
+        for (int firstFeature = 0; firstFeature < featureCount; ++firstFeature) {
+            double* mainEffectValues = getInteractionValues(firstFeature, firstFeature);
+            for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                mainEffectValues[dimension] = shapValues[firstFeature * approxDimension + dimension];
+            }
+            for (int secondFeature = 0; secondFeature < featureCount; ++secondFeature) {
+                if (secondFeature == firstFeature) {
+                    continue;
+                }
+                if (secondFeature > firstFeature) {
+                    Copy(
+                        getInteractionValues(firstFeature, secondFeature),
+                        getInteractionValues(firstFeature, secondFeature) + approxDimension,
+                        getInteractionValues(secondFeature, firstFeature)
+                    );
+                }
+                const double* interactionValues = getInteractionValues(firstFeature, secondFeature);
+                for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                    mainEffectValues[dimension] -= interactionValues[dimension];
+                }
+            }
+        }
+    }
+}
+
+// upper bound: each tree has at most depth distinct features
+static ui64 EstimatePreparedTreeMemoryUsage(const TObliviousTrees& forest, size_t treeIdx) {
+    const ui64 treeDepth = forest.TreeSizes[treeIdx];
+    return (ui64(1) << treeDepth) * treeDepth * treeDepth * forest.ApproxDimension * sizeof(double);
+}
+
+// returns tree ranges bounds, i-th range is [result[i], result[i + 1])
+static TVector<size_t> SplitTreesByPreparedMemoryUsage(const TObliviousTrees& forest, ui64 maxMemoryUsage) {
+    const size_t treeCount = forest.GetTreeCount();
+
+    TVector<size_t> treeRangesBounds = {0};
+    ui64 rangeMemoryUsage = 0;
+    for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
+        const ui64 treeMemoryUsage = EstimatePreparedTreeMemoryUsage(forest, treeIdx);
+        if ((treeIdx != treeRangesBounds.back()) && (rangeMemoryUsage + treeMemoryUsage > maxMemoryUsage)) {
+            treeRangesBounds.push_back(treeIdx);
+            rangeMemoryUsage = 0;
+        }
+        rangeMemoryUsage += treeMemoryUsage;
+    }
+    if (treeRangesBounds.back() != treeCount) {
+        treeRangesBounds.push_back(treeCount);
+    }
+    return treeRangesBounds;
+}
+
+static TShapInteractionPreparedTrees PrepareTreesForRange(
+    const TFullModel& model,
+    const TShapPreparedTrees& shapPreparedTrees,
+    size_t treeRangeBegin,
+    size_t treeRangeEnd,
+    NPar::TLocalExecutor* localExecutor
+) {
+    TShapInteractionPreparedTrees preparedTrees;
+    preparedTrees.TreeRangeBegin = treeRangeBegin;
+    preparedTrees.TreeRangeEnd = treeRangeEnd;
+    preparedTrees.ValuesByTree.resize(treeRangeEnd - treeRangeBegin);
+
+    localExecutor->ExecRangeWithThrow(
+        [&] (int treeIdx) {
+            CalcShapInteractionValuesForTree(
+                *model.ObliviousTrees,
+                shapPreparedTrees,
+                treeIdx,
+                &preparedTrees.ValuesByTree[treeIdx - treeRangeBegin]
+            );
+        },
+        SafeIntegerCast<int>(treeRangeBegin),
+        SafeIntegerCast<int>(treeRangeEnd),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+    return preparedTrees;
+}
+
+// interactionValuesForBlock must be initialized, values for documents in [start, end) are added to them
+static void AddShapInteractionValuesForDocumentBlock(
+    const TFullModel& model,
+    const TShapPreparedTrees& shapPreparedTrees,
+    const TShapInteractionPreparedTrees& preparedTrees,
+    const TObjectsDataProvider& objectsData,
+    size_t start,
+    size_t end,
+    NPar::TLocalExecutor* localExecutor,
+    TArrayRef<TVector<TVector<double>>> interactionValuesForBlock
+) {
+    const size_t documentCount = end - start;
+    Y_ASSERT(interactionValuesForBlock.size() == documentCount);
+    if (documentCount == 0) {
+        return;
+    }
+
+    auto binarizedFeaturesForBlock = MakeQuantizedFeaturesForEvaluator(model, objectsData, start, end);
+    const auto* quantizedData
+        = reinterpret_cast<const NModelEvaluation::TCPUEvaluatorQuantizedData*>(binarizedFeaturesForBlock.Get());
+
+    const int approxDimension = model.GetDimensionsCount();
+    const size_t flatFeatureCount = objectsData.GetFeaturesLayout()->GetExternalFeatureCount();
+    const size_t rowSize = flatFeatureCount + 1;
+    const TVector<TVector<int>>& combinationClassFeatures = shapPreparedTrees.CombinationClassFeatures;
+
+    const size_t treeBegin = preparedTrees.TreeRangeBegin;
+    const size_t treeEnd = preparedTrees.TreeRangeEnd;
+
+    localExecutor->ExecRangeWithThrow(
+        [&] (int subBlockIdx) {
+            const auto subBlock = quantizedData->ExtractBlock(subBlockIdx);
+            const size_t subBlockDocumentCount = subBlock.GetObjectsCount();
+
+            TVector<NModelEvaluation::TCalcerIndexType> leafIndexes(subBlockDocumentCount * (treeEnd - treeBegin), 0);
+            model.GetCurrentEvaluator()->CalcLeafIndexes(&subBlock, treeBegin, treeEnd, leafIndexes);
+
+            TVector<TVector<double>>* dstForSubBlock = interactionValuesForBlock.data()
+                + subBlockIdx * NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE;
+
+            for (size_t treeIdx = treeBegin; treeIdx < treeEnd; ++treeIdx) {
+                const TShapInteractionValuesForTree& valuesForTree = preparedTrees.ValuesByTree[treeIdx - treeBegin];
+                const int featureCount = valuesForTree.Features.size();
+                const size_t leafValuesSize = featureCount * featureCount * approxDimension;
+
+                for (size_t documentIdx = 0; documentIdx < subBlockDocumentCount; ++documentIdx) {
+                    const size_t leafIdx = leafIndexes[(treeIdx - treeBegin) * subBlockDocumentCount + documentIdx];
+                    const double* leafValues = valuesForTree.Values.data() + leafIdx * leafValuesSize;
+                    TVector<TVector<double>>& dst = dstForSubBlock[documentIdx];
+
+                    for (int firstFeature = 0; firstFeature < featureCount; ++firstFeature) {
+                        const auto& firstFlatFeatures = combinationClassFeatures[valuesForTree.Features[firstFeature]];
+                        for (int secondFeature = 0; secondFeature < featureCount; ++secondFeature) {
+                            const auto& secondFlatFeatures
+                                = combinationClassFeatures[valuesForTree.Features[secondFeature]];
+                            const double coefficient = 1.0 / (firstFlatFeatures.size() * secondFlatFeatures.size());
+                            const double* values
+                                = leafValues + (firstFeature * featureCount + secondFeature) * approxDimension;
+                            for (int firstFlatFeature : firstFlatFeatures) {
+                                for (int secondFlatFeature : secondFlatFeatures) {
+                                    const size_t dstIdx = firstFlatFeature * rowSize + secondFlatFeature;
+                                    for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                                        dst[dimension][dstIdx] += coefficient * values[dimension];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        },
+        0,
+        SafeIntegerCast<int>(quantizedData->BlocksCount),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+
+    TVector<double> meanValue(approxDimension, 0.0);
+    for (size_t treeIdx = treeBegin; treeIdx < treeEnd; ++treeIdx) {
+        for (int dimension = 0; dimension < approxDimension; ++dimension) {
+            meanValue[dimension] += shapPreparedTrees.MeanValuesForAllTrees[treeIdx][dimension];
+        }
+    }
+    for (auto& documentValues : interactionValuesForBlock) {
+        for (int dimension = 0; dimension < approxDimension; ++dimension) {
+            documentValues[dimension][flatFeatureCount * rowSize + flatFeatureCount] += meanValue[dimension];
+        }
+    }
+}
+
+static void CalcShapInteractionValuesByDocumentBlocks(
+    const TFullModel& model,
+    const TDataProvider& dataset,
+    int logPeriod,
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions,
+    size_t documentBlockSize,
+    const std::function<void(size_t, size_t, TVector<TVector<TVector<double>>>*)>& processDocumentBlock
+) {
+    CB_ENSURE(model.IsOblivious(), "SHAP interaction values are supported only for symmetric trees");
+
+    // calculates subtree weights and mean values for all trees without precalculation of shap values for leaves
+    const TShapPreparedTrees shapPreparedTrees = PrepareTrees(
+        model,
+        &dataset,
+        logPeriod,
+        EPreCalcShapValues::NoPreCalc,
+        localExecutor
+    );
+
+    const TVector<size_t> treeRangesBounds
+        = SplitTreesByPreparedMemoryUsage(*model.ObliviousTrees, preparedTreesOptions.MaxMemoryUsage);
+    const size_t treeRangeCount = treeRangesBounds.size() - 1;
+    if (treeRangeCount > 1) {
+        CATBOOST_INFO_LOG << "SHAP interaction values for leaves are calculated in " << treeRangeCount
+            << " tree ranges for each block of documents to fit in memory limit" << Endl;
+    }
+
+    TMaybe<TShapInteractionPreparedTrees> singleRangePreparedTrees;
+    if (treeRangeCount == 1) {
+        singleRangePreparedTrees
+            = PrepareTreesForRange(model, shapPreparedTrees, 0, model.GetTreeCount(), localExecutor);
+    }
+
+    const size_t documentCount = dataset.ObjectsGrouping->GetObjectCount();
+    const int approxDimension = model.GetDimensionsCount();
+    const size_t rowSize = dataset.ObjectsData->GetFeaturesLayout()->GetExternalFeatureCount() + 1;
+
+    TImportanceLogger documentsLogger(documentCount, "documents processed", "Processing documents...", logPeriod);
+    TProfileInfo processDocumentsProfile(documentCount);
+
+    for (size_t start = 0; start < documentCount; start += documentBlockSize) {
+        size_t end = Min(start + documentBlockSize, documentCount);
+
+        processDocumentsProfile.StartIterationBlock();
+
+        TVector<TVector<TVector<double>>> interactionValuesForBlock(
+            end - start,
+            TVector<TVector<double>>(approxDimension, TVector<double>(rowSize * rowSize, 0.0))
+        );
+
+        for (size_t treeRangeIdx = 0; treeRangeIdx < treeRangeCount; ++treeRangeIdx) {
+            TMaybe<TShapInteractionPreparedTrees> rangePreparedTrees;
+            if (!singleRangePreparedTrees) {
+                rangePreparedTrees = PrepareTreesForRange(
+                    model,
+                    shapPreparedTrees,
+                    treeRangesBounds[treeRangeIdx],
+                    treeRangesBounds[treeRangeIdx + 1],
+                    localExecutor
+                );
+            }
+            AddShapInteractionValuesForDocumentBlock(
+                model,
+                shapPreparedTrees,
+                singleRangePreparedTrees ? *singleRangePreparedTrees : *rangePreparedTrees,
+                *dataset.ObjectsData,
+                start,
+                end,
+                localExecutor,
+                interactionValuesForBlock
+            );
+        }
+
+        processDocumentBlock(start, end, &interactionValuesForBlock);
+
+        processDocumentsProfile.FinishIterationBlock(end - start);
+        auto profileResults = processDocumentsProfile.GetProfileResults();
+        documentsLogger.Log(profileResults);
+    }
+}
+
+TVector<TVector<TVector<double>>> CalcShapInteractionValuesMulti(
+    const TFullModel& model,
+    const TDataProvider& dataset,
+    int logPeriod,
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions
+) {
+    TVector<TVector<TVector<double>>> interactionValues(dataset.ObjectsGrouping->GetObjectCount());
+
+    // all documents are in memory anyway so prepared trees are calculated once for each tree range
+    CalcShapInteractionValuesByDocumentBlocks(
+        model,
+        dataset,
+        logPeriod,
+        localExecutor,
+        preparedTreesOptions,
+        /*documentBlockSize*/ Max<size_t>(interactionValues.size(), 1),
+        [&] (size_t start, size_t /*end*/, TVector<TVector<TVector<double>>>* interactionValuesForBlock) {
+            for (auto documentIdx : xrange(interactionValuesForBlock->size())) {
+                interactionValues[start + documentIdx] = std::move((*interactionValuesForBlock)[documentIdx]);
+            }
+        }
+    );
+
+    return interactionValues;
+}
+
+void CalcAndOutputShapInteractionValues(
+    const TFullModel& model,
+    const TDataProvider& dataset,
+    const TString& outputPath,
+    int logPeriod,
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions
+) {
+    TFileOutput out(outputPath);
+
+    CalcShapInteractionValuesByDocumentBlocks(
+        model,
+        dataset,
+        logPeriod,
+        localExecutor,
+        preparedTreesOptions,
+        NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE * (localExecutor->GetThreadCount() + 1),
+        [&] (size_t /*start*/, size_t /*end*/, TVector<TVector<TVector<double>>>* interactionValuesForBlock) {
+            for (const auto& interactionValuesForDocument : *interactionValuesForBlock) {
+                for (const auto& interactionValuesForClass : interactionValuesForDocument) {
+                    const size_t valuesCount = interactionValuesForClass.size();
+                    for (size_t valueIdx = 0; valueIdx < valuesCount; ++valueIdx) {
+                        out << interactionValuesForClass[valueIdx] << (valueIdx + 1 == valuesCount ? '\n' : '\t');
+                    }
+                }
+            }
+        }
+    );
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "shap_values.h"
+
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/model/model.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+
+
+/* SHAP interaction values (https://arxiv.org/abs/1802.03888) for oblivious trees.
+ *
+ * All splits at the same depth of an oblivious tree use the same feature, so a tree depends on at most
+ *  depth features and its interactions are calculated exactly over the subsets of these features
+ *  for each leaf (a document's contribution depends only on the leaf it falls to).
+ * Features are combination classes as in TShapPreparedTrees,
+ *  values for classes with several features (ctrs) are split evenly between them.
+ * Time for a tree grows as 2^(depth + number of its distinct features), trees with this sum over 26
+ *  are rejected with an exception (ShapValues have no such limit).
+ */
+
+// returned: ShapInteractionValues[documentIdx][dimension][firstFeature * (featureCount + 1) + secondFeature]
+//  where featureCount is flat feature count, [featureCount][featureCount] element is the expected value
+TVector<TVector<TVector<double>>> CalcShapInteractionValuesMulti(
+    const TFullModel& model,
+    const NCB::TDataProvider& dataset,
+    int logPeriod,
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
+);
+
+// outputs for each document in order for each dimension in order a row-major (featureCount + 1)^2 matrix
+void CalcAndOutputShapInteractionValues(
+    const TFullModel& model,
+    const NCB::TDataProvider& dataset,
+    const TString& outputPath,
+    int logPeriod,
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
+);
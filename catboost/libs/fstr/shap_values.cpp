@@ -10,6 +10,8 @@
 #include <catboost/libs/options/restrictions.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
+#include <util/generic/maybe.h>
 #include <util/generic/utility.h>
 #include <util/generic/ymath.h>
 #include <catboost/libs/model/cpu/quantization.h>
@@ -429,7 +431,94 @@ static void MapBinFeaturesToClasses(
     }
 }
 
-void CalcShapValuesForDocumentMulti(
+static void PackShapValuesForTree(
+    const TVector<TVector<TShapValue>>& shapValuesByLeaf,
+    int approxDimension,
+    bool useSinglePrecision,
+    TShapValuesForTree* shapValuesForTree
+) {
+    size_t shapValueCount = 0;
+    for (const auto& shapValuesForLeaf : shapValuesByLeaf) {
+        shapValueCount += shapValuesForLeaf.size();
+    }
+
+    shapValuesForTree->LeafOffsets.yresize(shapValuesByLeaf.size() + 1);
+    shapValuesForTree->Features.yresize(shapValueCount);
+    TVector<double>& values = shapValuesForTree->Values;
+    TVector<float>& singlePrecisionValues = shapValuesForTree->SinglePrecisionValues;
+    if (useSinglePrecision) {
+        values.clear();
+        singlePrecisionValues.yresize(shapValueCount * approxDimension);
+    } else {
+        values.yresize(shapValueCount * approxDimension);
+        singlePrecisionValues.clear();
+    }
+
+    size_t shapValueIdx = 0;
+    for (size_t leafIdx = 0; leafIdx < shapValuesByLeaf.size(); ++leafIdx) {
+        shapValuesForTree->LeafOffsets[leafIdx] = SafeIntegerCast<ui32>(shapValueIdx);
+        for (const TShapValue& shapValue : shapValuesByLeaf[leafIdx]) {
+            shapValuesForTree->Features[shapValueIdx] = shapValue.Feature;
+            for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                if (useSinglePrecision) {
+                    singlePrecisionValues[shapValueIdx * approxDimension + dimension] = shapValue.Value[dimension];
+                } else {
+                    values[shapValueIdx * approxDimension + dimension] = shapValue.Value[dimension];
+                }
+            }
+            ++shapValueIdx;
+        }
+    }
+    shapValuesForTree->LeafOffsets.back() = SafeIntegerCast<ui32>(shapValueIdx);
+}
+
+template <class TValue, class TAddValue>
+static inline void AddShapValuesForLeafImpl(
+    const TShapValuesForTree& shapValuesForTree,
+    const TValue* values,
+    size_t leafIdx,
+    int approxDimension,
+    TAddValue&& addValue
+) {
+    const ui32 leafEnd = shapValuesForTree.LeafOffsets[leafIdx + 1];
+    for (ui32 shapValueIdx = shapValuesForTree.LeafOffsets[leafIdx]; shapValueIdx < leafEnd; ++shapValueIdx) {
+        const int feature = shapValuesForTree.Features[shapValueIdx];
+        const TValue* valuesForFeature = values + shapValueIdx * approxDimension;
+        for (int dimension = 0; dimension < approxDimension; ++dimension) {
+            addValue(feature, dimension, valuesForFeature[dimension]);
+        }
+    }
+}
+
+// addValue is called as addValue(feature, dimension, value)
+template <class TAddValue>
+static inline void AddShapValuesForLeaf(
+    const TShapValuesForTree& shapValuesForTree,
+    size_t leafIdx,
+    int approxDimension,
+    TAddValue&& addValue
+) {
+    if (shapValuesForTree.Values.empty()) {
+        AddShapValuesForLeafImpl(
+            shapValuesForTree,
+            shapValuesForTree.SinglePrecisionValues.data(),
+            leafIdx,
+            approxDimension,
+            addValue
+        );
+    } else {
+        AddShapValuesForLeafImpl(
+            shapValuesForTree,
+            shapValuesForTree.Values.data(),
+            leafIdx,
+            approxDimension,
+            addValue
+        );
+    }
+}
+
+// add shap values for trees in [preparedTrees.TreeRangeBegin, preparedTrees.TreeRangeEnd)
+static void AddShapValuesForDocumentMulti(
     const TFullModel& model,
     const TShapPreparedTrees& preparedTrees,
     const NCB::NModelEvaluation::IQuantizedData* binarizedFeaturesForBlock,
@@ -438,9 +527,7 @@ void CalcShapValuesForDocumentMulti(
     TVector<TVector<double>>* shapValues
 ) {
     const int approxDimension = model.GetDimensionsCount();
-    shapValues->assign(approxDimension, TVector<double>(flatFeatureCount + 1, 0.0));
-    const size_t treeCount = model.GetTreeCount();
-    for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
+    for (size_t treeIdx = preparedTrees.TreeRangeBegin; treeIdx < preparedTrees.TreeRangeEnd; ++treeIdx) {
         size_t leafIdx = CalcLeafToFallForDocument(
             model.GetCurrentEvaluator().Get(),
             treeIdx,
@@ -448,11 +535,14 @@ void CalcShapValuesForDocumentMulti(
             documentIdx
         );
         if (preparedTrees.CalcShapValuesByLeafForAllTrees) {
-            for (const TShapValue& shapValue : preparedTrees.ShapValuesByLeafForAllTrees[treeIdx][leafIdx]) {
-                for (int dimension = 0; dimension < approxDimension; ++dimension) {
-                    (*shapValues)[dimension][shapValue.Feature] += shapValue.Value[dimension];
+            AddShapValuesForLeaf(
+                preparedTrees.ShapValuesByLeaf[treeIdx - preparedTrees.TreeRangeBegin],
+                leafIdx,
+                approxDimension,
+                [shapValues] (int feature, int dimension, double value) {
+                    (*shapValues)[dimension][feature] += value;
                 }
-            }
+            );
         } else {
             TVector<TShapValue> shapValuesByLeaf;
 
@@ -481,6 +571,101 @@ void CalcShapValuesForDocumentMulti(
     }
 }
 
+void CalcShapValuesForDocumentMulti(
+    const TFullModel& model,
+    const TShapPreparedTrees& preparedTrees,
+    const NCB::NModelEvaluation::IQuantizedData* binarizedFeaturesForBlock,
+    int flatFeatureCount,
+    size_t documentIdx,
+    TVector<TVector<double>>* shapValues
+) {
+    const int approxDimension = model.GetDimensionsCount();
+    shapValues->assign(approxDimension, TVector<double>(flatFeatureCount + 1, 0.0));
+    AddShapValuesForDocumentMulti(
+        model,
+        preparedTrees,
+        binarizedFeaturesForBlock,
+        flatFeatureCount,
+        documentIdx,
+        shapValues
+    );
+}
+
+// leaf indexes for all documents of subBlock are calculated at once, returned: [(treeIdx - treeBegin) * documentCount + documentIdx]
+static TVector<NModelEvaluation::TCalcerIndexType> CalcLeafIndexesForSubBlock(
+    const TFullModel& model,
+    const NModelEvaluation::TCPUEvaluatorQuantizedData& subBlock,
+    size_t treeBegin,
+    size_t treeEnd
+) {
+    TVector<NModelEvaluation::TCalcerIndexType> leafIndexes(subBlock.GetObjectsCount() * (treeEnd - treeBegin), 0);
+    model.GetCurrentEvaluator()->CalcLeafIndexes(&subBlock, treeBegin, treeEnd, leafIndexes);
+    return leafIndexes;
+}
+
+/* leafIndexes are calculated by CalcLeafIndexesForSubBlock for trees in [treeBegin, treeEnd)
+ * addValue is called as addValue(documentIdxInSubBlock, feature, dimension, value)
+ * mean values of trees are not added
+ */
+template <class TAddValue>
+static void AddShapValuesForSubBlock(
+    const TFullModel& model,
+    const TShapPreparedTrees& preparedTrees,
+    TConstArrayRef<NModelEvaluation::TCalcerIndexType> leafIndexes,
+    size_t documentCount,
+    size_t treeBegin,
+    size_t treeEnd,
+    TAddValue&& addValue
+) {
+    const int approxDimension = model.GetDimensionsCount();
+
+    TVector<TMaybe<TVector<TShapValue>>> shapValuesByLeafCache;
+    for (size_t treeIdx = treeBegin; treeIdx < treeEnd; ++treeIdx) {
+        const NModelEvaluation::TCalcerIndexType* treeLeafIndexes
+            = leafIndexes.data() + (treeIdx - treeBegin) * documentCount;
+
+        if (preparedTrees.CalcShapValuesByLeafForAllTrees) {
+            const TShapValuesForTree& shapValuesForTree
+                = preparedTrees.ShapValuesByLeaf[treeIdx - preparedTrees.TreeRangeBegin];
+            for (size_t documentIdx = 0; documentIdx < documentCount; ++documentIdx) {
+                AddShapValuesForLeaf(
+                    shapValuesForTree,
+                    treeLeafIndexes[documentIdx],
+                    approxDimension,
+                    [&addValue, documentIdx] (int feature, int dimension, double value) {
+                        addValue(documentIdx, feature, dimension, value);
+                    }
+                );
+            }
+        } else {
+            // documents in block often fall to the same leaves, calculate shap values for each leaf once
+            shapValuesByLeafCache.assign(size_t(1) << model.ObliviousTrees->TreeSizes[treeIdx], Nothing());
+            for (size_t documentIdx = 0; documentIdx < documentCount; ++documentIdx) {
+                const size_t leafIdx = treeLeafIndexes[documentIdx];
+                if (!shapValuesByLeafCache[leafIdx]) {
+                    shapValuesByLeafCache[leafIdx].ConstructInPlace();
+                    CalcShapValuesForLeaf(
+                        *model.ObliviousTrees.Get(),
+                        preparedTrees.BinFeatureCombinationClass,
+                        preparedTrees.CombinationClassFeatures,
+                        leafIdx,
+                        treeIdx,
+                        preparedTrees.SubtreeWeightsForAllTrees[treeIdx],
+                        preparedTrees.CalcInternalValues,
+                        shapValuesByLeafCache[leafIdx].Get()
+                    );
+                }
+                for (const TShapValue& shapValue : *shapValuesByLeafCache[leafIdx]) {
+                    for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                        addValue(documentIdx, shapValue.Feature, dimension, shapValue.Value[dimension]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// shapValuesForBlock must be initialized, shap values for documents in [start, end) are added to them
 static void CalcShapValuesForDocumentBlockMulti(
     const TFullModel& model,
     const TObjectsDataProvider& objectsData,
@@ -488,31 +673,136 @@ static void CalcShapValuesForDocumentBlockMulti(
     size_t start,
     size_t end,
     NPar::TLocalExecutor* localExecutor,
-    TVector<TVector<TVector<double>>>* shapValuesForAllDocuments
+    TArrayRef<TVector<TVector<double>>> shapValuesForBlock
 ) {
     const size_t documentCount = end - start;
+    Y_ASSERT(shapValuesForBlock.size() == documentCount);
+    if (documentCount == 0) {
+        return;
+    }
 
     auto binarizedFeaturesForBlock = MakeQuantizedFeaturesForEvaluator(model, objectsData, start, end);
+    const auto* quantizedData
+        = reinterpret_cast<const NModelEvaluation::TCPUEvaluatorQuantizedData*>(binarizedFeaturesForBlock.Get());
 
     const int flatFeatureCount = objectsData.GetFeaturesLayout()->GetExternalFeatureCount();
+    const int approxDimension = model.GetDimensionsCount();
+    const size_t dimensionStride = flatFeatureCount + 1;
+    const size_t documentStride = approxDimension * dimensionStride;
 
-    const int oldShapValuesSize = shapValuesForAllDocuments->size();
-    shapValuesForAllDocuments->resize(oldShapValuesSize + end - start);
-
-    NPar::TLocalExecutor::TExecRangeParams blockParams(0, documentCount);
-    localExecutor->ExecRange([&] (size_t documentIdx) {
-        TVector<TVector<double>>& shapValues = (*shapValuesForAllDocuments)[oldShapValuesSize + documentIdx];
+    TVector<double> meanValue(approxDimension, 0.0);
+    for (size_t treeIdx = preparedTrees.TreeRangeBegin; treeIdx < preparedTrees.TreeRangeEnd; ++treeIdx) {
+        for (int dimension = 0; dimension < approxDimension; ++dimension) {
+            meanValue[dimension] += preparedTrees.MeanValuesForAllTrees[treeIdx][dimension];
+        }
+    }
 
-        CalcShapValuesForDocumentMulti(
-            model,
-            preparedTrees,
-            binarizedFeaturesForBlock.Get(),
-            flatFeatureCount,
-            documentIdx,
-            &shapValues
+    // if there are fewer evaluation blocks than threads trees are processed by ranges in parallel as well
+    const size_t treeCount = preparedTrees.TreeRangeEnd - preparedTrees.TreeRangeBegin;
+    const size_t subBlockCount = quantizedData->BlocksCount;
+    const size_t threadCount = localExecutor->GetThreadCount() + 1;
+    const size_t treeRangeCount = subBlockCount < threadCount
+        ? Max<size_t>(1, Min<size_t>(treeCount, threadCount / subBlockCount))
+        : 1;
+    const size_t treeRangeSize = CeilDiv(treeCount, treeRangeCount);
+
+    if (treeRangeCount == 1) {
+        // blocks write to their own documents, no intermediate buffers are needed
+        localExecutor->ExecRangeWithThrow(
+            [&] (int subBlockIdx) {
+                auto* shapValuesForSubBlock
+                    = shapValuesForBlock.data() + subBlockIdx * NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE;
+                const auto subBlock = quantizedData->ExtractBlock(subBlockIdx);
+                const size_t subBlockDocumentCount = subBlock.GetObjectsCount();
+                AddShapValuesForSubBlock(
+                    model,
+                    preparedTrees,
+                    CalcLeafIndexesForSubBlock(
+                        model,
+                        subBlock,
+                        preparedTrees.TreeRangeBegin,
+                        preparedTrees.TreeRangeEnd
+                    ),
+                    subBlockDocumentCount,
+                    preparedTrees.TreeRangeBegin,
+                    preparedTrees.TreeRangeEnd,
+                    [=] (size_t documentIdx, int feature, int dimension, double value) {
+                        shapValuesForSubBlock[documentIdx][dimension][feature] += value;
+                    }
+                );
+                for (size_t documentIdx = 0; documentIdx < subBlockDocumentCount; ++documentIdx) {
+                    for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                        shapValuesForSubBlock[documentIdx][dimension][flatFeatureCount] += meanValue[dimension];
+                    }
+                }
+            },
+            0,
+            SafeIntegerCast<int>(subBlockCount),
+            NPar::TLocalExecutor::WAIT_COMPLETE
         );
+        return;
+    }
 
-    }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+    TVector<TVector<double>> shapValuesByTreeRange(
+        treeRangeCount,
+        TVector<double>(documentCount * documentStride, 0.0)
+    ); // [treeRangeIdx][documentIdx * documentStride + dimension * dimensionStride + feature]
+
+    localExecutor->ExecRangeWithThrow(
+        [&] (int taskIdx) {
+            const size_t subBlockIdx = taskIdx / treeRangeCount;
+            const size_t treeRangeIdx = taskIdx % treeRangeCount;
+            const size_t treeBegin = preparedTrees.TreeRangeBegin + treeRangeIdx * treeRangeSize;
+            const size_t treeEnd = Min(treeBegin + treeRangeSize, preparedTrees.TreeRangeEnd);
+            if (treeBegin >= treeEnd) {
+                return;
+            }
+
+            double* shapValuesForSubBlock = shapValuesByTreeRange[treeRangeIdx].data()
+                + subBlockIdx * NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE * documentStride;
+            const auto subBlock = quantizedData->ExtractBlock(subBlockIdx);
+            AddShapValuesForSubBlock(
+                model,
+                preparedTrees,
+                CalcLeafIndexesForSubBlock(model, subBlock, treeBegin, treeEnd),
+                subBlock.GetObjectsCount(),
+                treeBegin,
+                treeEnd,
+                [=] (size_t documentIdx, int feature, int dimension, double value) {
+                    shapValuesForSubBlock[documentIdx * documentStride + dimension * dimensionStride + feature]
+                        += value;
+                }
+            );
+        },
+        0,
+        SafeIntegerCast<int>(subBlockCount * treeRangeCount),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+
+    NPar::ParallelFor(
+        *localExecutor,
+        0,
+        SafeIntegerCast<ui32>(documentCount),
+        [&] (ui32 documentIdx) {
+            TVector<TVector<double>>& shapValues = shapValuesForBlock[documentIdx];
+            for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                double* dst = shapValues[dimension].data();
+                for (const auto& shapValuesForTreeRange : shapValuesByTreeRange) {
+                    const double* src
+                        = shapValuesForTreeRange.data() + documentIdx * documentStride + dimension * dimensionStride;
+                    for (size_t feature = 0; feature < dimensionStride; ++feature) {
+                        dst[feature] += src[feature];
+                    }
+                }
+                dst[flatFeatureCount] += meanValue[dimension];
+            }
+        }
+    );
+}
+
+// enough evaluation blocks for all threads, so that trees are split into ranges only for the last document block
+static size_t GetShapDocumentBlockSize(const NPar::TLocalExecutor& localExecutor) {
+    return (localExecutor.GetThreadCount() + 1) * NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE;
 }
 
 static void CalcShapValuesByLeafForTreeBlock(
@@ -521,6 +811,7 @@ static void CalcShapValuesByLeafForTreeBlock(
     int start,
     int end,
     bool calcInternalValues,
+    bool useSinglePrecision,
     NPar::TLocalExecutor* localExecutor,
     TShapPreparedTrees* preparedTrees
 ) {
@@ -530,15 +821,12 @@ static void CalcShapValuesByLeafForTreeBlock(
     NPar::TLocalExecutor::TExecRangeParams blockParams(start, end);
     localExecutor->ExecRange([&] (size_t treeIdx) {
         const size_t leafCount = (size_t(1) << forest.TreeSizes[treeIdx]);
-        TVector<TVector<TShapValue>>& shapValuesByLeaf = preparedTrees->ShapValuesByLeafForAllTrees[treeIdx];
-        if (preparedTrees->CalcShapValuesByLeafForAllTrees) {
-            shapValuesByLeaf.resize(leafCount);
-        }
 
         TVector<TVector<double>> subtreeWeights
             = CalcSubtreeWeightsForTree(leafWeights[treeIdx], forest.TreeSizes[treeIdx]);
 
         if (preparedTrees->CalcShapValuesByLeafForAllTrees) {
+            TVector<TVector<TShapValue>> shapValuesByLeaf(leafCount);
             for (size_t leafIdx = 0; leafIdx < leafCount; ++leafIdx) {
                 CalcShapValuesForLeaf(
                     forest,
@@ -551,6 +839,12 @@ static void CalcShapValuesByLeafForTreeBlock(
                     &shapValuesByLeaf[leafIdx]
                 );
             }
+            PackShapValuesForTree(
+                shapValuesByLeaf,
+                forest.ApproxDimension,
+                useSinglePrecision,
+                &preparedTrees->ShapValuesByLeaf[treeIdx - preparedTrees->TreeRangeBegin]
+            );
         } else {
             preparedTrees->SubtreeWeightsForAllTrees[treeIdx] = subtreeWeights;
         }
@@ -586,41 +880,119 @@ bool PrepareTreesCalcShapValues(
     }
 }
 
-TShapPreparedTrees PrepareTrees(
+// upper bound: each leaf has shap values at most for all flat features used in the tree (ctrs add several ones)
+static ui64 EstimatePreparedTreeMemoryUsage(
+    const TObliviousTrees& forest,
+    const TVector<int>& binFeatureCombinationClass,
+    const TVector<TVector<int>>& combinationClassFeatures,
+    size_t treeIdx,
+    bool useSinglePrecision
+) {
+    const ui64 treeDepth = forest.TreeSizes[treeIdx];
+    TVector<int> flatFeatures;
+    for (ui64 depth = 0; depth < treeDepth; ++depth) {
+        const int combinationClass
+            = binFeatureCombinationClass[forest.TreeSplits[forest.TreeStartOffsets[treeIdx] + depth]];
+        const auto& classFlatFeatures = combinationClassFeatures[combinationClass];
+        flatFeatures.insert(flatFeatures.end(), classFlatFeatures.begin(), classFlatFeatures.end());
+    }
+    SortUnique(flatFeatures);
+
+    const ui64 leafCount = ui64(1) << treeDepth;
+    const ui64 valueSize = useSinglePrecision ? sizeof(float) : sizeof(double);
+    return (leafCount + 1) * sizeof(ui32)
+        + leafCount * flatFeatures.size() * (sizeof(int) + forest.ApproxDimension * valueSize);
+}
+
+// returns tree ranges bounds, i-th range is [result[i], result[i + 1])
+static TVector<size_t> SplitTreesByPreparedMemoryUsage(
+    const TObliviousTrees& forest,
+    const TShapPreparedTreesOptions& preparedTreesOptions
+) {
+    const size_t treeCount = forest.GetTreeCount();
+
+    TVector<int> binFeatureCombinationClass;
+    TVector<TVector<int>> combinationClassFeatures;
+    MapBinFeaturesToClasses(forest, &binFeatureCombinationClass, &combinationClassFeatures);
+
+    TVector<size_t> treeRangesBounds = {0};
+    ui64 rangeMemoryUsage = 0;
+    for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
+        const ui64 treeMemoryUsage = EstimatePreparedTreeMemoryUsage(
+            forest,
+            binFeatureCombinationClass,
+            combinationClassFeatures,
+            treeIdx,
+            preparedTreesOptions.UseSinglePrecision
+        );
+        if ((treeIdx != treeRangesBounds.back())
+            && (rangeMemoryUsage + treeMemoryUsage > preparedTreesOptions.MaxMemoryUsage))
+        {
+            treeRangesBounds.push_back(treeIdx);
+            rangeMemoryUsage = 0;
+        }
+        rangeMemoryUsage += treeMemoryUsage;
+    }
+    if (treeRangesBounds.back() != treeCount) {
+        treeRangesBounds.push_back(treeCount);
+    }
+    return treeRangesBounds;
+}
+
+// use only if model.ObliviousTrees->LeafWeights is empty
+static TVector<TVector<double>> CollectLeafWeightsIfNeeded(
     const TFullModel& model,
-    const TDataProvider* dataset, // can be nullptr if model has LeafWeights
+    const TDataProvider* dataset,
+    NPar::TLocalExecutor* localExecutor
+) {
+    if (!model.ObliviousTrees->LeafWeights.empty()) {
+        return {};
+    }
+    CB_ENSURE(
+            dataset,
+            "PrepareTrees requires either non-empty LeafWeights in model or provided dataset"
+    );
+    CB_ENSURE(dataset->ObjectsGrouping->GetObjectCount() != 0, "no docs in pool");
+    CB_ENSURE(dataset->MetaInfo.GetFeatureCount() > 0, "no features in pool");
+    return CollectLeavesStatistics(*dataset, model, localExecutor);
+}
+
+static TShapPreparedTrees PrepareTreesForRange(
+    const TFullModel& model,
+    const TVector<TVector<double>>& collectedLeafWeights,
+    bool calcShapValuesByLeaf,
+    size_t treeRangeBegin,
+    size_t treeRangeEnd,
     int logPeriod,
-    EPreCalcShapValues mode,
     NPar::TLocalExecutor* localExecutor,
-    bool calcInternalValues
+    bool calcInternalValues,
+    const TShapPreparedTreesOptions& preparedTreesOptions
 ) {
     const size_t treeCount = model.GetTreeCount();
     const size_t treeBlockSize = CB_THREAD_LIMIT; // least necessary for threading
 
-    TImportanceLogger treesLogger(treeCount, "trees processed", "Processing trees...", logPeriod);
+    TImportanceLogger treesLogger(
+        treeRangeEnd - treeRangeBegin,
+        "trees processed",
+        "Processing trees...",
+        logPeriod
+    );
 
-    // use only if model.ObliviousTrees->LeafWeights is empty
-    TVector<TVector<double>> leafWeights;
-    if (model.ObliviousTrees->LeafWeights.empty()) {
-        CB_ENSURE(
-                dataset,
-                "PrepareTrees requires either non-empty LeafWeights in model or provided dataset"
-        );
-        CB_ENSURE(dataset->ObjectsGrouping->GetObjectCount() != 0, "no docs in pool");
-        CB_ENSURE(dataset->MetaInfo.GetFeatureCount() > 0, "no features in pool");
-        leafWeights = CollectLeavesStatistics(*dataset, model, localExecutor);
-    }
+    const TVector<TVector<double>>& leafWeights
+        = model.ObliviousTrees->LeafWeights.empty() ? collectedLeafWeights : model.ObliviousTrees->LeafWeights;
 
     TShapPreparedTrees preparedTrees;
-    preparedTrees.CalcShapValuesByLeafForAllTrees = PrepareTreesCalcShapValues(model, dataset, mode);
+    preparedTrees.CalcShapValuesByLeafForAllTrees = calcShapValuesByLeaf;
+    preparedTrees.TreeRangeBegin = treeRangeBegin;
+    preparedTrees.TreeRangeEnd = treeRangeEnd;
 
     if (!preparedTrees.CalcShapValuesByLeafForAllTrees) {
-        preparedTrees.LeafWeightsForAllTrees
-            = model.ObliviousTrees->LeafWeights.empty() ? leafWeights : model.ObliviousTrees->LeafWeights;
+        preparedTrees.LeafWeightsForAllTrees = leafWeights;
+        preparedTrees.SubtreeWeightsForAllTrees.resize(treeCount);
+    } else {
+        preparedTrees.ShapValuesByLeaf.resize(treeRangeEnd - treeRangeBegin);
     }
 
-    preparedTrees.ShapValuesByLeafForAllTrees.resize(treeCount);
-    preparedTrees.SubtreeWeightsForAllTrees.resize(treeCount);
     preparedTrees.MeanValuesForAllTrees.resize(treeCount);
     preparedTrees.CalcInternalValues = calcInternalValues;
 
@@ -631,19 +1003,20 @@ TShapPreparedTrees PrepareTrees(
         &preparedTrees.CombinationClassFeatures
     );
 
-    TProfileInfo processTreesProfile(treeCount);
+    TProfileInfo processTreesProfile(treeRangeEnd - treeRangeBegin);
 
-    for (size_t start = 0; start < treeCount; start += treeBlockSize) {
-        size_t end = Min(start + treeBlockSize, treeCount);
+    for (size_t start = treeRangeBegin; start < treeRangeEnd; start += treeBlockSize) {
+        size_t end = Min(start + treeBlockSize, treeRangeEnd);
 
         processTreesProfile.StartIterationBlock();
 
         CalcShapValuesByLeafForTreeBlock(
-            *model.ObliviousTrees,
-            model.ObliviousTrees->LeafWeights.empty() ? leafWeights : model.ObliviousTrees->LeafWeights,
+            forest,
+            leafWeights,
             start,
             end,
             calcInternalValues,
+            preparedTreesOptions.UseSinglePrecision,
             localExecutor,
             &preparedTrees
         );
@@ -656,6 +1029,28 @@ TShapPreparedTrees PrepareTrees(
     return preparedTrees;
 }
 
+TShapPreparedTrees PrepareTrees(
+    const TFullModel& model,
+    const TDataProvider* dataset, // can be nullptr if model has LeafWeights
+    int logPeriod,
+    EPreCalcShapValues mode,
+    NPar::TLocalExecutor* localExecutor,
+    bool calcInternalValues,
+    const TShapPreparedTreesOptions& preparedTreesOptions
+) {
+    return PrepareTreesForRange(
+        model,
+        CollectLeafWeightsIfNeeded(model, dataset, localExecutor),
+        PrepareTreesCalcShapValues(model, dataset, mode),
+        /*treeRangeBegin*/ 0,
+        model.GetTreeCount(),
+        logPeriod,
+        localExecutor,
+        calcInternalValues,
+        preparedTreesOptions
+    );
+}
+
 TShapPreparedTrees PrepareTrees(
     const TFullModel& model,
     NPar::TLocalExecutor* localExecutor
@@ -667,6 +1062,66 @@ TShapPreparedTrees PrepareTrees(
     return PrepareTrees(model, nullptr, 0, EPreCalcShapValues::Auto, localExecutor);
 }
 
+TShapPreparedTreeRanges::TShapPreparedTreeRanges(
+    const TFullModel& model,
+    const TDataProvider* dataset,
+    int logPeriod,
+    EPreCalcShapValues mode,
+    NPar::TLocalExecutor* localExecutor,
+    bool calcInternalValues,
+    const TShapPreparedTreesOptions& preparedTreesOptions
+)
+    : Model(model)
+    , LocalExecutor(localExecutor)
+    , CalcInternalValues(calcInternalValues)
+    , PreparedTreesOptions(preparedTreesOptions)
+    , CollectedLeafWeights(CollectLeafWeightsIfNeeded(model, dataset, localExecutor))
+    , CalcShapValuesByLeaf(PrepareTreesCalcShapValues(model, dataset, mode))
+{
+    // without precalculation memory usage does not depend on leaves' shap values so all trees are processed at once
+    TreeRangesBounds = CalcShapValuesByLeaf ?
+        SplitTreesByPreparedMemoryUsage(*model.ObliviousTrees, preparedTreesOptions)
+        : TVector<size_t>{0, model.GetTreeCount()};
+    if (GetRangeCount() == 1) {
+        AllTreesPreparedTrees = PrepareTreesForRange(
+            model,
+            CollectedLeafWeights,
+            CalcShapValuesByLeaf,
+            /*treeRangeBegin*/ 0,
+            model.GetTreeCount(),
+            logPeriod,
+            localExecutor,
+            calcInternalValues,
+            preparedTreesOptions
+        );
+    } else {
+        CATBOOST_INFO_LOG << "Shap values for leaves are precalculated in " << GetRangeCount()
+            << " tree ranges for each block of documents to fit in memory limit" << Endl;
+    }
+}
+
+const TShapPreparedTrees& TShapPreparedTreeRanges::GetPreparedTrees(
+    size_t rangeIdx,
+    TMaybe<TShapPreparedTrees>* rangeHolder
+) const {
+    Y_ASSERT(rangeIdx < GetRangeCount());
+    if (AllTreesPreparedTrees) {
+        return *AllTreesPreparedTrees;
+    }
+    *rangeHolder = PrepareTreesForRange(
+        Model,
+        CollectedLeafWeights,
+        CalcShapValuesByLeaf,
+        TreeRangesBounds[rangeIdx],
+        TreeRangesBounds[rangeIdx + 1],
+        /*logPeriod*/ 0,
+        LocalExecutor,
+        CalcInternalValues,
+        PreparedTreesOptions
+    );
+    return **rangeHolder;
+}
+
 void CalcShapValuesInternalForFeature(
     const TShapPreparedTrees& preparedTrees,
     const TFullModel& model,
@@ -676,7 +1131,8 @@ void CalcShapValuesInternalForFeature(
     ui32 featuresCount,
     const NCB::TObjectsDataProvider& objectsData,
     TVector<TVector<TVector<double>>>* shapValues, // [docIdx][featureIdx][dim]
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TVector<double>>* approx
 ) {
     CB_ENSURE(start <= end && end <= objectsData.GetObjectCount());
     const TObliviousTrees& forest = *model.ObliviousTrees;
@@ -684,50 +1140,60 @@ void CalcShapValuesInternalForFeature(
     const ui32 documentCount = end - start;
     shapValues->resize(documentCount);
 
-    auto binarizedFeaturesForBlock = MakeQuantizedFeaturesForEvaluator(model, objectsData, start, end);
-    const ui32 documentBlockSize = CB_THREAD_LIMIT;
-    for (ui32 startIdx = 0; startIdx < documentCount; startIdx += documentBlockSize) {
-        NPar::TLocalExecutor::TExecRangeParams blockParams(startIdx, startIdx + Min(documentBlockSize, documentCount - startIdx));
-        localExecutor->ExecRange([&](ui32 documentIdx) {
-            TVector<TVector<double>> &docShapValues = (*shapValues)[documentIdx];
-            docShapValues.assign(featuresCount, TVector<double>(forest.ApproxDimension + 1, 0.0));
-            for (size_t treeIdx = 0; treeIdx < forest.GetTreeCount(); ++treeIdx) {
-                size_t leafIdx = CalcLeafToFallForDocument(
-                    model.GetCurrentEvaluator().Get(),
-                    treeIdx,
-                    binarizedFeaturesForBlock.Get(),
-                    documentIdx
-                );
-
-                if (preparedTrees.CalcShapValuesByLeafForAllTrees) {
-                    for (const TShapValue& shapValue : preparedTrees.ShapValuesByLeafForAllTrees[treeIdx][leafIdx]) {
-                        for (int dimension = 0; dimension < forest.ApproxDimension; ++dimension) {
-                            docShapValues[shapValue.Feature][dimension] += shapValue.Value[dimension];
-                        }
-                    }
-                } else {
-                    TVector<TShapValue> shapValuesByLeaf;
-
-                    CalcShapValuesForLeaf(
-                        forest,
-                        preparedTrees.BinFeatureCombinationClass,
-                        preparedTrees.CombinationClassFeatures,
-                        leafIdx,
-                        treeIdx,
-                        preparedTrees.SubtreeWeightsForAllTrees[treeIdx],
-                        preparedTrees.CalcInternalValues,
-                        &shapValuesByLeaf
-                    );
+    for (auto& docShapValues : *shapValues) {
+        docShapValues.assign(featuresCount, TVector<double>(forest.ApproxDimension + 1, 0.0));
+    }
+    if (approx) {
+        approx->assign(forest.ApproxDimension, TVector<double>(documentCount, 0.0));
+    }
 
-                    for (const TShapValue& shapValue : shapValuesByLeaf) {
-                        for (int dimension = 0; dimension < forest.ApproxDimension; ++dimension) {
-                            docShapValues[shapValue.Feature][dimension] += shapValue.Value[dimension];
+    auto binarizedFeaturesForBlock = MakeQuantizedFeaturesForEvaluator(model, objectsData, start, end);
+    const auto* quantizedData
+        = reinterpret_cast<const NModelEvaluation::TCPUEvaluatorQuantizedData*>(binarizedFeaturesForBlock.Get());
+
+    localExecutor->ExecRangeWithThrow(
+        [&] (int subBlockIdx) {
+            const size_t subBlockStart = subBlockIdx * NModelEvaluation::FORMULA_EVALUATION_BLOCK_SIZE;
+            TVector<TVector<double>>* shapValuesForSubBlock = shapValues->data() + subBlockStart;
+            const auto subBlock = quantizedData->ExtractBlock(subBlockIdx);
+            const size_t subBlockDocumentCount = subBlock.GetObjectsCount();
+            const auto leafIndexes = CalcLeafIndexesForSubBlock(
+                model,
+                subBlock,
+                preparedTrees.TreeRangeBegin,
+                preparedTrees.TreeRangeEnd
+            );
+            AddShapValuesForSubBlock(
+                model,
+                preparedTrees,
+                leafIndexes,
+                subBlockDocumentCount,
+                preparedTrees.TreeRangeBegin,
+                preparedTrees.TreeRangeEnd,
+                [=] (size_t documentIdx, int feature, int dimension, double value) {
+                    shapValuesForSubBlock[documentIdx][feature][dimension] += value;
+                }
+            );
+            if (approx) {
+                // the same leaf indexes give model predictions, so the model is not applied separately
+                for (size_t treeIdx = preparedTrees.TreeRangeBegin; treeIdx < preparedTrees.TreeRangeEnd; ++treeIdx) {
+                    const double* leafValues = forest.GetFirstLeafPtrForTree(treeIdx);
+                    const auto* treeLeafIndexes
+                        = leafIndexes.data() + (treeIdx - preparedTrees.TreeRangeBegin) * subBlockDocumentCount;
+                    for (int dimension = 0; dimension < forest.ApproxDimension; ++dimension) {
+                        double* approxForSubBlock = (*approx)[dimension].data() + subBlockStart;
+                        for (size_t documentIdx = 0; documentIdx < subBlockDocumentCount; ++documentIdx) {
+                            approxForSubBlock[documentIdx]
+                                += leafValues[treeLeafIndexes[documentIdx] * forest.ApproxDimension + dimension];
                         }
                     }
                 }
             }
-        }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
-    }
+        },
+        0,
+        SafeIntegerCast<int>(quantizedData->BlocksCount),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
 }
 
 TVector<TVector<TVector<double>>> CalcShapValuesMulti(
@@ -735,45 +1201,67 @@ TVector<TVector<TVector<double>>> CalcShapValuesMulti(
     const TDataProvider& dataset,
     int logPeriod,
     EPreCalcShapValues mode,
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions
 ) {
-    TShapPreparedTrees preparedTrees = PrepareTrees(
-        model,
-        &dataset,
-        logPeriod,
-        mode,
-        localExecutor,
-        /*calcInternalValues=*/false
-    );
+    const TVector<TVector<double>> collectedLeafWeights
+        = CollectLeafWeightsIfNeeded(model, &dataset, localExecutor);
+    const bool calcShapValuesByLeaf = PrepareTreesCalcShapValues(model, &dataset, mode);
+
+    // without precalculation memory usage does not depend on leaves' shap values so all trees are processed at once
+    const TVector<size_t> treeRangesBounds = calcShapValuesByLeaf ?
+        SplitTreesByPreparedMemoryUsage(*model.ObliviousTrees, preparedTreesOptions)
+        : TVector<size_t>{0, model.GetTreeCount()};
+    if (treeRangesBounds.size() > 2) {
+        CATBOOST_INFO_LOG << "Shap values for leaves are precalculated in " << treeRangesBounds.size() - 1
+            << " tree ranges to fit in memory limit" << Endl;
+    }
 
     const size_t documentCount = dataset.ObjectsGrouping->GetObjectCount();
-    const size_t documentBlockSize = CB_THREAD_LIMIT; // least necessary for threading
+    const size_t documentBlockSize = GetShapDocumentBlockSize(*localExecutor);
+    const int flatFeatureCount = dataset.ObjectsData->GetFeaturesLayout()->GetExternalFeatureCount();
 
-    TImportanceLogger documentsLogger(documentCount, "documents processed", "Processing documents...", logPeriod);
+    TVector<TVector<TVector<double>>> shapValues(
+        documentCount,
+        TVector<TVector<double>>(model.GetDimensionsCount(), TVector<double>(flatFeatureCount + 1, 0.0))
+    );
 
-    TVector<TVector<TVector<double>>> shapValues;
-    shapValues.reserve(documentCount);
+    for (size_t treeRangeIdx = 0; treeRangeIdx + 1 < treeRangesBounds.size(); ++treeRangeIdx) {
+        const TShapPreparedTrees preparedTrees = PrepareTreesForRange(
+            model,
+            collectedLeafWeights,
+            calcShapValuesByLeaf,
+            treeRangesBounds[treeRangeIdx],
+            treeRangesBounds[treeRangeIdx + 1],
+            logPeriod,
+            localExecutor,
+            /*calcInternalValues=*/false,
+            preparedTreesOptions
+        );
 
-    TProfileInfo processDocumentsProfile(documentCount);
+        TImportanceLogger documentsLogger(documentCount, "documents processed", "Processing documents...", logPeriod);
 
-    for (size_t start = 0; start < documentCount; start += documentBlockSize) {
-        size_t end = Min(start + documentBlockSize, documentCount);
+        TProfileInfo processDocumentsProfile(documentCount);
 
-        processDocumentsProfile.StartIterationBlock();
+        for (size_t start = 0; start < documentCount; start += documentBlockSize) {
+            size_t end = Min(start + documentBlockSize, documentCount);
 
-        CalcShapValuesForDocumentBlockMulti(
-            model,
-            *dataset.ObjectsData,
-            preparedTrees,
-            start,
-            end,
-            localExecutor,
-            &shapValues
-        );
+            processDocumentsProfile.StartIterationBlock();
 
-        processDocumentsProfile.FinishIterationBlock(end - start);
-        auto profileResults = processDocumentsProfile.GetProfileResults();
-        documentsLogger.Log(profileResults);
+            CalcShapValuesForDocumentBlockMulti(
+                model,
+                *dataset.ObjectsData,
+                preparedTrees,
+                start,
+                end,
+                localExecutor,
+                TArrayRef<TVector<TVector<double>>>(shapValues.data() + start, end - start)
+            );
+
+            processDocumentsProfile.FinishIterationBlock(end - start);
+            auto profileResults = processDocumentsProfile.GetProfileResults();
+            documentsLogger.Log(profileResults);
+        }
     }
 
     return shapValues;
@@ -784,7 +1272,8 @@ TVector<TVector<double>> CalcShapValues(
     const TDataProvider& dataset,
     int logPeriod,
     EPreCalcShapValues mode,
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions
 ) {
     CB_ENSURE(model.ObliviousTrees->ApproxDimension == 1, "Model must not be trained for multiclassification.");
     TVector<TVector<TVector<double>>> shapValuesMulti = CalcShapValuesMulti(
@@ -792,7 +1281,8 @@ TVector<TVector<double>> CalcShapValues(
         dataset,
         logPeriod,
         mode,
-        localExecutor
+        localExecutor,
+        preparedTreesOptions
     );
 
     size_t documentsCount = dataset.ObjectsGrouping->GetObjectCount();
@@ -821,19 +1311,30 @@ void CalcAndOutputShapValues(
     const TString& outputPath,
     int logPeriod,
     EPreCalcShapValues mode,
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions
 ) {
+    if (PrepareTreesCalcShapValues(model, &dataset, mode)
+        && (SplitTreesByPreparedMemoryUsage(*model.ObliviousTrees, preparedTreesOptions).size() > 2))
+    {
+        CATBOOST_WARNING_LOG << "Shap values for leaves do not fit in memory limit, calculate them without precalculation"
+            << Endl;
+        mode = EPreCalcShapValues::NoPreCalc;
+    }
+
     TShapPreparedTrees preparedTrees = PrepareTrees(
         model,
         &dataset,
         logPeriod,
         mode,
         localExecutor,
-        /*calcInternalValues=*/false
+        /*calcInternalValues=*/false,
+        preparedTreesOptions
     );
 
     const size_t documentCount = dataset.ObjectsGrouping->GetObjectCount();
-    const size_t documentBlockSize = CB_THREAD_LIMIT; // least necessary for threading
+    const size_t documentBlockSize = GetShapDocumentBlockSize(*localExecutor);
+    const int flatFeatureCount = dataset.ObjectsData->GetFeaturesLayout()->GetExternalFeatureCount();
 
     TImportanceLogger documentsLogger(documentCount, "documents processed", "Processing documents...", logPeriod);
 
@@ -844,8 +1345,10 @@ void CalcAndOutputShapValues(
         size_t end = Min(start + documentBlockSize, documentCount);
         processDocumentsProfile.StartIterationBlock();
 
-        TVector<TVector<TVector<double>>> shapValuesForBlock;
-        shapValuesForBlock.reserve(end - start);
+        TVector<TVector<TVector<double>>> shapValuesForBlock(
+            end - start,
+            TVector<TVector<double>>(model.GetDimensionsCount(), TVector<double>(flatFeatureCount + 1, 0.0))
+        );
 
         CalcShapValuesForDocumentBlockMulti(
             model,
@@ -854,7 +1357,7 @@ void CalcAndOutputShapValues(
             start,
             end,
             localExecutor,
-            &shapValuesForBlock
+            shapValuesForBlock
         );
 
         OutputShapValuesMulti(shapValuesForBlock, out);
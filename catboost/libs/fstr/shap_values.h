@@ -5,6 +5,7 @@
 #include <catboost/libs/options/enums.h>
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/maybe.h>
 #include <util/generic/vector.h>
 #include <util/stream/input.h>
 #include <util/stream/output.h>
@@ -28,8 +29,42 @@ public:
     Y_SAVELOAD_DEFINE(Feature, Value);
 };
 
+/* Precalculated shap values for all leaves of a tree, stored contiguously:
+ *  shap values for leaf leafIdx are [LeafOffsets[leafIdx], LeafOffsets[leafIdx + 1]) elements of Features
+ *  and the same elements multiplied by approxDimension of Values (or SinglePrecisionValues)
+ */
+struct TShapValuesForTree {
+    TVector<ui32> LeafOffsets; // [leafIdx], leafCount + 1 elements
+    TVector<int> Features; // [shapValueIdx]
+    TVector<double> Values; // [shapValueIdx * approxDimension + dimension], empty if single precision is used
+    TVector<float> SinglePrecisionValues; // [shapValueIdx * approxDimension + dimension]
+
+public:
+    Y_SAVELOAD_DEFINE(LeafOffsets, Features, Values, SinglePrecisionValues);
+
+    size_t GetMemoryUsage() const {
+        return LeafOffsets.size() * sizeof(ui32)
+            + Features.size() * sizeof(int)
+            + Values.size() * sizeof(double)
+            + SinglePrecisionValues.size() * sizeof(float);
+    }
+};
+
+struct TShapPreparedTreesOptions {
+    // store precalculated shap values for leaves as float instead of double
+    bool UseSinglePrecision = false;
+
+    /* if precalculated shap values for leaves of all trees do not fit in this size (in bytes)
+     *  they are calculated and applied by consecutive ranges of trees
+     */
+    ui64 MaxMemoryUsage = ui64(1) << 31;
+};
+
 struct TShapPreparedTrees {
-    TVector<TVector<TVector<TShapValue>>> ShapValuesByLeafForAllTrees; // [treeIdx][leafIdx][shapFeature] trees * 2^d * d
+    // shap values are precalculated for trees in [TreeRangeBegin, TreeRangeEnd)
+    size_t TreeRangeBegin = 0;
+    size_t TreeRangeEnd = 0;
+    TVector<TShapValuesForTree> ShapValuesByLeaf; // [treeIdx - TreeRangeBegin]
     TVector<TVector<double>> MeanValuesForAllTrees;
     TVector<int> BinFeatureCombinationClass;
     TVector<TVector<int>> CombinationClassFeatures;
@@ -41,17 +76,10 @@ struct TShapPreparedTrees {
 public:
     TShapPreparedTrees() = default;
 
-    TShapPreparedTrees(
-        const TVector<TVector<TVector<TShapValue>>>& shapValuesByLeafForAllTrees,
-        const TVector<TVector<double>>& meanValuesForAllTrees
-    )
-        : ShapValuesByLeafForAllTrees(shapValuesByLeafForAllTrees)
-        , MeanValuesForAllTrees(meanValuesForAllTrees)
-    {
-    }
-
     Y_SAVELOAD_DEFINE(
-        ShapValuesByLeafForAllTrees,
+        TreeRangeBegin,
+        TreeRangeEnd,
+        ShapValuesByLeaf,
         MeanValuesForAllTrees,
         BinFeatureCombinationClass,
         CombinationClassFeatures,
@@ -72,22 +100,59 @@ void CalcShapValuesForDocumentMulti(
 );
 
 TShapPreparedTrees PrepareTrees(const TFullModel& model, NPar::TLocalExecutor* localExecutor);
+// shap values are precalculated for all trees regardless of preparedTreesOptions.MaxMemoryUsage
 TShapPreparedTrees PrepareTrees(
     const TFullModel& model,
     const NCB::TDataProvider* dataset, // can be nullptr if model has LeafWeights
     int logPeriod,
     EPreCalcShapValues mode,
     NPar::TLocalExecutor* localExecutor,
-    bool calcInternalValues = false
+    bool calcInternalValues = false,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
 );
 
+/* Prepared trees for consumers processing documents by blocks: if precalculated shap values for leaves
+ *  do not fit in preparedTreesOptions.MaxMemoryUsage they are precalculated by consecutive ranges of trees
+ *  again for each block, otherwise all trees are prepared once.
+ */
+class TShapPreparedTreeRanges {
+public:
+    TShapPreparedTreeRanges(
+        const TFullModel& model,
+        const NCB::TDataProvider* dataset, // can be nullptr if model has LeafWeights
+        int logPeriod,
+        EPreCalcShapValues mode,
+        NPar::TLocalExecutor* localExecutor,
+        bool calcInternalValues = false,
+        const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
+    );
+
+    size_t GetRangeCount() const {
+        return TreeRangesBounds.size() - 1;
+    }
+
+    // *rangeHolder keeps the prepared trees of the range if they are not kept for all blocks
+    const TShapPreparedTrees& GetPreparedTrees(size_t rangeIdx, TMaybe<TShapPreparedTrees>* rangeHolder) const;
+
+private:
+    const TFullModel& Model;
+    NPar::TLocalExecutor* LocalExecutor;
+    bool CalcInternalValues;
+    TShapPreparedTreesOptions PreparedTreesOptions;
+    TVector<TVector<double>> CollectedLeafWeights;
+    bool CalcShapValuesByLeaf;
+    TVector<size_t> TreeRangesBounds; // i-th range is [TreeRangesBounds[i], TreeRangesBounds[i + 1])
+    TMaybe<TShapPreparedTrees> AllTreesPreparedTrees;
+};
+
 // returned: ShapValues[documentIdx][dimenesion][feature]
 TVector<TVector<TVector<double>>> CalcShapValuesMulti(
     const TFullModel& model,
     const NCB::TDataProvider& dataset,
     int logPeriod,
     EPreCalcShapValues mode,
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
 );
 
 // returned: ShapValues[documentIdx][feature]
@@ -96,17 +161,22 @@ TVector<TVector<double>> CalcShapValues(
     const NCB::TDataProvider& dataset,
     int logPeriod,
     EPreCalcShapValues mode,
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
 );
 
-// outputs for each document in order for each dimension in order an array of feature contributions
+/* outputs for each document in order for each dimension in order an array of feature contributions
+ * if precalculated shap values for leaves do not fit in preparedTreesOptions.MaxMemoryUsage
+ *  shap values are calculated without precalculation because documents are output by blocks
+ */
 void CalcAndOutputShapValues(
     const TFullModel& model,
     const NCB::TDataProvider& dataset,
     const TString& outputPath,
     int logPeriod,
     EPreCalcShapValues mode,
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    const TShapPreparedTreesOptions& preparedTreesOptions = TShapPreparedTreesOptions()
 );
 
 void CalcShapValuesInternalForFeature(
@@ -118,5 +188,6 @@ void CalcShapValuesInternalForFeature(
     ui32 featuresCount,
     const NCB::TObjectsDataProvider& objectsData,
     TVector<TVector<TVector<double>>>* shapValues, // [docIdx][featureIdx][dim]
-    NPar::TLocalExecutor* localExecutor
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TVector<double>>* approx = nullptr // [dim][docIdx], model predictions for trees of preparedTrees, optional
 );
@@ -0,0 +1,109 @@
+#include "fstr_test_helpers.h"
+
+#include <catboost/libs/data_new/data_provider_builders.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+
+
+using namespace NCB;
+
+
+TDataProviderPtr CreateRandomPool(
+    ui32 objectCount,
+    ui32 floatFeatureCount,
+    ui32 catFeatureCount,
+    ui32 catValueCount,
+    ui64 seed,
+    ui32 objectsPerGroup
+) {
+    TFastRng64 rng(seed);
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TVector<ui32> catFeatureIndices;
+            for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                catFeatureIndices.push_back(floatFeatureCount + catFeatureIdx);
+            }
+
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.HasGroupId = objectsPerGroup != 0;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                floatFeatureCount + catFeatureCount,
+                catFeatureIndices,
+                TVector<TString>{}
+            );
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> target(objectCount, 0.0f);
+            for (auto featureIdx : xrange(floatFeatureCount)) {
+                TVector<float> feature(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    feature[objectIdx] = rng.GenRandReal1();
+                    target[objectIdx] += feature[objectIdx] * (featureIdx + 1);
+                }
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    TMaybeOwningConstArrayHolder<float>::CreateOwning(std::move(feature))
+                );
+            }
+            for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                TVector<TString> feature(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    const ui32 value = rng.Uniform(catValueCount);
+                    feature[objectIdx] = ToString(value);
+                    target[objectIdx] += (value % 2) ? 1.0f : 0.0f;
+                }
+                visitor->AddCatFeature(floatFeatureCount + catFeatureIdx, feature);
+            }
+            for (auto& value : target) {
+                value += 0.1f * rng.GenRandReal1();
+            }
+            visitor->AddTarget(target);
+            if (objectsPerGroup != 0) {
+                for (auto objectIdx : xrange(objectCount)) {
+                    visitor->AddGroupId(objectIdx, TGroupId(objectIdx / objectsPerGroup));
+                }
+            }
+
+            visitor->Finish();
+        }
+    );
+}
+
+TFullModel TrainModelOnPool(TDataProviderPtr pool, const TString& lossFunction, int iterations, int depth) {
+    TTempDir trainDir;
+
+    TDataProviders dataProviders;
+    dataProviders.Learn = pool;
+    dataProviders.Test.push_back(pool);
+
+    NJson::TJsonValue params;
+    params.InsertValue("loss_function", lossFunction);
+    params.InsertValue("iterations", iterations);
+    params.InsertValue("depth", depth);
+    params.InsertValue("random_seed", 1);
+    params.InsertValue("train_dir", trainDir.Name());
+
+    TFullModel model;
+    TEvalResult evalResult;
+    TrainModel(
+        params,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        std::move(dataProviders),
+        /*initModel*/ Nothing(),
+        /*initLearnProgress*/ nullptr,
+        "",
+        &model,
+        {&evalResult}
+    );
+    return model;
+}
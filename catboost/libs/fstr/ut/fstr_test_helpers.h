@@ -0,0 +1,25 @@
+#pragma once
+
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/model/model.h>
+
+#include <util/generic/string.h>
+
+/* float features are uniform in [0, 1), categorical ones have catValueCount values, target depends on all of them
+ * if objectsPerGroup is not 0 consecutive objects are grouped by objectsPerGroup
+ */
+NCB::TDataProviderPtr CreateRandomPool(
+    ui32 objectCount,
+    ui32 floatFeatureCount,
+    ui32 catFeatureCount = 0,
+    ui32 catValueCount = 5,
+    ui64 seed = 42,
+    ui32 objectsPerGroup = 0
+);
+
+TFullModel TrainModelOnPool(
+    NCB::TDataProviderPtr pool,
+    const TString& lossFunction = "RMSE",
+    int iterations = 20,
+    int depth = 4
+);
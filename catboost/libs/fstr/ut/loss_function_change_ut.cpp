@@ -0,0 +1,155 @@
+#include "fstr_test_helpers.h"
+
+#include <catboost/libs/algo/apply.h>
+#include <catboost/libs/fstr/calc_fstr.h>
+#include <catboost/libs/fstr/shap_values.h>
+#include <catboost/libs/metrics/metric.h>
+#include <catboost/libs/options/loss_description.h>
+#include <catboost/libs/target/data_providers.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+
+/* LossFunctionChange calculated on the whole dataset at once, as it was calculated before processing documents by
+ *  blocks: the metric of the model without the feature contribution minus the metric of the model
+ *  returned: [floatFeatureIdx]
+ */
+static TVector<double> CalcLossFunctionChangeOnWholeDataset(
+    const TFullModel& model,
+    const TDataProvider& dataset,
+    const TString& metricDescription,
+    NPar::TLocalExecutor* localExecutor
+) {
+    const auto lossDescription = NCatboostOptions::ParseLossDescription(metricDescription);
+    TRestorableFastRng64 rand(0);
+    const auto targetData = CreateModelCompatibleProcessedDataProvider(
+        dataset,
+        {lossDescription},
+        model,
+        &rand,
+        localExecutor
+    ).TargetData;
+    const TConstArrayRef<TQueryInfo> queriesInfo
+        = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
+    const TConstArrayRef<float> target = *targetData->GetTarget();
+    const TConstArrayRef<float> weights = GetWeights(*targetData);
+    const int evalEnd = queriesInfo.empty() ? target.ysize() : queriesInfo.ysize();
+
+    const auto metric = std::move(CreateMetricFromDescription(lossDescription, model.GetDimensionsCount())[0]);
+    const auto evalMetric = [&] (const TVector<TVector<double>>& approx) {
+        return metric->GetFinalError(
+            metric->Eval(approx, target, weights, queriesInfo, 0, evalEnd, *localExecutor)
+        );
+    };
+
+    const auto approx = ApplyModelMulti(model, dataset);
+    const double modelMetric = evalMetric(approx);
+
+    const auto shapValues = CalcShapValuesMulti(
+        model,
+        dataset,
+        /*logPeriod*/ 0,
+        EPreCalcShapValues::Auto,
+        localExecutor
+    ); // [docIdx][dim][featureIdx]
+
+    EMetricBestValue valueType;
+    float bestValue;
+    metric->GetBestValue(&valueType, &bestValue);
+
+    TVector<double> lossFunctionChange(model.GetNumFloatFeatures());
+    for (auto featureIdx : xrange(lossFunctionChange.size())) {
+        auto featureApprox = approx;
+        for (auto dimension : xrange(featureApprox.size())) {
+            for (auto documentIdx : xrange(featureApprox[dimension].size())) {
+                featureApprox[dimension][documentIdx] -= shapValues[documentIdx][dimension][featureIdx];
+            }
+        }
+        lossFunctionChange[featureIdx] = evalMetric(featureApprox) - modelMetric;
+        if (valueType == EMetricBestValue::Max) {
+            lossFunctionChange[featureIdx] = -lossFunctionChange[featureIdx];
+        }
+    }
+    return lossFunctionChange;
+}
+
+static void CheckLossFunctionChange(
+    TDataProviderPtr pool,
+    const TString& lossFunction,
+    const TShapPreparedTreesOptions& preparedTreesOptions
+) {
+    const auto model = TrainModelOnPool(pool, lossFunction);
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(3);
+
+    const auto expected = CalcLossFunctionChangeOnWholeDataset(model, *pool, lossFunction, &localExecutor);
+    const auto actual = CalcFeatureEffect(
+        model,
+        pool,
+        EFstrType::LossFunctionChange,
+        &localExecutor,
+        preparedTreesOptions
+    );
+
+    UNIT_ASSERT(!actual.empty());
+    for (const auto& [score, feature] : actual) {
+        UNIT_ASSERT_EQUAL(feature.Type, ESplitType::FloatFeature);
+        UNIT_ASSERT_DOUBLES_EQUAL_C(
+            expected[feature.FeatureIdx],
+            score,
+            1e-6 * Max(1.0, Abs(expected[feature.FeatureIdx])),
+            "feature " << feature.FeatureIdx
+        );
+    }
+}
+
+static TShapPreparedTreesOptions GetTreeRangesOptions() {
+    TShapPreparedTreesOptions options;
+    options.MaxMemoryUsage = 1; // each tree is prepared in its own range
+    return options;
+}
+
+Y_UNIT_TEST_SUITE(TLossFunctionChange) {
+    // more than one block of 10000 documents
+    Y_UNIT_TEST(MatchesWholeDatasetCalculation) {
+        const auto pool = CreateRandomPool(/*objectCount*/ 25000, /*floatFeatureCount*/ 5);
+        CheckLossFunctionChange(pool, "RMSE", TShapPreparedTreesOptions());
+    }
+
+    Y_UNIT_TEST(MatchesWholeDatasetCalculationWithTreeRanges) {
+        const auto pool = CreateRandomPool(/*objectCount*/ 25000, /*floatFeatureCount*/ 5);
+        CheckLossFunctionChange(pool, "RMSE", GetTreeRangesOptions());
+    }
+
+    // more than one block of 10000 queries, so queries of the last block are shifted to its begin
+    Y_UNIT_TEST(MatchesWholeDatasetCalculationForQueries) {
+        const auto pool = CreateRandomPool(
+            /*objectCount*/ 24000,
+            /*floatFeatureCount*/ 5,
+            /*catFeatureCount*/ 0,
+            /*catValueCount*/ 5,
+            /*seed*/ 42,
+            /*objectsPerGroup*/ 2
+        );
+        CheckLossFunctionChange(pool, "QueryRMSE", TShapPreparedTreesOptions());
+    }
+
+    Y_UNIT_TEST(MatchesWholeDatasetCalculationForQueriesWithTreeRanges) {
+        const auto pool = CreateRandomPool(
+            /*objectCount*/ 24000,
+            /*floatFeatureCount*/ 5,
+            /*catFeatureCount*/ 0,
+            /*catValueCount*/ 5,
+            /*seed*/ 42,
+            /*objectsPerGroup*/ 2
+        );
+        CheckLossFunctionChange(pool, "QueryRMSE", GetTreeRangesOptions());
+    }
+}
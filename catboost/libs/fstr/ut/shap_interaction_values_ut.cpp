@@ -0,0 +1,201 @@
+#include "fstr_test_helpers.h"
+
+#include <catboost/libs/fstr/shap_interaction_values.h>
+#include <catboost/libs/fstr/shap_values.h>
+
+#include <library/pop_count/popcount.h>
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+
+
+using namespace NCB;
+
+
+// expected value of the tree subtree at (depth, nodeIdx) for a document with known features only from subset
+static double CalcConditionalTreeValue(
+    const TObliviousTrees& forest,
+    size_t treeIdx,
+    const TVector<float>& features,
+    ui32 subset,
+    int depth,
+    size_t nodeIdx,
+    double* nodeWeight
+) {
+    const int treeDepth = forest.TreeSizes[treeIdx];
+    if (depth == treeDepth) {
+        *nodeWeight = forest.LeafWeights[treeIdx][nodeIdx];
+        return forest.GetFirstLeafPtrForTree(treeIdx)[nodeIdx];
+    }
+    const auto& split = forest.GetBinFeatures()[forest.TreeSplits[forest.TreeStartOffsets[treeIdx] + depth]];
+    const int feature = split.FloatFeature.FloatFeature;
+    const size_t rightNodeIdx = nodeIdx | (size_t(1) << depth);
+    if (subset & (1u << feature)) {
+        const bool goRight = features[feature] > split.FloatFeature.Split;
+        return CalcConditionalTreeValue(
+            forest, treeIdx, features, subset, depth + 1, goRight ? rightNodeIdx : nodeIdx, nodeWeight
+        );
+    }
+    double leftWeight = 0;
+    double rightWeight = 0;
+    const double leftValue = CalcConditionalTreeValue(
+        forest, treeIdx, features, subset, depth + 1, nodeIdx, &leftWeight
+    );
+    const double rightValue = CalcConditionalTreeValue(
+        forest, treeIdx, features, subset, depth + 1, rightNodeIdx, &rightWeight
+    );
+    *nodeWeight = leftWeight + rightWeight;
+    return *nodeWeight > 0 ? (leftWeight * leftValue + rightWeight * rightValue) / *nodeWeight : 0.0;
+}
+
+static double Factorial(int n) {
+    double result = 1;
+    for (int i = 2; i <= n; ++i) {
+        result *= i;
+    }
+    return result;
+}
+
+// interaction values by definition: weighted sums over all subsets of all features
+static TVector<double> CalcShapInteractionValuesByDefinition(
+    const TFullModel& model,
+    const TVector<float>& features
+) {
+    const TObliviousTrees& forest = *model.ObliviousTrees;
+    const int featureCount = features.size();
+    const ui32 subsetCount = 1u << featureCount;
+
+    TVector<double> conditionalValues(subsetCount, 0.0);
+    for (auto subset : xrange(subsetCount)) {
+        for (auto treeIdx : xrange(forest.TreeSizes.size())) {
+            double weight = 0;
+            conditionalValues[subset] += CalcConditionalTreeValue(forest, treeIdx, features, subset, 0, 0, &weight);
+        }
+    }
+
+    const size_t rowSize = featureCount + 1;
+    TVector<double> result(rowSize * rowSize, 0.0);
+    for (int i = 0; i < featureCount; ++i) {
+        for (int j = 0; j < featureCount; ++j) {
+            if (i == j) {
+                continue;
+            }
+            const ui32 pairMask = (1u << i) | (1u << j);
+            for (ui32 subset = 0; subset < subsetCount; ++subset) {
+                if (subset & pairMask) {
+                    continue;
+                }
+                const int subsetSize = PopCount(subset);
+                const double weight = Factorial(subsetSize) * Factorial(featureCount - subsetSize - 2)
+                    / (2 * Factorial(featureCount - 1));
+                result[i * rowSize + j] += weight * (
+                    conditionalValues[subset | pairMask]
+                    - conditionalValues[subset | (1u << i)]
+                    - conditionalValues[subset | (1u << j)]
+                    + conditionalValues[subset]
+                );
+            }
+        }
+    }
+    for (int i = 0; i < featureCount; ++i) {
+        double shapValue = 0;
+        for (ui32 subset = 0; subset < subsetCount; ++subset) {
+            if (subset & (1u << i)) {
+                continue;
+            }
+            const int subsetSize = PopCount(subset);
+            shapValue += Factorial(subsetSize) * Factorial(featureCount - subsetSize - 1) / Factorial(featureCount)
+                * (conditionalValues[subset | (1u << i)] - conditionalValues[subset]);
+        }
+        result[i * rowSize + i] = shapValue;
+        for (int j = 0; j < featureCount; ++j) {
+            if (j != i) {
+                result[i * rowSize + i] -= result[i * rowSize + j];
+            }
+        }
+    }
+    result[featureCount * rowSize + featureCount] = conditionalValues[0];
+    return result;
+}
+
+Y_UNIT_TEST_SUITE(ShapInteractionValuesTests) {
+    Y_UNIT_TEST(MatchesDefinition) {
+        const ui32 featureCount = 5;
+        const auto pool = CreateRandomPool(/*objectCount*/ 200, featureCount);
+        const auto model = TrainModelOnPool(pool, "RMSE", /*iterations*/ 10, /*depth*/ 6);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        const auto& rawObjectsData = dynamic_cast<const TRawObjectsDataProvider&>(*pool->ObjectsData);
+        TVector<TVector<float>> featureColumns(featureCount, TVector<float>(pool->GetObjectCount()));
+        for (auto featureIdx : xrange(featureCount)) {
+            (*rawObjectsData.GetFloatFeature(featureIdx))->GetArrayData().ForEach(
+                [&] (ui32 objectIdx, float value) {
+                    featureColumns[featureIdx][objectIdx] = value;
+                }
+            );
+        }
+
+        TShapPreparedTreesOptions splitTreesOptions;
+        splitTreesOptions.MaxMemoryUsage = 1;
+        for (const auto& preparedTreesOptions : {TShapPreparedTreesOptions(), splitTreesOptions}) {
+            const auto interactionValues = CalcShapInteractionValuesMulti(
+                model, *pool, /*logPeriod*/ 0, &localExecutor, preparedTreesOptions
+            );
+            UNIT_ASSERT_VALUES_EQUAL(interactionValues.size(), pool->GetObjectCount());
+            for (auto documentIdx : xrange<ui32>(0, pool->GetObjectCount(), 7)) {
+                TVector<float> features;
+                for (const auto& column : featureColumns) {
+                    features.push_back(column[documentIdx]);
+                }
+                const auto expected = CalcShapInteractionValuesByDefinition(model, features);
+                const auto& actual = interactionValues[documentIdx][0];
+                UNIT_ASSERT_VALUES_EQUAL(expected.size(), actual.size());
+                for (auto idx : xrange(expected.size())) {
+                    UNIT_ASSERT_DOUBLES_EQUAL_C(
+                        expected[idx],
+                        actual[idx],
+                        1e-6,
+                        "document " << documentIdx << ", element " << idx
+                    );
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(RowsSumToShapValues) {
+        const auto pool = CreateRandomPool(/*objectCount*/ 300, /*floatFeatureCount*/ 4, /*catFeatureCount*/ 2);
+        const auto model = TrainModelOnPool(pool, "MultiClass");
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        const auto interactionValues = CalcShapInteractionValuesMulti(model, *pool, /*logPeriod*/ 0, &localExecutor);
+        const auto shapValues = CalcShapValuesMulti(
+            model, *pool, /*logPeriod*/ 0, EPreCalcShapValues::NoPreCalc, &localExecutor
+        );
+        UNIT_ASSERT_VALUES_EQUAL(interactionValues.size(), shapValues.size());
+        for (auto documentIdx : xrange(shapValues.size())) {
+            for (auto dimension : xrange(shapValues[documentIdx].size())) {
+                const auto& documentShapValues = shapValues[documentIdx][dimension];
+                const auto& documentInteractionValues = interactionValues[documentIdx][dimension];
+                const size_t rowSize = documentShapValues.size();
+                UNIT_ASSERT_VALUES_EQUAL(documentInteractionValues.size(), rowSize * rowSize);
+                for (auto row : xrange(rowSize)) {
+                    double rowSum = 0;
+                    for (auto column : xrange(rowSize)) {
+                        rowSum += documentInteractionValues[row * rowSize + column];
+                    }
+                    UNIT_ASSERT_DOUBLES_EQUAL_C(
+                        documentShapValues[row],
+                        rowSum,
+                        1e-6,
+                        "document " << documentIdx << ", dimension " << dimension << ", feature " << row
+                    );
+                }
+            }
+        }
+    }
+}
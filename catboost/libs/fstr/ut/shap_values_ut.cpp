@@ -0,0 +1,140 @@
+#include "fstr_test_helpers.h"
+
+#include <catboost/libs/algo/model_quantization_adapter.h>
+#include <catboost/libs/fstr/shap_values.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+
+
+using namespace NCB;
+
+
+// shap values calculated document by document, as they were calculated before block calculation
+static TVector<TVector<TVector<double>>> CalcShapValuesByDocuments(
+    const TFullModel& model,
+    const TDataProvider& dataset,
+    EPreCalcShapValues mode,
+    NPar::TLocalExecutor* localExecutor
+) {
+    const auto preparedTrees = PrepareTrees(model, &dataset, /*logPeriod*/ 0, mode, localExecutor);
+    const auto quantizedData = MakeQuantizedFeaturesForEvaluator(model, *dataset.ObjectsData);
+    const int flatFeatureCount = dataset.ObjectsData->GetFeaturesLayout()->GetExternalFeatureCount();
+
+    TVector<TVector<TVector<double>>> shapValues(dataset.GetObjectCount());
+    for (auto documentIdx : xrange(shapValues.size())) {
+        CalcShapValuesForDocumentMulti(
+            model,
+            preparedTrees,
+            quantizedData.Get(),
+            flatFeatureCount,
+            documentIdx,
+            &shapValues[documentIdx]
+        );
+    }
+    return shapValues;
+}
+
+static void AssertEqualShapValues(
+    const TVector<TVector<TVector<double>>>& expected,
+    const TVector<TVector<TVector<double>>>& actual
+) {
+    UNIT_ASSERT_VALUES_EQUAL(expected.size(), actual.size());
+    for (auto documentIdx : xrange(expected.size())) {
+        UNIT_ASSERT_VALUES_EQUAL(expected[documentIdx].size(), actual[documentIdx].size());
+        for (auto dimension : xrange(expected[documentIdx].size())) {
+            UNIT_ASSERT_VALUES_EQUAL(expected[documentIdx][dimension].size(), actual[documentIdx][dimension].size());
+            for (auto feature : xrange(expected[documentIdx][dimension].size())) {
+                UNIT_ASSERT_DOUBLES_EQUAL_C(
+                    expected[documentIdx][dimension][feature],
+                    actual[documentIdx][dimension][feature],
+                    1e-9,
+                    "document " << documentIdx << ", dimension " << dimension << ", feature " << feature
+                );
+            }
+        }
+    }
+}
+
+Y_UNIT_TEST_SUITE(ShapValuesTests) {
+    void CheckBlocksMatchDocuments(const TString& lossFunction, ui32 objectCount, int threadCount) {
+        const auto pool = CreateRandomPool(objectCount, /*floatFeatureCount*/ 6);
+        const auto model = TrainModelOnPool(pool, lossFunction);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(threadCount - 1);
+        for (auto mode : {EPreCalcShapValues::UsePreCalc, EPreCalcShapValues::NoPreCalc}) {
+            AssertEqualShapValues(
+                CalcShapValuesByDocuments(model, *pool, mode, &localExecutor),
+                CalcShapValuesMulti(model, *pool, /*logPeriod*/ 0, mode, &localExecutor)
+            );
+        }
+    }
+
+    Y_UNIT_TEST(BlocksMatchDocuments) {
+        // a single thread, fewer evaluation blocks than threads (trees are split), several document blocks
+        for (ui32 objectCount : {1, 100, 1000, 3000}) {
+            for (int threadCount : {1, 4}) {
+                CheckBlocksMatchDocuments("RMSE", objectCount, threadCount);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(BlocksMatchDocumentsMultiClass) {
+        CheckBlocksMatchDocuments("MultiClass", 1000, 4);
+    }
+
+    void CheckPreparedTreesOptions(const TString& lossFunction, ui32 catFeatureCount) {
+        const auto pool = CreateRandomPool(/*objectCount*/ 1000, /*floatFeatureCount*/ 4, catFeatureCount);
+        const auto model = TrainModelOnPool(pool, lossFunction);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        const auto expected = CalcShapValuesMulti(
+            model, *pool, /*logPeriod*/ 0, EPreCalcShapValues::UsePreCalc, &localExecutor
+        );
+
+        // each tree in its own range, a few trees in a range
+        for (ui64 maxMemoryUsage : {ui64(1), ui64(64) << 10}) {
+            TShapPreparedTreesOptions options;
+            options.MaxMemoryUsage = maxMemoryUsage;
+            AssertEqualShapValues(
+                expected,
+                CalcShapValuesMulti(
+                    model, *pool, /*logPeriod*/ 0, EPreCalcShapValues::UsePreCalc, &localExecutor, options
+                )
+            );
+        }
+
+        TShapPreparedTreesOptions singlePrecisionOptions;
+        singlePrecisionOptions.UseSinglePrecision = true;
+        const auto singlePrecisionValues = CalcShapValuesMulti(
+            model, *pool, /*logPeriod*/ 0, EPreCalcShapValues::UsePreCalc, &localExecutor, singlePrecisionOptions
+        );
+        UNIT_ASSERT_VALUES_EQUAL(expected.size(), singlePrecisionValues.size());
+        for (auto documentIdx : xrange(expected.size())) {
+            for (auto dimension : xrange(expected[documentIdx].size())) {
+                for (auto feature : xrange(expected[documentIdx][dimension].size())) {
+                    const double value = expected[documentIdx][dimension][feature];
+                    UNIT_ASSERT_DOUBLES_EQUAL(
+                        value,
+                        singlePrecisionValues[documentIdx][dimension][feature],
+                        1e-5 * Max(1.0, Abs(value))
+                    );
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(PreparedTreesOptions) {
+        CheckPreparedTreesOptions("RMSE", /*catFeatureCount*/ 0);
+    }
+
+    Y_UNIT_TEST(PreparedTreesOptionsWithCtrs) {
+        // ctrs of feature combinations split values of a tree leaf between more flat features than tree depth
+        CheckPreparedTreesOptions("RMSE", /*catFeatureCount*/ 3);
+        CheckPreparedTreesOptions("MultiClass", /*catFeatureCount*/ 3);
+    }
+}
@@ -0,0 +1,119 @@
+#include "numa.h"
+
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/ymath.h>
+#include <util/system/align.h>
+#include <util/system/info.h>
+
+#if defined(_linux_)
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+
+bool NCB::BindMemoryToNumaNode(const void* data, size_t size, int numaNode) {
+#if defined(_linux_) && defined(SYS_mbind)
+    if (size == 0) {
+        return true;
+    }
+    constexpr int MpolPreferred = 1; // MPOL_PREFERRED from numaif.h, falls back to other nodes if the node is full
+    constexpr unsigned MpolMfMove = 1 << 1; // MPOL_MF_MOVE, move already touched pages too
+    constexpr int MaskWordBits = sizeof(unsigned long) * 8;
+
+    const uintptr_t pageSize = NSystemInfo::GetPageSize();
+    const uintptr_t begin = AlignDown(reinterpret_cast<uintptr_t>(data), pageSize);
+    const uintptr_t end = AlignUp(reinterpret_cast<uintptr_t>(data) + size, pageSize);
+
+    // the kernel uses maxnode - 1 bits of the mask
+    TVector<unsigned long> nodeMask((numaNode + 1) / MaskWordBits + 1, 0);
+    nodeMask[numaNode / MaskWordBits] |= 1UL << (numaNode % MaskWordBits);
+    const bool success = syscall(
+        SYS_mbind,
+        begin,
+        end - begin,
+        MpolPreferred,
+        nodeMask.data(),
+        nodeMask.size() * MaskWordBits,
+        MpolMfMove
+    ) == 0;
+    if (!success) {
+        CATBOOST_DEBUG_LOG << "mbind to NUMA node " << numaNode << " failed: " << strerror(errno) << Endl;
+    }
+    return success;
+#else
+    Y_UNUSED(data);
+    Y_UNUSED(size);
+    Y_UNUSED(numaNode);
+    return false;
+#endif
+}
+
+
+NCB::TNumaObjectsPartition::TNumaObjectsPartition(
+    ui64 objectCount,
+    ui64 blockSize,
+    const NPar::TLocalExecutor& localExecutor
+)
+    : TNumaObjectsPartition(
+        localExecutor.GetNumaNodeCount() < 2 ? 0 : objectCount,
+        blockSize,
+        [&localExecutor, blockCount = blockSize ? CeilDiv<ui64>(objectCount, blockSize) : 0] (int blockIdx) {
+            return localExecutor.GetRangeNumaNode(blockIdx, 0, static_cast<int>(blockCount));
+        }
+    )
+{
+}
+
+NCB::TNumaObjectsPartition::TNumaObjectsPartition(
+    ui64 objectCount,
+    ui64 blockSize,
+    const std::function<int(int)>& getBlockNumaNode
+) {
+    if ((objectCount == 0) || (blockSize == 0) || (objectCount <= blockSize)) {
+        return;
+    }
+    const int blockCount = static_cast<int>(CeilDiv<ui64>(objectCount, blockSize));
+    for (int blockIdx = 0; blockIdx < blockCount; ++blockIdx) {
+        const ui64 blockEnd = Min(objectCount, blockSize * (blockIdx + 1));
+        const int numaNode = getBlockNumaNode(blockIdx);
+        if (!Parts.empty() && (Parts.back().second == numaNode)) {
+            Parts.back().first = blockEnd;
+        } else {
+            Parts.emplace_back(blockEnd, numaNode);
+        }
+    }
+}
+
+int NCB::TNumaObjectsPartition::GetNumaNode(ui64 objectIdx) const {
+    const auto part = UpperBound(
+        Parts.begin(),
+        Parts.end(),
+        objectIdx,
+        [] (ui64 objectIdx, const std::pair<ui64, int>& part) {
+            return objectIdx < part.first;
+        }
+    );
+    return part == Parts.end() ? 0 : part->second;
+}
+
+void NCB::TNumaObjectsPartition::Place(const void* data, ui64 objectCount, ui32 bitsPerObject) const {
+    if (IsTrivial() || !data) {
+        return;
+    }
+    const char* bytes = static_cast<const char*>(data);
+    ui64 partBegin = 0;
+    for (const auto& [partEnd, numaNode] : Parts) {
+        const ui64 begin = Min(partBegin, objectCount) * bitsPerObject / 8;
+        const ui64 end = CeilDiv<ui64>(Min(partEnd, objectCount) * bitsPerObject, 8);
+        PlacedByteCount += end - begin;
+        if (!BindMemoryToNumaNode(bytes + begin, end - begin, numaNode)) {
+            FailedByteCount += end - begin;
+        }
+        partBegin = partEnd;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <functional>
+#include <utility>
+
+
+namespace NCB {
+
+    // moves pages of [data, data + size) to NUMA node, returns false if it is not supported on this platform
+    bool BindMemoryToNumaNode(const void* data, size_t size, int numaNode);
+
+    // block size of NPar::ParallelFor over objectCount objects with localExecutor of threadCount threads
+    inline ui64 GetParallelForBlockSize(ui64 objectCount, int threadCount) {
+        return (objectCount + threadCount) / (threadCount + 1);
+    }
+
+    /**
+     * Splits objects into consecutive parts by the NUMA node that processes them when blocks of blockSize
+     *  objects (the last one may be smaller) are processed by localExecutor->ExecRange over [0, blockCount),
+     *  as MapMerge does for TSimpleIndexRangesGenerator ranges of TCalcScoreFold::GetCalcStatsIndexRanges()
+     *
+     * The split is trivial unless localExecutor threads are pinned and there are several NUMA nodes.
+     */
+    class TNumaObjectsPartition {
+    public:
+        TNumaObjectsPartition(ui64 objectCount, ui64 blockSize, const NPar::TLocalExecutor& localExecutor);
+
+        // getBlockNumaNode(blockIdx) is the NUMA node that processes block blockIdx
+        TNumaObjectsPartition(ui64 objectCount, ui64 blockSize, const std::function<int(int)>& getBlockNumaNode);
+
+        bool IsTrivial() const {
+            return Parts.size() < 2;
+        }
+
+        // 0 for objects outside of [0, objectCount) and for trivial partitions
+        int GetNumaNode(ui64 objectIdx) const;
+
+        // object objectIdx occupies bits [objectIdx * bitsPerObject, (objectIdx + 1) * bitsPerObject) of data,
+        //  parts that can't be moved are left where they are and counted in GetFailedByteCount()
+        void Place(const void* data, ui64 objectCount, ui32 bitsPerObject) const;
+
+        template <class T>
+        void Place(TConstArrayRef<T> data) const {
+            Place(data.data(), data.size(), sizeof(T) * 8);
+        }
+
+        // bytes passed to BindMemoryToNumaNode by Place calls
+        ui64 GetPlacedByteCount() const {
+            return PlacedByteCount;
+        }
+
+        ui64 GetFailedByteCount() const {
+            return FailedByteCount;
+        }
+
+    private:
+        TVector<std::pair<ui64, int>> Parts; // (end object index, NUMA node)
+        mutable ui64 PlacedByteCount = 0;
+        mutable ui64 FailedByteCount = 0;
+    };
+
+}
@@ -0,0 +1,102 @@
+#include <catboost/libs/helpers/numa.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/ymath.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(TNumaObjectsPartitionTest) {
+    // blocks as TSimpleIndexRangesGenerator creates them and slices as ExecRange processes them
+    void CheckPartitionMatchesExecRangeSlices(ui64 objectCount, ui64 blockSize, int threadCount, int numaNodeCount) {
+        const int blockCount = CeilDiv<ui64>(objectCount, blockSize);
+        const int sliceCount = Min(threadCount + 1, blockCount);
+        const auto getBlockNumaNode = [=] (int blockIdx) {
+            const int sliceIdx = NPar::TLocalExecutor::GetRangeSliceIdx(blockIdx, 0, blockCount, sliceCount);
+            return sliceIdx * numaNodeCount / sliceCount;
+        };
+        const NCB::TNumaObjectsPartition partition(objectCount, blockSize, getBlockNumaNode);
+        UNIT_ASSERT_EQUAL(partition.IsTrivial(), sliceCount == 1 || numaNodeCount == 1);
+
+        for (int sliceIdx = 0; sliceIdx < sliceCount; ++sliceIdx) {
+            const auto [beginBlock, endBlock] = NPar::TLocalExecutor::GetRangeSlice(sliceIdx, 0, blockCount, sliceCount);
+            const int expectedNumaNode = partition.IsTrivial() ? 0 : sliceIdx * numaNodeCount / sliceCount;
+            for (int blockIdx = beginBlock; blockIdx < endBlock; ++blockIdx) {
+                const ui64 blockEnd = Min(objectCount, (blockIdx + 1) * blockSize);
+                for (ui64 objectIdx = blockIdx * blockSize; objectIdx < blockEnd; ++objectIdx) {
+                    UNIT_ASSERT_EQUAL_C(
+                        partition.GetNumaNode(objectIdx),
+                        expectedNumaNode,
+                        "object " << objectIdx << " of " << objectCount << ", block size " << blockSize
+                    );
+                }
+            }
+        }
+        UNIT_ASSERT_EQUAL(partition.GetNumaNode(objectCount), 0);
+    }
+
+    Y_UNIT_TEST(TestPartitionMatchesExecRangeSlices) {
+        for (ui64 objectCount : {1, 9, 10, 1000, 12345}) {
+            for (ui64 blockSize : {1, 4, 100, 5000}) {
+                for (int threadCount : {0, 1, 3, 15}) {
+                    for (int numaNodeCount : {1, 2, 3}) {
+                        CheckPartitionMatchesExecRangeSlices(objectCount, blockSize, threadCount, numaNodeCount);
+                    }
+                }
+            }
+        }
+    }
+
+    // partitions of fold order arrays do not depend on the score calculation block size
+    Y_UNIT_TEST(TestParallelForPartitionPlacement) {
+        const ui64 objectCount = 1000;
+        const int threadCount = 3;
+        const int numaNodeCount = 2;
+        const ui64 blockSize = NCB::GetParallelForBlockSize(objectCount, threadCount);
+        UNIT_ASSERT_EQUAL(CeilDiv<ui64>(objectCount, blockSize), threadCount + 1);
+        const NCB::TNumaObjectsPartition partition(
+            objectCount,
+            blockSize,
+            [=] (int blockIdx) {
+                return blockIdx * numaNodeCount / (threadCount + 1);
+            }
+        );
+        UNIT_ASSERT(!partition.IsTrivial());
+        UNIT_ASSERT_EQUAL(partition.GetNumaNode(0), 0);
+        UNIT_ASSERT_EQUAL(partition.GetNumaNode(objectCount - 1), numaNodeCount - 1);
+
+        TVector<ui32> data(objectCount);
+        partition.Place<ui32>(data);
+        UNIT_ASSERT_EQUAL(partition.GetPlacedByteCount(), objectCount * sizeof(ui32));
+        UNIT_ASSERT(partition.GetFailedByteCount() <= partition.GetPlacedByteCount());
+    }
+
+    Y_UNIT_TEST(TestPartitionWithLocalExecutor) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.SetThreadPinning(true);
+        localExecutor.RunAdditionalThreads(7);
+        const ui64 objectCount = 10000;
+        const ui64 blockSize = 300;
+        const int blockCount = CeilDiv(objectCount, blockSize);
+        const NCB::TNumaObjectsPartition partition(objectCount, blockSize, localExecutor);
+        UNIT_ASSERT(!partition.IsTrivial() || (localExecutor.GetNumaNodeCount() < 2));
+        for (ui64 objectIdx = 0; objectIdx < objectCount; ++objectIdx) {
+            const int expectedNumaNode = partition.IsTrivial()
+                ? 0
+                : localExecutor.GetRangeNumaNode(objectIdx / blockSize, 0, blockCount);
+            UNIT_ASSERT_EQUAL(partition.GetNumaNode(objectIdx), expectedNumaNode);
+        }
+
+        // placement may be unsupported, but it never moves data
+        TVector<ui32> data(objectCount);
+        for (ui64 objectIdx = 0; objectIdx < objectCount; ++objectIdx) {
+            data[objectIdx] = objectIdx;
+        }
+        partition.Place<ui32>(data);
+        for (ui64 objectIdx = 0; objectIdx < objectCount; ++objectIdx) {
+            UNIT_ASSERT_EQUAL(data[objectIdx], objectIdx);
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <catboost/libs/algo/data.h>
 #include <catboost/libs/algo/approx_dimension.h>
+#include <catboost/libs/algo/learn_context.h>
 #include <catboost/libs/data_new/objects_grouping.h>
 #include <catboost/libs/helpers/cpu_random.h>
 #include <catboost/libs/helpers/exception.h>
@@ -11,12 +12,18 @@
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/logging/profile_info.h>
 #include <catboost/libs/options/plain_options_helper.h>
+#include <catboost/libs/options/system_options.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/deque.h>
 #include <util/generic/set.h>
 #include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/random/shuffle.h>
+#include <util/system/guard.h>
+#include <util/system/mem_info.h>
+#include <util/system/mutex.h>
 
 #include <numeric>
 
@@ -854,9 +861,440 @@ namespace {
         }
         return bestParamsSetMetricValue;
     }
+
+    struct TSuccessiveHalvingQuantizedData {
+        TQuantizationParamsInfo QuantizationParamsSet;
+        TMaybe<NCB::TTrainingDataProviders> TrainTestData; // quantized on demand, released when not needed
+        TLabelConverter LabelConverter;
+    };
+
+    struct TSuccessiveHalvingCandidate {
+        TQuantizationParamsInfo QuantizationParamsSet;
+        NJson::TJsonValue ModelParams;
+        NCatboostOptions::TCatBoostOptions CatBoostOptions;
+        NCatboostOptions::TOutputFilesOptions OutputFileOptions;
+        size_t QuantizedDataIdx = 0;
+        THolder<TLearnProgress> LearnProgress; // nullptr before the first round or if released to save memory
+        ui32 TrainedIterationCount = 0;
+        TMaybe<double> MetricValue;
+
+    public:
+        explicit TSuccessiveHalvingCandidate(const NCatboostOptions::TCatBoostOptions& catBoostOptions)
+            : CatBoostOptions(catBoostOptions)
+        {}
+    };
+
+    bool IsSameQuantization(const TQuantizationParamsInfo& lhs, const TQuantizationParamsInfo& rhs) {
+        return lhs.BinsCount == rhs.BinsCount && lhs.BorderType == rhs.BorderType && lhs.NanMode == rhs.NanMode;
+    }
+
+    // candidates alive at the beginning of each round, the last round trains them to full iterations
+    TVector<size_t> GetSuccessiveHalvingRoundSizes(size_t candidateCount, ui32 reductionFactor) {
+        TVector<size_t> roundSizes = {candidateCount};
+        while (roundSizes.back() > reductionFactor) {
+            roundSizes.push_back(Max<size_t>(1, roundSizes.back() / reductionFactor));
+        }
+        return roundSizes;
+    }
+
+    bool IsCpuRamUsageOverLimit(const NCatboostOptions::TCatBoostOptions& catBoostOptions) {
+        const ui64 cpuRamLimit = ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get());
+        return NMemInfo::GetMemInfo().RSS > cpuRamLimit;
+    }
+
+    double TuneHyperparamsTrainTestBySuccessiveHalving(
+        const TVector<TString>& paramNames,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        const TTrainTestSplitParams& trainTestSplitParams,
+        const NCB::TSuccessiveHalvingParams& successiveHalvingParams,
+        NCB::TDataProviderPtr data,
+        TProductIteratorBase<TDeque<NJson::TJsonValue>, NJson::TJsonValue>* gridIterator,
+        NJson::TJsonValue* modelParamsToBeTried,
+        TGridParamsInfo * bestGridParams,
+        NPar::TLocalExecutor* localExecutor,
+        bool verbose,
+        const THashMap<TString, NCB::TCustomRandomDistributionGenerator>& randDistGenerators = {}) {
+
+        const ui32 reductionFactor = successiveHalvingParams.ReductionFactor;
+        CB_ENSURE(reductionFactor > 1, "Error: successive halving reduction factor should be greater than 1");
+
+        TRestorableFastRng64 rand(trainTestSplitParams.PartitionRandSeed);
+
+        if (trainTestSplitParams.Shuffle) {
+            auto objectsGroupingSubset = NCB::Shuffle(data->ObjectsGrouping, 1, &rand);
+            data = data->GetSubset(objectsGroupingSubset, localExecutor);
+        }
+        // every quantization starts from the same state, so released data is quantized and split the same way again
+        const TRestorableFastRng64& shuffledRand = rand;
+        const TRestorableFastRng64 quantizationRand(shuffledRand);
+
+        // All candidates are enumerated beforehand, data is quantized for each distinct quantization
+        //  when its candidates are trained and shared by all of them
+        TVector<TSuccessiveHalvingQuantizedData> quantizedData;
+        TVector<TSuccessiveHalvingCandidate> candidates;
+        while (auto paramsSet = gridIterator->Next()) {
+            // paramsSet: {border_count, feature_border_type, nan_mode, [others]}
+            TQuantizationParamsInfo quantizationParamsSet;
+            quantizationParamsSet.BinsCount = GetRandomValueIfNeeded((*paramsSet)[0], randDistGenerators).GetInteger();
+            quantizationParamsSet.BorderType = FromString<EBorderSelectionType>((*paramsSet)[1].GetString());
+            quantizationParamsSet.NanMode = FromString<ENanMode>((*paramsSet)[2].GetString());
+
+            AssignOptionsToJson(
+                TConstArrayRef<TString>(paramNames),
+                TConstArrayRef<NJson::TJsonValue>(
+                    paramsSet->begin() + 3,
+                    paramsSet->end()
+                ), // Ignoring quantization params
+                randDistGenerators,
+                modelParamsToBeTried
+            );
+
+            NJson::TJsonValue jsonParams;
+            NJson::TJsonValue outputJsonParams;
+            NCatboostOptions::PlainJsonToOptions(*modelParamsToBeTried, &jsonParams, &outputJsonParams);
+            TSuccessiveHalvingCandidate candidate(NCatboostOptions::LoadOptions(jsonParams));
+            candidate.OutputFileOptions.Load(outputJsonParams);
+            candidate.QuantizationParamsSet = quantizationParamsSet;
+            candidate.ModelParams = *modelParamsToBeTried;
+            CB_ENSURE(
+                candidate.CatBoostOptions.GetTaskType() == ETaskType::CPU,
+                "Error: successive halving search is supported only for CPU training"
+            );
+
+            const auto quantizedDataIt = FindIf(
+                quantizedData,
+                [&] (const auto& dataForQuantization) {
+                    return IsSameQuantization(dataForQuantization.QuantizationParamsSet, quantizationParamsSet);
+                }
+            );
+            candidate.QuantizedDataIdx = quantizedDataIt - quantizedData.begin();
+            if (quantizedDataIt == quantizedData.end()) {
+                TSuccessiveHalvingQuantizedData dataForQuantization;
+                dataForQuantization.QuantizationParamsSet = quantizationParamsSet;
+                quantizedData.push_back(std::move(dataForQuantization));
+            }
+            candidates.push_back(std::move(candidate));
+        }
+        if (candidates.empty()) {
+            return 0.0;
+        }
+
+        const auto quantizeIfNeeded = [&] (
+            const TSuccessiveHalvingCandidate& candidate,
+            NCatboostOptions::TCatBoostOptions* catBoostOptions) {
+
+            auto& dataForCandidate = quantizedData[candidate.QuantizedDataIdx];
+            if (dataForCandidate.TrainTestData) {
+                return;
+            }
+            TSetLogging inThisScope(candidate.CatBoostOptions.LoggingLevel);
+            TRestorableFastRng64 splitRand(quantizationRand);
+            dataForCandidate.LabelConverter = TLabelConverter();
+            dataForCandidate.TrainTestData.ConstructInPlace();
+            QuantizeAndSplitDataIfNeeded(
+                candidate.OutputFileOptions.AllowWriteFiles(),
+                trainTestSplitParams,
+                data->MetaInfo.FeaturesLayout,
+                /*quantizedFeaturesInfo*/ nullptr,
+                data,
+                /*oldQuantizedParamsInfo*/ TQuantizationParamsInfo(),
+                dataForCandidate.QuantizationParamsSet,
+                &dataForCandidate.LabelConverter,
+                localExecutor,
+                &splitRand,
+                catBoostOptions,
+                dataForCandidate.TrainTestData.Get()
+            );
+        };
+
+        quantizeIfNeeded(candidates[0], &candidates[0].CatBoostOptions);
+        const TVector<THolder<IMetric>> metrics = CreateMetrics(
+            candidates[0].CatBoostOptions.MetricOptions,
+            evalMetricDescriptor,
+            NCB::GetApproxDimension(
+                candidates[0].CatBoostOptions,
+                quantizedData[candidates[0].QuantizedDataIdx].LabelConverter
+            )
+        );
+        const TString& lossDescription = metrics[0]->GetDescription();
+        const int metricSign = GetSignForMetricMinimization(metrics[0]);
+
+        const TVector<size_t> roundSizes = GetSuccessiveHalvingRoundSizes(candidates.size(), reductionFactor);
+        const size_t trainingCount = Accumulate(roundSizes, size_t(0));
+
+        TSetLogging inThisScope(ELoggingLevel::Verbose);
+        TLogger logger;
+        TString searchToken = "loss";
+        AddConsoleLogger(
+            searchToken,
+            {},
+            /*hasTrain=*/true,
+            verbose,
+            trainingCount,
+            &logger
+        );
+        double bestParamsSetMetricValue = 0.0;
+        int iterationIdx = 0;
+        int bestIterationIdx = 0;
+        TProfileInfo profile(trainingCount);
+
+        const ui32 threadCount = localExecutor->GetThreadCount() + 1;
+        // custom descriptors can call interpreter code that is not thread-safe
+        const bool trainConcurrently = !objectiveDescriptor && !evalMetricDescriptor && (threadCount > 1);
+
+        TVector<size_t> aliveCandidates(candidates.size());
+        std::iota(aliveCandidates.begin(), aliveCandidates.end(), 0);
+        for (auto roundIdx : xrange(roundSizes.size())) {
+            const bool isLastRound = (roundIdx + 1 == roundSizes.size());
+            const size_t aliveCount = aliveCandidates.size();
+            if (verbose) {
+                CATBOOST_NOTICE_LOG << "Successive halving round #" << roundIdx << ": "
+                    << aliveCount << " candidates" << Endl;
+            }
+
+            const auto trainCandidate = [&] (size_t aliveIdx, ui32 candidateThreadCount, NPar::TLocalExecutor* candidateExecutor) {
+                auto& candidate = candidates[aliveCandidates[aliveIdx]];
+                const auto& dataForCandidate = quantizedData[candidate.QuantizedDataIdx];
+
+                const ui32 roundIterationCount = NCB::GetSuccessiveHalvingIterationCounts(
+                    candidate.CatBoostOptions.BoostingOptions->IterationCount.Get(),
+                    roundSizes.size(),
+                    reductionFactor
+                )[roundIdx];
+                if (roundIterationCount <= candidate.TrainedIterationCount) {
+                    return;
+                }
+
+                // training continues from the candidate's learn progress, so only the rest of the budget is set
+                NCatboostOptions::TCatBoostOptions roundCatBoostOptions = candidate.CatBoostOptions;
+                roundCatBoostOptions.BoostingOptions->IterationCount.Set(
+                    roundIterationCount - candidate.TrainedIterationCount
+                );
+                if (candidateExecutor != localExecutor) {
+                    roundCatBoostOptions.SystemOptions->NumThreads.Set(candidateThreadCount);
+                    // concurrent trainings' logging scopes are not nested, all of them run silently
+                    roundCatBoostOptions.LoggingLevel.Set(ELoggingLevel::Silent);
+                }
+
+                TEvalResult evalRes;
+                TMetricsAndTimeLeftHistory metricsAndTimeHistory;
+
+                TTrainModelInternalOptions internalOptions;
+                internalOptions.CalcMetricsOnly = true;
+                internalOptions.ForceCalcEvalMetricOnEveryIteration = false;
+                internalOptions.OffsetMetricPeriodByInitModelSize = true;
+
+                THolder<TLearnProgress> initLearnProgress = std::move(candidate.LearnProgress);
+                TTrainerFactory::Construct(ETaskType::CPU)->TrainModel(
+                    internalOptions,
+                    roundCatBoostOptions,
+                    candidate.OutputFileOptions,
+                    objectiveDescriptor,
+                    evalMetricDescriptor,
+                    /*onEndIterationCallback*/ Nothing(),
+                    *dataForCandidate.TrainTestData,
+                    dataForCandidate.LabelConverter,
+                    /*initModel*/ Nothing(),
+                    std::move(initLearnProgress),
+                    /*initModelApplyCompatiblePools*/ NCB::TDataProviders(),
+                    candidateExecutor,
+                    /*rand*/ Nothing(), // shared rand would make results depend on trials' order
+                    /*dstModel*/ nullptr,
+                    /*evalResultPtrs*/ {&evalRes},
+                    &metricsAndTimeHistory,
+                    /*dstLearnProgress*/ isLastRound ? nullptr : &candidate.LearnProgress
+                );
+                candidate.TrainedIterationCount = roundIterationCount;
+
+                const TVector<THolder<IMetric>> candidateMetrics = CreateMetrics(
+                    candidate.CatBoostOptions.MetricOptions,
+                    evalMetricDescriptor,
+                    NCB::GetApproxDimension(candidate.CatBoostOptions, dataForCandidate.LabelConverter)
+                );
+                // metrics history is reset for continuation, so keep the best value over all rounds
+                const double metricValue
+                    = metricsAndTimeHistory.TestBestError[0][candidateMetrics[0]->GetDescription()];
+                if (!candidate.MetricValue || metricSign * metricValue < metricSign * *candidate.MetricValue) {
+                    candidate.MetricValue = metricValue;
+                }
+            };
+
+            /* learn progress is kept only by the candidates that would survive the round if it ended now
+             *  (ordered as the survivors are chosen below), so at most the next round size progresses
+             *  plus the ones of candidates being trained are in memory.
+             * Progress is also dropped when used_ram_limit is exceeded, such candidates are trained from scratch
+             *  in the next round.
+             */
+            const size_t nextRoundSize = isLastRound ? 0 : roundSizes[roundIdx + 1];
+            TVector<size_t> progressKeepers; // alive indices
+            TMutex progressKeepersLock;
+            const auto keepProgressIfNeeded = [&] (size_t aliveIdx) {
+                auto& candidate = candidates[aliveCandidates[aliveIdx]];
+                if (!candidate.LearnProgress) {
+                    return;
+                }
+                const auto dropProgress = [&] (size_t aliveIdxToDrop) {
+                    auto& candidateToDrop = candidates[aliveCandidates[aliveIdxToDrop]];
+                    candidateToDrop.LearnProgress.Destroy();
+                    candidateToDrop.TrainedIterationCount = 0;
+                };
+                const auto isBetter = [&] (size_t lhs, size_t rhs) {
+                    const double lhsValue = metricSign * *candidates[aliveCandidates[lhs]].MetricValue;
+                    const double rhsValue = metricSign * *candidates[aliveCandidates[rhs]].MetricValue;
+                    return lhsValue != rhsValue ? lhsValue < rhsValue : lhs < rhs;
+                };
+                with_lock(progressKeepersLock) {
+                    if (IsCpuRamUsageOverLimit(candidate.CatBoostOptions)) {
+                        dropProgress(aliveIdx);
+                        return;
+                    }
+                    progressKeepers.push_back(aliveIdx);
+                    if (progressKeepers.size() > nextRoundSize) {
+                        const auto worst = MaxElement(progressKeepers.begin(), progressKeepers.end(), isBetter);
+                        dropProgress(*worst);
+                        progressKeepers.erase(worst);
+                    }
+                }
+            };
+
+            // candidates are trained in groups sharing quantized data, so that one dataset is needed at a time
+            TVector<TVector<size_t>> quantizationGroups; // alive indices
+            TVector<size_t> groupIdxByQuantization(quantizedData.size(), quantizedData.size());
+            for (auto aliveIdx : xrange(aliveCount)) {
+                const size_t quantizedDataIdx = candidates[aliveCandidates[aliveIdx]].QuantizedDataIdx;
+                if (groupIdxByQuantization[quantizedDataIdx] == quantizedData.size()) {
+                    groupIdxByQuantization[quantizedDataIdx] = quantizationGroups.size();
+                    quantizationGroups.emplace_back();
+                }
+                quantizationGroups[groupIdxByQuantization[quantizedDataIdx]].push_back(aliveIdx);
+            }
+
+            for (const auto& group : quantizationGroups) {
+                const auto& firstCandidate = candidates[aliveCandidates[group[0]]];
+                NCatboostOptions::TCatBoostOptions quantizationOptions = firstCandidate.CatBoostOptions;
+                quantizeIfNeeded(firstCandidate, &quantizationOptions);
+
+                const size_t concurrentCount = trainConcurrently ? Min<size_t>(group.size(), threadCount) : 1;
+                if (concurrentCount > 1) {
+                    const ui32 candidateThreadCount = Max<ui32>(1, threadCount / concurrentCount);
+                    TVector<THolder<NPar::TLocalExecutor>> candidateExecutors;
+                    for (auto groupIdx : xrange(group.size())) {
+                        Y_UNUSED(groupIdx);
+                        candidateExecutors.push_back(MakeHolder<NPar::TLocalExecutor>());
+                        candidateExecutors.back()->RunAdditionalThreads(candidateThreadCount - 1);
+                    }
+                    profile.StartIterationBlock();
+                    {
+                        TSetLoggingSilent silentMode;
+                        localExecutor->ExecRangeWithThrow(
+                            [&] (int groupIdx) {
+                                trainCandidate(group[groupIdx], candidateThreadCount, candidateExecutors[groupIdx].Get());
+                                keepProgressIfNeeded(group[groupIdx]);
+                            },
+                            0,
+                            SafeIntegerCast<int>(group.size()),
+                            NPar::TLocalExecutor::WAIT_COMPLETE
+                        );
+                    }
+                    profile.FinishIterationBlock(group.size());
+                } else {
+                    for (auto aliveIdx : group) {
+                        profile.StartIterationBlock();
+                        {
+                            TSetLogging inThisScope(candidates[aliveCandidates[aliveIdx]].CatBoostOptions.LoggingLevel);
+                            trainCandidate(aliveIdx, threadCount, localExecutor);
+                        }
+                        keepProgressIfNeeded(aliveIdx);
+                        profile.FinishIterationBlock(1);
+                    }
+                }
+
+                // above used_ram_limit data is quantized again when needed
+                if (isLastRound || IsCpuRamUsageOverLimit(firstCandidate.CatBoostOptions)) {
+                    quantizedData[firstCandidate.QuantizedDataIdx].TrainTestData.Clear();
+                }
+            }
+
+            for (auto candidateIdx : aliveCandidates) {
+                const auto& candidate = candidates[candidateIdx];
+                const double metricValue = *candidate.MetricValue;
+                if (iterationIdx == 0 || (isLastRound && candidateIdx == aliveCandidates[0])) {
+                    // We guarantee to update the parameters on the first iteration
+                    bestParamsSetMetricValue = metricValue + metricSign;
+                }
+                // only candidates trained to full iterations can be chosen as the best ones
+                if (!isLastRound) {
+                    if (metricSign * metricValue < metricSign * bestParamsSetMetricValue) {
+                        bestParamsSetMetricValue = metricValue;
+                        bestIterationIdx = iterationIdx;
+                    }
+                } else {
+                    bool isUpdateBest = SetBestParamsAndUpdateMetricValueIfNeeded(
+                        metricValue,
+                        metrics,
+                        candidate.QuantizationParamsSet,
+                        candidate.ModelParams,
+                        paramNames,
+                        /*quantizedFeaturesInfo*/ nullptr,
+                        bestGridParams,
+                        &bestParamsSetMetricValue);
+                    if (isUpdateBest) {
+                        bestIterationIdx = iterationIdx;
+                    }
+                }
+                TOneInterationLogger oneIterLogger(logger);
+                oneIterLogger.OutputMetric(
+                    searchToken,
+                    TMetricEvalResult(
+                        lossDescription,
+                        metricValue,
+                        bestParamsSetMetricValue,
+                        bestIterationIdx,
+                        true
+                    )
+                );
+                oneIterLogger.OutputProfile(profile.GetProfileResults());
+                iterationIdx++;
+            }
+
+            if (!isLastRound) {
+                StableSort(
+                    aliveCandidates,
+                    [&] (size_t lhs, size_t rhs) {
+                        return metricSign * *candidates[lhs].MetricValue < metricSign * *candidates[rhs].MetricValue;
+                    }
+                );
+                for (auto i : xrange(roundSizes[roundIdx + 1], aliveCount)) {
+                    candidates[aliveCandidates[i]].LearnProgress.Destroy();
+                }
+                aliveCandidates.resize(roundSizes[roundIdx + 1]);
+
+                TVector<bool> isQuantizationAlive(quantizedData.size(), false);
+                for (auto candidateIdx : aliveCandidates) {
+                    isQuantizationAlive[candidates[candidateIdx].QuantizedDataIdx] = true;
+                }
+                for (auto quantizedDataIdx : xrange(quantizedData.size())) {
+                    if (!isQuantizationAlive[quantizedDataIdx]) {
+                        quantizedData[quantizedDataIdx].TrainTestData.Clear();
+                    }
+                }
+            }
+        }
+        return bestParamsSetMetricValue;
+    }
 } // anonymous namespace
 
 namespace NCB {
+    TVector<ui32> GetSuccessiveHalvingIterationCounts(ui32 iterationCount, size_t roundCount, ui32 reductionFactor) {
+        CB_ENSURE(roundCount > 0, "Error: successive halving needs at least one round");
+        TVector<ui32> iterationCounts(roundCount, iterationCount);
+        for (size_t roundIdx = roundCount - 1; roundIdx > 0; --roundIdx) {
+            iterationCounts[roundIdx - 1] = CeilDiv(iterationCounts[roundIdx], reductionFactor);
+        }
+        return iterationCounts;
+    }
+
     void TBestOptionValuesWithCvResult::SetOptionsFromJson(
         const THashMap<TString, NJson::TJsonValue>& options,
         const TVector<TString>& optionsNames) {
@@ -907,7 +1345,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit,
         bool returnCvStat,
-        int verbose) {
+        int verbose,
+        const TMaybe<TSuccessiveHalvingParams>& successiveHalvingParams) {
 
         // CatBoost options
         NJson::TJsonValue jsonParams;
@@ -917,6 +1356,10 @@ namespace NCB {
         NCatboostOptions::TOutputFilesOptions outputFileOptions;
         outputFileOptions.Load(outputJsonParams);
         CB_ENSURE(!outputJsonParams["save_snapshot"].GetBoolean(), "Snapshots are not yet supported for GridSearchCV");
+        CB_ENSURE(
+            !successiveHalvingParams || isSearchUsingTrainTestSplit,
+            "Successive halving is supported only for search using train-test split"
+        );
 
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
@@ -956,7 +1399,21 @@ namespace NCB {
                 TSetLogging inThisScope(ELoggingLevel::Verbose);
                 CATBOOST_NOTICE_LOG << "Grid #" << gridEnumerator << Endl;
             }
-            if (isSearchUsingTrainTestSplit) {
+            if (successiveHalvingParams) {
+                metricValue = TuneHyperparamsTrainTestBySuccessiveHalving(
+                    paramNames,
+                    objectiveDescriptor,
+                    evalMetricDescriptor,
+                    trainTestSplitParams,
+                    *successiveHalvingParams,
+                    data,
+                    &gridIterator,
+                    &modelParamsToBeTried,
+                    &gridParams,
+                    &localExecutor,
+                    verbose
+                );
+            } else if (isSearchUsingTrainTestSplit) {
                 metricValue = TuneHyperparamsTrainTest(
                     paramNames,
                     objectiveDescriptor,
@@ -1025,7 +1482,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit,
         bool returnCvStat,
-        int verbose) {
+        int verbose,
+        const TMaybe<TSuccessiveHalvingParams>& successiveHalvingParams) {
 
         // CatBoost options
         NJson::TJsonValue jsonParams;
@@ -1035,6 +1493,10 @@ namespace NCB {
         NCatboostOptions::TOutputFilesOptions outputFileOptions;
         outputFileOptions.Load(outputJsonParams);
         CB_ENSURE(!outputJsonParams["save_snapshot"].GetBoolean(), "Snapshots are not yet supported for RandomizedSearchCV");
+        CB_ENSURE(
+            !successiveHalvingParams || isSearchUsingTrainTestSplit,
+            "Successive halving is supported only for search using train-test split"
+        );
 
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
@@ -1070,7 +1532,22 @@ namespace NCB {
 
         TGridParamsInfo bestGridParams;
         TVector<TCVResult> cvResult;
-        if (isSearchUsingTrainTestSplit) {
+        if (successiveHalvingParams) {
+            TuneHyperparamsTrainTestBySuccessiveHalving(
+                paramNames,
+                objectiveDescriptor,
+                evalMetricDescriptor,
+                trainTestSplitParams,
+                *successiveHalvingParams,
+                data,
+                &gridIterator,
+                &modelParamsToBeTried,
+                &bestGridParams,
+                &localExecutor,
+                verbose,
+                randDistGenerators
+            );
+        } else if (isSearchUsingTrainTestSplit) {
             TuneHyperparamsTrainTest(
                 paramNames,
                 objectiveDescriptor,
@@ -29,6 +29,17 @@ namespace NCB {
         TEvalFuncPtr EvalFunc = nullptr;
     };
 
+    /* Successive halving: all candidates are trained for a small number of iterations, the best
+     * 1 / ReductionFactor of them continue training from their current state with ReductionFactor times
+     * larger budget and so on until no more than ReductionFactor candidates are trained to full iterations.
+     */
+    struct TSuccessiveHalvingParams {
+        ui32 ReductionFactor = 3;
+    };
+
+    // iterations each candidate is trained for by the end of each round, the last one is iterationCount
+    TVector<ui32> GetSuccessiveHalvingIterationCounts(ui32 iterationCount, size_t roundCount, ui32 reductionFactor);
+
     struct TBestOptionValuesWithCvResult {
     public:
         TVector<TCVResult> CvResult;
@@ -54,7 +65,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
-        int verbose = true);
+        int verbose = true,
+        const TMaybe<TSuccessiveHalvingParams>& successiveHalvingParams = Nothing()); // only for train-test split
 
     void RandomizedSearch(
         ui32 numberOfTries,
@@ -69,5 +81,6 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
-        int verbose = true);
+        int verbose = true,
+        const TMaybe<TSuccessiveHalvingParams>& successiveHalvingParams = Nothing()); // only for train-test split
 }
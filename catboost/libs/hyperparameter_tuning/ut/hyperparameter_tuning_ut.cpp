@@ -0,0 +1,124 @@
+#include <catboost/libs/data_new/data_provider_builders.h>
+#include <catboost/libs/hyperparameter_tuning/hyperparameter_tuning.h>
+
+#include <library/json/json_value.h>
+#include <library/unittest/registar.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+
+static TDataProviderPtr RandomFloatPool(ui32 objectCount, ui32 featureCount) {
+    TFastRng64 prng(17);
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                TVector<ui32>{},
+                TVector<TString>{}
+            );
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> target(objectCount, 0.0f);
+            for (auto featureIdx : xrange(featureCount)) {
+                TVector<float> feature(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    feature[objectIdx] = prng.GenRandReal1();
+                    target[objectIdx] += feature[objectIdx] * (featureIdx + 1);
+                }
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    TMaybeOwningConstArrayHolder<float>::CreateOwning(std::move(feature))
+                );
+            }
+            visitor->AddTarget(target);
+
+            visitor->Finish();
+        }
+    );
+}
+
+static double RunGridSearch(
+    const TMaybe<TSuccessiveHalvingParams>& successiveHalvingParams,
+    const TString& trainDir) {
+
+    NJson::TJsonValue grid;
+    for (double learningRate : {1e-5, 1e-4, 0.03, 0.3}) {
+        grid["learning_rate"].AppendValue(learningRate);
+    }
+    for (int borderCount : {16, 64}) {
+        grid["border_count"].AppendValue(borderCount);
+    }
+
+    NJson::TJsonValue params;
+    params.InsertValue("iterations", 30);
+    params.InsertValue("depth", 4);
+    params.InsertValue("random_seed", 1);
+    params.InsertValue("thread_count", 4);
+    params.InsertValue("logging_level", "Silent");
+    params.InsertValue("train_dir", trainDir);
+
+    TTrainTestSplitParams trainTestSplitParams;
+    trainTestSplitParams.PartitionRandSeed = 3;
+
+    TBestOptionValuesWithCvResult bestOptionValues;
+    GridSearch(
+        grid,
+        params,
+        trainTestSplitParams,
+        TCrossValidationParams(),
+        /*objectiveDescriptor*/ Nothing(),
+        /*evalMetricDescriptor*/ Nothing(),
+        RandomFloatPool(/*objectCount*/ 500, /*featureCount*/ 5),
+        &bestOptionValues,
+        /*isSearchUsingTrainTestSplit*/ true,
+        /*returnCvStat*/ false,
+        /*verbose*/ false,
+        successiveHalvingParams
+    );
+    return bestOptionValues.DoubleOptions.at("learning_rate");
+}
+
+Y_UNIT_TEST_SUITE(SuccessiveHalving) {
+    Y_UNIT_TEST(LastRoundTrainsFullIterations) {
+        const TVector<ui32> iterationCounts = GetSuccessiveHalvingIterationCounts(100, 3, 3);
+        UNIT_ASSERT_VALUES_EQUAL(iterationCounts, (TVector<ui32>{12, 34, 100}));
+
+        for (ui32 iterationCount : {1, 7, 1000}) {
+            for (size_t roundCount : {1, 2, 5}) {
+                for (ui32 reductionFactor : {2, 3, 10}) {
+                    const auto counts = GetSuccessiveHalvingIterationCounts(iterationCount, roundCount, reductionFactor);
+                    UNIT_ASSERT_VALUES_EQUAL(counts.size(), roundCount);
+                    UNIT_ASSERT_VALUES_EQUAL(counts.back(), iterationCount);
+                    for (auto roundIdx : xrange<size_t>(1, roundCount)) {
+                        UNIT_ASSERT(counts[roundIdx - 1] > 0);
+                        UNIT_ASSERT(counts[roundIdx - 1] <= counts[roundIdx]);
+                    }
+                }
+            }
+        }
+    }
+
+    // the winner is chosen among candidates trained to full iterations, so it is the exhaustive search's one
+    //  when the best candidate also leads after short trainings
+    Y_UNIT_TEST(WinnerMatchesExhaustiveSearch) {
+        TTempDir trainDir;
+        const double exhaustiveLearningRate = RunGridSearch(Nothing(), trainDir.Name());
+        for (ui32 reductionFactor : {2, 3}) {
+            TSuccessiveHalvingParams successiveHalvingParams;
+            successiveHalvingParams.ReductionFactor = reductionFactor;
+            UNIT_ASSERT_DOUBLES_EQUAL(
+                RunGridSearch(successiveHalvingParams, trainDir.Name()),
+                exhaustiveLearningRate,
+                1e-9
+            );
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include "catboost_logger_helpers.h"
 
+#include <util/generic/mapfindptr.h>
+
 void TMetricsAndTimeLeftHistory::TryUpdateBestError(const IMetric& metric, double error, THashMap<TString, double>& bestError, bool updateBestIteration) {
     TString metricDescription = metric.GetDescription();
     bool shouldUpdate = false;
@@ -23,12 +25,21 @@ void TMetricsAndTimeLeftHistory::TryUpdateBestError(const IMetric& metric, doubl
     }
 }
 
-void TMetricsAndTimeLeftHistory::AddLearnError(const IMetric& metric, double error) {
+void TMetricsAndTimeLeftHistory::AddLearnError(const IMetric& metric, double error, TMaybe<double> errorBound) {
     LearnMetricsHistory.back()[metric.GetDescription()] = error;
     TryUpdateBestError(metric, error, LearnBestError, false);
+    if (errorBound) {
+        LearnErrorBounds[metric.GetDescription()] = *errorBound;
+    }
 }
 
-void TMetricsAndTimeLeftHistory::AddTestError(size_t testIdx, const IMetric& metric, double error, bool updateBestIteration) {
+void TMetricsAndTimeLeftHistory::AddTestError(
+    size_t testIdx,
+    const IMetric& metric,
+    double error,
+    bool updateBestIteration,
+    TMaybe<double> errorBound
+) {
     if (testIdx >= TestMetricsHistory.back().size()) {
         TestMetricsHistory.back().resize(testIdx + 1);
     }
@@ -37,6 +48,12 @@ void TMetricsAndTimeLeftHistory::AddTestError(size_t testIdx, const IMetric& met
         TestBestError.resize(testIdx + 1);
     }
     TryUpdateBestError(metric, error, TestBestError[testIdx], updateBestIteration);
+    if (errorBound) {
+        if (testIdx >= TestErrorBounds.size()) {
+            TestErrorBounds.resize(testIdx + 1);
+        }
+        TestErrorBounds[testIdx][metric.GetDescription()] = *errorBound;
+    }
 }
 
 TString TOutputFiles::AlignFilePath(const TString& baseDir, const TString& fileName, const TString& namePrefix) {
@@ -152,11 +169,25 @@ void AddConsoleLogger(
     logger->AddProfileBackend(consoleLoggingBackend);
 }
 
+static TMaybe<double> GetErrorBound(
+    const THashMap<TString, double>& errorBounds,
+    const TString& metricDescription,
+    bool isLastIteration
+) {
+    if (!isLastIteration) {
+        return Nothing();
+    }
+    const double* errorBound = MapFindPtr(errorBounds, metricDescription);
+    return errorBound ? TMaybe<double>(*errorBound) : Nothing();
+}
+
 void Log(
         int iteration,
         const TVector<TString>& metricsDescription,
         const TVector<THashMap<TString, double>>& learnErrorsHistory, // [iter][metric]
         const TVector<TVector<THashMap<TString, double>>>& testErrorsHistory, // [iter][test][metric]
+        const THashMap<TString, double>& learnErrorBounds, // [metric]
+        const TVector<THashMap<TString, double>>& testErrorBounds, // [test][metric]
         TMaybe<double> bestErrorValue,
         TMaybe<int> bestIteration,
         const TProfileResults& profileResults,
@@ -170,18 +201,31 @@ void Log(
     if (outputErrors) {
         if (iteration < learnErrorsHistory.ysize()) {
             const THashMap<TString, double>& learnErrors = learnErrorsHistory[iteration];
+            // error bounds are kept for the last calculation only, e.g. they are absent for iterations restored from a snapshot
+            const bool isLastLearnIteration = iteration == learnErrorsHistory.ysize() - 1;
             for (int metricIdx = 0; metricIdx < metricsDescription.ysize(); ++metricIdx) {
                 const TString& metricDescription = metricsDescription[metricIdx];
                 if (learnErrors.contains(metricDescription)) {
-                    oneIterLogger.OutputMetric(learnToken, TMetricEvalResult(metricDescription, learnErrors.at(metricDescription), metricIdx == 0));
+                    oneIterLogger.OutputMetric(
+                        learnToken,
+                        TMetricEvalResult(
+                            metricDescription,
+                            learnErrors.at(metricDescription),
+                            metricIdx == 0,
+                            GetErrorBound(learnErrorBounds, metricDescription, isLastLearnIteration)
+                        )
+                    );
                 }
             }
         }
         if (iteration < testErrorsHistory.ysize()) {
             const int testCount = testErrorsHistory[iteration].ysize();
+            const bool isLastTestIteration = iteration == testErrorsHistory.ysize() - 1;
             for (int testIdx = 0; testIdx < testCount; ++testIdx) {
                 const TString& token = testTokens[testIdx];
                 const THashMap<TString, double>& testErrors = testErrorsHistory[iteration][testIdx];
+                const THashMap<TString, double>* testBounds
+                    = testIdx < testErrorBounds.ysize() ? &testErrorBounds[testIdx] : nullptr;
                 CB_ENSURE(
                     testErrors.size() == metricsDescription.size(),
                     "Wrong number of calculated metrics (" << testErrors.size() << "), expected "
@@ -194,12 +238,15 @@ void Log(
                     if (testErrors.contains(metricDescription)) {
                         double testError = testErrors.at(metricDescription);
                         bool isMainMetric = metricIdx == 0;
+                        const TMaybe<double> errorBound = testBounds
+                            ? GetErrorBound(*testBounds, metricDescription, isLastTestIteration)
+                            : Nothing();
 
                         if ((testIdx == testCount - 1) && bestErrorValue) {
                             // Only last test should be followed by 'best:'
-                            oneIterLogger.OutputMetric(token, TMetricEvalResult(metricDescription, testError, *bestErrorValue, *bestIteration, isMainMetric));
+                            oneIterLogger.OutputMetric(token, TMetricEvalResult(metricDescription, testError, *bestErrorValue, *bestIteration, isMainMetric, errorBound));
                         } else {
-                            oneIterLogger.OutputMetric(token, TMetricEvalResult(metricDescription + ":" + ToString(testIdx), testError, isMainMetric));
+                            oneIterLogger.OutputMetric(token, TMetricEvalResult(metricDescription + ":" + ToString(testIdx), testError, isMainMetric, errorBound));
                         }
                     }
                 }
@@ -34,10 +34,21 @@ struct TMetricsAndTimeLeftHistory {
     THashMap<TString, double> LearnBestError;
     TVector<THashMap<TString, double>> TestBestError;
 
+    // For approximate metrics (see GetMetricErrorBound): max difference from the exact value at the last calculation.
+    // Not saved in snapshots, filled again by the next metrics calculation.
+    THashMap<TString, double> LearnErrorBounds;
+    TVector<THashMap<TString, double>> TestErrorBounds;
+
     Y_SAVELOAD_DEFINE(LearnMetricsHistory, TestMetricsHistory, TimeHistory, BestIteration, LearnBestError, TestBestError);
 
-    void AddLearnError(const IMetric& metric, double error);
-    void AddTestError(size_t testIdx, const IMetric& metric, double error, bool updateBestIteration);
+    void AddLearnError(const IMetric& metric, double error, TMaybe<double> errorBound = Nothing());
+    void AddTestError(
+        size_t testIdx,
+        const IMetric& metric,
+        double error,
+        bool updateBestIteration,
+        TMaybe<double> errorBound = Nothing()
+    );
 
 private:
     void TryUpdateBestError(const IMetric& metric, double error, THashMap<TString, double>& bestError, bool updateBestIteration);
@@ -96,6 +107,8 @@ void Log(
     const TVector<TString>& metricsDescription,
     const TVector<THashMap<TString, double>>& learnErrorsHistory,
     const TVector<TVector<THashMap<TString, double>>>& testErrorsHistory, // [iter][test][metric]
+    const THashMap<TString, double>& learnErrorBounds, // [metric], for the last iteration of learnErrorsHistory
+    const TVector<THashMap<TString, double>>& testErrorBounds, // [test][metric], for the last iteration of testErrorsHistory
     TMaybe<double> bestErrorValue,
     TMaybe<int> bestIteration,
     const TProfileResults& profileResults,
@@ -8,6 +8,7 @@
 #include <library/json/writer/json_value.h>
 #include <util/stream/format.h>
 #include <util/generic/hash.h>
+#include <util/generic/maybe.h>
 #include <util/generic/ymath.h>
 
 
@@ -17,18 +18,26 @@ public:
     virtual TString GetMetricName() const = 0;
     virtual TString BuildHumanReadableMetricString() const = 0;
     virtual bool IsMainMetric() const = 0;
+    // max difference from the exact value for approximate metrics (see GetMetricErrorBound)
+    virtual TMaybe<double> GetMetricErrorBound() const = 0;
     virtual ~IMetricEvalResult() = default;
 };
 
 class TMetricEvalResult : public IMetricEvalResult {
 public:
-    TMetricEvalResult(const TString& name, const double value, const bool isMainMetric)
+    TMetricEvalResult(
+        const TString& name,
+        const double value,
+        const bool isMainMetric,
+        TMaybe<double> errorBound = Nothing()
+    )
         : Name(name)
         , Value(value)
         , BestValue(0)
         , BestIteration(0)
         , IsMain(isMainMetric)
         , HaveBestResults(false)
+        , ErrorBound(errorBound)
     {
     }
 
@@ -37,7 +46,8 @@ public:
         const double value,
         const double bestValue,
         const int bestIteration,
-        const bool isMainMetric
+        const bool isMainMetric,
+        TMaybe<double> errorBound = Nothing()
     )
         : Name(name)
         , Value(value)
@@ -45,6 +55,7 @@ public:
         , BestIteration(bestIteration)
         , IsMain(isMainMetric)
         , HaveBestResults(true)
+        , ErrorBound(errorBound)
     {
     }
 
@@ -60,9 +71,16 @@ public:
         return IsMain;
     }
 
+    TMaybe<double> GetMetricErrorBound() const override {
+        return ErrorBound;
+    }
+
     TString BuildHumanReadableMetricString() const override {
         TStringStream result;
         result << Prec(Value, PREC_POINT_DIGITS,7);
+        if (ErrorBound) {
+            result << " (+-" << Prec(*ErrorBound, PREC_POINT_DIGITS, 7) << ")";
+        }
         if (HaveBestResults) {
             result << "\tbest: " << Prec(BestValue, PREC_POINT_DIGITS, 7) << " (" << BestIteration << ")";
         }
@@ -76,6 +94,7 @@ private:
     int BestIteration;
     bool IsMain;
     bool HaveBestResults;
+    TMaybe<double> ErrorBound;
 };
 
 class ILoggingBackend : public TThrRefBase {
@@ -107,6 +126,9 @@ public:
         } else {
             IterationJson[sourceName].AppendValue(ToString<double>(metricValue));
         }
+        if (const TMaybe<double> errorBound = evalResult.GetMetricErrorBound()) {
+            IterationJson[sourceName + "_error_bounds"].InsertValue(evalResult.GetMetricName(), *errorBound);
+        }
     }
 
     void OutputProfile(const TProfileResults& profileResults) {
@@ -297,6 +319,12 @@ public:
         if (IsFirstIteration) {
             TitleStream << "\t" << evalResult.GetMetricName();
         }
+        if (const TMaybe<double> errorBound = evalResult.GetMetricErrorBound()) {
+            Stream << "\t" << *errorBound;
+            if (IsFirstIteration) {
+                TitleStream << "\t" << evalResult.GetMetricName() << ":error_bound";
+            }
+        }
     }
 
     void Flush(const int currentIteration) {
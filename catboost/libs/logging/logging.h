@@ -90,7 +90,10 @@ public:
     {
         ELogPriority newLogPriority = GetLogPriorityForLoggingLevel(level);
         RestoreLogPriority = SavedLogPriority != newLogPriority;
-        TCatBoostLogSettings::GetRef().Log.SetLogPriority(newLogPriority);
+        // scopes that don't change the level don't write it, so they can be entered concurrently
+        if (RestoreLogPriority) {
+            TCatBoostLogSettings::GetRef().Log.SetLogPriority(newLogPriority);
+        }
     }
 
     ~TSetLogging() {
@@ -4,7 +4,11 @@
 
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
+#include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/generic/ymath.h>
+
+#include <cmath>
 
 using NMetrics::TSample;
 using NCB::TMergeData;
@@ -228,3 +232,43 @@ double CalcAUC(TVector<TSample>* samples, double* outWeightSum, double* outPairW
     localExecutor.RunAdditionalThreads(threadCount - 1);
     return CalcAUC(samples, &localExecutor, outWeightSum, outPairWeightSum);
 }
+
+ui32 GetApproximateAucBin(double prediction, ui32 binCount) {
+    if (IsNan(prediction)) {
+        return 0;
+    }
+    // equal-width bins over the raw predictions window, predictions outside of it go to the edge bins
+    const double clipped = ClampVal(prediction, -APPROXIMATE_AUC_MAX_PREDICTION, APPROXIMATE_AUC_MAX_PREDICTION);
+    const double mapped = (clipped + APPROXIMATE_AUC_MAX_PREDICTION) / (2 * APPROXIMATE_AUC_MAX_PREDICTION);
+    return Min<ui32>(binCount - 1, static_cast<ui32>(mapped * binCount));
+}
+
+double CalcApproximateAUC(TConstArrayRef<double> histogram, double* outErrorBound) {
+    Y_ASSERT(histogram.size() % 2 == 0);
+    const size_t binCount = histogram.size() / 2;
+    const double* negativeWeights = histogram.data();
+    const double* positiveWeights = histogram.data() + binCount;
+
+    double negativeWeightSum = 0;
+    double positiveWeightSum = 0;
+    double correctPairWeightSum = 0;
+    double tiedPairWeightSum = 0;
+    for (size_t bin = 0; bin < binCount; ++bin) {
+        correctPairWeightSum += positiveWeights[bin] * negativeWeightSum;
+        tiedPairWeightSum += positiveWeights[bin] * negativeWeights[bin];
+        negativeWeightSum += negativeWeights[bin];
+        positiveWeightSum += positiveWeights[bin];
+    }
+
+    const double pairWeightSum = negativeWeightSum * positiveWeightSum;
+    if (pairWeightSum == 0) {
+        if (outErrorBound != nullptr) {
+            *outErrorBound = 0;
+        }
+        return 0;
+    }
+    if (outErrorBound != nullptr) {
+        *outErrorBound = tiedPairWeightSum / 2 / pairWeightSum;
+    }
+    return (correctPairWeightSum + tiedPairWeightSum / 2) / pairWeightSum;
+}
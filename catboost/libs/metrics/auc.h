@@ -4,5 +4,19 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
+
 double CalcAUC(TVector<NMetrics::TSample>* samples, NPar::TLocalExecutor* localExecutor, double* outWeightSum = nullptr, double* outPairWeightSum = nullptr);
 double CalcAUC(TVector<NMetrics::TSample>* samples, double* outWeightSum = nullptr, double* outPairWeightSum = nullptr, int threadCount = 1);
+
+/* Approximate AUC for binary targets by histograms of weights over predictions.
+ * Bins are equal-width over raw predictions in [-APPROXIMATE_AUC_MAX_PREDICTION, APPROXIMATE_AUC_MAX_PREDICTION],
+ * the edge bins also take predictions outside of it. Bins don't depend on data, so histograms calculated
+ * for different parts of data are summed (e.g. in TMetricHolder).
+ */
+constexpr double APPROXIMATE_AUC_MAX_PREDICTION = 8.0;
+ui32 GetApproximateAucBin(double prediction, ui32 binCount);
+
+// histogram is [2 * binCount]: negative objects' weights by bins followed by positive objects' weights by bins
+// pairs of objects from the same bin are counted as ties, so the result differs from exact AUC by at most outErrorBound
+double CalcApproximateAUC(TConstArrayRef<double> histogram, double* outErrorBound = nullptr);
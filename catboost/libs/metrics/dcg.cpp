@@ -41,13 +41,16 @@ static TStackVec<double> GetTopSortedTargets(
     return targets;
 }
 
-static double CalcDcgSorted(
+double CalcDcgSorted(
         const TConstArrayRef<double> sortedTargets,
         const ENdcgMetricType type,
         const TMaybe<double> expDecay,
         const ENdcgDenominatorType denominator)
 {
     const auto size = sortedTargets.size();
+    if (size == 0) {
+        return 0;
+    }
 
     TStackVec<double> decay;
     decay.yresize(size);
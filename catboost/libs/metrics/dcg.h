@@ -30,3 +30,10 @@ double CalcIDcg(
     TMaybe<double> expDecay = Nothing(),
     ui32 topSize = Max<ui32>(),
     ENdcgDenominatorType denominator = ENdcgDenominatorType::LogPosition);
+
+// DCG of the documents at the first positions of a ranking, sortedTargets are their targets in the ranked order
+double CalcDcgSorted(
+    TConstArrayRef<double> sortedTargets,
+    ENdcgMetricType type = ENdcgMetricType::Base,
+    TMaybe<double> expDecay = Nothing(),
+    ENdcgDenominatorType denominator = ENdcgDenominatorType::LogPosition);
@@ -10,6 +10,7 @@
 #include "llp.h"
 #include "pfound.h"
 #include "precision_recall_at_k.h"
+#include "query_ranking.h"
 
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/vector_helpers.h>
@@ -19,9 +20,11 @@
 #include <library/fast_exp/fast_exp.h>
 #include <library/fast_log/fast_log.h>
 
+#include <util/generic/cast.h>
 #include <util/generic/hash.h>
 #include <util/generic/maybe.h>
 #include <util/generic/string.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 #include <util/string/builder.h>
 #include <util/string/cast.h>
@@ -1645,10 +1648,61 @@ void TQueryRMSEMetric::GetBestValue(EMetricBestValue* valueType, float*) const {
     *valueType = EMetricBestValue::Min;
 }
 
+/* Ranking metrics */
+
+namespace {
+    // Querywise metrics depending only on the ranking of query documents by approx (see TQueryRanking).
+    // Several such metrics with the same target are evaluated over one ranking of each query.
+    struct IRankingMetric {
+        virtual ~IRankingMetric() = default;
+
+        // number of first positions of the ranking of a query with querySize documents needed by the metric
+        virtual ui32 GetRankedTopSize(ui32 querySize) const = 0;
+        virtual void AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const = 0;
+    };
+}
+
+static TVector<TMetricHolder> EvalRankingMetricsSingleThread(
+    TConstArrayRef<const IRankingMetric*> metrics,
+    TConstArrayRef<double> approx,
+    TConstArrayRef<float> target,
+    TConstArrayRef<TQueryInfo> queriesInfo,
+    int queryStartIndex,
+    int queryEndIndex
+) {
+    TVector<TMetricHolder> stats(metrics.size(), TMetricHolder(2));
+    TQueryRanking ranking;
+    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
+        const auto& queryInfo = queriesInfo[queryIndex];
+        const ui32 querySize = queryInfo.End - queryInfo.Begin;
+        ui32 topSize = 0;
+        for (const auto* metric : metrics) {
+            topSize = Max(topSize, metric->GetRankedTopSize(querySize));
+        }
+        ranking.Rank(approx.Slice(queryInfo.Begin, querySize), target.Slice(queryInfo.Begin, querySize), topSize);
+        for (auto metricIdx : xrange(metrics.size())) {
+            metrics[metricIdx]->AddRankedQuery(queryInfo, &ranking, &stats[metricIdx]);
+        }
+    }
+    return stats;
+}
+
+static TMetricHolder EvalRankingMetricSingleThread(
+    const IRankingMetric& metric,
+    TConstArrayRef<double> approx,
+    TConstArrayRef<float> target,
+    TConstArrayRef<TQueryInfo> queriesInfo,
+    int queryStartIndex,
+    int queryEndIndex
+) {
+    const IRankingMetric* metrics[] = {&metric};
+    return EvalRankingMetricsSingleThread(metrics, approx, target, queriesInfo, queryStartIndex, queryEndIndex)[0];
+}
+
 /* PFound */
 
 namespace {
-    struct TPFoundMetric : public TAdditiveMetric<TPFoundMetric> {
+    struct TPFoundMetric : public TAdditiveMetric<TPFoundMetric>, public IRankingMetric {
         explicit TPFoundMetric(int topSize, double decay);
         TMetricHolder EvalSingleThread(
             const TVector<TVector<double>>& approx,
@@ -1664,10 +1718,13 @@ namespace {
         double GetFinalError(const TMetricHolder& error) const override;
         TString GetDescription() const override;
         void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
+        ui32 GetRankedTopSize(ui32 querySize) const override;
+        void AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const override;
 
     private:
         int TopSize;
         double Decay;
+        TPFoundCalcer QueryCalcer;
     };
 }
 
@@ -1677,7 +1734,8 @@ THolder<IMetric> MakePFoundMetric(int topSize, double decay) {
 
 TPFoundMetric::TPFoundMetric(int topSize, double decay)
         : TopSize(topSize)
-        , Decay(decay) {
+        , Decay(decay)
+        , QueryCalcer(topSize, decay) {
     UseWeights.SetDefaultValue(true);
 }
 
@@ -1691,6 +1749,10 @@ TMetricHolder TPFoundMetric::EvalSingleThread(
     int queryStartIndex,
     int queryEndIndex
 ) const {
+    if (approxDelta.empty()) {
+        // ranking by exponentiated approx is the same
+        return EvalRankingMetricSingleThread(*this, approx[0], target, queriesInfo, queryStartIndex, queryEndIndex);
+    }
     const auto impl = [=] (auto hasDelta, auto isExpApprox, TConstArrayRef<double> approx, TConstArrayRef<double> approxDelta) {
         TPFoundCalcer calcer(TopSize, Decay);
         for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
@@ -1742,10 +1804,26 @@ void TPFoundMetric::GetBestValue(EMetricBestValue* valueType, float*) const {
     *valueType = EMetricBestValue::Max;
 }
 
+ui32 TPFoundMetric::GetRankedTopSize(ui32 querySize) const {
+    return GetRankingTopSize(querySize, TopSize);
+}
+
+void TPFoundMetric::AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const {
+    const float queryWeight = UseWeights ? queryInfo.Weight : 1.0;
+    const ui32* subgroupIdData = queryInfo.SubgroupId.empty() ? nullptr : queryInfo.SubgroupId.data();
+    const double pFound = QueryCalcer.CalcRankedQueryPFound(
+        ranking->GetTopIndices(GetRankedTopSize(ranking->GetQuerySize())),
+        ranking->GetTarget().data(),
+        subgroupIdData
+    );
+    stats->Stats[0] += queryWeight * pFound;
+    stats->Stats[1] += queryWeight;
+}
+
 /* NDCG@N */
 
 namespace {
-    struct TDcgMetric: public TAdditiveMetric<TDcgMetric> {
+    struct TDcgMetric: public TAdditiveMetric<TDcgMetric>, public IRankingMetric {
         explicit TDcgMetric(int topSize, ENdcgMetricType type, bool normalized, ENdcgDenominatorType denominator);
         TMetricHolder EvalSingleThread(
                 const TVector<TVector<double>>& approx,
@@ -1761,6 +1839,8 @@ namespace {
         double GetFinalError(const TMetricHolder& error) const override;
         TString GetDescription() const override;
         void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
+        ui32 GetRankedTopSize(ui32 querySize) const override;
+        void AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const override;
 
     private:
         int TopSize;
@@ -1794,25 +1874,24 @@ TMetricHolder TDcgMetric::EvalSingleThread(
 ) const {
     Y_ASSERT(approxDelta.empty());
     Y_ASSERT(!isExpApprox);
-    TMetricHolder error(2);
-    TVector<NMetrics::TSample> samples;
-    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
-        const auto queryBegin = queriesInfo[queryIndex].Begin;
-        const auto queryEnd = queriesInfo[queryIndex].End;
-        const auto querySize = queryEnd - queryBegin;
-        const float queryWeight = UseWeights ? queriesInfo[queryIndex].Weight : 1.f;
-        NMetrics::TSample::FromVectors(
-            MakeArrayRef(target.data() + queryBegin, querySize),
-            MakeArrayRef(approx.front().data() + queryBegin, querySize),
-            &samples);
-        if (Normalized) {
-            error.Stats[0] += queryWeight * CalcNdcg(samples, MetricType, TopSize, DenominatorType);
-        } else {
-            error.Stats[0] += queryWeight * CalcDcg(samples, MetricType, Nothing(), TopSize, DenominatorType);
-        }
-        error.Stats[1] += queryWeight;
+    return EvalRankingMetricSingleThread(*this, approx[0], target, queriesInfo, queryStartIndex, queryEndIndex);
+}
+
+ui32 TDcgMetric::GetRankedTopSize(ui32 querySize) const {
+    return GetRankingTopSize(querySize, TopSize);
+}
+
+void TDcgMetric::AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const {
+    const ui32 topSize = GetRankedTopSize(ranking->GetQuerySize());
+    const float queryWeight = UseWeights ? queryInfo.Weight : 1.f;
+    const double dcg = CalcDcgSorted(ranking->GetTopTargets(topSize), MetricType, Nothing(), DenominatorType);
+    if (Normalized) {
+        const double idcg = CalcDcgSorted(ranking->GetIdealTopTargets(topSize), MetricType, Nothing(), DenominatorType);
+        stats->Stats[0] += queryWeight * (idcg > 0 ? dcg / idcg : 0);
+    } else {
+        stats->Stats[0] += queryWeight * dcg;
     }
-    return error;
+    stats->Stats[1] += queryWeight;
 }
 
 TString TDcgMetric::GetDescription() const {
@@ -2251,6 +2330,125 @@ void TAUCMetric::GetBestValue(EMetricBestValue* valueType, float*) const {
     *valueType = EMetricBestValue::Max;
 }
 
+/* Approximate AUC */
+
+namespace {
+    struct TApproximateAUCMetric: public TAdditiveMetric<TApproximateAUCMetric> {
+        TApproximateAUCMetric(double border, ui32 binCount)
+            : Border(border)
+            , IsMultiClass(false)
+            , BinCount(binCount) {
+            CB_ENSURE(BinCount > 0, "AUC approx_bins should be positive");
+        }
+
+        TApproximateAUCMetric(int positiveClass, ui32 binCount)
+            : PositiveClass(positiveClass)
+            , IsMultiClass(true)
+            , BinCount(binCount) {
+            CB_ENSURE(BinCount > 0, "AUC approx_bins should be positive");
+        }
+
+        TMetricHolder EvalSingleThread(
+            const TVector<TVector<double>>& approx,
+            const TVector<TVector<double>>& approxDelta,
+            bool isExpApprox,
+            TConstArrayRef<float> target,
+            TConstArrayRef<float> weight,
+            TConstArrayRef<TQueryInfo> queriesInfo,
+            int begin,
+            int end
+        ) const;
+        double GetFinalError(const TMetricHolder& error) const override;
+        TVector<TString> GetStatDescriptions() const override;
+        TString GetDescription() const override;
+        void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
+
+    private:
+        int PositiveClass = 1;
+        double Border = GetDefaultTargetBorder();
+        bool IsMultiClass = false;
+        ui32 BinCount;
+    };
+}
+
+THolder<IMetric> MakeBinClassApproximateAucMetric(double border, ui32 binCount) {
+    return MakeHolder<TApproximateAUCMetric>(border, binCount);
+}
+
+THolder<IMetric> MakeMultiClassApproximateAucMetric(int positiveClass, ui32 binCount) {
+    return MakeHolder<TApproximateAUCMetric>(positiveClass, binCount);
+}
+
+TMetricHolder TApproximateAUCMetric::EvalSingleThread(
+    const TVector<TVector<double>>& approx,
+    const TVector<TVector<double>>& approxDelta,
+    bool isExpApprox,
+    TConstArrayRef<float> target,
+    TConstArrayRef<float> weight,
+    TConstArrayRef<TQueryInfo> /*queriesInfo*/,
+    int begin,
+    int end
+) const {
+    Y_ASSERT(!isExpApprox);
+    Y_ASSERT((approx.size() > 1) == IsMultiClass);
+
+    const int approxIdx = IsMultiClass ? PositiveClass : 0;
+    TConstArrayRef<double> approxRef = approx[approxIdx];
+    TConstArrayRef<double> approxDeltaRef = approxDelta.empty() ? TConstArrayRef<double>() : approxDelta[approxIdx];
+
+    // [negative weights by bins, positive weights by bins]
+    TMetricHolder error(2 * BinCount);
+    for (int i : xrange(begin, end)) {
+        const bool isPositive = IsMultiClass ? target[i] == static_cast<double>(PositiveClass) : target[i] > Border;
+        const double prediction = approxRef[i] + (approxDeltaRef.empty() ? 0.0 : approxDeltaRef[i]);
+        const ui32 bin = GetApproximateAucBin(prediction, BinCount);
+        error.Stats[isPositive * BinCount + bin] += weight.empty() ? 1.0 : weight[i];
+    }
+    return error;
+}
+
+double TApproximateAUCMetric::GetFinalError(const TMetricHolder& error) const {
+    return CalcApproximateAUC(error.Stats);
+}
+
+TVector<TString> TApproximateAUCMetric::GetStatDescriptions() const {
+    TVector<TString> descriptions;
+    descriptions.reserve(2 * BinCount);
+    for (TStringBuf weightType : {TStringBuf("NegativeWeight"), TStringBuf("PositiveWeight")}) {
+        for (ui32 bin : xrange(BinCount)) {
+            descriptions.push_back(TStringBuilder() << weightType << "_" << bin);
+        }
+    }
+    return descriptions;
+}
+
+TString TApproximateAUCMetric::GetDescription() const {
+    const TMetricParam<ui32> binCount("approx_bins", BinCount, /*userDefined*/true);
+    if (IsMultiClass) {
+        const TMetricParam<int> positiveClass("class", PositiveClass, /*userDefined*/true);
+        return BuildDescription(ELossFunction::AUC, UseWeights, positiveClass, binCount);
+    } else {
+        return BuildDescription(ELossFunction::AUC, UseWeights, "%.3g", MakeBorderParam(Border), binCount);
+    }
+}
+
+void TApproximateAUCMetric::GetBestValue(EMetricBestValue* valueType, float*) const {
+    *valueType = EMetricBestValue::Max;
+}
+
+double GetApproximateAucErrorBound(const TMetricHolder& error) {
+    double errorBound = 0;
+    CalcApproximateAUC(error.Stats, &errorBound);
+    return errorBound;
+}
+
+TMaybe<double> GetMetricErrorBound(const IMetric& metric, const TMetricHolder& error) {
+    if (dynamic_cast<const TApproximateAUCMetric*>(&metric)) {
+        return GetApproximateAucErrorBound(error);
+    }
+    return Nothing();
+}
+
 /* Normalized Gini metric */
 
 namespace {
@@ -3556,7 +3754,7 @@ void TPairAccuracyMetric::GetBestValue(EMetricBestValue* valueType, float*) cons
 /* PrecisionAtK */
 
 namespace {
-    struct TPrecisionAtKMetric: public TAdditiveMetric<TPrecisionAtKMetric> {
+    struct TPrecisionAtKMetric: public TAdditiveMetric<TPrecisionAtKMetric>, public IRankingMetric {
         explicit TPrecisionAtKMetric(int topSize, double border);
         TMetricHolder EvalSingleThread(
                 const TVector<TVector<double>>& approx,
@@ -3572,6 +3770,8 @@ namespace {
         double GetFinalError(const TMetricHolder& error) const override;
         TString GetDescription() const override;
         void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
+        ui32 GetRankedTopSize(ui32 querySize) const override;
+        void AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const override;
     private:
         int TopSize;
         double Border;
@@ -3600,18 +3800,16 @@ TMetricHolder TPrecisionAtKMetric::EvalSingleThread(
 ) const {
     Y_ASSERT(approxDelta.empty());
     Y_ASSERT(!isExpApprox);
-    TMetricHolder error(2);
-    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
-        int queryBegin = queriesInfo[queryIndex].Begin;
-        int queryEnd = queriesInfo[queryIndex].End;
+    return EvalRankingMetricSingleThread(*this, approx[0], target, queriesInfo, queryStartIndex, queryEndIndex);
+}
 
-        TVector<double> approxCopy(approx[0].data() + queryBegin, approx[0].data() + queryEnd);
-        TVector<float> targetCopy(target.begin() + queryBegin, target.begin() + queryEnd);
+ui32 TPrecisionAtKMetric::GetRankedTopSize(ui32 querySize) const {
+    return GetRankingTopSize(querySize, TopSize);
+}
 
-        error.Stats[0] += CalcPrecisionAtK(approxCopy, targetCopy, TopSize, Border);
-        error.Stats[1]++;
-    }
-    return error;
+void TPrecisionAtKMetric::AddRankedQuery(const TQueryInfo& /*queryInfo*/, TQueryRanking* ranking, TMetricHolder* stats) const {
+    stats->Stats[0] += CalcPrecisionAtK(*ranking, TopSize, Border);
+    stats->Stats[1]++;
 }
 
 EErrorType TPrecisionAtKMetric::GetErrorType() const {
@@ -3634,7 +3832,7 @@ void TPrecisionAtKMetric::GetBestValue(EMetricBestValue* valueType, float*) cons
 /* RecallAtK */
 
 namespace {
-    struct TRecallAtKMetric: public TAdditiveMetric<TRecallAtKMetric> {
+    struct TRecallAtKMetric: public TAdditiveMetric<TRecallAtKMetric>, public IRankingMetric {
         explicit TRecallAtKMetric(int topSize, double border);
         TMetricHolder EvalSingleThread(
                 const TVector<TVector<double>>& approx,
@@ -3651,6 +3849,8 @@ namespace {
         TString GetDescription() const override;
         void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
 
+        ui32 GetRankedTopSize(ui32 querySize) const override;
+        void AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const override;
     private:
         int TopSize;
         double Border;
@@ -3679,18 +3879,16 @@ TMetricHolder TRecallAtKMetric::EvalSingleThread(
 ) const {
     Y_ASSERT(approxDelta.empty());
     Y_ASSERT(!isExpApprox);
-    TMetricHolder error(2);
-    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
-        int queryBegin = queriesInfo[queryIndex].Begin;
-        int queryEnd = queriesInfo[queryIndex].End;
+    return EvalRankingMetricSingleThread(*this, approx[0], target, queriesInfo, queryStartIndex, queryEndIndex);
+}
 
-        TVector<double> approxCopy(approx[0].data() + queryBegin, approx[0].data() + queryEnd);
-        TVector<float> targetCopy(target.begin() + queryBegin, target.begin() + queryEnd);
+ui32 TRecallAtKMetric::GetRankedTopSize(ui32 querySize) const {
+    return GetRankingTopSize(querySize, TopSize);
+}
 
-        error.Stats[0] += CalcRecallAtK(approxCopy, targetCopy, TopSize, Border);
-        error.Stats[1]++;
-    }
-    return error;
+void TRecallAtKMetric::AddRankedQuery(const TQueryInfo& /*queryInfo*/, TQueryRanking* ranking, TMetricHolder* stats) const {
+    stats->Stats[0] += CalcRecallAtK(*ranking, TopSize, Border);
+    stats->Stats[1]++;
 }
 
 EErrorType TRecallAtKMetric::GetErrorType() const {
@@ -3713,7 +3911,7 @@ void TRecallAtKMetric::GetBestValue(EMetricBestValue* valueType, float*) const {
 /* Mean Average Precision at k */
 
 namespace {
-    struct TMAPKMetric: public TAdditiveMetric<TMAPKMetric> {
+    struct TMAPKMetric: public TAdditiveMetric<TMAPKMetric>, public IRankingMetric {
         explicit TMAPKMetric(int topSize, double border);
         TMetricHolder EvalSingleThread(
                 const TVector<TVector<double>>& approx,
@@ -3730,6 +3928,8 @@ namespace {
         TString GetDescription() const override;
         void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
 
+        ui32 GetRankedTopSize(ui32 querySize) const override;
+        void AddRankedQuery(const TQueryInfo& queryInfo, TQueryRanking* ranking, TMetricHolder* stats) const override;
     private:
         int TopSize;
         double Border;
@@ -3758,19 +3958,16 @@ TMetricHolder TMAPKMetric::EvalSingleThread(
 ) const {
     Y_ASSERT(approxDelta.empty());
     Y_ASSERT(!isExpApprox);
-    TMetricHolder error(2);
-
-    for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
-        int queryBegin = queriesInfo[queryIndex].Begin;
-        int queryEnd = queriesInfo[queryIndex].End;
+    return EvalRankingMetricSingleThread(*this, approx[0], target, queriesInfo, queryStartIndex, queryEndIndex);
+}
 
-        TVector<double> approxCopy(approx[0].data() + queryBegin, approx[0].data() + queryEnd);
-        TVector<float> targetCopy(target.data() + queryBegin, target.data() + queryEnd);
+ui32 TMAPKMetric::GetRankedTopSize(ui32 querySize) const {
+    return GetRankingTopSize(querySize, TopSize);
+}
 
-        error.Stats[0] += CalcAveragePrecisionK(approxCopy, targetCopy, TopSize, Border);
-        error.Stats[1]++;
-    }
-    return error;
+void TMAPKMetric::AddRankedQuery(const TQueryInfo& /*queryInfo*/, TQueryRanking* ranking, TMetricHolder* stats) const {
+    stats->Stats[0] += CalcAveragePrecisionK(*ranking, TopSize, Border);
+    stats->Stats[1]++;
 }
 
 TString TMAPKMetric::GetDescription() const {
@@ -4484,13 +4681,24 @@ static TVector<THolder<IMetric>> CreateMetric(ELossFunction metric, TMap<TString
             break;
         }
         case ELossFunction::AUC: {
+            // opt-in histogram approximation: additive and linear in object count
+            const ui32 approxBinCount = params.contains("approx_bins") ? FromString<ui32>(params.at("approx_bins")) : 0;
             if (approxDimension == 1) {
-                result.push_back(MakeBinClassAucMetric(border));
-                validParams = {"border"};
+                if (approxBinCount) {
+                    result.push_back(MakeBinClassApproximateAucMetric(border, approxBinCount));
+                } else {
+                    result.push_back(MakeBinClassAucMetric(border));
+                }
+                validParams = {"border", "approx_bins"};
             } else {
                 for (int i = 0; i < approxDimension; ++i) {
-                    result.push_back(MakeMultiClassAucMetric(i));
+                    if (approxBinCount) {
+                        result.push_back(MakeMultiClassApproximateAucMetric(i, approxBinCount));
+                    } else {
+                        result.push_back(MakeMultiClassAucMetric(i));
+                    }
                 }
+                validParams = {"approx_bins"};
             }
             break;
         }
@@ -4887,6 +5095,111 @@ TMetricHolder EvalErrors(
 }
 
 
+TVector<TMetricHolder> EvalErrors(
+        const TVector<TVector<double>>& approx,
+        TConstArrayRef<TConstArrayRef<float>> targets,
+        TConstArrayRef<float> weight,
+        TConstArrayRef<TQueryInfo> queriesInfo,
+        TConstArrayRef<const IMetric*> metrics,
+        NPar::TLocalExecutor* localExecutor
+) {
+    Y_VERIFY(targets.size() == metrics.size());
+    TVector<TMetricHolder> result(metrics.size());
+
+    TVector<size_t> blockwiseMetricIndices;
+    TVector<TVector<size_t>> rankingMetricGroups; // metrics in a group have the same target
+    for (auto metricIdx : xrange(metrics.size())) {
+        const IMetric& metric = *metrics[metricIdx];
+        if (metric.GetErrorType() == EErrorType::PerObjectError && metric.IsAdditiveMetric()) {
+            blockwiseMetricIndices.push_back(metricIdx);
+        } else if (approx.size() == 1 && dynamic_cast<const IRankingMetric*>(&metric)) {
+            const auto group = FindIf(
+                rankingMetricGroups,
+                [&] (const TVector<size_t>& group) {
+                    return targets[group[0]].data() == targets[metricIdx].data();
+                }
+            );
+            if (group == rankingMetricGroups.end()) {
+                rankingMetricGroups.push_back({metricIdx});
+            } else {
+                group->push_back(metricIdx);
+            }
+        } else {
+            result[metricIdx] = EvalErrors(approx, targets[metricIdx], weight, queriesInfo, metric, localExecutor);
+        }
+    }
+
+    // Ranking metrics of a group are evaluated over one ranking of each query.
+    for (const auto& group : rankingMetricGroups) {
+        TVector<const IRankingMetric*> rankingMetrics;
+        for (auto metricIdx : group) {
+            rankingMetrics.push_back(dynamic_cast<const IRankingMetric*>(metrics[metricIdx]));
+        }
+        const int queryCount = queriesInfo.size();
+        const int queryBlockSize = Max(10000, CeilDiv(queryCount, localExecutor->GetThreadCount() + 1));
+        const int queryBlockCount = CeilDiv(queryCount, queryBlockSize);
+        TVector<TVector<TMetricHolder>> queryBlockResults(queryBlockCount);
+        NPar::ParallelFor(*localExecutor, 0, queryBlockCount, [&] (int blockIdx) {
+            const int queryBegin = blockIdx * queryBlockSize;
+            const int queryEnd = Min(queryBegin + queryBlockSize, queryCount);
+            queryBlockResults[blockIdx] = EvalRankingMetricsSingleThread(
+                rankingMetrics,
+                approx[0],
+                targets[group[0]],
+                queriesInfo,
+                queryBegin,
+                queryEnd
+            );
+        });
+        for (auto i : xrange(group.size())) {
+            result[group[i]] = TMetricHolder(2);
+            for (const auto& blockResult : queryBlockResults) {
+                result[group[i]].Add(blockResult[i]);
+            }
+        }
+    }
+
+    if (blockwiseMetricIndices.empty()) {
+        return result;
+    }
+
+    // Additive per-object metrics are evaluated together by blocks of objects: each block of approx, target
+    //  and weight is read once for all of them instead of one full pass over the data per metric.
+    // Blocks are not larger than the minimal block size of TAdditiveMetric::Eval so they are evaluated in place.
+    const int objectCount = approx[0].ysize();
+    for (auto metricIdx : blockwiseMetricIndices) {
+        Y_VERIFY(objectCount == SafeIntegerCast<int>(targets[metricIdx].size()));
+    }
+    // Each executor chunk accumulates its blocks, so temporary holders do not grow with the number of blocks.
+    const int blockSize = 10000;
+    const int blockCount = CeilDiv(objectCount, blockSize);
+    const int chunkCount = Min(blockCount, localExecutor->GetThreadCount() + 1);
+    const int blocksPerChunk = CeilDiv(blockCount, Max(chunkCount, 1));
+    TVector<TVector<TMetricHolder>> chunkResults(chunkCount); // [chunkIdx][blockwiseMetricIdx]
+    NPar::ParallelFor(*localExecutor, 0, chunkCount, [&] (int chunkIdx) {
+        auto& chunkResult = chunkResults[chunkIdx];
+        chunkResult.resize(blockwiseMetricIndices.size());
+        const int chunkBlockEnd = Min((chunkIdx + 1) * blocksPerChunk, blockCount);
+        for (int blockIdx = chunkIdx * blocksPerChunk; blockIdx < chunkBlockEnd; ++blockIdx) {
+            const int begin = blockIdx * blockSize;
+            const int end = Min(begin + blockSize, objectCount);
+            for (auto i : xrange(blockwiseMetricIndices.size())) {
+                const auto metricIdx = blockwiseMetricIndices[i];
+                chunkResult[i].Add(
+                    metrics[metricIdx]->Eval(approx, targets[metricIdx], weight, queriesInfo, begin, end, *localExecutor)
+                );
+            }
+        }
+    });
+    for (const auto& chunkResult : chunkResults) {
+        for (auto i : xrange(blockwiseMetricIndices.size())) {
+            result[blockwiseMetricIndices[i]].Add(chunkResult[i]);
+        }
+    }
+    return result;
+}
+
+
 static inline double BestQueryShift(const double* cursor,
                                     const float* targets,
                                     const float* weights,
@@ -15,6 +15,7 @@
 #include <library/containers/2d_array/2d_array.h>
 
 #include <util/generic/fwd.h>
+#include <util/generic/maybe.h>
 
 #include <cmath>
 
@@ -262,6 +263,19 @@ THolder<IMetric> MakeFilteredDcgMetric(ENdcgMetricType type, ENdcgDenominatorTyp
 THolder<IMetric> MakeBinClassAucMetric(double border = GetDefaultTargetBorder());
 THolder<IMetric> MakeMultiClassAucMetric(int positiveClass);
 
+/* AUC by histograms of weights over predictions (see CalcApproximateAUC), additive unlike the exact AUC.
+ * The difference from the exact AUC is at most GetApproximateAucErrorBound of the metric stats.
+ * Bins are equal-width over raw predictions in a fixed window (see GetApproximateAucBin), so that stats
+ *  of data parts can be summed; predictions outside of the window (|prediction| > APPROXIMATE_AUC_MAX_PREDICTION)
+ *  fall to the edge bins and are not ordered between each other, the error bound grows accordingly.
+ */
+THolder<IMetric> MakeBinClassApproximateAucMetric(double border, ui32 binCount);
+THolder<IMetric> MakeMultiClassApproximateAucMetric(int positiveClass, ui32 binCount);
+double GetApproximateAucErrorBound(const TMetricHolder& error);
+
+// max difference from the exact metric value for approximate metrics, Nothing() for exact ones
+TMaybe<double> GetMetricErrorBound(const IMetric& metric, const TMetricHolder& error);
+
 THolder<IMetric> MakeAccuracyMetric(double border = GetDefaultTargetBorder());
 
 THolder<IMetric> MakeBinClassPrecisionMetric(double border = GetDefaultTargetBorder());
@@ -367,6 +381,16 @@ TMetricHolder EvalErrors(
     NPar::TLocalExecutor* localExecutor
 );
 
+// evaluates several metrics on the same approx, targets[i] is the target for metrics[i]
+TVector<TMetricHolder> EvalErrors(
+    const TVector<TVector<double>>& approx,
+    TConstArrayRef<TConstArrayRef<float>> targets,
+    TConstArrayRef<float> weight,
+    TConstArrayRef<TQueryInfo> queriesInfo,
+    TConstArrayRef<const IMetric*> metrics,
+    NPar::TLocalExecutor* localExecutor
+);
+
 inline bool IsMaxOptimal(const IMetric& metric) {
     EMetricBestValue bestValueType;
     float bestPossibleValue;
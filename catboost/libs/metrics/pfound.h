@@ -4,6 +4,7 @@
 #include "doc_comparator.h"
 
 #include <util/system/types.h>
+#include <util/generic/array_ref.h>
 #include <util/generic/utility.h>
 #include <util/generic/algorithm.h>
 #include <util/generic/vector.h>
@@ -21,9 +22,11 @@ public:
 
     template <bool isExpApprox, bool hasDelta, class TRelevsType, class TApproxType>
     void AddQuery(const TRelevsType* relevs, const TApproxType* approxes, const TApproxType* approxDelta, float queryWeight, const ui32* subgroupData, ui32 querySize) {
-        TVector<int> qurls(querySize);
+        TVector<ui32> qurls(querySize);
         std::iota(qurls.begin(), qurls.end(), 0);
-        Sort(qurls.begin(), qurls.end(), [&](int left, int right) -> bool {
+        // only the first Depth positions contribute to the metric
+        const ui32 depth = Min<ui32>(querySize, Depth);
+        PartialSort(qurls.begin(), qurls.begin() + depth, qurls.end(), [&](ui32 left, ui32 right) -> bool {
             if (hasDelta) {
                 if (isExpApprox) {
                     return CompareDocs(approxes[left] * approxDelta[left], relevs[left], approxes[right] * approxDelta[right], relevs[right]);
@@ -34,13 +37,20 @@ public:
                 return CompareDocs(approxes[left], relevs[left], approxes[right], relevs[right]);
             }
         });
+        const double pFound = CalcRankedQueryPFound(MakeArrayRef(qurls.data(), depth), relevs, subgroupData);
+        Statistic.Stats[0] += queryWeight * pFound;
+        Statistic.Stats[1] += queryWeight;
+    }
 
+    // topIndices are the indices (in query) of the documents at the first Min(Depth, querySize) positions
+    template <class TRelevsType>
+    double CalcRankedQueryPFound(TConstArrayRef<ui32> topIndices, const TRelevsType* relevs, const ui32* subgroupData) const {
         double pLook = 1, pFound = 0;
-        const ui32 depth = Min<ui32>(querySize, Depth);
+        const ui32 depth = Min<ui32>(topIndices.size(), Depth);
 
         TSet<ui32> subgroupIds;
         for (ui32 position = 0; position < depth; position++) {
-            const int docId = qurls[position];
+            const ui32 docId = topIndices[position];
             if (subgroupData != nullptr) {
                 const ui32 subgroupId = subgroupData[docId];
                 if (subgroupIds.contains(subgroupId)) {
@@ -53,9 +63,7 @@ public:
             pFound += pRel * pLook;
             pLook *= (1 - pRel) * Decay;
         }
-
-        Statistic.Stats[0] += queryWeight * pFound;
-        Statistic.Stats[1] += queryWeight;
+        return pFound;
     }
 
     static double Score(const TMetricHolder& metric) {
@@ -2,8 +2,20 @@
 
 #include <util/generic/fwd.h>
 
+class TQueryRanking;
+
 double CalcPrecisionAtK(TConstArrayRef<double> approx, TConstArrayRef<float> target, int top, double border);
 
 double CalcRecallAtK(TConstArrayRef<double> approx, TConstArrayRef<float> target, int top, double border);
 
 double CalcAveragePrecisionK(TConstArrayRef<double> approx, TConstArrayRef<float> target, int top, double border);
+
+// same metrics for a query ranked at least to Min(top, querySize) first positions
+double CalcPrecisionAtK(const TQueryRanking& ranking, int top, double border);
+
+double CalcRecallAtK(const TQueryRanking& ranking, int top, double border);
+
+double CalcAveragePrecisionK(const TQueryRanking& ranking, int top, double border);
+
+// number of first positions of a query ranking needed by the metrics above
+ui32 GetRankingTopSize(ui32 querySize, int top);
@@ -0,0 +1,50 @@
+#include "query_ranking.h"
+#include "doc_comparator.h"
+
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+
+
+template <class TIterator, class TCompare>
+static void SelectAndSortTop(TIterator begin, TIterator end, size_t topSize, TCompare&& cmp) {
+    const auto size = static_cast<size_t>(end - begin);
+    if (topSize < size) {
+        std::nth_element(begin, begin + topSize, end, cmp);
+    }
+    std::sort(begin, begin + Min(topSize, size), cmp);
+}
+
+void TQueryRanking::Rank(TConstArrayRef<double> approx, TConstArrayRef<float> target, ui32 topSize) {
+    Y_ASSERT(approx.size() == target.size());
+    const ui32 querySize = target.size();
+    Target = target;
+    TopSize = Min(topSize, querySize);
+    IdealTopSize = 0;
+
+    Indices.yresize(querySize);
+    Iota(Indices.begin(), Indices.end(), static_cast<ui32>(0));
+    SelectAndSortTop(
+        Indices.begin(),
+        Indices.end(),
+        TopSize,
+        [approx, target] (ui32 left, ui32 right) {
+            return CompareDocs(approx[left], target[left], approx[right], target[right]);
+        }
+    );
+
+    TopTargets.yresize(TopSize);
+    for (auto position : xrange(TopSize)) {
+        TopTargets[position] = target[Indices[position]];
+    }
+}
+
+TConstArrayRef<double> TQueryRanking::GetIdealTopTargets(ui32 topSize) {
+    topSize = Min(topSize, GetQuerySize());
+    if (IdealTopSize < topSize) {
+        IdealTargets.assign(Target.begin(), Target.end());
+        SelectAndSortTop(IdealTargets.begin(), IdealTargets.end(), topSize, [] (double left, double right) { return left > right; });
+        IdealTopSize = topSize;
+    }
+    return MakeArrayRef(IdealTargets.data(), topSize);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+/* Ranking of the documents of a query by decreasing approx (ties are broken by increasing target,
+ *  see CompareDocs) as used by ranking metrics.
+ *
+ * Only the first TopSize positions are ordered: they are selected with nth_element and then sorted,
+ *  so ranking a query costs O(querySize + topSize * log(topSize)) instead of a full sort.
+ * Buffers are reused between queries, so one instance is meant to be reused for the queries
+ *  of a block and shared by all ranking metrics evaluated on them.
+ */
+class TQueryRanking {
+public:
+    void Rank(TConstArrayRef<double> approx, TConstArrayRef<float> target, ui32 topSize);
+
+    ui32 GetQuerySize() const {
+        return Target.size();
+    }
+
+    // target of the query documents in the original order
+    TConstArrayRef<float> GetTarget() const {
+        return Target;
+    }
+
+    // indices (in query) of the documents at the first topSize positions, topSize must not exceed ranked top size
+    TConstArrayRef<ui32> GetTopIndices(ui32 topSize) const {
+        Y_ASSERT(topSize <= TopSize);
+        return MakeArrayRef(Indices.data(), topSize);
+    }
+
+    // targets of the documents at the first topSize positions
+    TConstArrayRef<double> GetTopTargets(ui32 topSize) const {
+        Y_ASSERT(topSize <= TopSize);
+        return MakeArrayRef(TopTargets.data(), topSize);
+    }
+
+    // first topSize targets of the ideal ranking (by decreasing target), calculated on the first request
+    TConstArrayRef<double> GetIdealTopTargets(ui32 topSize);
+
+private:
+    TConstArrayRef<float> Target;
+    ui32 TopSize = 0;
+    TVector<ui32> Indices;
+    TVector<double> TopTargets;
+    ui32 IdealTopSize = 0;
+    TVector<double> IdealTargets;
+};
@@ -1,4 +1,5 @@
 #include <catboost/libs/metrics/auc.h>
+#include <catboost/libs/metrics/metric.h>
 #include <catboost/libs/metrics/metric_holder.h>
 #include <catboost/libs/helpers/cpu_random.h>
 
@@ -383,4 +384,108 @@ Y_UNIT_TEST_SUITE(AUCMetricTests) {
         TVector<double> weight{1, 1, 1};
         TestAuc(approx, target, weight, EPS);
     }
+
+    Y_UNIT_TEST(ApproximateAucErrorBoundTest) {
+        TFastRng<ui64> rng(239);
+        const ui32 size = 2000;
+        const ui32 binCount = 1000;
+        TVector<NMetrics::TSample> samples;
+        TVector<double> histogram(2 * binCount);
+        for (ui32 i = 0; i < size; ++i) {
+            const double prediction = 6 * rng.GenRandReal3() - 3;
+            const double target = rng.GenRandReal3() < 0.3 + 0.1 * prediction;
+            const double weight = rng.GenRandReal3();
+            samples.emplace_back(target, prediction, weight);
+            histogram[target * binCount + GetApproximateAucBin(prediction, binCount)] += weight;
+        }
+        double errorBound = 0;
+        const double approximateAuc = CalcApproximateAUC(histogram, &errorBound);
+        UNIT_ASSERT(errorBound < 1e-2);
+        UNIT_ASSERT_DOUBLES_EQUAL(approximateAuc, CalcAUC(&samples), errorBound + EPS);
+    }
+
+    Y_UNIT_TEST(ApproximateAucExactForDistinctBinsTest) {
+        TVector<double> prediction{-2, 0, 2, -2, 3, 0, 2};
+        TVector<double> target{0, 1, 1, 1, 0, 0, 1};
+        TVector<double> weight{1, 0.5, 2, 1, 1, 0.75, 1};
+        const ui32 binCount = 100;
+        TVector<double> histogram(2 * binCount);
+        TVector<NMetrics::TSample> samples;
+        for (ui32 i = 0; i < prediction.size(); ++i) {
+            histogram[target[i] * binCount + GetApproximateAucBin(prediction[i], binCount)] += weight[i];
+            samples.emplace_back(target[i], prediction[i], weight[i]);
+        }
+        UNIT_ASSERT_DOUBLES_EQUAL(CalcApproximateAUC(histogram), CalcAUC(&samples), EPS);
+    }
+
+    Y_UNIT_TEST(ApproximateAucMetricIsAdditiveTest) {
+        TFastRng<ui64> rng(239);
+        const ui32 size = 30000;
+        TVector<TVector<double>> approx(1, TVector<double>(size));
+        TVector<float> target(size);
+        for (ui32 i = 0; i < size; ++i) {
+            approx[0][i] = 4 * rng.GenRandReal3() - 2;
+            target[i] = rng.GenRandReal3() < 0.5 + 0.2 * approx[0][i];
+        }
+
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(3);
+        const auto metric = MakeBinClassApproximateAucMetric(0.5, 4096);
+        UNIT_ASSERT(metric->IsAdditiveMetric());
+
+        TMetricHolder parts = metric->Eval(approx, target, {}, {}, 0, size / 3, executor);
+        parts.Add(metric->Eval(approx, target, {}, {}, size / 3, size, executor));
+        const TMetricHolder whole = metric->Eval(approx, target, {}, {}, 0, size, executor);
+        UNIT_ASSERT_DOUBLES_EQUAL(metric->GetFinalError(parts), metric->GetFinalError(whole), EPS);
+
+        TVector<NMetrics::TSample> samples;
+        for (ui32 i = 0; i < size; ++i) {
+            samples.emplace_back(target[i], approx[0][i], 1.0);
+        }
+        UNIT_ASSERT_DOUBLES_EQUAL(
+            metric->GetFinalError(whole),
+            CalcAUC(&samples),
+            GetApproximateAucErrorBound(whole) + EPS
+        );
+
+        const TMaybe<double> errorBound = GetMetricErrorBound(*metric, whole);
+        UNIT_ASSERT(errorBound.Defined());
+        UNIT_ASSERT_DOUBLES_EQUAL(*errorBound, GetApproximateAucErrorBound(whole), EPS);
+        UNIT_ASSERT(!GetMetricErrorBound(*MakeBinClassAucMetric(0.5), whole).Defined());
+    }
+
+    Y_UNIT_TEST(ApproximateAucBinsResolutionTest) {
+        // typical raw predictions are spread over all bins instead of a narrow band around 0
+        const ui32 binCount = 200;
+        const double binWidth = 2 * APPROXIMATE_AUC_MAX_PREDICTION / binCount;
+        ui32 prevBin = GetApproximateAucBin(-APPROXIMATE_AUC_MAX_PREDICTION, binCount);
+        UNIT_ASSERT_VALUES_EQUAL(prevBin, 0);
+        for (double prediction = -APPROXIMATE_AUC_MAX_PREDICTION + 1.5 * binWidth;
+             prediction < APPROXIMATE_AUC_MAX_PREDICTION;
+             prediction += 1.5 * binWidth)
+        {
+            const ui32 bin = GetApproximateAucBin(prediction, binCount);
+            UNIT_ASSERT(bin > prevBin);
+            prevBin = bin;
+        }
+        UNIT_ASSERT_VALUES_EQUAL(GetApproximateAucBin(APPROXIMATE_AUC_MAX_PREDICTION, binCount), binCount - 1);
+    }
+
+    Y_UNIT_TEST(ApproximateAucEdgeBinsTest) {
+        // predictions outside of the binned window go to the edge bins, their order is lost and the bound reflects it
+        TVector<double> prediction{10, 20, 30, 40};
+        TVector<double> target{0, 1, 0, 1};
+        const ui32 binCount = 100;
+        TVector<double> histogram(2 * binCount);
+        TVector<NMetrics::TSample> samples;
+        for (ui32 i = 0; i < prediction.size(); ++i) {
+            UNIT_ASSERT_VALUES_EQUAL(GetApproximateAucBin(prediction[i], binCount), binCount - 1);
+            histogram[target[i] * binCount + GetApproximateAucBin(prediction[i], binCount)] += 1;
+            samples.emplace_back(target[i], prediction[i], 1);
+        }
+        double errorBound = 0;
+        UNIT_ASSERT_DOUBLES_EQUAL(CalcApproximateAUC(histogram, &errorBound), 0.5, EPS);
+        UNIT_ASSERT_DOUBLES_EQUAL(CalcAUC(&samples), 0.75, EPS);
+        UNIT_ASSERT_DOUBLES_EQUAL(errorBound, 0.5, EPS);
+    }
 }
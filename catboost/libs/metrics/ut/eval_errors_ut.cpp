@@ -0,0 +1,162 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/libs/metrics/dcg.h>
+#include <catboost/libs/metrics/metric.h>
+#include <catboost/libs/metrics/metric_holder.h>
+#include <catboost/libs/metrics/sample.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+// reference implementations: targets of the whole query in the ranked order
+//  (decreasing prediction, ties are broken by increasing target)
+static TVector<float> GetFullySortedTargets(TConstArrayRef<double> approx, TConstArrayRef<float> target) {
+    TVector<ui32> indices(target.size());
+    Iota(indices.begin(), indices.end(), 0);
+    StableSort(indices.begin(), indices.end(), [&](ui32 lhs, ui32 rhs) {
+        return approx[lhs] != approx[rhs] ? approx[lhs] > approx[rhs] : target[lhs] < target[rhs];
+    });
+    TVector<float> sortedTargets;
+    for (auto idx : indices) {
+        sortedTargets.push_back(target[idx]);
+    }
+    return sortedTargets;
+}
+
+static double CalcReferencePFound(TConstArrayRef<float> sortedTargets, size_t top, double decay = 0.85) {
+    double pLook = 1;
+    double pFound = 0;
+    for (auto pos : xrange(Min(top, sortedTargets.size()))) {
+        pFound += pLook * sortedTargets[pos];
+        pLook *= (1 - sortedTargets[pos]) * decay;
+    }
+    return pFound;
+}
+
+// returns {precision, recall, average precision} at top
+static TVector<double> CalcReferencePrecisionRecallMap(TConstArrayRef<float> sortedTargets, size_t top, double border) {
+    const size_t size = Min(top, sortedTargets.size());
+    size_t relevantInTop = 0;
+    double averagePrecision = 0;
+    for (auto pos : xrange(size)) {
+        if (sortedTargets[pos] > border) {
+            ++relevantInTop;
+            averagePrecision += relevantInTop / double(pos + 1);
+        }
+    }
+    const size_t relevant = CountIf(sortedTargets, [=](float target) { return target > border; });
+    return {
+        relevantInTop / double(size),
+        relevant ? relevantInTop / double(relevant) : 1.0,
+        relevant ? averagePrecision / Min(relevant, size) : 0.0
+    };
+}
+
+Y_UNIT_TEST_SUITE(EvalErrorsTest) {
+Y_UNIT_TEST(SeveralMetricsTest) {
+    const int objectCount = 25000; // several blocks
+    TFastRng64 rng(0);
+    TVector<TVector<double>> approx(1, TVector<double>(objectCount));
+    TVector<float> target(objectCount);
+    TVector<float> binarizedTarget(objectCount);
+    TVector<float> weight(objectCount);
+    for (auto i : xrange(objectCount)) {
+        approx[0][i] = rng.GenRandReal1() * 4 - 2;
+        target[i] = rng.GenRandReal1();
+        binarizedTarget[i] = target[i] > 0.5;
+        weight[i] = rng.GenRandReal1() + 0.5;
+    }
+
+    NPar::TLocalExecutor executor;
+    executor.RunAdditionalThreads(3);
+    const auto rmse = MakeRMSEMetric();
+    const auto logloss = MakeCrossEntropyMetric(ELossFunction::Logloss);
+    const auto auc = MakeBinClassAucMetric();
+    const TVector<const IMetric*> metrics = {rmse.Get(), logloss.Get(), auc.Get()};
+    const TVector<TConstArrayRef<float>> targets = {target, binarizedTarget, binarizedTarget};
+
+    const auto scores = EvalErrors(approx, targets, weight, {}, metrics, &executor);
+    UNIT_ASSERT_VALUES_EQUAL(scores.size(), metrics.size());
+    for (auto i : xrange(metrics.size())) {
+        const auto score = EvalErrors(approx, targets[i], weight, {}, *metrics[i], &executor);
+        UNIT_ASSERT_DOUBLES_EQUAL(metrics[i]->GetFinalError(scores[i]), metrics[i]->GetFinalError(score), 1e-9);
+    }
+}
+
+Y_UNIT_TEST(RankingMetricsTest) {
+    const int queryCount = 3000;
+    TFastRng64 rng(0);
+    TVector<TVector<double>> approx(1);
+    TVector<float> target;
+    TVector<TQueryInfo> queriesInfo;
+    for (auto queryIdx : xrange(queryCount)) {
+        const ui32 queryBegin = target.size();
+        const ui32 querySize = 1 + rng.Uniform(30);
+        for (auto i : xrange(querySize)) {
+            Y_UNUSED(i);
+            approx[0].push_back(rng.Uniform(5)); // ties are frequent
+            target.push_back(rng.Uniform(4) / 3.0f);
+        }
+        queriesInfo.emplace_back(queryBegin, queryBegin + querySize);
+        queriesInfo.back().Weight = 1 + queryIdx % 3;
+    }
+    TVector<float> weight(target.size(), 1.0f);
+
+    NPar::TLocalExecutor executor;
+    executor.RunAdditionalThreads(3);
+    const auto ndcg1 = MakeDcgMetric(1);
+    const auto ndcg5 = MakeDcgMetric(5, ENdcgMetricType::Exp);
+    const auto dcg = MakeDcgMetric(-1, ENdcgMetricType::Base, /*normalized*/false);
+    const auto pFound = MakePFoundMetric(10);
+    const auto precision = MakePrecisionAtKMetric(3, 0.5);
+    const auto recall = MakeRecallAtKMetric(3, 0.5);
+    const auto map = MakeMAPKMetric(7, 0.5);
+    const TVector<const IMetric*> metrics = {
+        ndcg1.Get(), ndcg5.Get(), dcg.Get(), pFound.Get(), precision.Get(), recall.Get(), map.Get()
+    };
+    const TVector<TConstArrayRef<float>> targets(metrics.size(), target);
+
+    // query-weighted averages for ndcg, dcg and pfound, plain averages for the rest
+    TVector<double> referenceSums(metrics.size());
+    double queryWeightSum = 0;
+    for (const auto& queryInfo : queriesInfo) {
+        const TConstArrayRef<double> queryApprox(approx[0].data() + queryInfo.Begin, approx[0].data() + queryInfo.End);
+        const TConstArrayRef<float> queryTarget(target.data() + queryInfo.Begin, target.data() + queryInfo.End);
+        TVector<NMetrics::TSample> samples;
+        for (auto i : xrange(queryTarget.size())) {
+            samples.emplace_back(queryTarget[i], queryApprox[i]);
+        }
+        const auto sortedTargets = GetFullySortedTargets(queryApprox, queryTarget);
+        const auto precisionRecallMap = CalcReferencePrecisionRecallMap(sortedTargets, 3, 0.5);
+        const double mapAt7 = CalcReferencePrecisionRecallMap(sortedTargets, 7, 0.5)[2];
+
+        referenceSums[0] += queryInfo.Weight * CalcNdcg(samples, ENdcgMetricType::Base, 1);
+        referenceSums[1] += queryInfo.Weight * CalcNdcg(samples, ENdcgMetricType::Exp, 5);
+        referenceSums[2] += queryInfo.Weight * CalcDcg(samples);
+        referenceSums[3] += queryInfo.Weight * CalcReferencePFound(sortedTargets, 10);
+        referenceSums[4] += precisionRecallMap[0];
+        referenceSums[5] += precisionRecallMap[1];
+        referenceSums[6] += mapAt7;
+        queryWeightSum += queryInfo.Weight;
+    }
+    const TVector<double> references = {
+        referenceSums[0] / queryWeightSum,
+        referenceSums[1] / queryWeightSum,
+        referenceSums[2] / queryWeightSum,
+        referenceSums[3] / queryWeightSum,
+        referenceSums[4] / queryCount,
+        referenceSums[5] / queryCount,
+        referenceSums[6] / queryCount
+    };
+
+    const auto scores = EvalErrors(approx, targets, weight, queriesInfo, metrics, &executor);
+    for (auto i : xrange(metrics.size())) {
+        UNIT_ASSERT_DOUBLES_EQUAL_C(references[i], metrics[i]->GetFinalError(scores[i]), 1e-9, metrics[i]->GetDescription());
+        const auto score = EvalErrors(approx, targets[i], weight, queriesInfo, *metrics[i], &executor);
+        UNIT_ASSERT_DOUBLES_EQUAL_C(references[i], metrics[i]->GetFinalError(score), 1e-9, metrics[i]->GetDescription());
+    }
+}
+}
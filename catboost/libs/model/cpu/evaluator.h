@@ -313,7 +313,7 @@ namespace NCB::NModelEvaluation {
                 if constexpr (std::is_integral_v<TCatFeatureValue>) {
                     return catFeatures[index][position.Index];
                 } else {
-                    return CalcCatFeatureHash(catFeatures[index][position.Index]);
+                    return CalcCatFeatureHashCached(catFeatures[index][position.Index]);
                 }
             },
             docCount,
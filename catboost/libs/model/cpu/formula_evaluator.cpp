@@ -276,7 +276,7 @@ namespace NCB::NModelEvaluation {
                         return floatFeatures[index][position.Index];
                     },
                     [&catFeatures](const TFeaturePosition& position, size_t index) -> int {
-                        return CalcCatFeatureHash(catFeatures[index][position.Index]);
+                        return CalcCatFeatureHashCached(catFeatures[index][position.Index]);
                     },
                     docCount,
                     treeStart,
@@ -306,7 +306,7 @@ namespace NCB::NModelEvaluation {
                         return floatFeatures[position.Index];
                     },
                     [&catFeatures](const TFeaturePosition& position, size_t) -> int {
-                        return CalcCatFeatureHash(catFeatures[position.Index]);
+                        return CalcCatFeatureHashCached(catFeatures[position.Index]);
                     },
                     1,
                     treeStart,
@@ -337,7 +337,7 @@ namespace NCB::NModelEvaluation {
                         return floatFeatures[index][position.Index];
                     },
                     [&catFeatures](const TFeaturePosition& position, size_t index) -> int {
-                        return CalcCatFeatureHash(catFeatures[index][position.Index]);
+                        return CalcCatFeatureHashCached(catFeatures[index][position.Index]);
                     },
                     docCount,
                     treeStart,
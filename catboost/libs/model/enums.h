@@ -20,3 +20,9 @@ enum class EModelType {
     Onnx           /* "Onnx", "onnx" */,
     Pmml           /* "PMML", "pmml" */
 };
+
+enum class EFormulaEvaluatorType {
+    CPU,
+    GPU,
+    Jit  // model compiled to native code at load time, falls back to CPU if unavailable
+};
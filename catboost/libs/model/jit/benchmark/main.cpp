@@ -0,0 +1,74 @@
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/ut/lib/random_model.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+using namespace NCB::NModelEvaluation;
+using NCB::NModelUT::BuildRandomModel;
+
+namespace {
+    const size_t FeatureCount = 50;
+    const size_t BorderCount = 64;
+    const size_t DocCount = 10000;
+
+    class TBenchmarkModel {
+    public:
+        TBenchmarkModel(size_t treeCount, size_t treeDepth)
+            // both evaluators apply identical models
+            : CpuModel(BuildRandomModel(FeatureCount, BorderCount, treeCount, treeDepth))
+            , JitModel(BuildRandomModel(FeatureCount, BorderCount, treeCount, treeDepth))
+        {
+            TFastRng64 rng(0);
+            Data.resize(DocCount);
+            for (auto& doc : Data) {
+                doc.yresize(FeatureCount);
+                for (auto& value : doc) {
+                    value = rng.GenRandReal1();
+                }
+            }
+            Features.assign(Data.begin(), Data.end());
+            Results.resize(DocCount);
+
+            // compilation happens here, outside of the measured loop
+            JitModel.SetEvaluatorType(EFormulaEvaluatorType::Jit);
+        }
+
+        void Run(EFormulaEvaluatorType evaluatorType, size_t iterations) {
+            const auto& model = (evaluatorType == EFormulaEvaluatorType::Jit) ? JitModel : CpuModel;
+            for (auto iteration : xrange(iterations)) {
+                Y_UNUSED(iteration);
+                model.CalcFlat(Features, Results);
+                Y_DO_NOT_OPTIMIZE_AWAY(Results.data());
+            }
+        }
+
+    private:
+        TFullModel CpuModel;
+        TFullModel JitModel;
+        TVector<TVector<float>> Data;
+        TVector<TConstArrayRef<float>> Features;
+        TVector<double> Results;
+    };
+
+    template <size_t TreeCount, size_t TreeDepth>
+    TBenchmarkModel& GetBenchmarkModel() {
+        static TBenchmarkModel model(TreeCount, TreeDepth);
+        return model;
+    }
+}
+
+#define DEFINE_EVALUATOR_BENCHMARKS(treeCount, treeDepth)                                          \
+    Y_CPU_BENCHMARK(Cpu_##treeCount##_Trees_Depth_##treeDepth, iface) {                            \
+        GetBenchmarkModel<treeCount, treeDepth>().Run(EFormulaEvaluatorType::CPU, iface.Iterations()); \
+    }                                                                                              \
+    Y_CPU_BENCHMARK(Jit_##treeCount##_Trees_Depth_##treeDepth, iface) {                            \
+        GetBenchmarkModel<treeCount, treeDepth>().Run(EFormulaEvaluatorType::Jit, iface.Iterations()); \
+    }
+
+DEFINE_EVALUATOR_BENCHMARKS(100, 6)
+DEFINE_EVALUATOR_BENCHMARKS(1000, 6)
+DEFINE_EVALUATOR_BENCHMARKS(1000, 8)
@@ -0,0 +1,426 @@
+#include "jit_evaluator.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/model/eval_processing.h>
+#include <catboost/libs/model/model_export/model_exporter.h>
+
+#include <library/svnversion/svnversion.h>
+
+#include <util/digest/murmur.h>
+#include <util/folder/dirut.h>
+#include <util/folder/path.h>
+#include <util/generic/cast.h>
+#include <util/generic/guid.h>
+#include <util/generic/list.h>
+#include <util/generic/scope.h>
+#include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/stream/labeled.h>
+#include <util/stream/str.h>
+#include <util/string/builder.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+#include <util/system/dynlib.h>
+#include <util/system/env.h>
+#include <util/system/fs.h>
+#include <util/system/shellcommand.h>
+
+#if defined(_unix_)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace NCB::NModelEvaluation {
+    namespace {
+        using TApplyBatchFunction = void (*)(const float* features, unsigned int docCount, double* result);
+
+        const char* const ApplyBatchSymbol = "CatboostJitApplyBatch";
+
+        // per user, so that other users can't plant libraries into the cache
+        TString GetDefaultCacheDir() {
+#if defined(_unix_)
+            return JoinFsPaths(GetSystemTempDir(), TStringBuilder() << "catboost_jit_" << geteuid());
+#else
+            return JoinFsPaths(GetSystemTempDir(), "catboost_jit");
+#endif
+        }
+
+        struct TJitCompilerOptions {
+            TString Compiler;
+            TVector<TString> Flags;
+            TString CacheDir;
+
+        public:
+            TJitCompilerOptions()
+                : Compiler(GetEnv("CATBOOST_JIT_CXX", "c++"))
+                , CacheDir(GetEnv("CATBOOST_JIT_CACHE_DIR", GetDefaultCacheDir()))
+            {
+                const TString flags = GetEnv("CATBOOST_JIT_CXXFLAGS", "-O3 -march=native");
+                for (const auto& flag : StringSplitter(flags).Split(' ').SkipEmpty()) {
+                    Flags.push_back(TString(flag.Token()));
+                }
+            }
+
+            TString GetDescription() const {
+                TStringBuilder description;
+                description << Compiler;
+                for (const auto& flag : Flags) {
+                    description << ' ' << flag;
+                }
+                return description;
+            }
+        };
+
+        class TJitModule {
+        public:
+            explicit TJitModule(const TString& libraryPath)
+                : Library(libraryPath)
+            {
+                ApplyBatch = reinterpret_cast<TApplyBatchFunction>(Library.Sym(ApplyBatchSymbol));
+            }
+
+        public:
+            TApplyBatchFunction ApplyBatch = nullptr;
+
+        private:
+            TDynamicLibrary Library;
+        };
+    }
+
+    // catboost version is a part of the key, as the exporter output and -march=native code change between builds
+    static TString GetModelKey(const TFullModel& model, const TJitCompilerOptions& options) {
+        const TString serializedModel = SerializeModel(model);
+        const TString compilerDescription = options.GetDescription() + '\n' + GetProgramSvnVersion();
+        const ui64 modelHash = MurmurHash<ui64>(serializedModel.data(), serializedModel.size());
+        const ui64 compilerHash = MurmurHash<ui64>(compilerDescription.data(), compilerDescription.size());
+        return TStringBuilder() << "model_" << modelHash << "_" << compilerHash;
+    }
+
+    static TString GetLibraryPath(const TString& modelKey, const TJitCompilerOptions& options) {
+        return JoinFsPaths(options.CacheDir, modelKey + ".so");
+    }
+
+    /* Loaded libraries run with the rights of the process, so the cache directory and the libraries in it
+     * must be owned by the current user and must not be writable by anybody else.
+     */
+    static void CheckCachePathIsTrusted(const TString& path, bool isDirectory) {
+#if defined(_unix_)
+        struct stat pathStat;
+        CB_ENSURE(lstat(path.c_str(), &pathStat) == 0, "Can't stat Jit cache path " << path);
+        CB_ENSURE(
+            isDirectory ? S_ISDIR(pathStat.st_mode) : S_ISREG(pathStat.st_mode),
+            "Jit cache path " << path << " is not a " << (isDirectory ? "directory" : "regular file")
+        );
+        CB_ENSURE(pathStat.st_uid == geteuid(), "Jit cache path " << path << " is not owned by the current user");
+        CB_ENSURE(
+            (pathStat.st_mode & (S_IWGRP | S_IWOTH)) == 0,
+            "Jit cache path " << path << " is writable by other users"
+        );
+#else
+        Y_UNUSED(path, isDirectory);
+#endif
+    }
+
+    // the compiled library is written to a temporary path and renamed, so concurrent compilations don't clash
+    static void CompileModel(const TFullModel& model, const TString& libraryPath, const TJitCompilerOptions& options) {
+        const TString tmpPrefix = libraryPath + "." + CreateGuidAsString();
+        const TString sourcePath = tmpPrefix + ".cpp";
+        const TString tmpLibraryPath = tmpPrefix + ".so";
+        Y_SCOPE_EXIT(&sourcePath, &tmpLibraryPath) {
+            NFs::Remove(sourcePath);
+            NFs::Remove(tmpLibraryPath);
+        };
+
+        ExportModel(
+            model,
+            sourcePath,
+            EModelType::Cpp,
+            "{\"cpp_export_mode\": \"specialized\", \"cpp_batch_api\": true}"
+        );
+        {
+            TFileOutput source(TFile(sourcePath, OpenExisting | WrOnly | ForAppend));
+            source << '\n';
+            source << "extern \"C\" void " << ApplyBatchSymbol << "(const float* features, unsigned int docCount, double* result) {" << '\n';
+            source << "    ApplyCatboostModelBatch(features, docCount, result);" << '\n';
+            source << "}" << '\n';
+            source.Finish();
+        }
+
+        TList<TString> args(options.Flags.begin(), options.Flags.end());
+        args.insert(args.end(), {"-std=c++14", "-fPIC", "-shared", "-o", tmpLibraryPath, sourcePath});
+        TStringStream compilerErrors;
+        TShellCommand compilerCommand(options.Compiler, args, TShellCommandOptions().SetErrorStream(&compilerErrors));
+        compilerCommand.Run();
+        CB_ENSURE(
+            compilerCommand.GetStatus() == TShellCommand::SHELL_FINISHED && compilerCommand.GetExitCode() == 0,
+            "Jit compilation with " << options.GetDescription() << " failed: " << compilerErrors.Str()
+        );
+        CB_ENSURE(NFs::Rename(tmpLibraryPath, libraryPath), "Can't move compiled model to " << libraryPath);
+    }
+
+    static TAtomicSharedPtr<TJitModule> LoadJitModule(const TFullModel& model) {
+        CB_ENSURE(
+            JitEvaluationPossible(model),
+            "Jit evaluation is supported only for oblivious single dimension models without categorical features"
+        );
+        const TJitCompilerOptions options;
+        TFsPath(options.CacheDir).MkDirs(0700);
+        CheckCachePathIsTrusted(options.CacheDir, /*isDirectory*/ true);
+        const TString libraryPath = GetLibraryPath(GetModelKey(model, options), options);
+        if (!NFs::Exists(libraryPath)) {
+            CATBOOST_DEBUG_LOG << "Compiling model to " << libraryPath << Endl;
+            CompileModel(model, libraryPath, options);
+        }
+        CheckCachePathIsTrusted(libraryPath, /*isDirectory*/ false);
+        return MakeAtomicShared<TJitModule>(libraryPath);
+    }
+
+    namespace {
+        class TJitEvaluator final : public IModelEvaluator {
+        public:
+            explicit TJitEvaluator(const TFullModel& model)
+                : Module(LoadJitModule(model))
+                , FloatFeatureCount(model.GetNumFloatFeatures())
+                , FlatFeatureVectorExpectedSize(model.ObliviousTrees->GetFlatFeatureVectorExpectedSize())
+                , TreeCount(model.GetTreeCount())
+                , CpuEvaluator(CreateCpuEvaluator(model))
+            {}
+
+            TJitEvaluator(const TJitEvaluator& other)
+                : Module(other.Module)
+                , FloatFeatureCount(other.FloatFeatureCount)
+                , FlatFeatureVectorExpectedSize(other.FlatFeatureVectorExpectedSize)
+                , TreeCount(other.TreeCount)
+                , PredictionType(other.PredictionType)
+                , HasFeatureLayout(other.HasFeatureLayout)
+                , CpuEvaluator(other.CpuEvaluator->Clone())
+            {}
+
+            void SetPredictionType(EPredictionType type) override {
+                PredictionType = type;
+                CpuEvaluator->SetPredictionType(type);
+            }
+
+            EPredictionType GetPredictionType() const override {
+                return PredictionType;
+            }
+
+            TModelEvaluatorPtr Clone() const override {
+                return new TJitEvaluator(*this);
+            }
+
+            i32 GetApproxDimension() const override {
+                return 1;
+            }
+
+            size_t GetTreeCount() const override {
+                return TreeCount;
+            }
+
+            void SetFeatureLayout(const TFeatureLayout& featureLayout) override {
+                HasFeatureLayout = true;
+                CpuEvaluator->SetFeatureLayout(featureLayout);
+            }
+
+            void SetProperty(const TStringBuf propName, const TStringBuf propValue) override {
+                CB_ENSURE(false, "Jit evaluator don't have any properties. Got: " << propName);
+                Y_UNUSED(propValue);
+            }
+
+            void CalcFlatTransposed(
+                TConstArrayRef<TConstArrayRef<float>> transposedFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                if (!CanUseJit(treeStart, treeEnd, featureInfo)) {
+                    CpuEvaluator->CalcFlatTransposed(transposedFeatures, treeStart, treeEnd, results, featureInfo);
+                    return;
+                }
+                CB_ENSURE(
+                    FlatFeatureVectorExpectedSize <= transposedFeatures.size(),
+                    "Not enough features provided" << LabeledOutput(FlatFeatureVectorExpectedSize, transposedFeatures.size())
+                );
+                for (const auto& featureValues : transposedFeatures) {
+                    CB_ENSURE(
+                        featureValues.size() >= results.size(),
+                        "insufficient feature values count: " << featureValues.size() << " expected: " << results.size()
+                    );
+                }
+                CalcJit(
+                    results.size(),
+                    [&] (size_t docIdx, size_t featureIdx) { return transposedFeatures[featureIdx][docIdx]; },
+                    results
+                );
+            }
+
+            void CalcFlat(
+                TConstArrayRef<TConstArrayRef<float>> features,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                if (!CanUseJit(treeStart, treeEnd, featureInfo)) {
+                    CpuEvaluator->CalcFlat(features, treeStart, treeEnd, results, featureInfo);
+                    return;
+                }
+                for (const auto& flatFeaturesVec : features) {
+                    CB_ENSURE(
+                        flatFeaturesVec.size() >= FlatFeatureVectorExpectedSize,
+                        "insufficient flat features vector size: " << flatFeaturesVec.size()
+                            << " expected: " << FlatFeatureVectorExpectedSize
+                    );
+                }
+                CalcJit(
+                    features.size(),
+                    [&] (size_t docIdx, size_t featureIdx) { return features[docIdx][featureIdx]; },
+                    results
+                );
+            }
+
+            void CalcFlatSingle(
+                TConstArrayRef<float> features,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                CalcFlat(MakeArrayRef(&features, 1), treeStart, treeEnd, results, featureInfo);
+            }
+
+            // the compiled models have no categorical features, so catFeatures are ignored
+            void Calc(
+                TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+                TConstArrayRef<TConstArrayRef<int>> catFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                if (!CanUseJit(treeStart, treeEnd, featureInfo)) {
+                    CpuEvaluator->Calc(floatFeatures, catFeatures, treeStart, treeEnd, results, featureInfo);
+                    return;
+                }
+                CalcFlat(floatFeatures, treeStart, treeEnd, results, featureInfo);
+            }
+
+            void Calc(
+                TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+                TConstArrayRef<TConstArrayRef<TStringBuf>> catFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                if (!CanUseJit(treeStart, treeEnd, featureInfo)) {
+                    CpuEvaluator->Calc(floatFeatures, catFeatures, treeStart, treeEnd, results, featureInfo);
+                    return;
+                }
+                CalcFlat(floatFeatures, treeStart, treeEnd, results, featureInfo);
+            }
+
+            void Calc(
+                const IQuantizedData* quantizedFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<double> results
+            ) const override {
+                CpuEvaluator->Calc(quantizedFeatures, treeStart, treeEnd, results);
+            }
+
+            void CalcLeafIndexesSingle(
+                TConstArrayRef<float> floatFeatures,
+                TConstArrayRef<TStringBuf> catFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<TCalcerIndexType> indexes,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                CpuEvaluator->CalcLeafIndexesSingle(floatFeatures, catFeatures, treeStart, treeEnd, indexes, featureInfo);
+            }
+
+            void CalcLeafIndexes(
+                TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+                TConstArrayRef<TConstArrayRef<TStringBuf>> catFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<TCalcerIndexType> indexes,
+                const TFeatureLayout* featureInfo
+            ) const override {
+                CpuEvaluator->CalcLeafIndexes(floatFeatures, catFeatures, treeStart, treeEnd, indexes, featureInfo);
+            }
+
+            void CalcLeafIndexes(
+                const IQuantizedData* quantizedFeatures,
+                size_t treeStart,
+                size_t treeEnd,
+                TArrayRef<TCalcerIndexType> indexes
+            ) const override {
+                CpuEvaluator->CalcLeafIndexes(quantizedFeatures, treeStart, treeEnd, indexes);
+            }
+
+        private:
+            bool CanUseJit(size_t treeStart, size_t treeEnd, const TFeatureLayout* featureInfo) const {
+                return treeStart == 0 && treeEnd == TreeCount && !featureInfo && !HasFeatureLayout;
+            }
+
+            template <class TFeatureAccessor>
+            void CalcJit(size_t docCount, TFeatureAccessor featureAccessor, TArrayRef<double> results) const {
+                CB_ENSURE(results.size() == docCount, "`results` size is insufficient: " << LabeledOutput(results.size(), docCount));
+                TVector<float> features;
+                features.yresize(docCount * FloatFeatureCount);
+                for (auto docIdx : xrange(docCount)) {
+                    for (auto featureIdx : xrange(FloatFeatureCount)) {
+                        features[docIdx * FloatFeatureCount + featureIdx] = featureAccessor(docIdx, featureIdx);
+                    }
+                }
+                Module->ApplyBatch(features.data(), SafeIntegerCast<unsigned int>(docCount), results.data());
+
+                TEvalResultProcessor resultProcessor(docCount, results, PredictionType, 1, docCount);
+                resultProcessor.PostprocessBlock(0);
+            }
+
+        private:
+            TAtomicSharedPtr<TJitModule> Module;
+            size_t FloatFeatureCount;
+            size_t FlatFeatureVectorExpectedSize;
+            size_t TreeCount;
+            EPredictionType PredictionType = EPredictionType::RawFormulaVal;
+            bool HasFeatureLayout = false;
+            TModelEvaluatorPtr CpuEvaluator; // for everything the compiled code doesn't support
+        };
+    }
+
+    bool JitEvaluationPossible(const TFullModel& model) {
+#if defined(_unix_)
+        if (!model.IsOblivious() || model.HasCategoricalFeatures() || model.GetDimensionsCount() != 1) {
+            return false;
+        }
+        // compiled code reads float features by index, so they should coincide with flat indexes
+        for (const auto& floatFeature : model.ObliviousTrees->FloatFeatures) {
+            if (floatFeature.Position.Index != floatFeature.Position.FlatIndex) {
+                return false;
+            }
+        }
+        return true;
+#else
+        Y_UNUSED(model);
+        return false;
+#endif
+    }
+
+    TString GetJitCachedLibraryPath(const TFullModel& model) {
+        const TJitCompilerOptions options;
+        return GetLibraryPath(GetModelKey(model, options), options);
+    }
+
+    TModelEvaluatorPtr CreateJitEvaluator(const TFullModel& model) {
+        return MakeAtomicShared<TJitEvaluator>(model);
+    }
+
+    static TModelEvaluatorFactory::TRegistrator<TJitEvaluator> JitEvaluatorRegistrator(EFormulaEvaluatorType::Jit);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <catboost/libs/model/model.h>
+
+#include <util/generic/string.h>
+
+
+/* Jit evaluator (EFormulaEvaluatorType::Jit)
+ *
+ * The model is exported with the specialized Cpp exporter, compiled with the system compiler into a shared
+ *  library and loaded with dlopen. Compiled libraries are cached on disk keyed by the model checksum,
+ *  the compiler command and the catboost version, so each model is compiled only once per cache directory.
+ * The cache directory and the libraries in it are loaded only if they are owned by the current user
+ *  and are not writable by other users.
+ *
+ * Environment:
+ *  CATBOOST_JIT_CXX - compiler command, "c++" by default
+ *  CATBOOST_JIT_CXXFLAGS - compiler flags, "-O3 -march=native" by default
+ *  CATBOOST_JIT_CACHE_DIR - cache directory, <system temp dir>/catboost_jit_<uid> by default, created with mode 0700
+ *
+ * Only oblivious models with float features and a single dimension are compiled, evaluations over tree
+ *  subranges, custom feature layouts, quantized data and leaf indexes are delegated to the CPU evaluator.
+ * TFullModel::CreateEvaluator falls back to the CPU evaluator if the model can't be compiled.
+ */
+
+namespace NCB::NModelEvaluation {
+    bool JitEvaluationPossible(const TFullModel& model);
+
+    // throws if the model can't be compiled or loaded
+    TModelEvaluatorPtr CreateJitEvaluator(const TFullModel& model);
+
+    // path to the cached shared library for the model, it exists only after the model has been compiled
+    TString GetJitCachedLibraryPath(const TFullModel& model);
+}
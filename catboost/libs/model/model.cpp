@@ -570,6 +570,19 @@ void TFullModel::UpdateDynamicData() {
 NCB::NModelEvaluation::TModelEvaluatorPtr TFullModel::CreateEvaluator(EFormulaEvaluatorType evaluatorType) const {
     if (evaluatorType == EFormulaEvaluatorType::CPU) {
         return NCB::NModelEvaluation::CreateCpuEvaluator(*this);
+    } else if (evaluatorType == EFormulaEvaluatorType::Jit) {
+        using NCB::NModelEvaluation::TModelEvaluatorFactory;
+        if (!TModelEvaluatorFactory::Has(evaluatorType)) {
+            CATBOOST_WARNING_LOG << "Jit evaluator is not linked in, falling back to CPU evaluator" << Endl;
+            return NCB::NModelEvaluation::CreateCpuEvaluator(*this);
+        }
+        try {
+            return NCB::NModelEvaluation::TModelEvaluatorPtr(TModelEvaluatorFactory::Construct(evaluatorType, *this));
+        } catch (...) {
+            CATBOOST_WARNING_LOG << "Jit evaluator is unavailable for this model, falling back to CPU evaluator: "
+                << CurrentExceptionMessage() << Endl;
+            return NCB::NModelEvaluation::CreateCpuEvaluator(*this);
+        }
     } else {
         Y_ASSERT(evaluatorType == EFormulaEvaluatorType::GPU);
         return NCB::NModelEvaluation::CreateGpuEvaluator(*this);
@@ -10,6 +10,8 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/options/enums.h>
 
+#include <library/object_factory/object_factory.h>
+
 #include <util/generic/array_ref.h>
 #include <util/generic/maybe.h>
 #include <util/generic/hash.h>
@@ -360,10 +362,13 @@ private:
     mutable TMaybe<TRuntimeData> RuntimeData;
 };
 
-enum class EFormulaEvaluatorType {
-    CPU,
-    GPU
-};
+namespace NCB::NModelEvaluation {
+    // evaluators that are linked separately from the model library (Jit) register themselves here
+    using TModelEvaluatorFactory = NObjectFactory::TParametrizedObjectFactory<
+        IModelEvaluator,
+        EFormulaEvaluatorType,
+        const TFullModel&>;
+}
 
 class TCOWTreeWrapper {
 public:
@@ -5,17 +5,49 @@
 #include <catboost/libs/model/ctr_helpers.h>
 #include <catboost/libs/model/static_ctr_provider.h>
 
+#include <library/json/json_reader.h>
 #include <library/resource/resource.h>
 
 #include <util/generic/map.h>
 #include <util/generic/set.h>
+#include <util/generic/xrange.h>
 #include <util/string/builder.h>
 #include <util/string/cast.h>
 #include <util/stream/input.h>
+#include <util/stream/str.h>
 
 namespace NCB {
     using namespace NCatboostModelExportHelpers;
 
+    TCatboostModelToCppConverter::TCatboostModelToCppConverter(
+        const TString& modelFile,
+        bool addFileFormatExtension,
+        const TString& userParametersJson)
+        : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
+    {
+        if (userParametersJson.empty()) {
+            return;
+        }
+        TStringInput is(userParametersJson);
+        NJson::TJsonValue userParameters;
+        CB_ENSURE(NJson::ReadJsonTree(&is, &userParameters), "can't parse JSON user params for exporting the model to C++");
+        for (const auto& [name, value] : userParameters.GetMapSafe()) {
+            if (name == "cpp_export_mode") {
+                const TString& mode = value.GetStringSafe();
+                CB_ENSURE(
+                    mode == "generic" || mode == "specialized",
+                    "Unknown cpp_export_mode \"" << mode << "\", should be \"generic\" or \"specialized\""
+                );
+                Specialized = (mode == "specialized");
+            } else if (name == "cpp_batch_api") {
+                BatchApi = value.GetBooleanSafe();
+            } else {
+                CB_ENSURE(false, "JSON user param " << name << " for exporting the model to C++ is not supported");
+            }
+        }
+        CB_ENSURE(!BatchApi || Specialized, "cpp_batch_api is supported only for specialized cpp_export_mode");
+    }
+
     /*
      * Tiny code for case when cat features not present
      */
@@ -328,4 +360,201 @@ namespace NCB {
         Out << '\n';
         Out << NResource::Find("catboost_model_export_cpp_model_applicator");
     }
+
+    /*
+     * Specialized code for models without cat features: straight-line code for each tree
+     *  and binarization by exactly the borders used in the trees
+     */
+
+    namespace {
+        struct TSpecializedFloatFeature {
+            int FeatureIndex = 0;
+            bool NanAsTrue = false;
+            ui32 FirstBinaryFeature = 0;
+            TVector<float> Borders;
+        };
+    }
+
+    static void WriteSpecializedBinarization(
+        IOutputStream& out,
+        const TVector<TSpecializedFloatFeature>& features,
+        bool forBlock) {
+
+        TIndent indent(1);
+        for (const auto& feature : features) {
+            const TString bordersName = "BordersF" + ToString(feature.FeatureIndex);
+            if (forBlock) {
+                out << indent << "for (unsigned int doc = 0; doc < docCount; ++doc) {" << '\n';
+                out << indent << "    column[doc] = features[doc * FloatFeatureCount + " << feature.FeatureIndex << "];" << '\n';
+                out << indent << "}" << '\n';
+            }
+            out << indent++ << "for (unsigned int i = 0; i < " << feature.Borders.size() << "; ++i) {" << '\n';
+            const TString value = forBlock ? "column[doc]" : "features[" + ToString(feature.FeatureIndex) + "]";
+            const TString comparison = feature.NanAsTrue
+                ? "(" + value + " != " + value + " || " + value + " > " + bordersName + "[i])"
+                : "(" + value + " > " + bordersName + "[i])";
+            if (forBlock) {
+                out << indent++ << "for (unsigned int doc = 0; doc < docCount; ++doc) {" << '\n';
+                out << indent << "binaryFeatures[(" << feature.FirstBinaryFeature << " + i) * BlockSize + doc] = (unsigned char)" << comparison << ";" << '\n';
+                out << --indent << "}" << '\n';
+            } else {
+                out << indent << "binaryFeatures[" << feature.FirstBinaryFeature << " + i] = (unsigned char)" << comparison << ";" << '\n';
+            }
+            out << --indent << "}" << '\n';
+        }
+    }
+
+    void TCatboostModelToCppConverter::WriteSpecializedModel(const TFullModel& model) {
+        CB_ENSURE(!model.HasCategoricalFeatures(), "Specialized export of model with categorical features to cpp is not supported.");
+        CB_ENSURE(model.ObliviousTrees->ApproxDimension == 1, "Export of MultiClassification model to cpp is not supported.");
+
+        const auto& trees = *model.ObliviousTrees;
+
+        // binary features are enumerated by used float features and their borders as in TreeSplits
+        TVector<ui32> binaryFeatureToUsed;
+        TVector<std::pair<size_t, size_t>> binaryFeatureToBorder; // (used float feature, border idx)
+        TVector<const TFloatFeature*> usedFloatFeatures;
+        for (const auto& floatFeature : trees.FloatFeatures) {
+            if (!floatFeature.UsedInModel()) {
+                continue;
+            }
+            for (auto borderIdx : xrange(floatFeature.Borders.size())) {
+                binaryFeatureToBorder.emplace_back(usedFloatFeatures.size(), borderIdx);
+            }
+            usedFloatFeatures.push_back(&floatFeature);
+        }
+        TVector<bool> isBinaryFeatureUsed(binaryFeatureToBorder.size(), false);
+        for (auto split : trees.TreeSplits) {
+            isBinaryFeatureUsed[split] = true;
+        }
+
+        TVector<TSpecializedFloatFeature> specializedFeatures;
+        binaryFeatureToUsed.resize(binaryFeatureToBorder.size(), 0);
+        ui32 usedBinaryFeatureCount = 0;
+        for (auto binaryFeature : xrange(binaryFeatureToBorder.size())) {
+            if (!isBinaryFeatureUsed[binaryFeature]) {
+                continue;
+            }
+            const auto [usedFloatFeatureIdx, borderIdx] = binaryFeatureToBorder[binaryFeature];
+            const TFloatFeature& floatFeature = *usedFloatFeatures[usedFloatFeatureIdx];
+            if (specializedFeatures.empty() || specializedFeatures.back().FeatureIndex != floatFeature.Position.Index) {
+                TSpecializedFloatFeature specializedFeature;
+                specializedFeature.FeatureIndex = floatFeature.Position.Index;
+                specializedFeature.NanAsTrue = floatFeature.HasNans
+                    && (floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsTrue);
+                specializedFeature.FirstBinaryFeature = usedBinaryFeatureCount;
+                specializedFeatures.push_back(std::move(specializedFeature));
+            }
+            specializedFeatures.back().Borders.push_back(floatFeature.Borders[borderIdx]);
+            binaryFeatureToUsed[binaryFeature] = usedBinaryFeatureCount++;
+        }
+
+        Out << "/* Model data */" << '\n';
+        Out << "static const unsigned int FloatFeatureCount = " << model.GetNumFloatFeatures() << ";" << '\n';
+        Out << "static const unsigned int UsedBinaryFeatureCount = " << usedBinaryFeatureCount << ";" << '\n';
+        Out << '\n';
+        Out << "/* Borders used in the trees for each float feature */" << '\n';
+        for (const auto& feature : specializedFeatures) {
+            Out << "static const float BordersF" << feature.FeatureIndex << "[" << feature.Borders.size() << "] = {"
+                << OutputArrayInitializer([&feature] (size_t i) { return FloatToStringWithSuffix(feature.Borders[i], true); }, feature.Borders.size())
+                << "};" << '\n';
+        }
+        Out << '\n';
+        Out << "/* Aggregated array of leaf values for trees. Each tree is represented by a separate line: */" << '\n';
+        Out << "static const double LeafValues[" << trees.LeafValues.size() << "] = {" << OutputLeafValues(model, TIndent(0));
+        Out << "};" << '\n';
+        Out << '\n';
+
+        // leaf index expression of each tree, binaryFeature(usedIdx) is the access to the binarized value
+        const auto writeTrees = [&] (const TString& resultName, auto binaryFeature, TIndent indent) {
+            size_t treeSplitsOffset = 0;
+            size_t leafValuesOffset = 0;
+            for (auto treeIdx : xrange(trees.TreeSizes.size())) {
+                const int treeDepth = trees.TreeSizes[treeIdx];
+                Out << indent << resultName << " += LeafValues[" << leafValuesOffset;
+                for (auto depth : xrange(treeDepth)) {
+                    const ui32 usedBinaryFeature = binaryFeatureToUsed[trees.TreeSplits[treeSplitsOffset + depth]];
+                    Out << (depth == 0 ? " + (" : " | ") << binaryFeature(usedBinaryFeature);
+                    if (depth > 0) {
+                        Out << " << " << depth;
+                    }
+                }
+                Out << (treeDepth > 0 ? ")" : "") << "];" << '\n';
+                treeSplitsOffset += treeDepth;
+                leafValuesOffset += (size_t(1) << treeDepth);
+            }
+        };
+
+        Out << "/* Binarize features by the borders used in the trees */" << '\n';
+        Out << "static inline void BinarizeFeatures(const float* features, unsigned char* binaryFeatures) {" << '\n';
+        WriteSpecializedBinarization(Out, specializedFeatures, /*forBlock*/ false);
+        Out << "}" << '\n';
+        Out << '\n';
+        Out << "/* Sum leaf values of the trees, splits of each tree are inlined */" << '\n';
+        Out << "static inline double CalcTrees(const unsigned char* binaryFeatures) {" << '\n';
+        Out << "    double result = 0.0;" << '\n';
+        writeTrees(
+            "result",
+            [] (ui32 usedBinaryFeature) { return TStringBuilder() << "binaryFeatures[" << usedBinaryFeature << "]"; },
+            TIndent(1)
+        );
+        Out << "    return result;" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+
+        Out << "/* Model applicator */" << '\n';
+        Out << "double ApplyCatboostModel(" << '\n';
+        Out << "    const std::vector<float>& features" << '\n';
+        Out << ") {" << '\n';
+        Out << "    unsigned char binaryFeatures[" << Max<ui32>(usedBinaryFeatureCount, 1) << "];" << '\n';
+        Out << "    BinarizeFeatures(features.data(), binaryFeatures);" << '\n';
+        Out << "    return CalcTrees(binaryFeatures);" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+        Out << "double ApplyCatboostModel(" << '\n';
+        Out << "    const std::vector<float>& floatFeatures," << '\n';
+        Out << "    const std::vector<std::string>&" << '\n';
+        Out << ") {" << '\n';
+        Out << "    return ApplyCatboostModel(floatFeatures);" << '\n';
+        Out << "}" << '\n';
+
+        if (!BatchApi) {
+            return;
+        }
+
+        Out << '\n';
+        Out << "/* Block size as in the library evaluator, binary features of a block are stored as [binaryFeature][doc] */" << '\n';
+        Out << "static const unsigned int BlockSize = 128;" << '\n';
+        Out << '\n';
+        Out << "static inline void BinarizeFeaturesBlock(const float* features, unsigned int docCount, unsigned char* binaryFeatures) {" << '\n';
+        Out << "    float column[BlockSize];" << '\n';
+        WriteSpecializedBinarization(Out, specializedFeatures, /*forBlock*/ true);
+        Out << "    (void)column;" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+        Out << "static inline void CalcTreesBlock(const unsigned char* binaryFeatures, unsigned int docCount, double* result) {" << '\n';
+        Out << "    for (unsigned int doc = 0; doc < docCount; ++doc) {" << '\n';
+        Out << "        result[doc] = 0.0;" << '\n';
+        Out << "    }" << '\n';
+        Out << "    for (unsigned int doc = 0; doc < docCount; ++doc) {" << '\n';
+        writeTrees(
+            "result[doc]",
+            [] (ui32 usedBinaryFeature) {
+                return TStringBuilder() << "binaryFeatures[" << usedBinaryFeature << " * BlockSize + doc]";
+            },
+            TIndent(2)
+        );
+        Out << "    }" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+        Out << "/* Batch model applicator, features is a row-major docCount x FloatFeatureCount matrix */" << '\n';
+        Out << "void ApplyCatboostModelBatch(const float* features, unsigned int docCount, double* result) {" << '\n';
+        Out << "    std::vector<unsigned char> binaryFeatures(" << Max<ui32>(usedBinaryFeatureCount, 1) << " * BlockSize);" << '\n';
+        Out << "    for (unsigned int blockStart = 0; blockStart < docCount; blockStart += BlockSize) {" << '\n';
+        Out << "        const unsigned int blockSize = docCount - blockStart < BlockSize ? docCount - blockStart : BlockSize;" << '\n';
+        Out << "        BinarizeFeaturesBlock(features + (size_t)blockStart * FloatFeatureCount, blockSize, binaryFeatures.data());" << '\n';
+        Out << "        CalcTreesBlock(binaryFeatures.data(), blockSize, result + blockStart);" << '\n';
+        Out << "    }" << '\n';
+        Out << "}" << '\n';
+    }
 }
@@ -8,19 +8,27 @@
 
 
 namespace NCB {
+    /* JSON user params:
+     *  "cpp_export_mode": "generic" (default) - a generic evaluator over the model arrays,
+     *      "specialized" - straight-line code for each tree and binarization by exactly the used borders,
+     *      supported for models without categorical features
+     *  "cpp_batch_api": true - in "specialized" mode also emit ApplyCatboostModelBatch over a row-major
+     *      features matrix, documents are processed in blocks like in the library evaluator
+     */
     class TCatboostModelToCppConverter: public ICatboostModelExporter {
     private:
         TOFStream Out;
+        bool Specialized = false;
+        bool BatchApi = false;
 
     public:
-        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJson)
-            : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
-        {
-            CB_ENSURE(userParametersJson.empty(), "JSON user params for exporting the model to C++ are not supported");
-        };
+        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJson);
 
         void Write(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString = nullptr) override {
-            if (model.HasCategoricalFeatures()) {
+            if (Specialized) {
+                WriteHeader(/*forCatFeatures*/false);
+                WriteSpecializedModel(model);
+            } else if (model.HasCategoricalFeatures()) {
                 WriteHeader(/*forCatFeatures*/true);
                 WriteModelCatFeatures(model, catFeaturesHashToString);
                 WriteApplicatorCatFeatures();
@@ -38,5 +46,6 @@ namespace NCB {
         void WriteCTRStructs();
         void WriteModelCatFeatures(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString);
         void WriteApplicatorCatFeatures();
+        void WriteSpecializedModel(const TFullModel& model);
     };
 }
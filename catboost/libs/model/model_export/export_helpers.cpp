@@ -3,18 +3,18 @@
 #include <util/string/builder.h>
 #include <util/string/cast.h>
 
-static TString FloatToStringWithSuffix(float value, bool addFloatingSuffix) {
-    TString str = FloatToString(value, PREC_NDIGITS, 9);
-    if (addFloatingSuffix) {
-        if (int value; TryFromString<int>(str, value)) {
-            str.append('.');
+namespace NCatboostModelExportHelpers {
+    TString FloatToStringWithSuffix(float value, bool addFloatingSuffix) {
+        TString str = FloatToString(value, PREC_NDIGITS, 9);
+        if (addFloatingSuffix) {
+            if (int value; TryFromString<int>(str, value)) {
+                str.append('.');
+            }
+            str.append("f");
         }
-        str.append("f");
+        return str;
     }
-    return str;
-}
 
-namespace NCatboostModelExportHelpers {
     int GetBinaryFeatureCount(const TFullModel& model) {
         int binaryFeatureCount = 0;
         for (const auto& floatFeature : model.ObliviousTrees->FloatFeatures) {
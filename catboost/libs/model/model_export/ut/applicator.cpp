@@ -90,6 +90,11 @@ static void ParseFeatures(
 
 extern double ApplyCatboostModel(const vector<float>& floatFeatures, const vector<string>& catFeatures);
 
+#ifdef APPLY_BATCH
+// the batch API of the specialized export, supports only float features
+extern void ApplyCatboostModelBatch(const float* features, unsigned int docCount, double* result);
+#endif
+
 int main(int argc, char *argv[]) {
     assert(argc == 4);  // main.exe test.tsv cd.tsv predictions.txt
 
@@ -100,25 +105,39 @@ int main(int argc, char *argv[]) {
     sort(catColumns.begin(), catColumns.end());
 
     ifstream test(argv[1]);
-    ofstream predictions(argv[3]);
     string line;
+    vector<vector<float>> floatFeatures;
+    vector<vector<string>> catFeatures;
     for (size_t docId = 0; getline(test, line); ++docId) {
-        vector<float> floatFeatures;
-        vector<string> catFeatures;
         if (docId == 0) {
             // Column description may not mention all columns,
             // so the actual number of columns is not known up to this point.
             size_t columnCount = 1 + count(line.begin(), line.end(), DELIMITER);
             AdjustFloatColumns(columnCount, catColumns, otherColumns, &floatColumns);
         }
-        ParseFeatures(line, floatColumns, catColumns, &floatFeatures, &catFeatures);
+        floatFeatures.emplace_back();
+        catFeatures.emplace_back();
+        ParseFeatures(line, floatColumns, catColumns, &floatFeatures.back(), &catFeatures.back());
+    }
 
-        double rawFormulaVal = ApplyCatboostModel(floatFeatures, catFeatures);
+    vector<double> rawFormulaVals(floatFeatures.size());
+#ifdef APPLY_BATCH
+    assert(catColumns.empty());
+    vector<float> featuresMatrix;
+    for (const auto& docFloatFeatures : floatFeatures) {
+        featuresMatrix.insert(featuresMatrix.end(), docFloatFeatures.begin(), docFloatFeatures.end());
+    }
+    ApplyCatboostModelBatch(featuresMatrix.data(), floatFeatures.size(), rawFormulaVals.data());
+#else
+    for (size_t docId = 0; docId < floatFeatures.size(); ++docId) {
+        rawFormulaVals[docId] = ApplyCatboostModel(floatFeatures[docId], catFeatures[docId]);
+    }
+#endif
 
-        if (docId == 0) {
-            predictions << "DocId" << DELIMITER << "RawFormulaVal" << endl;
-        }
-        predictions << docId << DELIMITER << rawFormulaVal << endl;
+    ofstream predictions(argv[3]);
+    predictions << "DocId" << DELIMITER << "RawFormulaVal" << endl;
+    for (size_t docId = 0; docId < rawFormulaVals.size(); ++docId) {
+        predictions << docId << DELIMITER << rawFormulaVals[docId] << endl;
     }
 
     return 0;
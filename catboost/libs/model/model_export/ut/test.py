@@ -103,6 +103,62 @@ def test_cpp_export(dataset):
             raise
 
 
+@pytest.mark.parametrize('batch_api', [False, True], ids=['batch_api=False', 'batch_api=True'])
+def test_cpp_export_specialized(batch_api):
+    train_pool, _ = _get_train_test_pool('higgs')
+    _, test_path, cd_path = _get_train_test_cd_path('higgs')
+
+    model = CatBoost({'iterations': 100, 'random_seed': 1234, 'loss_function': 'Logloss'})
+    model.fit(train_pool)
+    model_cbm = yatest.common.test_output_path('model.bin')
+    model.save_model(model_cbm)
+    model_cpp = yatest.common.test_output_path('model.cpp')
+    model.save_model(
+        model_cpp,
+        format='cpp',
+        export_parameters={'cpp_export_mode': 'specialized', 'cpp_batch_api': batch_api}
+    )
+
+    applicator_cpp = yatest.common.source_path('catboost/libs/model/model_export/ut/applicator.cpp')
+    applicator_exe = yatest.common.test_output_path('applicator.exe')
+    predictions_by_catboost_path = yatest.common.test_output_path('predictions_by_catboost.txt')
+    predictions_path = yatest.common.test_output_path('predictions.txt')
+
+    if os.name == 'posix':
+        compile_cmd = ['g++', '-std=c++14', '-O2', '-o', applicator_exe]
+        if batch_api:
+            compile_cmd += ['-DAPPLY_BATCH']
+    else:
+        compile_cmd = ['cl.exe', '-Fe' + applicator_exe]
+        if batch_api:
+            compile_cmd += ['-DAPPLY_BATCH']
+    compile_cmd += [applicator_cpp, model_cpp]
+    apply_cmd = [applicator_exe, test_path, cd_path, predictions_path]
+    calc_cmd = [CATBOOST_APP_PATH, 'calc',
+                '-m', model_cbm,
+                '--input-path', test_path,
+                '--cd', cd_path,
+                '--output-path', predictions_by_catboost_path,
+                ]
+    compare_cmd = [APPROXIMATE_DIFF_PATH,
+                   '--have-header',
+                   '--diff-limit', '1e-6',
+                   predictions_path,
+                   predictions_by_catboost_path,
+                   ]
+
+    try:
+        yatest.common.execute(compile_cmd)
+        yatest.common.execute(apply_cmd)
+        yatest.common.execute(calc_cmd)
+        yatest.common.execute(compare_cmd)
+    except OSError as e:
+        if re.search(r"No such file or directory.*'{}'".format(re.escape(compile_cmd[0])), str(e)):
+            pytest.xfail(reason='We ignore `compiler not found` error: {}\n'.format(str(e)))
+        else:
+            raise
+
+
 def _predict_python(test_pool, apply_catboost_model):
     pred_python = []
     cat_feature_indices = test_pool.get_cat_feature_indices()
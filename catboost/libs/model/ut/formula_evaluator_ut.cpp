@@ -2,11 +2,16 @@
 
 #include <catboost/libs/data_new/data_provider_builders.h>
 #include <catboost/libs/model/cpu/evaluator.h>
+#include <catboost/libs/model/jit/jit_evaluator.h>
 #include <catboost/libs/model/model.h>
 #include <catboost/libs/train_lib/train_model.h>
 
 #include <library/unittest/registar.h>
 
+#include <util/system/env.h>
+#include <util/system/fs.h>
+#include <util/system/shellcommand.h>
+
 using namespace NCB;
 using namespace NCB::NModelEvaluation;
 
@@ -154,6 +159,46 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         };
         UNIT_ASSERT_NO_EXCEPTION(applyBatch());
     }
+
+    Y_UNIT_TEST(TestJitEvaluator) {
+        // passes both with the compiled model and with the fallback to the CPU evaluator
+        auto model = SimpleFloatModel(2);
+        TVector<double> expectedPredicts(FLOAT_FEATURES.size());
+        model.CalcFlat(FLOAT_FEATURES, expectedPredicts);
+
+        model.SetEvaluatorType(EFormulaEvaluatorType::Jit);
+        TVector<double> predicts(FLOAT_FEATURES.size());
+        model.CalcFlat(FLOAT_FEATURES, predicts);
+        UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+
+        TVector<double> singlePredict(1);
+        model.CalcFlatSingle(FLOAT_FEATURES[3], singlePredict);
+        UNIT_ASSERT_EQUAL(expectedPredicts[3], singlePredict[0]);
+    }
+
+    Y_UNIT_TEST(TestJitEvaluatorIsUsed) {
+        auto model = SimpleFloatModel(2);
+        UNIT_ASSERT(JitEvaluationPossible(model));
+        TShellCommand compilerCheck(GetEnv("CATBOOST_JIT_CXX", "c++"), {"--version"});
+        compilerCheck.Run();
+        if (compilerCheck.GetStatus() != TShellCommand::SHELL_FINISHED || compilerCheck.GetExitCode() != 0) {
+            return; // no compiler, fallback to the CPU evaluator is checked in TestJitEvaluator
+        }
+
+        // throws instead of falling back if the model can't be compiled or loaded
+        const auto jitEvaluator = CreateJitEvaluator(model);
+        UNIT_ASSERT(NFs::Exists(GetJitCachedLibraryPath(model)));
+
+        TVector<double> expectedPredicts(FLOAT_FEATURES.size());
+        model.CalcFlat(FLOAT_FEATURES, expectedPredicts);
+        TVector<double> predicts(FLOAT_FEATURES.size());
+        jitEvaluator->CalcFlat(FLOAT_FEATURES, predicts);
+        UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+
+        TVector<float> shortRow(FLOAT_FEATURES[0].begin(), FLOAT_FEATURES[0].end() - 1);
+        TVector<double> singlePredict(1);
+        UNIT_ASSERT_EXCEPTION(jitEvaluator->CalcFlatSingle(shortRow, singlePredict), TCatBoostException);
+    }
 }
 
 Y_UNIT_TEST_SUITE(TNonSymmetricTreeModel) {
@@ -0,0 +1,47 @@
+#include "random_model.h"
+
+#include <catboost/libs/model/model_build_helper.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+namespace NCB {
+    namespace NModelUT {
+
+    TFullModel BuildRandomModel(size_t featureCount, size_t borderCount, size_t treeCount, size_t treeDepth, ui64 seed) {
+        TFastRng64 rng(seed);
+        TVector<TFloatFeature> floatFeatures;
+        for (auto featureIdx : xrange(featureCount)) {
+            TVector<float> borders;
+            for (auto borderIdx : xrange(borderCount)) {
+                borders.push_back(float(borderIdx + 1) / (borderCount + 1));
+            }
+            floatFeatures.emplace_back(false, featureIdx, featureIdx, borders);
+        }
+
+        TObliviousTreeBuilder builder(floatFeatures, {}, 1);
+        for (auto treeIdx : xrange(treeCount)) {
+            Y_UNUSED(treeIdx);
+            TVector<TModelSplit> splits;
+            for (auto depth : xrange(treeDepth)) {
+                Y_UNUSED(depth);
+                const int featureIdx = rng.Uniform(featureCount);
+                splits.emplace_back(TFloatSplit(featureIdx, floatFeatures[featureIdx].Borders[rng.Uniform(borderCount)]));
+            }
+            TVector<double> leafValues;
+            for (auto leafIdx : xrange(1 << treeDepth)) {
+                Y_UNUSED(leafIdx);
+                leafValues.push_back(rng.GenRandReal1() - 0.5);
+            }
+            builder.AddTree(splits, leafValues, {});
+        }
+        TFullModel model;
+        builder.Build(model.ObliviousTrees.GetMutable());
+        model.UpdateDynamicData();
+        return model;
+    }
+
+    }
+}
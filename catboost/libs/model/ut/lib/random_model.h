@@ -0,0 +1,17 @@
+#pragma once
+
+#include <catboost/libs/model/model.h>
+
+#include <util/system/types.h>
+
+
+namespace NCB {
+    namespace NModelUT {
+
+    /* Random oblivious model over featureCount float features with borderCount uniform borders in (0, 1) each.
+     * The model is the same for the same arguments, so that different evaluators and builds apply identical models.
+     */
+    TFullModel BuildRandomModel(size_t featureCount, size_t borderCount, size_t treeCount, size_t treeDepth, ui64 seed = 42);
+
+    }
+}
@@ -150,7 +150,7 @@ EXPORT bool CalcModelPredictionWithHashedCatFeatures(ModelCalcerHandle* modelHan
 }
 
 EXPORT int GetStringCatFeatureHash(const char* data, size_t size) {
-    return CalcCatFeatureHash(TStringBuf(data, size));
+    return CalcCatFeatureHashCached(TStringBuf(data, size));
 }
 
 EXPORT int GetIntegerCatFeatureHash(long long val) {
@@ -18,6 +18,7 @@ namespace NCB {
         TString ModelFileName;
         EModelType ModelFormat = EModelType::CatboostBinary;
         NCB::TPathWithScheme OutputPath;
+        EEvalOutputFloatType OutputFloatType = EEvalOutputFloatType::Float64; // for binary and columnar output
 
         int Verbose;
 
@@ -31,6 +32,8 @@ namespace NCB {
 
         NCB::TPathWithScheme PairsFilePath;
 
+        TString TraceFilePath; // Chrome trace output (for calc mode), not written if empty
+
         void BindParserOpts(NLastGetopt::TOpts& parser);
     };
 
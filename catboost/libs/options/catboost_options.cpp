@@ -730,6 +730,12 @@ ui32 NCatboostOptions::GetThreadCount(const NJson::TJsonValue& source) {
     return threadCount.Get();
 }
 
+bool NCatboostOptions::GetNumaLocalPlacement(const NJson::TJsonValue& source) {
+    TOption<bool> numaLocalPlacement("numa_local_placement", false);
+    TJsonFieldHelper<decltype(numaLocalPlacement)>::Read(source["system_options"], &numaLocalPlacement);
+    return numaLocalPlacement.Get();
+}
+
 NCatboostOptions::TCatBoostOptions NCatboostOptions::LoadOptions(const NJson::TJsonValue& source) {
     //little hack. JSON parsing needs to known device_type
     TCatBoostOptions options(GetTaskType(source));
@@ -80,6 +80,8 @@ namespace NCatboostOptions {
 
     ui32 GetThreadCount(const NJson::TJsonValue& source);
 
+    bool GetNumaLocalPlacement(const NJson::TJsonValue& source);
+
     TCatBoostOptions LoadOptions(const NJson::TJsonValue& source);
 
     bool IsParamsCompatible(TStringBuf firstSerializedParams, TStringBuf secondSerializedParams);
@@ -21,6 +21,10 @@ struct TCrossValidationParams : public TSplitParams {
     double MaxTimeSpentOnFixedCostRatio = 0.05;
     ui32 DevMaxIterationsBatchSize = 100000; // useful primarily for tests
 
+    // CPU folds trained at the same time, 0 - limited by thread count and used_ram_limit only,
+    //  1 - folds are trained one after another
+    ui32 MaxConcurrentFoldCount = 0;
+
 public:
     bool Initialized() const {
         return FoldCount != 0;
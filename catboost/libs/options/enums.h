@@ -222,7 +222,8 @@ enum class EFstrType {
     InternalFeatureImportance,
     Interaction,
     InternalInteraction,
-    ShapValues
+    ShapValues,
+    ShapInteractionValues
 };
 
 enum class EPreCalcShapValues {
@@ -315,6 +316,11 @@ enum class ETokenizerType {
     UserDefined
 };
 
+enum class EEvalOutputFloatType {
+    Float32,
+    Float64
+};
+
 namespace NCB {
     enum class EFeatureEvalMode {
         OneVsNone,
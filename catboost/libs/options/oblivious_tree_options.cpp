@@ -20,6 +20,7 @@ NCatboostOptions::TObliviousTreeLearnerOptions::TObliviousTreeLearnerOptions(ETa
       , ModelSizeReg("model_size_reg", 0.5, taskType)
       , DevScoreCalcObjBlockSize("dev_score_calc_obj_block_size", 5000000, taskType)
       , DevExclusiveFeaturesBundleMaxBuckets("dev_efb_max_buckets", 1 << 10, taskType)
+      , DevExclusiveFeaturesBundleConflictsSampleSize("dev_efb_conflicts_sample_size", 0, taskType)
       , SparseFeaturesConflictFraction("sparse_features_conflict_fraction", 0.0f, taskType)
       , ObservationsToBootstrap("observations_to_bootstrap", EObservationsToBootstrap::TestOnly, taskType) //it's specific for fold-based scheme, so here and not in bootstrap options
       , FoldSizeLossNormalization("fold_size_loss_normalization", false, taskType)
@@ -55,6 +56,7 @@ void NCatboostOptions::TObliviousTreeLearnerOptions::Load(const NJson::TJsonValu
             &SamplingFrequency,
             &DevScoreCalcObjBlockSize,
             &DevExclusiveFeaturesBundleMaxBuckets,
+            &DevExclusiveFeaturesBundleConflictsSampleSize,
             &SparseFeaturesConflictFraction,
             &GrowPolicy,
             &MaxLeaves,
@@ -75,6 +77,7 @@ void NCatboostOptions::TObliviousTreeLearnerOptions::Save(NJson::TJsonValue* opt
             MaxCtrComplexityForBordersCaching, Rsm, ObservationsToBootstrap, SamplingFrequency,
             DevScoreCalcObjBlockSize,
             DevExclusiveFeaturesBundleMaxBuckets,
+            DevExclusiveFeaturesBundleConflictsSampleSize,
             SparseFeaturesConflictFraction,
             GrowPolicy,
             MaxLeaves,
@@ -88,15 +91,16 @@ bool NCatboostOptions::TObliviousTreeLearnerOptions::operator==(const TOblivious
             BootstrapConfig, Rsm, SamplingFrequency, ObservationsToBootstrap, FoldSizeLossNormalization,
             AddRidgeToTargetFunctionFlag, ScoreFunction, MaxCtrComplexityForBordersCaching,
             PairwiseNonDiagReg, LeavesEstimationBacktrackingType, DevScoreCalcObjBlockSize,
-            DevExclusiveFeaturesBundleMaxBuckets, SparseFeaturesConflictFraction,
-            GrowPolicy, MaxLeaves, MinDataInLeaf, MonotoneConstraints
+            DevExclusiveFeaturesBundleMaxBuckets, DevExclusiveFeaturesBundleConflictsSampleSize,
+            SparseFeaturesConflictFraction, GrowPolicy, MaxLeaves, MinDataInLeaf, MonotoneConstraints
             ) ==
         std::tie(rhs.MaxDepth, rhs.LeavesEstimationIterations, rhs.LeavesEstimationMethod, rhs.L2Reg, rhs.ModelSizeReg,
                 rhs.RandomStrength, rhs.BootstrapConfig, rhs.Rsm, rhs.SamplingFrequency,
                 rhs.ObservationsToBootstrap, rhs.FoldSizeLossNormalization, rhs.AddRidgeToTargetFunctionFlag,
                 rhs.ScoreFunction, rhs.MaxCtrComplexityForBordersCaching, rhs.PairwiseNonDiagReg, rhs.LeavesEstimationBacktrackingType,
                 rhs.DevScoreCalcObjBlockSize,
-                rhs.DevExclusiveFeaturesBundleMaxBuckets, rhs.SparseFeaturesConflictFraction,
+                rhs.DevExclusiveFeaturesBundleMaxBuckets, rhs.DevExclusiveFeaturesBundleConflictsSampleSize,
+                rhs.SparseFeaturesConflictFraction,
                 rhs.GrowPolicy, rhs.MaxLeaves, rhs.MinDataInLeaf, rhs.MonotoneConstraints);
 }
 
@@ -39,6 +39,8 @@ namespace NCatboostOptions {
         TCpuOnlyOption<ui32> DevScoreCalcObjBlockSize;
 
         TCpuOnlyOption<ui32> DevExclusiveFeaturesBundleMaxBuckets;
+        // 0 means that features conflicts are calculated using all objects
+        TCpuOnlyOption<ui32> DevExclusiveFeaturesBundleConflictsSampleSize;
         TCpuOnlyOption<float> SparseFeaturesConflictFraction;
 
         TGpuOnlyOption<EObservationsToBootstrap> ObservationsToBootstrap;
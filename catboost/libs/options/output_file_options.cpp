@@ -87,7 +87,8 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , MetricPeriod("metric_period", 1)
     , PredictionTypes("prediction_type", {EPredictionType::RawFormulaVal})
     , OutputColumns("output_columns", {"SampleId", "RawFormulaVal", "Label"})
-    , RocOutputPath("roc_file", "") {
+    , RocOutputPath("roc_file", "")
+    , TraceFileName("trace_file", "") {
 }
 
 const TString& NCatboostOptions::TOutputFilesOptions::GetTrainDir() const {
@@ -109,6 +110,14 @@ TString NCatboostOptions::TOutputFilesOptions::CreateOutputBordersFullPath() con
 bool NCatboostOptions::TOutputFilesOptions::NeedSaveBorders() const {
     return OutputBordersFileName.IsSet();
 }
+
+TString NCatboostOptions::TOutputFilesOptions::CreateTraceFullPath() const {
+    return GetFullPath(TraceFileName.Get());
+}
+
+bool NCatboostOptions::TOutputFilesOptions::NeedSaveTrace() const {
+    return !TraceFileName.Get().empty() && AllowWriteFiles();
+}
 //local
 const TString& NCatboostOptions::TOutputFilesOptions::GetLearnErrorFilename() const {
     return LearnErrorLogPath.Get();
@@ -251,7 +260,7 @@ bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions
             TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, FstrRegularFileName, FstrInternalFileName, FstrType,
-            TrainingOptionsFileName, OutputBordersFileName, RocOutputPath
+            TrainingOptionsFileName, OutputBordersFileName, RocOutputPath, TraceFileName
             ) == std::tie(
                 rhs.TrainDir, rhs.Name, rhs.JsonLogPath, rhs.ProfileLogPath,
                 rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
@@ -259,7 +268,7 @@ bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions
                 rhs.FinalCtrComputationMode, rhs.UseBestModel, rhs.BestModelMinTrees,
                 rhs.SnapshotSaveIntervalSeconds, rhs.EvalFileName, rhs.FstrRegularFileName,
                 rhs.FstrInternalFileName, rhs.FstrType, rhs.TrainingOptionsFileName, rhs.OutputBordersFileName,
-                rhs.RocOutputPath
+                rhs.RocOutputPath, rhs.TraceFileName
                 );
 }
 
@@ -275,7 +284,7 @@ void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& option
             &SaveSnapshotFlag, &AllowWriteFilesFlag, &FinalCtrComputationMode, &UseBestModel,
             &BestModelMinTrees, &SnapshotSaveIntervalSeconds, &EvalFileName, &OutputColumns,
             &FstrRegularFileName, &FstrInternalFileName, &FstrType, &TrainingOptionsFileName, &MetricPeriod,
-            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath
+            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath, &TraceFileName
             );
     if (!VerbosePeriod.IsSet() || VerbosePeriod.Get() == 1) {
         VerbosePeriod.Set(MetricPeriod.Get());
@@ -291,7 +300,7 @@ void NCatboostOptions::TOutputFilesOptions::Save(NJson::TJsonValue* options) con
             AllowWriteFilesFlag, FinalCtrComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, OutputColumns, FstrRegularFileName,
             FstrInternalFileName, FstrType, TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes,
-            OutputBordersFileName, RocOutputPath
+            OutputBordersFileName, RocOutputPath, TraceFileName
             );
 }
 
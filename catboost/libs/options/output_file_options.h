@@ -37,6 +37,11 @@ namespace NCatboostOptions {
 
         bool NeedSaveBorders() const;
 
+        // Chrome trace (chrome://tracing) of data loading and training stages
+        TString CreateTraceFullPath() const;
+
+        bool NeedSaveTrace() const;
+
         //local
         const TString& GetLearnErrorFilename() const;
 
@@ -146,5 +151,6 @@ namespace NCatboostOptions {
         TOption<TVector<EPredictionType>> PredictionTypes;
         TOption<TVector<TString>> OutputColumns;
         TOption<TString> RocOutputPath;
+        TOption<TString> TraceFileName;
     };
 }
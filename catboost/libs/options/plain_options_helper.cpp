@@ -348,6 +348,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "model_format",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "output_borders",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "roc_file",  &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "trace_file",  &outputFilesJson, &seenKeys);
 
 
     //boosting options
@@ -384,6 +385,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "model_size_reg", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "dev_score_calc_obj_block_size", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "dev_efb_max_buckets", &treeOptions, &seenKeys);
+    CopyOption(plainOptions, "dev_efb_conflicts_sample_size", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "sparse_features_conflict_fraction", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "random_strength", &treeOptions, &seenKeys);
     CopyOption(plainOptions, "leaf_estimation_method", &treeOptions, &seenKeys);
@@ -489,6 +491,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "node_type", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "node_port", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "file_with_hosts", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "numa_local_placement", &systemOptions, &seenKeys);
 
 
     //rest
@@ -583,6 +586,7 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "model_format");
     DeleteSeenOption(&outputoptionsCopy, "output_borders");
     DeleteSeenOption(&outputoptionsCopy, "roc_file");
+    DeleteSeenOption(&outputoptionsCopy, "trace_file");
     CB_ENSURE(outputoptionsCopy.GetMapSafe().empty(), "some output_options keys missed");
 
     // boosting options
@@ -669,6 +673,8 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
 
         DeleteSeenOption(&optionsCopyTree, "dev_efb_max_buckets");
 
+        DeleteSeenOption(&optionsCopyTree, "dev_efb_conflicts_sample_size");
+
         CopyOption(treeOptions, "sparse_features_conflict_fraction", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopyTree, "sparse_features_conflict_fraction");
 
@@ -896,6 +902,9 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(systemOptions, "file_with_hosts", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopySystemOptions, "file_with_hosts");
 
+        CopyOption(systemOptions, "numa_local_placement", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "numa_local_placement");
+
         CB_ENSURE(optionsCopySystemOptions.GetMapSafe().empty(), "some system options keys missed");
         DeleteSeenOption(&optionsCopy, "system_options");
     }
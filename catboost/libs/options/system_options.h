@@ -30,6 +30,9 @@ namespace NCatboostOptions {
         TCpuOnlyOption<TString> FileWithHosts;
         TCpuOnlyOption<ui32> NodePort;
 
+        // place training data on the NUMA nodes of the threads that process it and pin the threads
+        TCpuOnlyOption<bool> NumaLocalPlacement;
+
         static ui32 GetUnusedNodePort() { return 0; }
         bool IsMaster() const;
         bool IsSingleHost() const;
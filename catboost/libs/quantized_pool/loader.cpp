@@ -12,6 +12,7 @@
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/quantization_schema/serialization.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/deque.h>
 #include <util/generic/mapfindptr.h>
@@ -39,7 +40,7 @@ using NCB::TUnalignedArrayBuf;
 
 NCB::TCBQuantizedDataLoader::TCBQuantizedDataLoader(TDatasetLoaderPullArgs&& args)
     : ObjectCount(0) // inited later
-    , QuantizedPool(std::forward<TQuantizedPool>(LoadQuantizedPool(args.PoolPath, GetLoadParameters(args.CommonArgs.DatasetSubset))))
+    , QuantizedPool(std::forward<TQuantizedPool>(LoadQuantizedPool(args.PoolPath, GetLoadParameters(args.CommonArgs.DatasetSubset, args.CommonArgs.LocalExecutor))))
     , PairsPath(args.CommonArgs.PairsFilePath)
     , GroupWeightsPath(args.CommonArgs.GroupWeightsFilePath)
     , BaselinePath(args.CommonArgs.BaselineFilePath)
@@ -146,6 +147,13 @@ void TSequentialChunkEvictor::MaybeEvict(const bool force) noexcept {
     Evicted_ = true;
 }
 
+static bool IsMappedChunk(const TQuantizedPool& pool, const TChunkRef& chunk) {
+    const auto* const data = reinterpret_cast<const char*>(chunk.Description->Chunk->Quants()->data());
+    return AnyOf(pool.Blobs, [data](const TBlob& blob) {
+        return blob.AsCharPtr() <= data && data < blob.AsCharPtr() + blob.Size();
+    });
+}
+
 static TDeque<TChunkRef> GatherAndSortChunks(const TQuantizedPool& pool) {
     TDeque<TChunkRef> chunks;
     for (const auto [columnIdx, localIdx] : pool.ColumnIndexToLocalIndex) {
@@ -316,7 +324,7 @@ void NCB::TCBQuantizedDataLoader::Do(IQuantizedFeaturesDataVisitor* visitor) {
     TSequentialChunkEvictor evictor(1ULL << 24);
     CATBOOST_DEBUG_LOG << "Number of chunks to process " << chunkRefs.size() << Endl;
     for (const auto chunkRef : chunkRefs) {
-        if (QuantizedPool.ChunkStorage.empty()) { // reading from mapped file
+        if (IsMappedChunk(QuantizedPool, chunkRef)) { // decompressed chunks are in ChunkStorage
             evictor.Push(chunkRef);
         }
         Y_DEFER { evictor.MaybeEvict(); };
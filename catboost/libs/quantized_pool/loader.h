@@ -33,8 +33,11 @@ namespace NCB {
         TConstArrayRef<ui8> ClipByDatasetSubset(const TQuantizedPool::TChunkDescription& chunk) const;
         ui32 GetDatasetOffset(const TQuantizedPool::TChunkDescription& chunk) const;
 
-        static TLoadQuantizedPoolParameters GetLoadParameters(NCB::TDatasetSubset loadSubset) {
-            return {/*LockMemory*/ false, /*Precharge*/ false, loadSubset};
+        static TLoadQuantizedPoolParameters GetLoadParameters(
+            NCB::TDatasetSubset loadSubset,
+            NPar::TLocalExecutor* localExecutor) {
+
+            return {/*LockMemory*/ false, /*Precharge*/ false, loadSubset, localExecutor};
         }
 
     private:
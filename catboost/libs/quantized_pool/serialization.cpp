@@ -11,16 +11,22 @@
 
 #include <contrib/libs/flatbuffers/include/flatbuffers/flatbuffers.h>
 
+#include <library/blockcodecs/codecs.h>
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/digest/numeric.h>
 #include <util/folder/path.h>
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/array_size.h>
+#include <util/generic/buffer.h>
+#include <util/generic/cast.h>
 #include <util/generic/deque.h>
 #include <util/generic/strbuf.h>
 #include <util/generic/string.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
 #include <util/memory/blob.h>
 #include <util/stream/file.h>
 #include <util/stream/input.h>
@@ -42,6 +48,10 @@ static const char MagicEnd[] = "CatboostQuantizedPoolEnd";
 static const size_t MagicEndSize = Y_ARRAY_SIZE(MagicEnd);  // yes, with terminating zero
 static const ui32 Version = 1;
 static const ui32 VersionHash = IntHash(Version);
+// Same as `Version` but chunk may be compressed with codec which name is stored in header metainfo
+// and chunk infos also contain uncompressed chunk size.
+static const ui32 CompressedChunksVersion = 2;
+static const ui32 CompressedChunksVersionHash = IntHash(CompressedChunksVersion);
 
 template <typename T>
 static TDeque<ui32> CollectAndSortKeys(const T& m) {
@@ -101,22 +111,31 @@ namespace {
         ui64 Offset = 0;
         ui32 DocumentOffset = 0;
         ui32 DocumentsInChunkCount = 0;
+        ui32 UncompressedSize = 0;
 
         TChunkInfo() = default;
-        TChunkInfo(ui32 size, ui64 offset, ui32 documentOffset, ui32 documentsInChunkCount)
+        TChunkInfo(ui32 size, ui64 offset, ui32 documentOffset, ui32 documentsInChunkCount, ui32 uncompressedSize)
             : Size(size)
             , Offset(offset)
             , DocumentOffset(documentOffset)
-            , DocumentsInChunkCount(documentsInChunkCount) {
+            , DocumentsInChunkCount(documentsInChunkCount)
+            , UncompressedSize(uncompressedSize) {
+        }
+
+        // Writer stores chunk compressed only if it makes chunk strictly smaller.
+        bool IsCompressed() const {
+            return Size < UncompressedSize;
         }
     };
 }
 
 static void WriteChunk(
     const NCB::TQuantizedPool::TChunkDescription& chunk,
+    const NBlockCodecs::ICodec* const codec,
     TCountingOutput* const output,
     TDeque<TChunkInfo>* const chunkInfos,
-    flatbuffers::FlatBufferBuilder* const builder) {
+    flatbuffers::FlatBufferBuilder* const builder,
+    TBuffer* const compressed) {
 
     builder->Clear();
 
@@ -131,22 +150,40 @@ static void WriteChunk(
     AddPadding(16, output);
 
     const auto chunkOffset = output->Counter();
-    output->Write(builder->GetBufferPointer(), builder->GetSize());
+    const TConstArrayRef<char> uncompressed(
+        reinterpret_cast<const char*>(builder->GetBufferPointer()),
+        builder->GetSize());
+    if (codec) {
+        compressed->Clear();
+        codec->Encode(uncompressed, *compressed);
+    }
 
-    chunkInfos->emplace_back(builder->GetSize(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount);
+    if (codec && compressed->Size() < uncompressed.size()) {
+        output->Write(compressed->Data(), compressed->Size());
+        chunkInfos->emplace_back(compressed->Size(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount, uncompressed.size());
+    } else {
+        output->Write(uncompressed.data(), uncompressed.size());
+        chunkInfos->emplace_back(uncompressed.size(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount, uncompressed.size());
+    }
 }
 
-static void WriteHeader(TCountingOutput* const output) {
+static void WriteHeader(const TStringBuf chunkCodec, TCountingOutput* const output) {
     output->Write(Magic, MagicSize);
-    WriteLittleEndian(Version, output);
-    WriteLittleEndian(VersionHash, output);
+    if (chunkCodec) {
+        WriteLittleEndian(CompressedChunksVersion, output);
+        WriteLittleEndian(CompressedChunksVersionHash, output);
+    } else {
+        WriteLittleEndian(Version, output);
+        WriteLittleEndian(VersionHash, output);
+    }
 
-    const ui32 metainfoSize = 0;
+    const ui32 metainfoSize = chunkCodec.size();
     WriteLittleEndian(metainfoSize, output);
 
     AddPadding(16, output);
 
     // we may add some metainfo here
+    output->Write(chunkCodec.data(), chunkCodec.size());
 }
 
 static TPoolMetainfo MakePoolMetainfo(
@@ -224,10 +261,18 @@ static TPoolMetainfo MakePoolMetainfo(
     return metainfo;
 }
 
-static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave) {
+static void WriteAsOneFile(
+    const NCB::TQuantizedPool& pool,
+    const NCB::TSaveQuantizedPoolParameters& params,
+    IOutputStream* slave) {
+
+    const NBlockCodecs::ICodec* const codec = params.ChunkCodec
+        ? NBlockCodecs::Codec(params.ChunkCodec)
+        : nullptr;
+
     TCountingOutput output(slave);
 
-    WriteHeader(&output);
+    WriteHeader(params.ChunkCodec, &output);
 
     const auto chunksOffset = output.Counter();
 
@@ -236,11 +281,12 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     perFeatureChunkInfos.resize(pool.ColumnIndexToLocalIndex.size());
     {
         flatbuffers::FlatBufferBuilder builder;
+        TBuffer compressed;
         for (const auto trueFeatureIndex : sortedTrueFeatureIndices) {
             const auto localIndex = pool.ColumnIndexToLocalIndex.at(trueFeatureIndex);
             auto* const chunkInfos = &perFeatureChunkInfos[localIndex];
             for (const auto& chunk : pool.Chunks[localIndex]) {
-                WriteChunk(chunk, &output, chunkInfos, &builder);
+                WriteChunk(chunk, codec, &output, chunkInfos, &builder, &compressed);
             }
         }
     }
@@ -277,6 +323,9 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
             WriteLittleEndian(chunkInfo.Offset, &output);
             WriteLittleEndian(chunkInfo.DocumentOffset, &output);
             WriteLittleEndian(chunkInfo.DocumentsInChunkCount, &output);
+            if (codec) {
+                WriteLittleEndian(chunkInfo.UncompressedSize, &output);
+            }
         }
     }
 
@@ -288,7 +337,15 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
 }
 
 void NCB::SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* const output) {
-    WriteAsOneFile(pool, output);
+    WriteAsOneFile(pool, TSaveQuantizedPoolParameters(), output);
+}
+
+void NCB::SaveQuantizedPool(
+    const TQuantizedPool& pool,
+    const TSaveQuantizedPoolParameters& params,
+    IOutputStream* const output) {
+
+    WriteAsOneFile(pool, params, output);
 }
 
 static void ValidatePoolPart(const TConstArrayRef<char> blob) {
@@ -296,27 +353,44 @@ static void ValidatePoolPart(const TConstArrayRef<char> blob) {
     (void)blob;
 }
 
-static void ReadHeader(TCountingInput* const input) {
+namespace {
+    struct THeader {
+        ui32 Version = 0;
+        TString ChunkCodec;
+    };
+}
+
+static THeader ReadHeader(TCountingInput* const input) {
     char magic[MagicSize];
     const auto magicSize = input->Load(magic, MagicSize);
     CB_ENSURE(MagicSize == magicSize);
     CB_ENSURE(!std::memcmp(magic, Magic, MagicSize));
 
-    ui32 version;
-    ReadLittleEndian(&version, input);
-    CB_ENSURE(Version == version);
+    THeader header;
+    ReadLittleEndian(&header.Version, input);
+    CB_ENSURE(
+        Version == header.Version || CompressedChunksVersion == header.Version,
+        "Unsupported quantized pool format version " << header.Version);
 
     ui32 versionHash;
     ReadLittleEndian(&versionHash, input);
-    CB_ENSURE(VersionHash == versionHash);
+    CB_ENSURE(IntHash(header.Version) == versionHash);
 
     ui32 metainfoSize;
     ReadLittleEndian(&metainfoSize, input);
 
     SkipPadding(16, input);
 
-    const auto metainfoBytesSkipped = input->Skip(metainfoSize);
-    CB_ENSURE(metainfoSize == metainfoBytesSkipped);
+    if (header.Version == CompressedChunksVersion) {
+        header.ChunkCodec.resize(metainfoSize);
+        const auto metainfoBytesRead = input->Load(header.ChunkCodec.begin(), metainfoSize);
+        CB_ENSURE(metainfoSize == metainfoBytesRead);
+    } else {
+        const auto metainfoBytesSkipped = input->Skip(metainfoSize);
+        CB_ENSURE(metainfoSize == metainfoBytesSkipped);
+    }
+
+    return header;
 }
 
 template <typename T>
@@ -493,15 +567,24 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
 
     ValidatePoolPart(blob);
 
-    const auto chunksOffsetByReading = [blob] {
+    THeader header;
+    const auto chunksOffsetByReading = [blob, &header] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        header = ReadHeader(&input);
         return input.Counter();
     }();
     const auto epilogOffsets = ReadEpilogOffsets(blob);
     CB_ENSURE(chunksOffsetByReading == epilogOffsets.ChunksOffset);
 
+    const NBlockCodecs::ICodec* const codec = header.ChunkCodec
+        ? NBlockCodecs::Codec(header.ChunkCodec)
+        : nullptr;
+
+    // Compressed chunks are decompressed into `pool.ChunkStorage` after reading chunk infos, while
+    // uncompressed ones are referenced directly from the mapped file.
+    TVector<TConstArrayRef<char>> compressedChunkBlobs;
+
     TPoolMetainfo poolMetainfo;
     const auto poolMetainfoSize = LittleToHost(ReadUnaligned<ui32>(
         blob.data() + epilogOffsets.PoolMetainfoSizeOffset));
@@ -562,7 +645,10 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
         ui64 chunkOffset;
         ui32 docOffset;
         ui32 docsInChunkCount;
-        const size_t featureEpilogBytes = chunkCount * (sizeof(chunkSize) + sizeof(chunkOffset) + sizeof(docOffset) + sizeof(docsInChunkCount));
+        ui32 uncompressedChunkSize;
+        const size_t chunkInfoBytes = sizeof(chunkSize) + sizeof(chunkOffset) + sizeof(docOffset) + sizeof(docsInChunkCount)
+            + (codec ? sizeof(uncompressedChunkSize) : 0);
+        const size_t featureEpilogBytes = chunkCount * chunkInfoBytes;
         TVector<ui8> featureEpilog(featureEpilogBytes);
         CB_ENSURE(featureEpilogBytes == epilog.Load(featureEpilog.data(), featureEpilogBytes));
         const auto* featureEpilogPtr = featureEpilog.data();
@@ -577,14 +663,52 @@ NCB::TQuantizedPool TFileQuantizedPoolLoader::LoadQuantizedPool(NCB::TLoadQuanti
 
             ReadLittleEndian(&docsInChunkCount, &featureEpilogPtr);
 
+            uncompressedChunkSize = chunkSize;
+            if (codec) {
+                ReadLittleEndian(&uncompressedChunkSize, &featureEpilogPtr);
+            }
+
             const TConstArrayRef<char> chunkBlob{blob.data() + chunkOffset, chunkSize};
+            const char* chunkData = chunkBlob.data();
+            if (chunkSize < uncompressedChunkSize) {
+                // Data will be filled later, but storage address is already known and won't change.
+                compressedChunkBlobs.push_back(chunkBlob);
+                pool.ChunkStorage.emplace_back();
+                pool.ChunkStorage.back().yresize(uncompressedChunkSize);
+                chunkData = reinterpret_cast<const char*>(pool.ChunkStorage.back().data());
+            }
             // TODO(yazevnul): validate flatbuffer, including document count
-            const auto* const chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkBlob.data());
+            const auto* const chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkData);
 
             chunks.emplace_back(docOffset, docsInChunkCount, chunk);
         }
     }
 
+    const auto decompressChunk = [&](const int chunkIdx) {
+        auto& storage = pool.ChunkStorage[chunkIdx];
+        const TStringBuf compressedBlob(compressedChunkBlobs[chunkIdx].data(), compressedChunkBlobs[chunkIdx].size());
+        // the storage is sized from the chunk table, check it against the codec before writing into it
+        const auto expectedDecompressedSize = codec->DecompressedLength(compressedBlob);
+        CB_ENSURE(
+            expectedDecompressedSize == storage.size(),
+            "Corrupted chunk in quantized pool: " LabeledOutput(expectedDecompressedSize, storage.size()));
+        const auto decompressedSize = codec->Decompress(compressedBlob, storage.data());
+        CB_ENSURE(
+            decompressedSize == storage.size(),
+            "Corrupted chunk in quantized pool: " LabeledOutput(decompressedSize, storage.size()));
+    };
+    if (params.LocalExecutor) {
+        params.LocalExecutor->ExecRangeWithThrow(
+            decompressChunk,
+            0,
+            SafeIntegerCast<int>(compressedChunkBlobs.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE);
+    } else {
+        for (auto chunkIdx : xrange(compressedChunkBlobs.size())) {
+            decompressChunk(chunkIdx);
+        }
+    }
+
     AddPoolMetainfo(poolMetainfo, &pool);
 
     // `pool.ColumnTypes` expected to have the same size as number of columns in pool,
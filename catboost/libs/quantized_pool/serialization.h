@@ -4,8 +4,13 @@
 #include <catboost/libs/data_util/path_with_scheme.h>
 
 #include <util/generic/fwd.h>
+#include <util/generic/string.h>
 #include <util/stream/fwd.h>
 
+namespace NPar {
+    class TLocalExecutor;
+}
+
 namespace NCB {
     struct TQuantizedPool;
     struct TQuantizedPoolDigest;
@@ -17,12 +22,21 @@ namespace NCB {
 }
 
 namespace NCB {
+    struct TSaveQuantizedPoolParameters {
+        // Name of `library/blockcodecs` codec (e.g. "lz4", "zstd08_1") used to compress chunks.
+        // Empty name means that chunks are stored uncompressed in format of version 1.
+        TString ChunkCodec;
+    };
+
     void SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* output);
+    void SaveQuantizedPool(const TQuantizedPool& pool, const TSaveQuantizedPoolParameters& params, IOutputStream* output);
 
     struct TLoadQuantizedPoolParameters {
         bool LockMemory = true;
         bool Precharge = true;
         TDatasetSubset DatasetSubset;
+        // Used to decompress chunks in parallel, if null chunks are decompressed in current thread.
+        NPar::TLocalExecutor* LocalExecutor = nullptr;
     };
 
     // Load quantized pool saved by `SaveQuantizedPool` from file.
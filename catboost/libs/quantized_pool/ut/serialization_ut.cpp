@@ -2,6 +2,7 @@
 #include "print.h"
 #include "serialization.h"
 
+#include <library/threading/local_executor/local_executor.h>
 #include <library/unittest/registar.h>
 
 #include <contrib/libs/flatbuffers/include/flatbuffers/flatbuffers.h>
@@ -154,6 +155,28 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
         UNIT_ASSERT_VALUES_EQUAL(loadedPoolAsText, poolAsText);
     }
 
+    Y_UNIT_TEST(TestSerializeDeserializeCompressed) {
+        const auto pool = MakeQuantizedPool();
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool_compressed.bin";
+
+        for (const TString codec : {"lz4", "zstd08_1"}) {
+            {
+                TFileOutput output(path.GetPath());
+                NCB::SaveQuantizedPool(pool, {codec}, &output);
+            }
+
+            NPar::TLocalExecutor localExecutor;
+            localExecutor.RunAdditionalThreads(3);
+            NCB::TLoadQuantizedPoolParameters params{false, false, NCB::TDatasetSubset::MakeColumns(), &localExecutor};
+            const auto loadedPool = NCB::LoadQuantizedPool(NCB::TPathWithScheme(path.GetPath(), "quantized"), params);
+
+            const auto poolAsText = QuantizedPoolToString(pool);
+            const auto loadedPoolAsText = QuantizedPoolToString(loadedPool);
+
+            UNIT_ASSERT_VALUES_EQUAL_C(loadedPoolAsText, poolAsText, codec);
+        }
+    }
+
     Y_UNIT_TEST(TestLoadQuantizationSchema) {
         const auto pool = MakeQuantizedPool();
         const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
@@ -21,8 +21,10 @@
 #include <catboost/libs/model/features.h>
 #include <catboost/libs/options/enum_helpers.h>
 #include <catboost/libs/options/plain_options_helper.h>
+#include <catboost/libs/options/system_options.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/mapfindptr.h>
 #include <util/generic/scope.h>
 #include <util/generic/ymath.h>
@@ -30,6 +32,7 @@
 #include <util/stream/labeled.h>
 #include <util/string/cast.h>
 #include <util/system/hp_timer.h>
+#include <util/system/mem_info.h>
 
 #include <cmath>
 #include <numeric>
@@ -210,8 +213,9 @@ void TrainBatch(
     NPar::TLocalExecutor* localExecutor,
     TMaybe<ui32>* upToIteration) { // exclusive bound, if not inited - init from profile data
 
-    // don't output data from folds training
-    TSetLoggingSilent silentMode;
+    // logging of folds training is silenced by the caller, catboostOption.LoggingLevel must be Silent
+    //  so that concurrently trained folds don't change the global logging level
+    Y_ASSERT(catboostOption.LoggingLevel.Get() == ELoggingLevel::Silent);
 
     const size_t batchStartIteration = foldContext->MetricValuesOnTest.size();
     Y_ASSERT(
@@ -463,6 +467,84 @@ void UpdatePermutationBlockSize(
     }
 }
 
+/*
+ * CPU folds are trained concurrently, each fold with its own executor and a share of the threads
+ *  (not less than one), so that total CV time is close to the total work divided by thread count
+ *  instead of the sum of fold trainings.
+ *  The calling threads of the fold executors are the threads of the common executor.
+ *
+ * Each concurrently trained fold allocates its own sampled docs buffers for a batch,
+ *  so the number of concurrent folds is also limited by used_ram_limit and cvParams.MaxConcurrentFoldCount.
+ */
+static ui64 EstimateFoldBatchRamUsage(const TFoldContext& foldContext, ui32 approxDimension) {
+    // TLearnContext::SampledDocs and SmallestSplitSideDocs: indices, permutation, index in fold, control,
+    //  learn and sample weights, weighted derivatives and sample weighted derivatives
+    const ui64 bytesPerObject = 2 * (
+        sizeof(TIndexType) + 2 * sizeof(ui32) + sizeof(bool) + 2 * sizeof(float)
+        + 2 * approxDimension * sizeof(double)
+    );
+    return foldContext.TrainingData.Learn->GetObjectCount() * bytesPerObject;
+}
+
+static ui32 GetConcurrentFoldCount(
+    ETaskType taskType,
+    const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+    const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+    const TCrossValidationParams& cvParams,
+    const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+    ui32 approxDimension,
+    TConstArrayRef<TFoldContext> foldContexts,
+    NPar::TLocalExecutor* localExecutor
+) {
+    if ((taskType != ETaskType::CPU)
+        || objectiveDescriptor // custom descriptors can call interpreter code that is not thread-safe
+        || evalMetricDescriptor)
+    {
+        return 1;
+    }
+    ui32 concurrentFoldCount = Min<ui32>(foldContexts.size(), localExecutor->GetThreadCount() + 1);
+    if (cvParams.MaxConcurrentFoldCount) {
+        concurrentFoldCount = Min(concurrentFoldCount, cvParams.MaxConcurrentFoldCount);
+    }
+    if (concurrentFoldCount < 2) {
+        return 1;
+    }
+
+    ui64 foldRamUsage = 0;
+    for (const auto& foldContext : foldContexts) {
+        foldRamUsage = Max(foldRamUsage, EstimateFoldBatchRamUsage(foldContext, approxDimension));
+    }
+    const ui64 cpuRamLimit = ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get());
+    const ui64 cpuRamUsage = NMemInfo::GetMemInfo().RSS;
+    const ui64 availableRam = cpuRamLimit > cpuRamUsage ? cpuRamLimit - cpuRamUsage : 0;
+    if (foldRamUsage && (availableRam / foldRamUsage < concurrentFoldCount)) {
+        concurrentFoldCount = Max<ui64>(1, availableRam / foldRamUsage);
+        CATBOOST_INFO_LOG << "CrossValidation: concurrent fold count is limited to " << concurrentFoldCount
+            << " by used_ram_limit" << Endl;
+    }
+    return concurrentFoldCount;
+}
+
+// executors and options for each of concurrentFoldCount slots that train folds
+static TVector<THolder<NPar::TLocalExecutor>> CreateFoldExecutors(
+    ui32 concurrentFoldCount,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<NCatboostOptions::TCatBoostOptions>* foldCatBoostOptions // NumThreads are updated
+) {
+    const ui32 threadCount = localExecutor->GetThreadCount() + 1;
+    TVector<THolder<NPar::TLocalExecutor>> foldExecutors;
+    for (auto slotIdx : xrange(concurrentFoldCount)) {
+        const ui32 foldThreadCount = Max<ui32>(
+            1,
+            threadCount / concurrentFoldCount + (slotIdx < threadCount % concurrentFoldCount ? 1 : 0)
+        );
+        foldExecutors.push_back(MakeHolder<NPar::TLocalExecutor>());
+        foldExecutors.back()->RunAdditionalThreads(foldThreadCount - 1);
+        (*foldCatBoostOptions)[slotIdx].SystemOptions->NumThreads.Set(foldThreadCount);
+    }
+    return foldExecutors;
+}
+
 void CrossValidate(
     NJson::TJsonValue plainJsonParams,
     const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
@@ -656,6 +738,29 @@ void CrossValidate(
 
     ui32 globalMaxIteration = catBoostOptions.BoostingOptions->IterationCount;
 
+    const ui32 concurrentFoldCount = GetConcurrentFoldCount(
+        taskType,
+        objectiveDescriptor,
+        evalMetricDescriptor,
+        cvParams,
+        catBoostOptions,
+        approxDimension,
+        foldContexts,
+        localExecutor);
+    const bool trainFoldsConcurrently = concurrentFoldCount > 1;
+
+    // catBoostOptions.LoggingLevel is Silent, so TrainModel calls inside fold tasks don't change logging level
+    TVector<NCatboostOptions::TCatBoostOptions> foldCatBoostOptions;
+    TVector<THolder<NPar::TLocalExecutor>> foldExecutors;
+    if (trainFoldsConcurrently) {
+        foldCatBoostOptions.reserve(concurrentFoldCount);
+        for (auto slotIdx : xrange(concurrentFoldCount)) {
+            Y_UNUSED(slotIdx);
+            foldCatBoostOptions.push_back(catBoostOptions); // options are not copy assignable
+        }
+        foldExecutors = CreateFoldExecutors(concurrentFoldCount, localExecutor, &foldCatBoostOptions);
+    }
+
     TProfileInfo profile(globalMaxIteration);
 
     ui32 iteration = 0;
@@ -672,30 +777,76 @@ void CrossValidate(
          */
         TMaybe<ui32> batchEndIteration;
 
-        for (auto foldIdx : xrange(foldContexts.size())) {
-            THPTimer timer;
+        if (trainFoldsConcurrently) {
+            // batches on CPU are always one iteration long (see CalcBatchSize), so folds do not have to wait
+            //  for the first fold to estimate it
+            batchEndIteration = batchStartIteration + 1;
 
-            TrainBatch(
-                catBoostOptions,
-                objectiveDescriptor,
-                evalMetricDescriptor,
-                labelConverter,
-                metrics,
-                skipMetricOnTrain,
-                cvParams.MaxTimeSpentOnFixedCostRatio,
-                cvParams.DevMaxIterationsBatchSize,
-                globalMaxIteration,
-                errorTracker.IsActive(),
-                loggingLevel,
-                &foldContexts[foldIdx],
-                modelTrainerHolder.Get(),
-                localExecutor,
-                &batchEndIteration);
-
-            Y_ASSERT(batchEndIteration); // should be inited right after the first iteration of the first fold
+            THPTimer timer;
+            {
+                // set once for all folds, scopes of concurrent fold tasks would restore each other's levels
+                TSetLoggingSilent silentMode;
+
+                localExecutor->ExecRangeWithThrow(
+                    [&] (int slotIdx) {
+                        for (size_t foldIdx = slotIdx; foldIdx < foldContexts.size(); foldIdx += concurrentFoldCount) {
+                            TrainBatch(
+                                foldCatBoostOptions[slotIdx],
+                                objectiveDescriptor,
+                                evalMetricDescriptor,
+                                labelConverter,
+                                metrics,
+                                skipMetricOnTrain,
+                                cvParams.MaxTimeSpentOnFixedCostRatio,
+                                cvParams.DevMaxIterationsBatchSize,
+                                globalMaxIteration,
+                                errorTracker.IsActive(),
+                                loggingLevel,
+                                &foldContexts[foldIdx],
+                                modelTrainerHolder.Get(),
+                                foldExecutors[slotIdx].Get(),
+                                &batchEndIteration);
+                        }
+                    },
+                    0,
+                    SafeIntegerCast<int>(concurrentFoldCount),
+                    NPar::TLocalExecutor::WAIT_COMPLETE);
+            }
             CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
-                << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
+                << ',' << *batchEndIteration << ") for " << cvParams.FoldCount << " folds, "
+                << concurrentFoldCount << " of them concurrently"
                 << " in " << FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
+        } else {
+            for (auto foldIdx : xrange(foldContexts.size())) {
+                THPTimer timer;
+
+                {
+                    // don't output data from folds training
+                    TSetLoggingSilent silentMode;
+
+                    TrainBatch(
+                        catBoostOptions,
+                        objectiveDescriptor,
+                        evalMetricDescriptor,
+                        labelConverter,
+                        metrics,
+                        skipMetricOnTrain,
+                        cvParams.MaxTimeSpentOnFixedCostRatio,
+                        cvParams.DevMaxIterationsBatchSize,
+                        globalMaxIteration,
+                        errorTracker.IsActive(),
+                        loggingLevel,
+                        &foldContexts[foldIdx],
+                        modelTrainerHolder.Get(),
+                        localExecutor,
+                        &batchEndIteration);
+                }
+
+                Y_ASSERT(batchEndIteration); // should be inited right after the first iteration of the first fold
+                CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
+                    << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
+                    << " in " << FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
+            }
         }
 
         while (true) {
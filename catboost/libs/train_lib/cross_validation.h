@@ -115,11 +115,15 @@ TVector<TDataProvidersTemplate> PrepareCvFolds(
     TVector<std::function<void()>> tasks;
 
     for (ui32 resultIdx : xrange(resultFolds.size())) {
-        result[resultIdx] = NCB::CreateTrainTestSubsets<TDataProvidersTemplate>(
-            srcData,
-            std::move(trainSubsets[resultFolds[resultIdx]]),
-            std::move(testSubsets[resultFolds[resultIdx]]),
-            localExecutor
+        tasks.emplace_back(
+            [&, resultIdx]() {
+                result[resultIdx] = NCB::CreateTrainTestSubsets<TDataProvidersTemplate>(
+                    srcData,
+                    std::move(trainSubsets[resultFolds[resultIdx]]),
+                    std::move(testSubsets[resultFolds[resultIdx]]),
+                    localExecutor
+                );
+            }
         );
     }
 
@@ -19,6 +19,7 @@
 #include <catboost/libs/fstr/output_fstr.h>
 #include <catboost/libs/helpers/int_cast.h>
 #include <catboost/libs/helpers/mem_usage.h>
+#include <catboost/libs/helpers/numa.h>
 #include <catboost/libs/helpers/permutation.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/vector_helpers.h>
@@ -34,9 +35,11 @@
 #include <catboost/libs/pairs/util.h>
 #include <catboost/libs/target/classification_target_helper.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/grid_creator/binarization.h>
 #include <library/json/json_prettifier.h>
 
+#include <util/folder/path.h>
 #include <util/generic/cast.h>
 #include <util/generic/mapfindptr.h>
 #include <util/generic/scope.h>
@@ -60,6 +63,18 @@ static void CreateDirIfNotExist(const TString& path) {
     }
 }
 
+static THolder<NChromiumTrace::TGlobalJsonFileSink> CreateTraceSink(
+    const NCatboostOptions::TOutputFilesOptions& outputOptions
+) {
+    if (!outputOptions.NeedSaveTrace()) {
+        return nullptr;
+    }
+    const TString traceFilePath = outputOptions.CreateTraceFullPath();
+    TFsPath(traceFilePath).Parent().MkDirs();
+    CATBOOST_INFO_LOG << "Writing trace to " << traceFilePath << Endl;
+    return MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(traceFilePath);
+}
+
 static void ShrinkModel(int itCount, const TCtrHelper& ctrsHelper, TLearnProgress* progress) {
     itCount += SafeIntegerCast<int>(progress->InitTreesSize);
     progress->LeafValues.resize(itCount);
@@ -89,6 +104,8 @@ static TDataProviders LoadPools(
     NPar::TLocalExecutor* const executor,
     TProfileInfo* profile
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("LoadPools");
+
     const auto& cvParams = loadOptions.CvParams;
     const bool cvMode = cvParams.FoldCount != 0;
     CB_ENSURE(
@@ -266,6 +283,8 @@ static void ProcessHistoryMetrics(
             GetMetricsDescription(metricsData->Metrics),
             ctx.LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory,
             testMetricsHistory,
+            ctx.LearnProgress->MetricsAndTimeHistory.LearnErrorBounds,
+            ctx.LearnProgress->MetricsAndTimeHistory.TestErrorBounds,
             metricsData->ErrorTracker ? TMaybe<double>(metricsData->ErrorTracker->GetBestError()) : Nothing(),
             metricsData->ErrorTracker ? TMaybe<int>(metricsData->ErrorTracker->GetBestIteration()) : Nothing(),
             TProfileResults(timeHistory[iter].PassedTime, timeHistory[iter].RemainingTime),
@@ -315,6 +334,122 @@ static void InitializeSamplingStructures(
     ); // TODO(espetrov): create only if sample rate < 1
 }
 
+// TUnsizedVector hides the size of the allocated buffer, which may differ from the doc count
+template <class TData>
+static TConstArrayRef<TData> GetUnsizedVectorRef(const TCalcScoreFold::TUnsizedVector<TData>& data) {
+    return static_cast<const TVector<TData>&>(data);
+}
+
+static void PlaceFoldNumaLocal(const NCB::TNumaObjectsPartition& partition, const TFold& fold) {
+    for (const auto& bodyTail : fold.BodyTailArr) {
+        for (const auto& approx : bodyTail.Approx) {
+            partition.Place<double>(approx);
+        }
+        for (const auto& derivatives : bodyTail.WeightedDerivatives) {
+            partition.Place<double>(derivatives);
+        }
+        for (const auto& derivatives : bodyTail.SampleWeightedDerivatives) {
+            partition.Place<double>(derivatives);
+        }
+    }
+    partition.Place<float>(fold.LearnTarget);
+    partition.Place<float>(fold.SampleWeights);
+}
+
+static bool HasIdentityFeaturesPermutation(const TFold& fold) {
+    const auto& indices = fold.LearnPermutationFeaturesSubset.Get<NCB::TIndexedSubset<ui32>>();
+    for (auto i : xrange(indices.size())) {
+        if (indices[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// see TSystemOptions::NumaLocalPlacement
+static void PlaceTrainingDataNumaLocal(const TTrainingForCPUDataProviders& data, TLearnContext* ctx) {
+    auto& sampledDocs = ctx->SampledDocs;
+    const int docCount = sampledDocs.GetDocCount();
+
+    // fold order arrays are processed by NPar::ParallelFor blocks (approxes, derivatives, sampling)
+    const NCB::TNumaObjectsPartition partition(
+        docCount,
+        NCB::GetParallelForBlockSize(docCount, ctx->LocalExecutor->GetThreadCount()),
+        *ctx->LocalExecutor
+    );
+    if (partition.IsTrivial()) {
+        CATBOOST_INFO_LOG << "NUMA local placement is skipped: there's a single NUMA node or a single thread" << Endl;
+        return;
+    }
+
+    /* columns are read in fold order through LearnPermutationFeaturesSubset,
+     *  so their object blocks match the partition only if the folds are not permuted
+     */
+    const auto& objectsData = *data.Learn->ObjectsData;
+    const auto consecutiveSubsetBegin = objectsData.GetFeaturesArraySubsetIndexing().GetConsecutiveSubsetBegin();
+    const bool areFoldsPermuted = !AllOf(ctx->LearnProgress->Folds, HasIdentityFeaturesPermutation)
+        || !HasIdentityFeaturesPermutation(ctx->LearnProgress->AveragingFold);
+    if (areFoldsPermuted) {
+        CATBOOST_DEBUG_LOG << "NUMA local placement of feature columns is skipped: learn folds are permuted" << Endl;
+    } else if (consecutiveSubsetBegin && (*consecutiveSubsetBegin == 0)) {
+        const auto& featuresLayout = *objectsData.GetFeaturesLayout();
+        const auto placeColumn = [&] (const TCompressedArray& column) {
+            partition.Place(column.GetRawPtr(), column.GetSize(), column.GetBitsPerKey());
+        };
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Float>(
+            [&] (TFloatFeatureIdx floatFeatureIdx) {
+                if (!objectsData.IsFeaturePackedBinary(floatFeatureIdx)
+                    && !objectsData.IsFeatureInExclusiveBundle(floatFeatureIdx))
+                {
+                    placeColumn(
+                        *(*objectsData.GetNonPackedFloatFeature(*floatFeatureIdx))->GetCompressedData().GetSrc()
+                    );
+                }
+            }
+        );
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Categorical>(
+            [&] (TCatFeatureIdx catFeatureIdx) {
+                if (!objectsData.IsFeaturePackedBinary(catFeatureIdx)
+                    && !objectsData.IsFeatureInExclusiveBundle(catFeatureIdx))
+                {
+                    placeColumn(
+                        *(*objectsData.GetNonPackedCatFeature(*catFeatureIdx))->GetCompressedData().GetSrc()
+                    );
+                }
+            }
+        );
+        for (auto packIdx : xrange(objectsData.GetBinaryFeaturesPacksSize())) {
+            partition.Place(**objectsData.GetBinaryFeaturesPack(packIdx).GetSrc());
+        }
+        for (auto bundleIdx : xrange(objectsData.GetExclusiveFeatureBundlesSize())) {
+            const auto bundle = objectsData.GetExclusiveFeaturesBundle(bundleIdx);
+            partition.Place(bundle.SrcData.data(), objectsData.GetObjectCount(), bundle.MetaData->SizeInBytes * 8);
+        }
+    } else {
+        CATBOOST_DEBUG_LOG << "NUMA local placement of feature columns is skipped: learn data is a subset" << Endl;
+    }
+
+    // folds
+    for (const auto& fold : ctx->LearnProgress->Folds) {
+        PlaceFoldNumaLocal(partition, fold);
+    }
+    PlaceFoldNumaLocal(partition, ctx->LearnProgress->AveragingFold);
+
+    partition.Place(GetUnsizedVectorRef(sampledDocs.Indices));
+    for (auto bodyTailIdx : xrange(sampledDocs.GetBodyTailCount())) {
+        const auto& bodyTail = sampledDocs.BodyTailArr[bodyTailIdx];
+        for (auto dimIdx : xrange(sampledDocs.GetApproxDimension())) {
+            partition.Place(GetUnsizedVectorRef(bodyTail.WeightedDerivatives[dimIdx]));
+            partition.Place(GetUnsizedVectorRef(bodyTail.SampleWeightedDerivatives[dimIdx]));
+        }
+    }
+
+    if (partition.GetFailedByteCount()) {
+        CATBOOST_WARNING_LOG << "NUMA local placement failed for " << partition.GetFailedByteCount()
+            << " bytes of training data, they stay on the NUMA nodes they were allocated on" << Endl;
+    }
+}
+
 static void LogThatStoppingOccured(const TErrorTracker& errorTracker) {
     CATBOOST_NOTICE_LOG << "Stopped by overfitting detector "
         << " (" << errorTracker.GetOverfittingDetectorIterationsWait() << " iterations wait)" << Endl;
@@ -351,6 +486,9 @@ static void Train(
 
     if (continueTraining) {
         InitializeSamplingStructures(data, ctx);
+        if (ctx->Params.SystemOptions->NumaLocalPlacement) {
+            PlaceTrainingDataNumaLocal(data, ctx);
+        }
     }
 
     THPTimer timer;
@@ -369,6 +507,10 @@ static void Train(
             break;
         }
 
+        NChromiumTrace::TEventArgs iterationTraceArgs;
+        iterationTraceArgs.Add(AsStringBuf("iteration"), i64(iter));
+        CHROMIUM_TRACE_COMPLETE_W_ARGS(AsStringBuf("Iteration"), AsStringBuf("train"), &iterationTraceArgs);
+
         profile.StartNextIteration();
 
         if (timer.Passed() > ctx->OutputOptions.GetSnapshotSaveInterval()) {
@@ -413,6 +555,8 @@ static void Train(
             GetMetricsDescription(metrics),
             ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory,
             ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory,
+            ctx->LearnProgress->MetricsAndTimeHistory.LearnErrorBounds,
+            ctx->LearnProgress->MetricsAndTimeHistory.TestErrorBounds,
             errorTracker ? TMaybe<double>(errorTracker->GetBestError()) : Nothing(),
             errorTracker ? TMaybe<int>(errorTracker->GetBestIteration()) : Nothing(),
             profileResults,
@@ -454,6 +598,18 @@ static void Train(
         CATBOOST_NOTICE_LOG << "\n";
     }
 
+    const auto& metricsHistory = ctx->LearnProgress->MetricsAndTimeHistory;
+    for (const auto& [description, errorBound] : metricsHistory.LearnErrorBounds) {
+        CATBOOST_NOTICE_LOG << loggingData.LearnToken << " " << description
+            << " is approximate, max difference from the exact value = " << errorBound << Endl;
+    }
+    for (auto testIdx : xrange(metricsHistory.TestErrorBounds.size())) {
+        for (const auto& [description, errorBound] : metricsHistory.TestErrorBounds[testIdx]) {
+            CATBOOST_NOTICE_LOG << loggingData.TestTokens[testIdx] << " " << description
+                << " is approximate, max difference from the exact value = " << errorBound << Endl;
+        }
+    }
+
     if (useBestModel && metricsData.BestModelMinTreesTracker && ctx->Params.BoostingOptions->IterationCount > 0) {
         const int bestModelIterations = metricsData.BestModelMinTreesTracker->GetBestIteration() + 1;
         if (0 < bestModelIterations && bestModelIterations < static_cast<int>(ctx->Params.BoostingOptions->IterationCount)) {
@@ -893,6 +1049,7 @@ void TrainModel(
     const NJson::TJsonValue& trainJson
 ) {
     THPTimer runTimer;
+    const auto traceSink = CreateTraceSink(outputOptions);
     auto catBoostOptions = NCatboostOptions::LoadOptions(trainJson);
 
     TSetLogging inThisScope(catBoostOptions.LoggingLevel);
@@ -905,6 +1062,7 @@ void TrainModel(
     );
 
     NPar::TLocalExecutor executor;
+    executor.SetThreadPinning(catBoostOptions.SystemOptions->NumaLocalPlacement.GetUnchecked());
     executor.RunAdditionalThreads(catBoostOptions.SystemOptions.Get().NumThreads.Get() - 1);
 
     TVector<TString> classNames = catBoostOptions.DataProcessingOptions->ClassNames;
@@ -1246,7 +1404,10 @@ void TrainModel(
     NCatboostOptions::TOutputFilesOptions outputOptions;
     outputOptions.Load(outputFilesOptionsJson);
 
+    const auto traceSink = CreateTraceSink(outputOptions);
+
     NPar::TLocalExecutor executor;
+    executor.SetThreadPinning(NCatboostOptions::GetNumaLocalPlacement(trainOptionsJson));
     executor.RunAdditionalThreads(
         NCatboostOptions::GetThreadCount(trainOptionsJson) - 1);
 
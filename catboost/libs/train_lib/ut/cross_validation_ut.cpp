@@ -0,0 +1,104 @@
+#include <catboost/libs/data_new/data_provider_builders.h>
+#include <catboost/libs/train_lib/cross_validation.h>
+
+#include <library/json/json_value.h>
+#include <library/unittest/registar.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+
+static TDataProviderPtr RandomFloatPool(ui32 objectCount, ui32 featureCount) {
+    TFastRng64 prng(17);
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                TVector<ui32>{},
+                TVector<TString>{}
+            );
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> target(objectCount, 0.0f);
+            for (auto featureIdx : xrange(featureCount)) {
+                TVector<float> feature(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    feature[objectIdx] = prng.GenRandReal1();
+                    target[objectIdx] += feature[objectIdx] * (featureIdx + 1);
+                }
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    TMaybeOwningConstArrayHolder<float>::CreateOwning(std::move(feature))
+                );
+            }
+            visitor->AddTarget(target);
+
+            visitor->Finish();
+        }
+    );
+}
+
+static TVector<TCVResult> RunCrossValidation(ui32 maxConcurrentFoldCount, ui32 foldCount, const TString& trainDir) {
+    NJson::TJsonValue params;
+    params.InsertValue("iterations", 20);
+    params.InsertValue("depth", 4);
+    params.InsertValue("random_seed", 1);
+    params.InsertValue("thread_count", 4);
+    params.InsertValue("train_dir", trainDir);
+
+    TCrossValidationParams cvParams;
+    cvParams.FoldCount = foldCount;
+    cvParams.PartitionRandSeed = 3;
+    cvParams.Shuffle = true;
+    cvParams.MaxConcurrentFoldCount = maxConcurrentFoldCount;
+
+    TVector<TCVResult> results;
+    CrossValidate(
+        params,
+        /*quantizedFeaturesInfo*/ nullptr,
+        /*objectiveDescriptor*/ Nothing(),
+        /*evalMetricDescriptor*/ Nothing(),
+        RandomFloatPool(/*objectCount*/ 500, /*featureCount*/ 5),
+        cvParams,
+        &results
+    );
+    return results;
+}
+
+static void AssertEqualResults(TConstArrayRef<double> expected, TConstArrayRef<double> actual) {
+    UNIT_ASSERT_VALUES_EQUAL(expected.size(), actual.size());
+    for (auto i : xrange(expected.size())) {
+        UNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], 1e-9);
+    }
+}
+
+Y_UNIT_TEST_SUITE(CrossValidationTests) {
+    Y_UNIT_TEST(ConcurrentFoldsMatchSequentialFolds) {
+        for (ui32 foldCount : {2, 3, 5}) {
+            TTempDir trainDir;
+            const auto sequentialResults = RunCrossValidation(1, foldCount, trainDir.Name());
+            // all folds at once and folds sharing concurrent slots
+            for (ui32 maxConcurrentFoldCount : {0, 2}) {
+                const auto concurrentResults = RunCrossValidation(maxConcurrentFoldCount, foldCount, trainDir.Name());
+                UNIT_ASSERT_VALUES_EQUAL(sequentialResults.size(), concurrentResults.size());
+                for (auto metricIdx : xrange(sequentialResults.size())) {
+                    const auto& expected = sequentialResults[metricIdx];
+                    const auto& actual = concurrentResults[metricIdx];
+                    UNIT_ASSERT_VALUES_EQUAL(expected.Metric, actual.Metric);
+                    UNIT_ASSERT_VALUES_EQUAL(expected.Iterations, actual.Iterations);
+                    AssertEqualResults(expected.AverageTrain, actual.AverageTrain);
+                    AssertEqualResults(expected.StdDevTrain, actual.StdDevTrain);
+                    AssertEqualResults(expected.AverageTest, actual.AverageTest);
+                    AssertEqualResults(expected.StdDevTest, actual.StdDevTest);
+                }
+            }
+        }
+    }
+}
@@ -1106,6 +1106,164 @@ def test_multi_leaf_estimation_method(leaf_estimation_method, boosting_type, dev
     return [local_canonical_file(output_eval_path)]
 
 
+@pytest.mark.parametrize('output_scheme', ['binary', 'columnar'])
+@pytest.mark.parametrize('float_type', ['Float32', 'Float64'])
+def test_calc_binary_output(output_scheme, float_type):
+    output_model_path = yatest.common.test_output_path('model.bin')
+    test_path = data_file('cloudness_small', 'test_small')
+    cd_path = data_file('cloudness_small', 'train.cd')
+
+    cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', 'MultiClass',
+        '-f', data_file('cloudness_small', 'train_small'),
+        '--column-description', cd_path,
+        '-i', '10',
+        '-T', '4',
+        '-m', output_model_path,
+    )
+    yatest.common.execute(cmd)
+
+    dsv_predict_path = yatest.common.test_output_path('predict_test.eval')
+    binary_predict_path = yatest.common.test_output_path('predict_test.bin')
+    for output_path in (dsv_predict_path, output_scheme + '://' + binary_predict_path):
+        calc_cmd = (
+            CATBOOST_PATH,
+            'calc',
+            '--input-path', test_path,
+            '--column-description', cd_path,
+            '-m', output_model_path,
+            '--output-path', output_path,
+            '--prediction-type', 'RawFormulaVal,Probability',
+            '--eval-period', '5',
+            '--output-float-type', float_type,
+        )
+        yatest.common.execute(calc_cmd)
+
+    expected = np.loadtxt(dsv_predict_path, delimiter='\t', skiprows=1, ndmin=2)[:, 1:]
+    with open(dsv_predict_path) as dsv:
+        expected_column_names = dsv.readline().rstrip('\n').split('\t')[1:]
+    dtype = np.float32 if float_type == 'Float32' else np.float64
+
+    if output_scheme == 'binary':
+        with open(binary_predict_path + '.json') as sidecar_file:
+            sidecar = json.load(sidecar_file)
+        values = np.fromfile(binary_predict_path, dtype=np.dtype(dtype).newbyteorder('<'))
+        values = values.reshape(sidecar['object_count'], len(sidecar['column_names']))
+    else:
+        with open(os.path.join(binary_predict_path, 'meta.json')) as sidecar_file:
+            sidecar = json.load(sidecar_file)
+        values = np.column_stack([
+            np.fromfile(os.path.join(binary_predict_path, column_file), dtype=np.dtype(dtype).newbyteorder('<'))
+            for column_file in sidecar['column_files']
+        ])
+
+    assert sidecar['float_type'] == float_type
+    assert sidecar['object_count'] == expected.shape[0]
+    assert sidecar['column_names'] == expected_column_names
+    assert np.allclose(values, expected, rtol=1e-5)
+
+
+def test_calc_pipelined_blocks():
+    output_model_path = yatest.common.test_output_path('model.bin')
+    test_path = data_file('adult', 'test_small')
+    cd_path = data_file('adult', 'train.cd')
+    iteration_count = 320
+
+    cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', 'Logloss',
+        '-f', data_file('adult', 'train_small'),
+        '--column-description', cd_path,
+        '-i', str(iteration_count),
+        '-T', '4',
+        '-m', output_model_path,
+    )
+    yatest.common.execute(cmd)
+
+    # calc reads blocks of max(32, 10000 / (iteration_count / eval_period)) objects,
+    #  so with eval_period = 1 the pool is split into several blocks
+    pipelined_path = yatest.common.test_output_path('pipelined.eval')
+    single_block_path = yatest.common.test_output_path('single_block.eval')
+    for output_path, eval_period in ((pipelined_path, 1), (single_block_path, iteration_count)):
+        calc_cmd = (
+            CATBOOST_PATH,
+            'calc',
+            '--input-path', test_path,
+            '--column-description', cd_path,
+            '-m', output_model_path,
+            '--output-path', output_path,
+            '--prediction-type', 'RawFormulaVal',
+            '--eval-period', str(eval_period),
+            '-T', '4',
+        )
+        yatest.common.execute(calc_cmd)
+
+    pipelined = np.loadtxt(pipelined_path, delimiter='\t', skiprows=1, ndmin=2)
+    single_block = np.loadtxt(single_block_path, delimiter='\t', skiprows=1, ndmin=2)
+    object_count = single_block.shape[0]
+    assert object_count > 32
+    assert pipelined.shape == (object_count, 1 + iteration_count)
+    assert np.array_equal(pipelined[:, 0], np.arange(object_count))
+    assert np.array_equal(single_block[:, 0], np.arange(object_count))
+    assert np.allclose(pipelined[:, -1], single_block[:, 1], rtol=1e-6)
+
+    py_catboost = catboost.CatBoost()
+    py_catboost.load_model(output_model_path)
+    staged_predictions = py_catboost.staged_predict(
+        catboost.Pool(test_path, column_description=cd_path),
+        prediction_type='RawFormulaVal',
+        eval_period=1
+    )
+    for iteration, prediction in enumerate(staged_predictions):
+        assert np.allclose(pipelined[:, 1 + iteration], prediction, rtol=1e-6)
+
+
+def test_trace_file():
+    output_model_path = yatest.common.test_output_path('model.bin')
+    train_trace_path = yatest.common.test_output_path('train_trace.json')
+    calc_trace_path = yatest.common.test_output_path('calc_trace.json')
+    test_path = data_file('adult', 'test_small')
+    cd_path = data_file('adult', 'train.cd')
+
+    cmd = (
+        CATBOOST_PATH,
+        'fit',
+        '--loss-function', 'Logloss',
+        '-f', data_file('adult', 'train_small'),
+        '-t', test_path,
+        '--column-description', cd_path,
+        '-i', '5',
+        '-T', '4',
+        '-m', output_model_path,
+        '--trace-file', train_trace_path,
+    )
+    yatest.common.execute(cmd)
+
+    calc_cmd = (
+        CATBOOST_PATH,
+        'calc',
+        '--input-path', test_path,
+        '--column-description', cd_path,
+        '-m', output_model_path,
+        '--output-path', yatest.common.test_output_path('test.eval'),
+        '--trace-file', calc_trace_path,
+    )
+    yatest.common.execute(calc_cmd)
+
+    def get_scope_names(trace_path):
+        with open(trace_path) as trace_file:
+            events = json.load(trace_file)
+        return set(event['name'] for event in events if 'name' in event)
+
+    train_scopes = get_scope_names(train_trace_path)
+    for scope in ('Iteration', 'Depth', 'CalcStatsAndScores'):
+        assert scope in train_scopes
+    assert 'Apply block' in get_scope_names(calc_trace_path)
+
+
 LOSS_FUNCTIONS_SHORT = ['Logloss', 'MultiClass']
 
 
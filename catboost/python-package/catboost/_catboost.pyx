@@ -435,6 +435,11 @@ cdef extern from "catboost/libs/data_new/visitor.h" namespace "NCB":
         void AddCatFeature(ui32 flatFeatureIdx, TConstArrayRef[TStringBuf] feature) except +ProcessException
 
         void AddCatFeature(ui32 flatFeatureIdx, TMaybeOwningConstArrayHolder[ui32] features) except +ProcessException
+        void AddCatFeatureHashToString(
+            ui32 flatFeatureIdx,
+            TConstArrayRef[ui32] hashes,
+            TConstArrayRef[TString] values
+        ) except +ProcessException
 
         void AddTarget(TConstArrayRef[TString] value) except +ProcessException
         void AddTarget(TConstArrayRef[float] value) except +ProcessException
@@ -1007,6 +1012,9 @@ cdef extern from "catboost/libs/hyperparameter_tuning/hyperparameter_tuning.h" n
         THashMap[TString, double] DoubleOptions
         THashMap[TString, TString] StringOptions
 
+    cdef cppclass TSuccessiveHalvingParams:
+        ui32 ReductionFactor
+
     cdef void GridSearch(
         const TJsonValue& grid,
         const TJsonValue& params,
@@ -1018,7 +1026,8 @@ cdef extern from "catboost/libs/hyperparameter_tuning/hyperparameter_tuning.h" n
         TBestOptionValuesWithCvResult* results,
         bool_t isSearchUsingCV,
         bool_t isReturnCvResults,
-        int verbose) nogil except +ProcessException
+        int verbose,
+        const TMaybe[TSuccessiveHalvingParams]& successiveHalvingParams) nogil except +ProcessException
 
     cdef void RandomizedSearch(
         ui32 numberOfTries,
@@ -1033,7 +1042,8 @@ cdef extern from "catboost/libs/hyperparameter_tuning/hyperparameter_tuning.h" n
         TBestOptionValuesWithCvResult* results,
         bool_t isSearchUsingCV,
         bool_t isReturnCvResults,
-        int verbose) nogil except +ProcessException
+        int verbose,
+        const TMaybe[TSuccessiveHalvingParams]& successiveHalvingParams) nogil except +ProcessException
 
 cdef inline float _FloatOrNan(object obj) except *:
     try:
@@ -1764,6 +1774,75 @@ cdef get_cat_factor_bytes_representation(
         )
 
 
+# categories are hashed once each and their codes are mapped to hashes without GIL
+cdef _set_cat_feature_from_codes(
+    ui32 flat_feature_idx,
+    categories,
+    np.ndarray codes, # index in categories for each object, negative for missing values
+    IRawFeaturesOrderDataVisitor* builder_visitor
+):
+    cdef ui32 doc_count = len(codes)
+    cdef i64 category_count = len(categories)
+
+    cdef TString category_string
+    cdef TVector[TString] category_strings
+    cdef TVector[ui32] category_hashes
+    category_strings.reserve(category_count)
+    category_hashes.reserve(category_count)
+    for category in categories:
+        try:
+            get_id_object_bytes_string_representation(category, &category_string)
+        except CatBoostError:
+            raise CatBoostError(
+                'Invalid type for cat_feature[,{}] category {} :'
+                ' cat_features must be integer or string, real number values and NaN values'
+                ' should be converted to string.'.format(flat_feature_idx, category)
+            )
+        category_strings.push_back(category_string)
+        category_hashes.push_back(CalcCatFeatureHash(<TStringBuf>category_string))
+
+    cdef const i64[:] codes_view = np.ascontiguousarray(codes, dtype=np.int64)
+
+    # two pointers are needed as a workaround for Cython assignment of derived types restrictions
+    cdef TIntrusivePtr[TVectorHolder[ui32]] cat_factor_data = new TVectorHolder[ui32]()
+    cdef TIntrusivePtr[IResourceHolder] cat_factor_data_holder
+    cat_factor_data.Get()[0].Data.resize(doc_count)
+
+    cdef ui32* dst_hashes = cat_factor_data.Get()[0].Data.data()
+    cdef const ui32* src_hashes = category_hashes.data()
+    cdef i64 code
+    cdef i64 bad_doc_idx = -1
+    cdef ui32 doc_idx
+    with nogil:
+        for doc_idx in range(doc_count):
+            code = codes_view[doc_idx]
+            if (code < 0) or (code >= category_count):
+                bad_doc_idx = doc_idx
+                break
+            dst_hashes[doc_idx] = src_hashes[code]
+
+    if bad_doc_idx >= 0:
+        raise CatBoostError(
+            'Invalid type for cat_feature[{},{}]=NaN :'
+            ' cat_features must be integer or string, real number values and NaN values'
+            ' should be converted to string.'.format(bad_doc_idx, flat_feature_idx)
+        )
+
+    cat_factor_data_holder.Reset(cat_factor_data.Get())
+    builder_visitor[0].AddCatFeature(
+        flat_feature_idx,
+        TMaybeOwningConstArrayHolder[ui32].CreateOwning(
+            <TConstArrayRef[ui32]>cat_factor_data.Get()[0].Data,
+            cat_factor_data_holder
+        )
+    )
+    builder_visitor[0].AddCatFeatureHashToString(
+        flat_feature_idx,
+        <TConstArrayRef[ui32]>category_hashes,
+        <TConstArrayRef[TString]>category_strings
+    )
+
+
 # returns new data holders array
 cdef object _set_features_order_data_pd_data_frame(
     data_frame,
@@ -1792,7 +1871,18 @@ cdef object _set_features_order_data_pd_data_frame(
         column_type_is_pandas_Categorical = column_data.dtype.name == 'category'
         if not column_type_is_pandas_Categorical:
             column_values = column_data.values
-        if is_cat_feature_mask[flat_feature_idx]:
+        if is_cat_feature_mask[flat_feature_idx] and column_type_is_pandas_Categorical:
+            _set_cat_feature_from_codes(
+                flat_feature_idx,
+                column_data.cat.categories,
+                np.asarray(column_data.cat.codes),
+                builder_visitor
+            )
+        elif is_cat_feature_mask[flat_feature_idx] and (column_values.dtype.kind in 'iu'):
+            # integer-coded column, categories are its distinct values
+            categories, codes = np.unique(column_values, return_inverse=True)
+            _set_cat_feature_from_codes(flat_feature_idx, categories, codes, builder_visitor)
+        elif is_cat_feature_mask[flat_feature_idx]:
             cat_factor_data.clear()
             for doc_idx in range(doc_count):
                 get_cat_factor_bytes_representation(
@@ -2887,7 +2977,7 @@ cdef class _CatBoost:
         cdef EFstrType fstr_type = string_to_fstr_type(type_name)
         cdef EPreCalcShapValues shap_mode = string_to_shap_mode(shap_mode_name)
 
-        if type_name == 'ShapValues' and dereference(self.__model).GetDimensionsCount() > 1:
+        if type_name == 'ShapInteractionValues' or (type_name == 'ShapValues' and dereference(self.__model).GetDimensionsCount() > 1):
             with nogil:
                 fstr_multi = GetFeatureImportancesMulti(
                     fstr_type,
@@ -3064,7 +3154,7 @@ cdef class _CatBoost:
     cpdef _tune_hyperparams(self, list grids_list, _PoolBase train_pool, dict params, int n_iter,
                           int fold_count, int partition_random_seed, bool_t shuffle, bool_t stratified,
                           double train_size, bool_t choose_by_train_test_split, bool_t return_cv_results,
-                          custom_folds, int verbose):
+                          custom_folds, int verbose, successive_halving_reduction_factor):
 
         prep_params = _PreprocessParams(params)
         prep_grids = _PreprocessGrids(grids_list)
@@ -3092,6 +3182,12 @@ cdef class _CatBoost:
         ttParams.Stratified = False
         ttParams.TrainPart = train_size
 
+        cdef TSuccessiveHalvingParams successiveHalvingParamsValue
+        cdef TMaybe[TSuccessiveHalvingParams] successiveHalvingParams
+        if successive_halving_reduction_factor is not None:
+            successiveHalvingParamsValue.ReductionFactor = successive_halving_reduction_factor
+            successiveHalvingParams.ConstructInPlace(successiveHalvingParamsValue)
+
         cdef TBestOptionValuesWithCvResult results
         with nogil:
             SetPythonInterruptHandler()
@@ -3108,7 +3204,8 @@ cdef class _CatBoost:
                         &results,
                         choose_by_train_test_split,
                         return_cv_results,
-                        verbose
+                        verbose,
+                        successiveHalvingParams
                     )
                 else:
                     RandomizedSearch(
@@ -3124,7 +3221,8 @@ cdef class _CatBoost:
                         &results,
                         choose_by_train_test_split,
                         return_cv_results,
-                        verbose
+                        verbose,
+                        successiveHalvingParams
                     )
             finally:
                 ResetPythonInterruptHandler()
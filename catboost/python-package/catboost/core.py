@@ -175,6 +175,8 @@ class EFstrType(Enum):
     Interaction = 3
     """Calculate SHAP Values for every object."""
     ShapValues = 4
+    """Calculate SHAP Interaction Values between every pair of features for every object."""
+    ShapInteractionValues = 5
 
 
 def _get_cat_features_indices(cat_features, feature_names):
@@ -1892,6 +1894,8 @@ class CatBoost(_CatBoostBase):
                     PredictionValuesChange for non-ranking metrics and LossFunctionChange for ranking metrics
                 - ShapValues
                     Calculate SHAP Values for every object.
+                - ShapInteractionValues
+                    Calculate SHAP Interaction Values between every pair of features for every object.
                 - Interaction
                     Calculate pairwise score between every feature.
 
@@ -1936,6 +1940,12 @@ class CatBoost(_CatBoostBase):
                 In case of multiclass the returned value is np.array of shape
                 (n_objects, classes_count, n_features + 1). For each object it contains Shap values (float).
                 Values are calculated for RawFormulaVal predictions.
+            - ShapInteractionValues
+                np.array of shape (n_objects, n_features + 1, n_features + 1) with SHAP interaction values (float)
+                for (object, first_feature, second_feature). Main effects are on the diagonal, the last diagonal
+                element is the expected value. In case of multiclass the returned value is np.array of shape
+                (n_objects, classes_count, n_features + 1, n_features + 1).
+                Values are calculated for RawFormulaVal predictions.
             - Interaction
                 list of length [n_features] of 3-element lists of (first_feature_index, second_feature_index, interaction_score (float))
         """
@@ -2005,6 +2015,14 @@ class CatBoost(_CatBoostBase):
                     return DataFrame(result)
                 else:
                     return np.array(result)
+        elif type == EFstrType.ShapInteractionValues:
+            # returned as [object][dimension][flattened (n_features + 1) x (n_features + 1) matrix]
+            result = np.array(fstr)
+            features_count = int(round(np.sqrt(result.shape[2])))
+            result = result.reshape(result.shape[0], result.shape[1], features_count, features_count)
+            if result.shape[1] == 1:
+                result = result[:, 0]
+            return result
         elif type == EFstrType.Interaction:
             result = [[int(row[0]), int(row[1]), row[2]] for row in fstr]
             if prettified:
@@ -2496,7 +2514,8 @@ class CatBoost(_CatBoostBase):
 
     def _tune_hyperparams(self, param_grid, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True,
-                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1):
+                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1,
+                          successive_halving_reduction_factor=None):
 
         currently_not_supported_params = {
             'ignored_features',
@@ -2558,7 +2577,8 @@ class CatBoost(_CatBoostBase):
             cv_result = self._object._tune_hyperparams(
                 param_grid, train_params["train_pool"], params, n_iter,
                 fold_count, partition_random_seed, shuffle, stratified, train_size,
-                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose
+                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose,
+                successive_halving_reduction_factor
             )
 
         self.set_params(**cv_result['params'])
@@ -2568,7 +2588,8 @@ class CatBoost(_CatBoostBase):
 
     def grid_search(self, param_grid, X, y=None, cv=3, partition_random_seed=0,
                     calc_cv_statistics=True, search_by_train_test_split=True,
-                    refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True):
+                    refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True,
+                    successive_halving_reduction_factor=None):
         """
         Exhaustive search over specified parameter values for a model.
         Aafter calling this method model is fitted and can be used, if not specified otherwise (refit=False).
@@ -2635,6 +2656,13 @@ class CatBoost(_CatBoostBase):
             If verbose is int, it determines the frequency of writing metrics to output
             verbose==True is equal to verbose==1
             When verbose==False, there is no messages
+
+        successive_halving_reduction_factor: int or None, optional (default=None)
+            If set, parameter settings are compared by successive halving: all of them are trained
+            for a part of iterations, the best 1/successive_halving_reduction_factor of them continue training
+            and so on, until no more than successive_halving_reduction_factor of them are trained to full iterations.
+            Should be greater than 1. Used only when search_by_train_test_split=True.
+
         Returns
         -------
         dict with two fields:
@@ -2655,12 +2683,14 @@ class CatBoost(_CatBoostBase):
             param_grid=param_grid, X=X, y=y, cv=cv, n_iter=-1,
             partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
             search_by_train_test_split=search_by_train_test_split, refit=refit, shuffle=shuffle,
-            stratified=stratified, train_size=train_size, verbose=verbose
+            stratified=stratified, train_size=train_size, verbose=verbose,
+            successive_halving_reduction_factor=successive_halving_reduction_factor
         )
 
     def randomized_search(self, param_distributions, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True,
-                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True):
+                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True,
+                          successive_halving_reduction_factor=None):
         """
         Randomized search on hyper parameters.
         After calling this method model is fitted and can be used, if not specified otherwise (refit=False).
@@ -2734,6 +2764,13 @@ class CatBoost(_CatBoostBase):
             If verbose is int, it determines the frequency of writing metrics to output
             verbose==True is equal to verbose==1
             When verbose==False, there is no messages
+
+        successive_halving_reduction_factor: int or None, optional (default=None)
+            If set, parameter settings are compared by successive halving: all of them are trained
+            for a part of iterations, the best 1/successive_halving_reduction_factor of them continue training
+            and so on, until no more than successive_halving_reduction_factor of them are trained to full iterations.
+            Should be greater than 1. Used only when search_by_train_test_split=True.
+
         Returns
         -------
         dict with two fields:
@@ -2753,7 +2790,8 @@ class CatBoost(_CatBoostBase):
             param_grid=param_distributions, X=X, y=y, cv=cv, n_iter=n_iter,
             partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
             search_by_train_test_split=search_by_train_test_split, refit=refit, shuffle=shuffle,
-            stratified=stratified, train_size=train_size, verbose=verbose
+            stratified=stratified, train_size=train_size, verbose=verbose,
+            successive_halving_reduction_factor=successive_halving_reduction_factor
         )
 
 class CatBoostClassifier(CatBoost):
@@ -3020,6 +3058,11 @@ class CatBoostClassifier(CatBoost):
         CPU only. Maximum bucket count in exclusive features bundle. Should be in an integer between 0 and 65536.
         Used only for learning speed tuning.
 
+    dev_efb_conflicts_sample_size : int, [default=0]
+        CPU only. Number of objects used to calculate conflicts between features for exclusive features bundles,
+        0 means all objects.
+        Used only for learning speed tuning.
+
     sparse_features_conflict_fraction : float, [default=0.0]
         CPU only. Maximum allowed fraction of conflicting non-default values for features in exclusive features bundle.
         Should be a real value in [0, 1) interval.
@@ -3156,6 +3199,7 @@ class CatBoostClassifier(CatBoost):
         sampling_unit=None,
         dev_score_calc_obj_block_size=None,
         dev_efb_max_buckets=None,
+        dev_efb_conflicts_sample_size=None,
         sparse_features_conflict_fraction=None,
         max_depth=None,
         n_estimators=None,
@@ -3589,6 +3633,7 @@ class CatBoostRegressor(CatBoost):
         sampling_unit=None,
         dev_score_calc_obj_block_size=None,
         dev_efb_max_buckets=None,
+        dev_efb_conflicts_sample_size=None,
         sparse_features_conflict_fraction=None,
         max_depth=None,
         n_estimators=None,
@@ -320,6 +320,38 @@ def test_dataframe_with_pandas_categorical_columns():
     return local_canonical_file(preds_path)
 
 
+def test_dataframe_with_pandas_categorical_and_integer_columns_same_as_strings():
+    prng = np.random.RandomState(seed=20191018)
+    doc_count = 100
+    cat_values = prng.choice(['a', 'b', 'c', 'd'], size=doc_count)
+    int_values = prng.randint(-3, 5, size=doc_count)
+    labels = _generate_nontrivial_binary_target(doc_count, prng=prng)
+
+    df_codes = DataFrame()
+    df_codes['num_feat'] = prng.random_sample(doc_count)
+    df_codes['cat_feat_categorical'] = Categorical(cat_values, categories=['d', 'c', 'b', 'a', 'unused'])
+    df_codes['cat_feat_int'] = int_values
+
+    df_strings = df_codes.copy()
+    df_strings['cat_feat_categorical'] = cat_values
+    df_strings['cat_feat_int'] = [str(value) for value in int_values]
+
+    model = CatBoostClassifier(iterations=5, one_hot_max_size=3, thread_count=4)
+    model.fit(Pool(df_strings, labels, cat_features=[1, 2]))
+
+    assert np.array_equal(
+        model.predict(Pool(df_codes, cat_features=[1, 2]), prediction_type='RawFormulaVal'),
+        model.predict(Pool(df_strings, cat_features=[1, 2]), prediction_type='RawFormulaVal')
+    )
+
+
+def test_dataframe_with_pandas_categorical_column_with_nan():
+    df = DataFrame()
+    df['cat_feat'] = Categorical(['a', None, 'b'])
+    with pytest.raises(CatBoostError):
+        Pool(df, [0, 1, 0], cat_features=[0])
+
+
 # feature_matrix is (doc_count x feature_count)
 def get_features_data_from_matrix(feature_matrix, cat_feature_indices, order='C'):
     object_count = len(feature_matrix)
@@ -2004,6 +2036,33 @@ def test_randomized_search(task_type):
     assert results['params'].get('border_count') in border_count_list
 
 
+def test_grid_search_successive_halving():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    grid = {
+        'learning_rate': [0.0001, 0.001, 0.01, 0.5],
+        'depth': [4, 6],
+        'border_count': [10, 50]
+    }
+    params = {
+        "iterations": 30,
+        "loss_function": "Logloss",
+        "random_seed": 0,
+    }
+    exhaustive_results = CatBoost(params).grid_search(grid, pool, calc_cv_statistics=False, refit=False)
+    for reduction_factor in [2, 3]:
+        results = CatBoost(params).grid_search(
+            grid,
+            pool,
+            calc_cv_statistics=False,
+            refit=False,
+            successive_halving_reduction_factor=reduction_factor
+        )
+        assert results['params']['learning_rate'] == exhaustive_results['params']['learning_rate']
+
+    with pytest.raises(CatBoostError):
+        CatBoost(params).grid_search(grid, pool, search_by_train_test_split=False, successive_halving_reduction_factor=2)
+
+
 def test_randomized_search_only_dist(task_type):
     pool = Pool(TRAIN_FILE, column_description=CD_FILE)
     model = CatBoost(
@@ -3164,6 +3223,28 @@ def test_shap_multiclass(task_type):
     return local_canonical_file(fimp_txt_path)
 
 
+@pytest.mark.parametrize('loss_function', ['RMSE', 'MultiClass'])
+def test_shap_interaction_values(loss_function):
+    pool = Pool(CLOUDNESS_TRAIN_FILE, column_description=CLOUDNESS_CD_FILE)
+    model = CatBoost({'iterations': 10, 'depth': 4, 'loss_function': loss_function, 'thread_count': 8})
+    model.fit(pool)
+    pred = model.predict(pool, prediction_type='RawFormulaVal')
+    shap_values = model.get_feature_importance(type=EFstrType.ShapValues, data=pool, thread_count=8)
+    interaction_values = model.get_feature_importance(
+        type=EFstrType.ShapInteractionValues,
+        data=pool,
+        thread_count=8
+    )
+    features_count = pool.num_col()
+    if loss_function == 'MultiClass':
+        assert interaction_values.shape == (pool.num_row(), pred.shape[1], features_count + 1, features_count + 1)
+    else:
+        assert interaction_values.shape == (pool.num_row(), features_count + 1, features_count + 1)
+    assert np.allclose(interaction_values, np.swapaxes(interaction_values, -1, -2), atol=EPS)
+    assert np.allclose(interaction_values.sum(axis=-1), shap_values, atol=EPS)
+    assert np.allclose(interaction_values.sum(axis=(-1, -2)), pred, atol=EPS)
+
+
 def test_loading_pool_with_numpy_int():
     assert _check_shape(Pool(np.array([[2, 2], [1, 2]]), [1.2, 3.4], cat_features=[0]), object_count=2, features_count=2)
 
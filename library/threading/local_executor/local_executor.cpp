@@ -2,16 +2,32 @@
 
 #include <library/threading/future/future.h>
 
+#include <util/folder/path.h>
+#include <util/generic/algorithm.h>
+#include <util/generic/deque.h>
+#include <util/generic/singleton.h>
 #include <util/generic/utility.h>
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+#include <util/string/strip.h>
 #include <util/system/atomic.h>
 #include <util/system/event.h>
+#include <util/system/guard.h>
+#include <util/system/info.h>
+#include <util/system/spinlock.h>
 #include <util/system/thread.h>
 #include <util/system/tls.h>
 #include <util/system/yield.h>
 #include <util/thread/lfqueue.h>
 
+#include <atomic>
 #include <utility>
 
+#if defined(_linux_)
+#include <sched.h>
+#endif
+
 #ifdef _win_
 static void RegularYield() {
 }
@@ -82,43 +98,307 @@ namespace {
         }
     };
 
+    constexpr size_t CacheLineSize = 64;
+
+    Y_POD_STATIC_THREAD(int) CurrentNumaNode(-1);
+
+    // cpus of each NUMA node, a single node with all cpus if the topology is unknown
+    class TNumaTopology {
+    public:
+        TNumaTopology() {
+#if defined(_linux_)
+            const TFsPath nodesDir("/sys/devices/system/node");
+            if (nodesDir.IsDirectory()) {
+                TVector<TString> names;
+                nodesDir.ListNames(names);
+                TVector<std::pair<int, TString>> nodes;
+                for (const auto& name : names) {
+                    int node;
+                    if (name.StartsWith("node") && TryFromString<int>(name.substr(4), node)) {
+                        nodes.emplace_back(node, name);
+                    }
+                }
+                Sort(nodes);
+                for (const auto& node : nodes) {
+                    try {
+                        auto cpus = ParseCpuList(TFileInput(nodesDir / node.second / "cpulist").ReadAll());
+                        if (!cpus.empty()) {
+                            NodeCpus.push_back(std::move(cpus));
+                        }
+                    } catch (...) {
+                        NodeCpus.clear();
+                        break;
+                    }
+                }
+            }
+#endif
+            if (NodeCpus.empty()) {
+                NodeCpus.emplace_back();
+                for (size_t cpu = 0; cpu < NSystemInfo::CachedNumberOfCpus(); ++cpu) {
+                    NodeCpus.back().push_back(cpu);
+                }
+            }
+        }
+
+        int GetNodeCount() const {
+            return NodeCpus.ysize();
+        }
+
+        const TVector<int>& GetNodeCpus(int node) const {
+            return NodeCpus[node];
+        }
+
+    private:
+        // "0-23,48-71"
+        static TVector<int> ParseCpuList(TStringBuf cpuList) {
+            TVector<int> cpus;
+            for (const auto& it : StringSplitter(StripString(cpuList)).Split(',').SkipEmpty()) {
+                TStringBuf first, last;
+                if (!it.Token().TrySplit('-', first, last)) {
+                    first = last = it.Token();
+                }
+                for (int cpu = FromString<int>(first); cpu <= FromString<int>(last); ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            return cpus;
+        }
+
+    private:
+        TVector<TVector<int>> NodeCpus;
+    };
+
+    void SetCurrentThreadAffinity(int cpu) {
+#if defined(_linux_)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        // failure is not fatal, the thread just stays unpinned
+        sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+#else
+        Y_UNUSED(cpu);
+#endif
+    }
+
+    // Jobs of one priority pushed by a worker thread. The owner pops from the back, other workers
+    //  steal from the front.
+    class TJobDeque {
+    public:
+        void PushBack(TSingleJob job) {
+            with_lock (Lock) {
+                Jobs.push_back(std::move(job));
+                AtomicSet(Size, Jobs.size());
+            }
+        }
+
+        bool PopBack(TSingleJob* job) {
+            if (AtomicGet(Size) == 0) {
+                return false;
+            }
+            with_lock (Lock) {
+                if (Jobs.empty()) {
+                    return false;
+                }
+                *job = std::move(Jobs.back());
+                Jobs.pop_back();
+                AtomicSet(Size, Jobs.size());
+            }
+            return true;
+        }
+
+        bool PopFront(TSingleJob* job) {
+            if (AtomicGet(Size) == 0) {
+                return false;
+            }
+            with_lock (Lock) {
+                if (Jobs.empty()) {
+                    return false;
+                }
+                *job = std::move(Jobs.front());
+                Jobs.pop_front();
+                AtomicSet(Size, Jobs.size());
+            }
+            return true;
+        }
+
+    private:
+        TAdaptiveLock Lock;
+        TDeque<TSingleJob> Jobs;
+        TAtomic Size = 0;
+    };
+
+    struct alignas(CacheLineSize) TWorker {
+        void* Owner = nullptr;
+        int Id = 0; // 1-based, 0 is reserved for threads outside of the executor
+        int NumaNode = 0;
+        int Cpu = -1; // -1 if not pinned
+        TJobDeque Jobs[3]; // by priority
+        ui32 StealSeed = 0;
+
+    public:
+        int NextVictim(int workerCount) {
+            // xorshift, only used to spread thieves over victims
+            StealSeed ^= StealSeed << 13;
+            StealSeed ^= StealSeed >> 17;
+            StealSeed ^= StealSeed << 5;
+            return StealSeed % workerCount;
+        }
+    };
+
+    // The range [firstId, lastId) is split into one slice per participating thread, slices are tagged with
+    //  NUMA nodes in proportion to the node worker counts. Each thread claims a slice of its node and takes
+    //  ids from it without contention, when the slice is exhausted it steals the upper half of another slice,
+    //  same node first. Stolen ids are republished in the thief's slice, so they can be stolen again.
     class TLocalRangeExecutor: public NPar::ILocallyExecutable {
+        struct alignas(CacheLineSize) TSlice {
+            std::atomic<ui64> Bounds{0}; // begin offset in low 32 bits, end offset in high 32 bits
+            TAtomic Claimed = 0;
+            int NumaNode = 0;
+        };
+
         TIntrusivePtr<NPar::ILocallyExecutable> Exec;
-        TAtomic Counter;
+        int FirstId;
+        int RangeSize;
+        TVector<TSlice> Slices;
         TAtomic WorkerCount;
-        int LastId;
+
+        static ui64 PackBounds(ui32 begin, ui32 end) {
+            return (static_cast<ui64>(end) << 32) | begin;
+        }
+
+        static ui32 GetBegin(ui64 bounds) {
+            return static_cast<ui32>(bounds);
+        }
+
+        static ui32 GetEnd(ui64 bounds) {
+            return static_cast<ui32>(bounds >> 32);
+        }
 
         void LocalExec(int) override {
             AtomicAdd(WorkerCount, 1);
+            Participate();
+            AtomicAdd(WorkerCount, -1);
+        }
+
+        int ClaimSlice(int numaNode) {
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int sliceIdx = 0; sliceIdx < Slices.ysize(); ++sliceIdx) {
+                    auto& slice = Slices[sliceIdx];
+                    if (pass == 0 && slice.NumaNode != numaNode) {
+                        continue;
+                    }
+                    if (AtomicGet(slice.Claimed) == 0 && AtomicCas(&slice.Claimed, 1, 0)) {
+                        return sliceIdx;
+                    }
+                }
+            }
+            return -1;
+        }
+
+        bool TakeOffset(TSlice& slice, ui32* offset) {
+            ui64 bounds = slice.Bounds.load();
             for (;;) {
-                if (!DoSingleOp())
-                    break;
+                const ui32 begin = GetBegin(bounds);
+                const ui32 end = GetEnd(bounds);
+                if (begin >= end) {
+                    return false;
+                }
+                if (slice.Bounds.compare_exchange_weak(bounds, PackBounds(begin + 1, end))) {
+                    *offset = begin;
+                    return true;
+                }
+            }
+        }
+
+        bool StealHalf(TSlice& slice, ui32* stolenBegin, ui32* stolenEnd) {
+            ui64 bounds = slice.Bounds.load();
+            for (;;) {
+                const ui32 begin = GetBegin(bounds);
+                const ui32 end = GetEnd(bounds);
+                if (begin >= end) {
+                    return false;
+                }
+                const ui32 middle = begin + (end - begin) / 2;
+                if (slice.Bounds.compare_exchange_weak(bounds, PackBounds(begin, middle))) {
+                    *stolenBegin = middle;
+                    *stolenEnd = end;
+                    return true;
+                }
             }
-            AtomicAdd(WorkerCount, -1);
+        }
+
+        bool Steal(int numaNode, int thiefSliceIdx, ui32* stolenBegin, ui32* stolenEnd) {
+            const int sliceCount = Slices.ysize();
+            const int start = thiefSliceIdx >= 0 ? thiefSliceIdx + 1 : 0;
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int i = 0; i < sliceCount; ++i) {
+                    const int sliceIdx = (start + i) % sliceCount;
+                    auto& slice = Slices[sliceIdx];
+                    if (sliceIdx == thiefSliceIdx || ((pass == 0) != (slice.NumaNode == numaNode))) {
+                        continue;
+                    }
+                    if (StealHalf(slice, stolenBegin, stolenEnd)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void ExecOffset(ui32 offset) {
+            Exec->LocalExec(FirstId + static_cast<int>(offset));
+            RegularYield();
         }
 
     public:
-        TLocalRangeExecutor(TIntrusivePtr<ILocallyExecutable> exec, int firstId, int lastId)
+        TLocalRangeExecutor(TIntrusivePtr<ILocallyExecutable> exec, int firstId, int lastId, const TVector<int>& sliceNumaNodes)
             : Exec(std::move(exec))
-            , Counter(firstId)
+            , FirstId(firstId)
+            , RangeSize(lastId - firstId)
+            , Slices(sliceNumaNodes.size())
             , WorkerCount(0)
-            , LastId(lastId)
         {
+            Y_ASSERT(!Slices.empty());
+            const int sliceCount = Slices.ysize();
+            for (int sliceIdx = 0; sliceIdx < sliceCount; ++sliceIdx) {
+                const auto [begin, end] = NPar::TLocalExecutor::GetRangeSlice(sliceIdx, 0, RangeSize, sliceCount);
+                Slices[sliceIdx].Bounds.store(PackBounds(begin, end));
+                Slices[sliceIdx].NumaNode = sliceNumaNodes[sliceIdx];
+            }
         }
-        bool DoSingleOp() {
-            TAtomic id = AtomicAdd(Counter, 1) - 1;
-            if (id >= LastId)
-                return false;
-            Exec->LocalExec(id);
-            RegularYield();
-            return true;
+
+        // executes ids until the whole range is taken
+        void Participate() {
+            const int numaNode = CurrentNumaNode;
+            const int sliceIdx = ClaimSlice(numaNode);
+            ui32 offset;
+            if (sliceIdx >= 0) {
+                while (TakeOffset(Slices[sliceIdx], &offset)) {
+                    ExecOffset(offset);
+                }
+            }
+            ui32 stolenBegin, stolenEnd;
+            while (Steal(numaNode, sliceIdx, &stolenBegin, &stolenEnd)) {
+                if (sliceIdx >= 0) {
+                    Slices[sliceIdx].Bounds.store(PackBounds(stolenBegin, stolenEnd));
+                    while (TakeOffset(Slices[sliceIdx], &offset)) {
+                        ExecOffset(offset);
+                    }
+                } else {
+                    for (offset = stolenBegin; offset < stolenEnd; ++offset) {
+                        ExecOffset(offset);
+                    }
+                }
+            }
         }
+
         void WaitComplete() {
             while (AtomicGet(WorkerCount) > 0)
                 RegularYield();
         }
+
         int GetRangeSize() const {
-            return Max<int>(LastId - Counter, 0);
+            return RangeSize;
         }
     };
 
@@ -127,6 +407,9 @@ namespace {
 //////////////////////////////////////////////////////////////////////////
 class NPar::TLocalExecutor::TImpl {
 public:
+    static constexpr int MaxWorkerCount = 4096;
+
+    // jobs from threads outside of the executor, workers push to their own deques
     TLockFreeQueue<TSingleJob> JobQueue;
     TLockFreeQueue<TSingleJob> MedJobQueue;
     TLockFreeQueue<TSingleJob> LowJobQueue;
@@ -136,20 +419,59 @@ public:
     TAtomic QueueSize{0};
     TAtomic MPQueueSize{0};
     TAtomic LPQueueSize{0};
-    TAtomic ThreadId{0};
+
+    // Workers[0, WorkerCount) are published and never removed until destruction
+    TVector<THolder<TWorker>> Workers;
+    TAtomic WorkerCount{0};
+    TAdaptiveLock AddWorkerLock;
+    bool PinThreads = false;
+    TVector<int> NumaNodeWorkerCounts;
 
     Y_THREAD(int)
     CurrentTaskPriority;
     Y_THREAD(int)
     WorkerThreadId;
+    Y_THREAD(TWorker*)
+    CurrentWorker;
 
     static void* HostWorkerThread(void* p);
-    bool GetJob(TSingleJob* job);
+    bool GetJob(TWorker* worker, TSingleJob* job);
+    bool StealJob(TWorker* thief, int priority, TSingleJob* job);
     void RunNewThread();
+    void PushJob(TSingleJob job, int priority);
+    TVector<int> GetSliceNumaNodes(int sliceCount);
     void LaunchRange(TIntrusivePtr<TLocalRangeExecutor> execRange, int queueSizeLimit,
                      TAtomic* queueSize, TLockFreeQueue<TSingleJob>* jobQueue);
 
-    TImpl() = default;
+    TLockFreeQueue<TSingleJob>& GetJobQueue(int priority) {
+        switch (priority) {
+            case HIGH_PRIORITY:
+                return JobQueue;
+            case MED_PRIORITY:
+                return MedJobQueue;
+            default:
+                Y_ASSERT(priority == LOW_PRIORITY);
+                return LowJobQueue;
+        }
+    }
+
+    TAtomic& GetQueueSize(int priority) {
+        switch (priority) {
+            case HIGH_PRIORITY:
+                return QueueSize;
+            case MED_PRIORITY:
+                return MPQueueSize;
+            default:
+                Y_ASSERT(priority == LOW_PRIORITY);
+                return LPQueueSize;
+        }
+    }
+
+    TImpl()
+        : Workers(MaxWorkerCount)
+        , NumaNodeWorkerCounts(Singleton<TNumaTopology>()->GetNodeCount(), 0)
+    {
+    }
     ~TImpl();
 };
 
@@ -165,21 +487,27 @@ NPar::TLocalExecutor::TImpl::~TImpl() {
 void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
     static const int FAST_ITERATIONS = 200;
 
-    auto* const ctx = (TImpl*)p;
+    auto* const worker = (TWorker*)p;
+    auto* const ctx = (TImpl*)worker->Owner;
     TThread::CurrentThreadSetName("ParLocalExecutor");
-    ctx->WorkerThreadId = AtomicAdd(ctx->ThreadId, 1);
+    if (worker->Cpu >= 0) {
+        SetCurrentThreadAffinity(worker->Cpu);
+    }
+    ctx->WorkerThreadId = worker->Id;
+    ctx->CurrentWorker = worker;
+    CurrentNumaNode = worker->NumaNode;
     for (bool cont = true; cont;) {
         TSingleJob job;
         bool gotJob = false;
         for (int iter = 0; iter < FAST_ITERATIONS; ++iter) {
-            if (ctx->GetJob(&job)) {
+            if (ctx->GetJob(worker, &job)) {
                 gotJob = true;
                 break;
             }
         }
         if (!gotJob) {
             ctx->HasJob.Reset();
-            if (!ctx->GetJob(&job)) {
+            if (!ctx->GetJob(worker, &job)) {
                 ctx->HasJob.Wait();
                 continue;
             }
@@ -198,30 +526,105 @@ void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
     return nullptr;
 }
 
-bool NPar::TLocalExecutor::TImpl::GetJob(TSingleJob* job) {
-    if (JobQueue.Dequeue(job)) {
-        CurrentTaskPriority = TLocalExecutor::HIGH_PRIORITY;
-        AtomicAdd(QueueSize, -1);
-        return true;
-    } else if (MedJobQueue.Dequeue(job)) {
-        CurrentTaskPriority = TLocalExecutor::MED_PRIORITY;
-        AtomicAdd(MPQueueSize, -1);
-        return true;
-    } else if (LowJobQueue.Dequeue(job)) {
-        CurrentTaskPriority = TLocalExecutor::LOW_PRIORITY;
-        AtomicAdd(LPQueueSize, -1);
-        return true;
+bool NPar::TLocalExecutor::TImpl::GetJob(TWorker* worker, TSingleJob* job) {
+    for (int priority : {HIGH_PRIORITY, MED_PRIORITY, LOW_PRIORITY}) {
+        if (worker->Jobs[priority].PopBack(job)
+            || GetJobQueue(priority).Dequeue(job)
+            || StealJob(worker, priority, job))
+        {
+            CurrentTaskPriority = priority;
+            AtomicAdd(GetQueueSize(priority), -1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NPar::TLocalExecutor::TImpl::StealJob(TWorker* thief, int priority, TSingleJob* job) {
+    const int workerCount = AtomicGet(WorkerCount);
+    if (workerCount < 2) {
+        return false;
+    }
+    const int start = thief->NextVictim(workerCount);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < workerCount; ++i) {
+            TWorker* victim = Workers[(start + i) % workerCount].Get();
+            if (victim == thief || ((pass == 0) != (victim->NumaNode == thief->NumaNode))) {
+                continue;
+            }
+            if (victim->Jobs[priority].PopFront(job)) {
+                return true;
+            }
+        }
     }
     return false;
 }
 
 void NPar::TLocalExecutor::TImpl::RunNewThread() {
+    TWorker* worker = nullptr;
+    with_lock (AddWorkerLock) {
+        const int workerIdx = AtomicGet(WorkerCount);
+        Y_VERIFY(workerIdx < MaxWorkerCount, "TLocalExecutor supports at most %d threads", MaxWorkerCount);
+        Workers[workerIdx] = MakeHolder<TWorker>();
+        worker = Workers[workerIdx].Get();
+        worker->Owner = this;
+        worker->Id = workerIdx + 1;
+        worker->StealSeed = 2654435761u * worker->Id;
+        if (PinThreads) {
+            // round robin over nodes, so that any number of threads is spread evenly
+            const auto& topology = *Singleton<TNumaTopology>();
+            worker->NumaNode = workerIdx % topology.GetNodeCount();
+            const auto& nodeCpus = topology.GetNodeCpus(worker->NumaNode);
+            worker->Cpu = nodeCpus[(workerIdx / topology.GetNodeCount()) % nodeCpus.size()];
+        }
+        ++NumaNodeWorkerCounts[worker->NumaNode];
+        AtomicIncrement(WorkerCount);
+    }
     AtomicAdd(ThreadCount, 1);
-    TThread thr(HostWorkerThread, this);
+    TThread thr(HostWorkerThread, worker);
     thr.Start();
     thr.Detach();
 }
 
+void NPar::TLocalExecutor::TImpl::PushJob(TSingleJob job, int priority) {
+    AtomicAdd(GetQueueSize(priority), 1);
+    TWorker* worker = CurrentWorker;
+    if (worker) {
+        worker->Jobs[priority].PushBack(std::move(job));
+    } else {
+        GetJobQueue(priority).Enqueue(std::move(job));
+    }
+    HasJob.Signal();
+}
+
+TVector<int> NPar::TLocalExecutor::TImpl::GetSliceNumaNodes(int sliceCount) {
+    TVector<int> sliceNumaNodes(sliceCount, 0);
+    TVector<int> nodeWorkerCounts;
+    with_lock (AddWorkerLock) {
+        nodeWorkerCounts = NumaNodeWorkerCounts;
+    }
+    int workerCount = 0;
+    for (int count : nodeWorkerCounts) {
+        workerCount += count;
+    }
+    if (workerCount == 0) {
+        return sliceNumaNodes;
+    }
+    // consecutive slices go to the same node, the node's share of slices is its share of workers
+    int node = 0;
+    int cumulativeWorkerCount = nodeWorkerCounts[0];
+    for (int sliceIdx = 0; sliceIdx < sliceCount; ++sliceIdx) {
+        while (node + 1 < nodeWorkerCounts.ysize()
+            && (2 * sliceIdx + 1) * (i64)workerCount > 2 * (i64)sliceCount * cumulativeWorkerCount)
+        {
+            ++node;
+            cumulativeWorkerCount += nodeWorkerCounts[node];
+        }
+        sliceNumaNodes[sliceIdx] = node;
+    }
+    return sliceNumaNodes;
+}
+
 void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<TLocalRangeExecutor> rangeExec,
                                               int queueSizeLimit,
                                               TAtomic* queueSize,
@@ -248,27 +651,17 @@ void NPar::TLocalExecutor::RunAdditionalThreads(int threadCount) {
         Impl_->RunNewThread();
 }
 
+void NPar::TLocalExecutor::SetThreadPinning(bool pinThreads) {
+    with_lock (Impl_->AddWorkerLock) {
+        Impl_->PinThreads = pinThreads;
+    }
+}
+
 void NPar::TLocalExecutor::Exec(TIntrusivePtr<ILocallyExecutable> exec, int id, int flags) {
     Y_ASSERT((flags & WAIT_COMPLETE) == 0); // unsupported
     int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
-    switch (prior) {
-        case HIGH_PRIORITY:
-            AtomicAdd(Impl_->QueueSize, 1);
-            Impl_->JobQueue.Enqueue(TSingleJob(std::move(exec), id));
-            break;
-        case MED_PRIORITY:
-            AtomicAdd(Impl_->MPQueueSize, 1);
-            Impl_->MedJobQueue.Enqueue(TSingleJob(std::move(exec), id));
-            break;
-        case LOW_PRIORITY:
-            AtomicAdd(Impl_->LPQueueSize, 1);
-            Impl_->LowJobQueue.Enqueue(TSingleJob(std::move(exec), id));
-            break;
-        default:
-            Y_ASSERT(0);
-            break;
-    }
-    Impl_->HasJob.Signal();
+    Y_ASSERT(prior == HIGH_PRIORITY || prior == MED_PRIORITY || prior == LOW_PRIORITY);
+    Impl_->PushJob(TSingleJob(std::move(exec), id), prior);
 }
 
 void NPar::TLocalExecutor::Exec(TLocallyExecutableFunction exec, int id, int flags) {
@@ -284,7 +677,8 @@ void NPar::TLocalExecutor::ExecRange(TIntrusivePtr<ILocallyExecutable> exec, int
         exec->LocalExec(firstId);
         return;
     }
-    auto rangeExec = MakeIntrusive<TLocalRangeExecutor>(std::move(exec), firstId, lastId);
+    const int sliceCount = Min<int>(AtomicGet(Impl_->ThreadCount) + 1, lastId - firstId);
+    auto rangeExec = MakeIntrusive<TLocalRangeExecutor>(std::move(exec), firstId, lastId, Impl_->GetSliceNumaNodes(sliceCount));
     int queueSizeLimit = (flags & WAIT_COMPLETE) ? 10000 : -1;
     int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
     switch (prior) {
@@ -304,8 +698,7 @@ void NPar::TLocalExecutor::ExecRange(TIntrusivePtr<ILocallyExecutable> exec, int
     if (flags & WAIT_COMPLETE) {
         int keepPrior = Impl_->CurrentTaskPriority;
         Impl_->CurrentTaskPriority = prior;
-        while (rangeExec->DoSingleOp()) {
-        }
+        rangeExec->Participate();
         Impl_->CurrentTaskPriority = keepPrior;
         rangeExec->WaitComplete();
     }
@@ -335,13 +728,18 @@ void NPar::TLocalExecutor::ClearLPQueue() {
     for (bool cont = true; cont;) {
         cont = false;
         TSingleJob job;
-        while (Impl_->LowJobQueue.Dequeue(&job)) {
-            AtomicAdd(Impl_->LPQueueSize, -1);
-            cont = true;
-        }
-        while (Impl_->MedJobQueue.Dequeue(&job)) {
-            AtomicAdd(Impl_->MPQueueSize, -1);
-            cont = true;
+        for (int priority : {LOW_PRIORITY, MED_PRIORITY}) {
+            while (Impl_->GetJobQueue(priority).Dequeue(&job)) {
+                AtomicAdd(Impl_->GetQueueSize(priority), -1);
+                cont = true;
+            }
+            const int workerCount = AtomicGet(Impl_->WorkerCount);
+            for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+                while (Impl_->Workers[workerIdx]->Jobs[priority].PopFront(&job)) {
+                    AtomicAdd(Impl_->GetQueueSize(priority), -1);
+                    cont = true;
+                }
+            }
         }
     }
 }
@@ -366,4 +764,35 @@ int NPar::TLocalExecutor::GetThreadCount() const noexcept {
     return AtomicGet(Impl_->ThreadCount);
 }
 
+int NPar::TLocalExecutor::GetWorkerNumaNode() const noexcept {
+    TWorker* worker = Impl_->CurrentWorker;
+    return worker ? worker->NumaNode : 0;
+}
+
+int NPar::TLocalExecutor::GetNumaNodeCount() const noexcept {
+    return Singleton<TNumaTopology>()->GetNodeCount();
+}
+
+int NPar::TLocalExecutor::GetRangeNumaNode(int id, int firstId, int lastId) const {
+    Y_ASSERT(firstId <= id && id < lastId);
+    const i64 rangeSize = lastId - firstId;
+    const int sliceCount = Min<i64>(AtomicGet(Impl_->ThreadCount) + 1, rangeSize);
+    return Impl_->GetSliceNumaNodes(sliceCount)[GetRangeSliceIdx(id, firstId, lastId, sliceCount)];
+}
+
+std::pair<int, int> NPar::TLocalExecutor::GetRangeSlice(int sliceIdx, int firstId, int lastId, int sliceCount) {
+    Y_ASSERT(0 <= sliceIdx && sliceIdx < sliceCount);
+    const i64 rangeSize = lastId - firstId;
+    return {
+        firstId + static_cast<int>(sliceIdx * rangeSize / sliceCount),
+        firstId + static_cast<int>((sliceIdx + 1) * rangeSize / sliceCount)
+    };
+}
+
+int NPar::TLocalExecutor::GetRangeSliceIdx(int id, int firstId, int lastId, int sliceCount) {
+    Y_ASSERT(firstId <= id && id < lastId);
+    // the largest sliceIdx with sliceIdx * rangeSize / sliceCount <= id - firstId
+    return ((i64)(id - firstId + 1) * sliceCount - 1) / (lastId - firstId);
+}
+
 //////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,7 @@
 #include <util/generic/ymath.h>
 
 #include <functional>
+#include <utility>
 
 namespace NPar {
     struct ILocallyExecutable : virtual public TThrRefBase {
@@ -128,11 +129,30 @@ namespace NPar {
         int GetWorkerThreadId() const noexcept;
         int GetThreadCount() const noexcept;
 
+        // NUMA node of the current worker thread, 0 for unpinned threads and threads outside of the executor
+        int GetWorkerNumaNode() const noexcept;
+        int GetNumaNodeCount() const noexcept;
+
+        // NUMA node whose threads take `id` first in `ExecRange` over [firstId, lastId) while the thread count
+        // doesn't change, data processed by range tasks can be placed on this node in advance
+        int GetRangeNumaNode(int id, int firstId, int lastId) const;
+
+        // [begin, end) ids of slice `sliceIdx` when `ExecRange` splits [firstId, lastId) into `sliceCount` slices
+        static std::pair<int, int> GetRangeSlice(int sliceIdx, int firstId, int lastId, int sliceCount);
+        // slice of `id` in the same split
+        static int GetRangeSliceIdx(int id, int firstId, int lastId, int sliceCount);
+
         // **Add** threads to underlying thread pool.
         //
         // @param threadCount       Number of threads to add.
         void RunAdditionalThreads(int threadCount);
 
+        // Pin threads added by subsequent `RunAdditionalThreads` calls to cpus, spreading them evenly
+        // over NUMA nodes. Pinned threads prefer to steal jobs and range slices from their own node.
+        //
+        // @param pinThreads        Whether to pin new threads, threads are not pinned by default.
+        void SetThreadPinning(bool pinThreads);
+
         // Add task for further execution.
         //
         // @param exec          Task description.
@@ -6,6 +6,8 @@
 #include <util/system/rwlock.h>
 #include <util/generic/algorithm.h>
 
+#include <atomic>
+
 using namespace NPar;
 
 class TTestException: public yexception {
@@ -324,3 +326,90 @@ Y_UNIT_TEST(NestedParallelExceptionsDoNotLeak) {
 }
 }
 ;
+
+Y_UNIT_TEST_SUITE(WorkStealing) {
+    void RunRangeAndCheckEachIdOnce(int rangeSize, int threadsCount, bool pinThreads, int flags) {
+        TLocalExecutor localExecutor;
+        localExecutor.SetThreadPinning(pinThreads);
+        localExecutor.RunAdditionalThreads(threadsCount);
+        TVector<std::atomic<int>> counts(rangeSize);
+        localExecutor.ExecRange([&counts](int id) {
+            ++counts[id - 10];
+        },
+                                10, 10 + rangeSize, flags | TLocalExecutor::WAIT_COMPLETE);
+        for (const auto& count : counts) {
+            UNIT_ASSERT_EQUAL(count.load(), 1);
+        }
+    }
+
+    Y_UNIT_TEST(RangeIdsAreExecutedOnce) {
+        for (int rangeSize : {2, 7, DefaultRangeSize, 100000}) {
+            RunRangeAndCheckEachIdOnce(rangeSize, DefaultThreadsCount, false, TLocalExecutor::HIGH_PRIORITY);
+            RunRangeAndCheckEachIdOnce(rangeSize, 3, false, TLocalExecutor::LOW_PRIORITY);
+            RunRangeAndCheckEachIdOnce(rangeSize, 0, false, TLocalExecutor::MED_PRIORITY);
+        }
+    }
+
+    Y_UNIT_TEST(RangeIdsAreExecutedOnceWithPinnedThreads) {
+        RunRangeAndCheckEachIdOnce(DefaultRangeSize, DefaultThreadsCount, true, TLocalExecutor::HIGH_PRIORITY);
+        UNIT_ASSERT(LocalExecutor().GetNumaNodeCount() >= 1);
+    }
+
+    Y_UNIT_TEST(RangeSlicesMatchSliceIdx) {
+        for (int rangeSize : {1, 2, 7, 64, DefaultRangeSize}) {
+            for (int sliceCount = 1; sliceCount <= Min(rangeSize, DefaultThreadsCount + 1); ++sliceCount) {
+                int expectedBegin = 10;
+                for (int sliceIdx = 0; sliceIdx < sliceCount; ++sliceIdx) {
+                    const auto [begin, end] = TLocalExecutor::GetRangeSlice(sliceIdx, 10, 10 + rangeSize, sliceCount);
+                    UNIT_ASSERT_EQUAL(begin, expectedBegin);
+                    UNIT_ASSERT(begin < end);
+                    for (int id = begin; id < end; ++id) {
+                        UNIT_ASSERT_EQUAL(TLocalExecutor::GetRangeSliceIdx(id, 10, 10 + rangeSize, sliceCount), sliceIdx);
+                    }
+                    expectedBegin = end;
+                }
+                UNIT_ASSERT_EQUAL(expectedBegin, 10 + rangeSize);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(RangeNumaNodesAreConsecutive) {
+        TLocalExecutor localExecutor;
+        localExecutor.SetThreadPinning(true);
+        localExecutor.RunAdditionalThreads(DefaultThreadsCount);
+        int prevNumaNode = 0;
+        for (int id = 10; id < 10 + DefaultRangeSize; ++id) {
+            const int numaNode = localExecutor.GetRangeNumaNode(id, 10, 10 + DefaultRangeSize);
+            UNIT_ASSERT(prevNumaNode <= numaNode && numaNode < localExecutor.GetNumaNodeCount());
+            prevNumaNode = numaNode;
+        }
+    }
+
+    Y_UNIT_TEST(NestedExecIsStolen) {
+        // jobs pushed by a worker go to its own deque and have to be stolen by the others
+        TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(DefaultThreadsCount);
+        const int outerCount = 8;
+        const int innerCount = 100;
+        TAtomic processed = 0;
+        localExecutor.ExecRange([&](int) {
+            TVector<NThreading::TPromise<void>> promises;
+            for (int i = 0; i < innerCount; ++i) {
+                promises.push_back(NThreading::NewPromise());
+            }
+            for (int i = 0; i < innerCount; ++i) {
+                localExecutor.Exec([&promises, &processed](int id) {
+                    AtomicAdd(processed, 1);
+                    promises[id].SetValue();
+                },
+                                   i, TLocalExecutor::HIGH_PRIORITY);
+            }
+            for (auto& promise : promises) {
+                promise.GetFuture().Wait();
+            }
+        },
+                                0, outerCount, TLocalExecutor::WAIT_COMPLETE);
+        UNIT_ASSERT_EQUAL(AtomicGet(processed), outerCount * innerCount);
+    }
+}
+;